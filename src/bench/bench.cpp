@@ -0,0 +1,308 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 01:12:40
+//  Module Name:        bench.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Microbenchmarks of the grid, graph and solver kernels,
+//                      ./pwrx_bench [case] [--filter name] [--repeat N]
+//                      [--csv file]. Grid kernels run on the given case, the
+//                      PointBinSystem and CornerStitching ones on seeded random
+//                      workloads, the pipeline group runs the flow of
+//                      runMyAlgorithm once per repeat and reads the ScopedTimer
+//                      events of the kernels inside it
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <map>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "microBenchmark.hpp"
+#include "caseResolver.hpp"
+#include "timeProfiler.hpp"
+#include "cord.hpp"
+#include "tile.hpp"
+#include "cornerStitching.hpp"
+#include "pointBinSystem.hpp"
+#include "diffusionEngine.hpp"
+
+namespace {
+    struct BenchOptions{
+        std::string caseName = "case01";
+        CaseFiles caseFiles;
+        std::string filter;
+        std::string csvPath;
+        size_t repeat = 5;
+    };
+
+    BenchOptions parseOptions(int argc, char **argv){
+        BenchOptions options;
+        // the case is the first argument as bin/pwrx takes it, case01 when the options come first
+        int firstOption = 1;
+        if((argc > 1) && (argv[1][0] != '-')){
+            options.caseName = argv[1];
+            firstOption = 2;
+        }
+        if(!resolveCaseFiles(options.caseName, options.caseFiles)){
+            std::cout << "[PowerX:Bench] Error: Invalid case \"" << options.caseName << "\", expected case01 ~ case06, a case under inputs/, or a case directory" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        for(int i = firstOption; i < argc; ++i){
+            std::string arg = argv[i];
+            if((arg == "--filter") && (i + 1 < argc)) options.filter = argv[++i];
+            else if((arg == "--csv") && (i + 1 < argc)) options.csvPath = argv[++i];
+            else if((arg == "--repeat") && (i + 1 < argc)) options.repeat = std::max(1, std::atoi(argv[++i]));
+            // anything else is left for PETSc
+        }
+        return options;
+    }
+
+    // durations of every ScopedTimer event called name, in the order they started
+    std::vector<double> collectEventDurations(const std::vector<TraceEvent> &events, const std::string &name){
+        std::vector<const TraceEvent *> matched;
+        for(const TraceEvent &ev : events){
+            if(name == ev.name) matched.push_back(&ev);
+        }
+        std::sort(matched.begin(), matched.end(), [](const TraceEvent *a, const TraceEvent *b){ return a->begin < b->begin; });
+
+        std::vector<double> durations;
+        for(const TraceEvent *ev : matched) durations.push_back(double(ev->end - ev->begin));
+        return durations;
+    }
+
+    // element-wise sum of scopes that always run back to back inside one call
+    std::vector<double> sumEventDurations(const std::vector<std::vector<double>> &parts){
+        size_t count = parts.front().size();
+        for(const std::vector<double> &part : parts) count = std::min(count, part.size());
+        std::vector<double> sums(count, 0.0);
+        for(const std::vector<double> &part : parts){
+            for(size_t i = 0; i < count; ++i) sums[i] += part[i];
+        }
+        return sums;
+    }
+
+    void benchGridIndexing(MicroBenchmark &bench, const BenchOptions &options, const std::string &bumpsPath, const std::string &configPath){
+        if(!bench.isSelected("calMetalIdx/calMetalCord") && !bench.isSelected("calViaIdx/calViaCord")) return;
+
+        DiffusionEngine dse(bumpsPath, configPath);
+        const size_t metalCount = dse.metalGrid.size();
+        const size_t viaCount = dse.viaGrid.size();
+
+        bench.run("calMetalIdx/calMetalCord", options.repeat * 10, 1, double(metalCount), "cells", nullptr, [&](){
+            size_t checksum = 0;
+            for(size_t idx = 0; idx < metalCount; ++idx) checksum += dse.calMetalIdx(dse.calMetalCord(idx));
+            keepAlive(checksum);
+        });
+
+        bench.run("calViaIdx/calViaCord", options.repeat * 10, 1, double(viaCount), "cells", nullptr, [&](){
+            size_t checksum = 0;
+            for(size_t idx = 0; idx < viaCount; ++idx) checksum += dse.calViaIdx(dse.calViaCord(idx));
+            keepAlive(checksum);
+        });
+    }
+
+    void benchGridKernels(MicroBenchmark &bench, const BenchOptions &options, const std::string &bumpsPath, const std::string &configPath){
+        std::unique_ptr<DiffusionEngine> dse;
+        auto cellCount = [&](){ return double(dse->metalGrid.size() + dse->viaGrid.size()); };
+
+        // each kernel gets a fresh engine prepared exactly as runDiffusionTop() leaves it
+        auto prepare = [&](int steps){
+            dse = std::make_unique<DiffusionEngine>(bumpsPath, configPath);
+            dse->markPreplacedAndInsertPadsOnCanvas();
+            dse->markObstaclesOnCanvas();
+            dse->initialiseGraphWithPreplaced();
+            if(steps < 1) return;
+            dse->fillEnclosedRegions();
+            dse->markHalfOccupiedMetalsAndPins();
+            dse->linkNeighbors();
+            if(steps < 2) return;
+            dse->initialiseIndexing();
+            dse->placeDiffusionParticles();
+        };
+
+        if(bench.isSelected("fillEnclosedRegions")){
+            prepare(0);
+            double cells = cellCount();
+            bench.run("fillEnclosedRegions", options.repeat, 1, cells, "cells", [&](){ prepare(0); }, [&](){ dse->fillEnclosedRegions(); });
+        }
+
+        if(bench.isSelected("initialiseIndexing")){
+            prepare(1);
+            double cells = cellCount();
+            bench.run("initialiseIndexing", options.repeat, 1, cells, "cells", [&](){ prepare(1); }, [&](){ keepAlive(dse->initialiseIndexing()); });
+        }
+
+        if(bench.isSelected("diffuse")){
+            prepare(2);
+            double cells = cellCount();
+            // one diffusion step per op, the engine keeps diffusing across ops of a round
+            bench.run("diffuse", options.repeat, 10, cells, "cells", [&](){ prepare(2); }, [&](){ dse->diffuse(0.1); });
+        }
+        dse.reset();
+    }
+
+    void benchPipeline(MicroBenchmark &bench, const BenchOptions &options, const std::string &bumpsPath, const std::string &configPath){
+        const std::vector<std::string> names = {"runMCFSolver model build", "buildGactFactorAndRefresh", "flush_chunk solve + gain", "flush_chunk gain", "buildPhysicalImplementation"};
+        if(std::none_of(names.begin(), names.end(), [&](const std::string &name){ return bench.isSelected(name); })) return;
+
+        std::map<std::string, std::vector<double>> samples;
+        double flowEdges = 0;
+        double physicalNodes = 0;
+
+        bool tracing = TraceRecorder::isEnabled();
+        if(!tracing) TraceRecorder::enable();
+        for(size_t round = 0; round < options.repeat; ++round){
+            std::cout << "[PowerX:Bench] pipeline round " << round + 1 << "/" << options.repeat << std::endl;
+            TraceRecorder::clear();
+
+            DiffusionEngine dse(bumpsPath, configPath);
+            dse.markPreplacedAndInsertPadsOnCanvas();
+            dse.markObstaclesOnCanvas();
+            dse.initialiseGraphWithPreplaced();
+            dse.fillEnclosedRegions();
+
+            dse.initialiseMCFSolver();
+            dse.runMCFSolver("", 0);
+            flowEdges = double(dse.flowEdgeOwnership.size());
+            dse.postMCFLocalRepairTop(false);
+            dse.writeBackToPDN();
+
+            dse.initialiseFiller();
+            dse.initialiseSignalTreesX();
+            dse.runInitialEvaluationX();
+            dse.evaluateAndFillX();
+            dse.writeBackToPDN();
+
+            dse.assignVias();
+            for(int i = 0; i < dse.getMetalLayerCount(); ++i) dse.removeFloatingPlanes(i);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            dse.buildPhysicalImplementation();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            samples["buildPhysicalImplementation"].push_back(elapsed.count());
+            physicalNodes = double(dse.physicalNodes.size());
+
+            std::vector<TraceEvent> events = TraceRecorder::getEvents();
+            auto append = [&](const std::string &name, const std::vector<double> &durations){
+                samples[name].insert(samples[name].end(), durations.begin(), durations.end());
+            };
+            append("runMCFSolver model build", collectEventDurations(events, "MCF Model Build"));
+            append("buildGactFactorAndRefresh", sumEventDurations({collectEventDurations(events, "Assemble"), collectEventDurations(events, "Factor"), collectEventDurations(events, "Baseline Solve")}));
+            std::vector<double> gain = collectEventDurations(events, "Gain");
+            append("flush_chunk solve + gain", sumEventDurations({collectEventDurations(events, "Batched Solve"), gain}));
+            append("flush_chunk gain", gain);
+        }
+        TraceRecorder::clear();
+        if(!tracing) TraceRecorder::disable();
+
+        bench.record("runMCFSolver model build", samples["runMCFSolver model build"], flowEdges, "edges");
+        bench.record("buildGactFactorAndRefresh", samples["buildGactFactorAndRefresh"], 1, "calls");
+        bench.record("flush_chunk solve + gain", samples["flush_chunk solve + gain"], 1, "chunks");
+        bench.record("flush_chunk gain", samples["flush_chunk gain"], 1, "chunks");
+        bench.record("buildPhysicalImplementation", samples["buildPhysicalImplementation"], physicalNodes, "nodes");
+    }
+
+    void benchPointBinSystem(MicroBenchmark &bench, const BenchOptions &options){
+        if(!bench.isSelected("PointBinSystem::queryDistance")) return;
+
+        constexpr int POINT_COUNT = 100000;
+        constexpr int QUERY_COUNT = 10000;
+        constexpr double CANVAS_SIZE = 1000.0;
+
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_real_distribution<double> coordinate(0.0, CANVAS_SIZE);
+        std::vector<int> objects(POINT_COUNT);
+        PointBinSystem<double, int> bins(10.0, 0.0, 0.0, CANVAS_SIZE, CANVAS_SIZE);
+        for(int i = 0; i < POINT_COUNT; ++i) bins.insert(coordinate(rng), coordinate(rng), &objects[i]);
+
+        std::vector<std::pair<double, double>> centres(QUERY_COUNT);
+        for(std::pair<double, double> &centre : centres) centre = {coordinate(rng), coordinate(rng)};
+
+        size_t queryIdx = 0;
+        bench.run("PointBinSystem::queryDistance", options.repeat, QUERY_COUNT, 1, "queries", [&](){ queryIdx = 0; }, [&](){
+            const std::pair<double, double> &centre = centres[queryIdx++];
+            keepAlive(bins.queryDistance(centre.first, centre.second, 15.0).size());
+        });
+    }
+
+    void benchCornerStitching(MicroBenchmark &bench, const BenchOptions &options){
+        if(!bench.isSelected("CornerStitching::insertTile") && !bench.isSelected("CornerStitching::findPoint")) return;
+
+        // disjoint 3x3 tiles on a 4x4 pitch, inserted in a seeded random order
+        constexpr int TILE_COLUMNS = 100;
+        constexpr int TILE_ROWS = 100;
+        constexpr int TILE_PITCH = 4;
+        constexpr int QUERY_COUNT = 100000;
+        const len_t canvasSize = TILE_COLUMNS * TILE_PITCH;
+
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::vector<Cord> tileOrigins;
+        for(int row = 0; row < TILE_ROWS; ++row){
+            for(int column = 0; column < TILE_COLUMNS; ++column) tileOrigins.push_back(Cord(column * TILE_PITCH, row * TILE_PITCH));
+        }
+        std::shuffle(tileOrigins.begin(), tileOrigins.end(), rng);
+
+        std::uniform_int_distribution<len_t> coordinate(0, canvasSize - 1);
+        std::vector<Cord> queries(QUERY_COUNT);
+        for(Cord &query : queries) query = Cord(coordinate(rng), coordinate(rng));
+
+        std::unique_ptr<CornerStitching> cs;
+        size_t tileIdx = 0;
+        bench.run("CornerStitching::insertTile", options.repeat, tileOrigins.size(), 1, "tiles", [&](){
+            cs = std::make_unique<CornerStitching>(canvasSize, canvasSize);
+            tileIdx = 0;
+        }, [&](){
+            keepAlive(cs->insertTile(Tile(tileType::BLOCK, tileOrigins[tileIdx++], 3, 3)));
+        });
+
+        if(!cs){
+            cs = std::make_unique<CornerStitching>(canvasSize, canvasSize);
+            for(const Cord &origin : tileOrigins) cs->insertTile(Tile(tileType::BLOCK, origin, 3, 3));
+        }
+        size_t queryIdx = 0;
+        bench.run("CornerStitching::findPoint", options.repeat, QUERY_COUNT, 1, "queries", [&](){ queryIdx = 0; }, [&](){
+            keepAlive(cs->findPoint(queries[queryIdx++]));
+        });
+    }
+}
+
+int main(int argc, char **argv){
+    BenchOptions options = parseOptions(argc, argv);
+    const std::string &bumpsPath = options.caseFiles.pinoutPath;
+    const std::string &configPath = options.caseFiles.configPath;
+
+    PetscInitialize(&argc, &argv, NULL, NULL);
+
+    MicroBenchmark bench(options.filter);
+    benchGridIndexing(bench, options, bumpsPath, configPath);
+    benchGridKernels(bench, options, bumpsPath, configPath);
+    benchPointBinSystem(bench, options);
+    benchCornerStitching(bench, options);
+    benchPipeline(bench, options, bumpsPath, configPath);
+
+    std::cout << "[PowerX:Bench] " << options.caseFiles.name << ", " << options.repeat << " rounds, seed " << BENCHMARK_SEED << std::endl;
+    bench.printReport();
+    if(!options.csvPath.empty()) bench.writeCSV(options.csvPath);
+
+    PetscFinalize();
+    return 0;
+}
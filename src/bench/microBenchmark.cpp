@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 01:12:40
+//  Module Name:        microBenchmark.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Small timing harness behind "make bench". A benchmark runs
+//                      an untimed setup and a timed body for a number of rounds
+//                      and reports the median and fastest ns/op and throughput.
+//                      Kernels that cannot be called on their own (lambdas inside
+//                      evaluateAndFillX, the Gurobi model build) are measured by
+//                      their ScopedTimer events and recorded the same way
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "microBenchmark.hpp"
+
+namespace {
+    // "12.30M" style
+    std::string formatRate(double itemsPerSecond){
+        const char *suffix[] = {"", "K", "M", "G", "T"};
+        int magnitude = 0;
+        while((itemsPerSecond >= 1000.0) && (magnitude < 4)){
+            itemsPerSecond /= 1000.0;
+            ++magnitude;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.2lf%s", itemsPerSecond, suffix[magnitude]);
+        return buffer;
+    }
+}
+
+MicroBenchmark::MicroBenchmark(const std::string &filter): m_filter(filter) {
+
+}
+
+bool MicroBenchmark::isSelected(const std::string &name) const {
+    return m_filter.empty() || (name.find(m_filter) != std::string::npos);
+}
+
+void MicroBenchmark::run(const std::string &name, size_t rounds, size_t opsPerRound, double itemsPerOp, const std::string &itemName,
+    const std::function<void()> &setup, const std::function<void()> &op){
+
+    assert(rounds >= 1);
+    assert(opsPerRound >= 1);
+    if(!isSelected(name)) return;
+
+    std::cout << "[PowerX:Bench] " << name << " ..." << std::flush;
+    std::vector<double> nsPerOp;
+    nsPerOp.reserve(rounds);
+    for(size_t round = 0; round < rounds; ++round){
+        if(setup) setup();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < opsPerRound; ++i) op();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        nsPerOp.push_back(elapsed.count() / double(opsPerRound));
+    }
+    std::cout << " done" << std::endl;
+
+    record(name, nsPerOp, itemsPerOp, itemName);
+}
+
+void MicroBenchmark::record(const std::string &name, const std::vector<double> &nsPerOp, double itemsPerOp, const std::string &itemName){
+    if(!isSelected(name)) return;
+    if(nsPerOp.empty()){
+        std::cout << "[PowerX:Bench] Warning: " << name << " has no sample" << std::endl;
+        return;
+    }
+
+    std::vector<double> sorted(nsPerOp);
+    std::sort(sorted.begin(), sorted.end());
+    // upper median for an even count, never better than a real sample
+    double median = sorted[sorted.size() / 2];
+    m_results.push_back(BenchmarkResult{name, sorted.size(), median, sorted.front(), itemsPerOp, itemName});
+}
+
+void MicroBenchmark::printReport() const {
+    printf("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║ Benchmark                                    │  Samples │  Median (ns/op) │     Min (ns/op) │ Throughput (median)                ║\n");
+    printf("╟──────────────────────────────────────────────│──────────│─────────────────│─────────────────│────────────────────────────────────╢\n");
+    for(const BenchmarkResult &br : m_results){
+        std::string name = " " + br.name;
+        std::string throughput = formatRate(br.itemsPerOp * 1e9 / br.medianNsPerOp) + " " + br.itemName + "/s";
+        printf("║%-46s│ %8zu │ %15.1lf │ %15.1lf │ %-35s║\n", name.c_str(), br.samples, br.medianNsPerOp, br.minNsPerOp, throughput.c_str());
+    }
+    printf("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+}
+
+bool MicroBenchmark::writeCSV(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        std::cout << "[PowerX:Bench] Error: Cannot open " << filePath << std::endl;
+        return false;
+    }
+
+    ofs << "benchmark,samples,median_ns_per_op,min_ns_per_op,items_per_op,item,items_per_s\n";
+    char buffer[160];
+    for(const BenchmarkResult &br : m_results){
+        std::snprintf(buffer, sizeof(buffer), ",%zu,%.3lf,%.3lf,%.6lf,", br.samples, br.medianNsPerOp, br.minNsPerOp, br.itemsPerOp);
+        ofs << br.name << buffer << br.itemName;
+        std::snprintf(buffer, sizeof(buffer), ",%.6e\n", br.itemsPerOp * 1e9 / br.medianNsPerOp);
+        ofs << buffer;
+    }
+    ofs.close();
+    return true;
+}
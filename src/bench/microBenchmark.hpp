@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 01:12:40
+//  Module Name:        microBenchmark.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Small timing harness behind "make bench". A benchmark runs
+//                      an untimed setup and a timed body for a number of rounds
+//                      and reports the median and fastest ns/op and throughput.
+//                      Kernels that cannot be called on their own (lambdas inside
+//                      evaluateAndFillX, the Gurobi model build) are measured by
+//                      their ScopedTimer events and recorded the same way
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __MICRO_BENCHMARK_H__
+#define __MICRO_BENCHMARK_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+// seed of every random workload so runs are comparable
+constexpr uint32_t BENCHMARK_SEED = 20261020;
+
+// keeps the compiler from dropping a computation whose result is unused
+template <typename T>
+inline void keepAlive(const T &value){
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct BenchmarkResult{
+    std::string name;
+    size_t samples;
+    double medianNsPerOp;
+    double minNsPerOp;
+    // what one op processes, throughput is itemsPerOp / time per op
+    double itemsPerOp;
+    std::string itemName;
+};
+
+class MicroBenchmark{
+private:
+    std::string m_filter;
+    std::vector<BenchmarkResult> m_results;
+
+public:
+    // only benchmarks whose name contains filter run, empty runs all
+    explicit MicroBenchmark(const std::string &filter = "");
+
+    bool isSelected(const std::string &name) const;
+
+    // setup runs before every round and is not timed, a round calls op opsPerRound times
+    void run(const std::string &name, size_t rounds, size_t opsPerRound, double itemsPerOp, const std::string &itemName,
+        const std::function<void()> &setup, const std::function<void()> &op);
+
+    // one duration per op measured elsewhere
+    void record(const std::string &name, const std::vector<double> &nsPerOp, double itemsPerOp, const std::string &itemName);
+
+    inline const std::vector<BenchmarkResult> &getResults() const {return this->m_results;}
+
+    void printReport() const;
+    bool writeCSV(const std::string &filePath) const;
+};
+
+#endif // __MICRO_BENCHMARK_H__
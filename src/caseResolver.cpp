@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:06:17
+//  Module Name:        caseResolver.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Maps the <case> argument of bin/pwrx and bin/pwrx_bench
+//                      to its .tch, .pinout and .config files
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <filesystem>
+#include <unordered_set>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "caseResolver.hpp"
+
+bool resolveCaseFiles(const std::string &caseSpec, CaseFiles &files){
+    static const std::unordered_set<std::string> shippedCases = {"case01", "case02", "case03", "case04", "case05", "case06"};
+
+    std::filesystem::path caseDir;
+    // cases from utils/genSyntheticCase.py are accepted when their pinout exists
+    if (shippedCases.count(caseSpec) || std::filesystem::exists("inputs/" + caseSpec + "/" + caseSpec + ".pinout")) {
+        caseDir = std::filesystem::path("inputs") / caseSpec;
+    } else if (std::filesystem::is_directory(caseSpec)) {
+        caseDir = std::filesystem::path(caseSpec);
+        if (!caseDir.has_filename()) caseDir = caseDir.parent_path();
+    } else {
+        return false;
+    }
+
+    files.name = caseDir.filename().string();
+    files.tchPath    = (caseDir / (files.name + ".tch")).string();
+    files.pinoutPath = (caseDir / (files.name + ".pinout")).string();
+    files.configPath = (caseDir / (files.name + ".config")).string();
+    return std::filesystem::exists(files.pinoutPath) && std::filesystem::exists(files.tchPath) && std::filesystem::exists(files.configPath);
+}
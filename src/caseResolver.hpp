@@ -0,0 +1,41 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:06:17
+//  Module Name:        caseResolver.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Maps the <case> argument of bin/pwrx and bin/pwrx_bench
+//                      to its .tch, .pinout and .config files
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CASE_RESOLVER_H__
+#define __CASE_RESOLVER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+struct CaseFiles{
+    std::string name;
+    std::string tchPath;
+    std::string pinoutPath;
+    std::string configPath;
+};
+
+// a case name resolves to inputs/<name>/, anything else must be a directory holding <dir name>.tch/.pinout/.config
+// false unless all three files exist
+bool resolveCaseFiles(const std::string &caseSpec, CaseFiles &files);
+
+#endif // __CASE_RESOLVER_H__
@@ -296,6 +296,28 @@ namespace colours{
     constexpr const char *C253  = "\u001b[38;5;253m";
     constexpr const char *C254  = "\u001b[38;5;254m";
     constexpr const char *C255  = "\u001b[38;5;255m";
+
+    // fill colour of every SignalType in image output, indexed by the SignalType value, same as
+    // SIGNAL_COLORS in utils/renderObjectArray.py, whose "none" entries (EMPTY, UNKNOWN) are never
+    // filled by the rasteriser, their cells and pins are left as outlines
+    constexpr unsigned char SIGNAL_RGB[16][3] = {
+        {0xFF, 0xFF, 0xFF}, // EMPTY
+        {0x1E, 0x81, 0xB0}, // POWER_1
+        {0xE6, 0x7E, 0x22}, // POWER_2
+        {0xFF, 0xC1, 0x07}, // POWER_3
+        {0xB2, 0x9D, 0xD9}, // POWER_4
+        {0xFC, 0x83, 0xBC}, // POWER_5
+        {0x72, 0xF2, 0xEE}, // POWER_6
+        {0xC0, 0x39, 0x2B}, // POWER_7
+        {0x21, 0xB2, 0xAB}, // POWER_8
+        {0xB0, 0xF2, 0x94}, // POWER_9
+        {0x8D, 0x57, 0xA3}, // POWER_10
+        {0x5C, 0xB8, 0x5C}, // GROUND
+        {0xB0, 0xB0, 0xB0}, // SIGNAL
+        {0x66, 0x33, 0x00}, // OBSTACLE
+        {0xFF, 0x00, 0xFF}, // OVERLAP, not in the python table, loud on purpose
+        {0xFF, 0xFF, 0xFF}  // UNKNOWN
+    };
 }
 
 #endif // __COLOURS_H__
\ No newline at end of file
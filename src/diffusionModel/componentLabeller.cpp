@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 10:12:44
+//  Module Name:        componentLabeller.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Two-pass connected component labelling over flat grids,
+//                      the first pass unites adjacent elements through a DSU and
+//                      the second pass hands out dense labels in element order
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <vector>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "dsu.hpp"
+#include "componentLabeller.hpp"
+
+ComponentLabeller::ComponentLabeller(): m_dsu(0), m_labelCount(0) {}
+
+ComponentLabeller::ComponentLabeller(int elementCount): m_dsu(elementCount), m_labelCount(0) {}
+
+void ComponentLabeller::reset(int elementCount){
+    m_dsu.reset(elementCount);
+    m_labels.clear();
+    m_labelCount = 0;
+}
+
+int ComponentLabeller::resolve(){
+    return resolve([](int){return true;});
+}
+
+int labelCanvas(const std::vector<std::vector<SignalType>> &canvas, std::vector<int> &labels, std::vector<SignalType> &labelSignals){
+    labels.clear();
+    labelSignals.clear();
+
+    const int height = static_cast<int>(canvas.size());
+    if(height == 0) return 0;
+    const int width = static_cast<int>(canvas[0].size());
+
+    ComponentLabeller labeller(width * height);
+    for(int y = 0; y < height; ++y){
+        for(int x = 0; x < width; ++x){
+            SignalType st = canvas[y][x];
+            int idx = y * width + x;
+            if((x != (width - 1)) && (canvas[y][x+1] == st)) labeller.unite(idx, idx + 1);
+            if((y != (height - 1)) && (canvas[y+1][x] == st)) labeller.unite(idx, idx + width);
+        }
+    }
+
+    int labelCount = labeller.resolve();
+    labels = labeller.getLabels();
+    labelSignals.assign(labelCount, SignalType::EMPTY);
+    for(int y = 0; y < height; ++y){
+        for(int x = 0; x < width; ++x){
+            labelSignals[labels[y * width + x]] = canvas[y][x];
+        }
+    }
+
+    return labelCount;
+}
+
+int labelCanvasSignal(const std::vector<std::vector<SignalType>> &canvas, SignalType st, std::vector<int> &labels){
+    labels.clear();
+
+    const int height = static_cast<int>(canvas.size());
+    if(height == 0) return 0;
+    const int width = static_cast<int>(canvas[0].size());
+
+    ComponentLabeller labeller(width * height);
+    for(int y = 0; y < height; ++y){
+        for(int x = 0; x < width; ++x){
+            if(canvas[y][x] != st) continue;
+            int idx = y * width + x;
+            if((x != (width - 1)) && (canvas[y][x+1] == st)) labeller.unite(idx, idx + 1);
+            if((y != (height - 1)) && (canvas[y+1][x] == st)) labeller.unite(idx, idx + width);
+        }
+    }
+
+    int labelCount = labeller.resolve([&](int idx){return canvas[idx / width][idx % width] == st;});
+    labels = labeller.getLabels();
+
+    return labelCount;
+}
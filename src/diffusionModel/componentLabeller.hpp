@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 10:12:44
+//  Module Name:        componentLabeller.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Two-pass connected component labelling over flat grids,
+//                      the first pass unites adjacent elements through a DSU and
+//                      the second pass hands out dense labels in element order
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __COMPONENT_LABELLER_H__
+#define __COMPONENT_LABELLER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <vector>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "dsu.hpp"
+
+constexpr int COMPONENT_LABEL_NONE = -1;
+
+class ComponentLabeller{
+private:
+    DSU m_dsu;
+    std::vector<int> m_labels;
+    std::vector<int> m_rootToLabel;
+    int m_labelCount;
+
+public:
+    ComponentLabeller();
+    explicit ComponentLabeller(int elementCount);
+
+    // drop all unions and labels, elements are ids 0..elementCount-1
+    void reset(int elementCount);
+
+    // first pass: record that a and b are adjacent members of the same component
+    inline bool unite(int a, int b) {return m_dsu.unite(a, b);}
+
+    // second pass: every set holding at least one seed receives a dense label (0..k-1), ordered by
+    // the smallest seed id of the set. Elements of unseeded sets receive COMPONENT_LABEL_NONE
+    template <typename SeedPredicate>
+    int resolve(SeedPredicate isSeed);
+
+    // second pass with every element as a seed
+    int resolve();
+
+    inline int getLabel(int idx) const {return m_labels[idx];}
+    inline const std::vector<int> &getLabels() const {return m_labels;}
+    inline int getLabelCount() const {return m_labelCount;}
+    inline int getElementCount() const {return static_cast<int>(m_labels.size());}
+};
+
+template <typename SeedPredicate>
+int ComponentLabeller::resolve(SeedPredicate isSeed){
+    int elementCount = m_dsu.getElementCount();
+    m_rootToLabel.assign(elementCount, COMPONENT_LABEL_NONE);
+    m_labels.assign(elementCount, COMPONENT_LABEL_NONE);
+    m_labelCount = 0;
+
+    for(int i = 0; i < elementCount; ++i){
+        if(!isSeed(i)) continue;
+        int root = m_dsu.find(i);
+        if(m_rootToLabel[root] == COMPONENT_LABEL_NONE) m_rootToLabel[root] = m_labelCount++;
+    }
+
+    for(int i = 0; i < elementCount; ++i){
+        m_labels[i] = m_rootToLabel[m_dsu.find(i)];
+    }
+
+    return m_labelCount;
+}
+
+// 2D mode: 4-connected cells of the same SignalType, labels are flattened as y * width + x and every cell is labelled
+int labelCanvas(const std::vector<std::vector<SignalType>> &canvas, std::vector<int> &labels, std::vector<SignalType> &labelSignals);
+
+// per-signal mode: only 4-connected cells of signal st are labelled, other cells receive COMPONENT_LABEL_NONE
+int labelCanvasSignal(const std::vector<std::vector<SignalType>> &canvas, SignalType st, std::vector<int> &labels);
+
+#endif // __COMPONENT_LABELLER_H__
@@ -27,6 +27,10 @@
 #include <set>
 #include <limits>
 #include <numeric>
+#include <bit>
+#include <cstring>
+#include <string_view>
+#include <memory>
 
 // 2. Boost Library:
 #include "boost/graph/adjacency_list.hpp"
@@ -37,39 +41,21 @@
 #include "diffusionEngine.hpp"
 #include "timeProfiler.hpp"
 #include "dsu.hpp"
+#include "inputTokenizer.hpp"
 
-void DiffusionEngine::readConfigurations(const std::string &configFileName){
-    if(subViaEdgeUBDivisor != 0) subViaEdgeUB = ViaEdgeUB / subViaEdgeUBDivisor;
-
-    if (configFileName.empty()) return;
-
-    std::ifstream inFile(configFileName);
-    if (!inFile) {
-        std::cout << "[DiffusionEngine] Warning: Could not open config file: " << configFileName << "\n";
-        return;
-    }
-
-    auto trim = [](std::string s) {
-        auto l = s.find_first_not_of(" \t\r\n");
-        auto r = s.find_last_not_of(" \t\r\n");
-        if (l == std::string::npos) return std::string{};
-        return s.substr(l, r - l + 1);
-    };
-    auto isCommentOrEmpty = [&](const std::string& s) {
-        if (s.empty()) return true;
-        size_t i = 0; 
-        while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
-        return (i < s.size() && s[i] == '#');
-    };
-    auto parseDouble = [&](const std::string& v, double& out) -> bool {
-        std::istringstream iss(v);
-        double tmp;
-        iss >> tmp;
-        if (!iss.fail() && iss.eof()) { out = tmp; return true; }
-        return false;
+const std::unordered_set<std::string> &DiffusionEngine::getFillingOnlyConfigurations(){
+    static const std::unordered_set<std::string> fillingOnlyKeys = {
+        "batchSize", "iterationCommitLBPctg", "minCommitRate", "maxCommitRate", "expectedFillingCycles", "maxFillingRate"
     };
+    return fillingOnlyKeys;
+}
 
-    std::unordered_map<std::string, double*> paramTable = {
+bool DiffusionEngine::isFillingOnlyConfiguration(const std::string &key){
+    return getFillingOnlyConfigurations().count(key) != 0;
+}
+
+std::unordered_map<std::string, double*> DiffusionEngine::getConfigurationTable(){
+    return {
         {"normalMetalEdgeLB", &normalMetalEdgeLB},
         {"normalMetalEdgeUB", &normalMetalEdgeUB},
         {"normalMetalEdgeWeight", &normalMetalEdgeWeight},
@@ -100,24 +86,71 @@ void DiffusionEngine::readConfigurations(const std::string &configFileName){
         {"maxFillingRate", &maxFillingRate},
 
     };
+}
+
+void DiffusionEngine::finaliseConfigurations(const std::set<std::string> &seenKeys){
+    if (!seenKeys.count("subViaEdgeUB")) {
+        subViaEdgeUB = ViaEdgeUB / subViaEdgeUBDivisor;
+    }
 
+    if (normalMetalEdgeLB > normalMetalEdgeUB) {
+        std::cout << "[DiffusionEngine] Warning: normalMetalEdgeLB > normalMetalEdgeUB; you may want to swap them.\n";
+    }
+    if (aggrMetalEdgeLB > aggrMetalEdgeUB) {
+        std::cout << "[DiffusionEngine] Warning: aggrMetalEdgeLB > aggrMetalEdgeUB; you may want to swap them.\n";
+    }
+    if (ViaEdgeLB > ViaEdgeUB) {
+        std::cout << "[DiffusionEngine] Warning: ViaEdgeLB > ViaEdgeUB; you may want to swap them.\n";
+    }
+}
+
+void DiffusionEngine::applyConfigurations(const std::unordered_map<std::string, double> &configuration){
+    if(subViaEdgeUBDivisor != 0) subViaEdgeUB = ViaEdgeUB / subViaEdgeUBDivisor;
+
+    std::unordered_map<std::string, double*> paramTable = getConfigurationTable();
     std::set<std::string> seenKeys;
-    std::string fileLine;
-    size_t lineNo = 0;
+    for(const auto &[key, value] : configuration){
+        auto it = paramTable.find(key);
+        if (it == paramTable.end()) {
+            std::cout << "[DiffusionEngine] Warning: unknown config key '" << key
+                        << "'; value '" << value << "' ignored.\n";
+            continue;
+        }
+        *(it->second) = value;
+        seenKeys.insert(key);
+    }
 
-    while (std::getline(inFile, fileLine)) {
-        ++lineNo;
-        std::string raw = trim(fileLine);
-        if (isCommentOrEmpty(raw)) continue;
+    finaliseConfigurations(seenKeys);
+}
+
+void DiffusionEngine::readConfigurations(const std::string &configFileName){
+    if(subViaEdgeUBDivisor != 0) subViaEdgeUB = ViaEdgeUB / subViaEdgeUBDivisor;
+
+    if (configFileName.empty()) return;
+
+    MappedFile inFile(configFileName);
+    if (!inFile.is_open()) {
+        std::cout << "[DiffusionEngine] Warning: Could not open config file: " << configFileName << "\n";
+        return;
+    }
+    InputTokenizer tokenizer(inFile.view());
+
+    std::unordered_map<std::string, double*> paramTable = getConfigurationTable();
+
+    std::set<std::string> seenKeys;
+    std::string_view raw;
+
+    while (tokenizer.nextLine(raw)) {
+        size_t lineNo = tokenizer.getLineNumber();
 
         auto pos = raw.find('=');
-        if (pos == std::string::npos) {
+        if (pos == std::string_view::npos) {
             std::cout << "[DiffusionEngine] Warning: Line " << lineNo 
                         << " missing '='; ignoring: " << raw << "\n";
             continue;
         }
-        std::string key = trim(raw.substr(0, pos));
-        std::string val = trim(raw.substr(pos + 1));
+        std::string key(InputTokenizer::trim(raw.substr(0, pos)));
+        std::string_view val = InputTokenizer::trim(raw.substr(pos + 1));
 
         if (key.empty()) {
             std::cout << "[DiffusionEngine] Warning: Line " << lineNo 
@@ -139,7 +172,7 @@ void DiffusionEngine::readConfigurations(const std::string &configFileName){
         }
 
         double parsed{};
-        if (!parseDouble(val, parsed)) {
+        if (!InputTokenizer::toDouble(val, parsed)) {
             std::cout << "[DiffusionEngine] Warning: Line " << lineNo 
                         << " value for key '" << key
                         << "' is not a valid number: '" << val 
@@ -151,23 +184,23 @@ void DiffusionEngine::readConfigurations(const std::string &configFileName){
         seenKeys.insert(key);
     }
 
-    if (!seenKeys.count("subViaEdgeUB")) {
-        subViaEdgeUB = ViaEdgeUB / subViaEdgeUBDivisor;
-    }
-
-    if (normalMetalEdgeLB > normalMetalEdgeUB) {
-        std::cout << "[DiffusionEngine] Warning: normalMetalEdgeLB > normalMetalEdgeUB; you may want to swap them.\n";
-    }
-    if (aggrMetalEdgeLB > aggrMetalEdgeUB) {
-        std::cout << "[DiffusionEngine] Warning: aggrMetalEdgeLB > aggrMetalEdgeUB; you may want to swap them.\n";
-    }
-    if (ViaEdgeLB > ViaEdgeUB) {
-        std::cout << "[DiffusionEngine] Warning: ViaEdgeLB > ViaEdgeUB; you may want to swap them.\n";
-    }
+    finaliseConfigurations(seenKeys);
 
 }
 
 DiffusionEngine::DiffusionEngine(const std::string &fileName, const std::string &configFileName): PowerDistributionNetwork(fileName) {
+    initialiseGridCounts();
+    readConfigurations(configFileName);
+    initialiseCurrentBudget();
+}
+
+DiffusionEngine::DiffusionEngine(const DesignSpec &spec): PowerDistributionNetwork(spec) {
+    initialiseGridCounts();
+    applyConfigurations(spec.configuration);
+    initialiseCurrentBudget();
+}
+
+void DiffusionEngine::initialiseGridCounts(){
     this->m_metalGridLayers = m_metalLayerCount;
     this->m_metalGridWidth = m_gridWidth;
     this->m_metalGridHeight = m_gridHeight;
@@ -175,10 +208,9 @@ DiffusionEngine::DiffusionEngine(const std::string &fileName, const std::string
     this->m_metalGrid3DCount = m_metalGrid2DCount * m_metalLayerCount;
 
     this->m_viaGridLayers = m_viaLayerCount;
+}
 
-    readConfigurations(configFileName);
-
-    // calculate current budget
+void DiffusionEngine::initialiseCurrentBudget(){
     double totalCurrentBudget = 0;
     for(auto &[st , us] : this->uBump.signalTypeToInstances){
         if(POWER_SIGNAL_SET.count(st) == 0) continue;
@@ -191,7 +223,6 @@ DiffusionEngine::DiffusionEngine(const std::string &fileName, const std::string
     for(auto &[st, value] : this->currentBudget){
         value /= totalCurrentBudget;
     }
-
 }
 
 size_t DiffusionEngine::calMetalIdx(size_t layer, size_t height, size_t width) const {
@@ -273,7 +304,7 @@ void DiffusionEngine::markPreplacedAndInsertPadsOnCanvas(){
         this->viaLayers[i].markPreplacedToCanvas();
     } 
 
-    std::unordered_set<SignalType> viaToMetalSignalTypes(POWER_SIGNAL_SET.begin(), POWER_SIGNAL_SET.end());
+    EnumSet<SignalType> viaToMetalSignalTypes(POWER_SIGNAL_SET);
     viaToMetalSignalTypes.insert(SignalType::SIGNAL);
     // insert pads for the uBump connecting metal layer
     markPinPadsWithSignals(this->metalLayers[m_ubumpConnectedMetalLayerIdx].canvas, this->uBump.canvas, POWER_SIGNAL_SET);
@@ -688,102 +719,53 @@ void DiffusionEngine::initialiseGraphWithPreplaced(){
 }
 
 void DiffusionEngine::fillEnclosedRegions() {
-    for (int layer = 0; layer < m_metalGridLayers; ++layer) {
-        std::vector<std::vector<bool>> visited(m_metalGridHeight, std::vector<bool>(m_metalGridWidth, false));
-
-        for (int y = 0; y < m_metalGridHeight; ++y) {
-            for (int x = 0; x < m_metalGridWidth; ++x) {
-                size_t cellIdx = calMetalIdx(layer, y, x);
-                MetalCell *cellPointer = &metalGrid[cellIdx];
-
-                if (cellPointer->type != CellType::EMPTY || visited[y][x]) continue;
-
-                SignalType cellSignalType = cellPointer->signal;
-
-                std::queue<Cord> q;
-                std::vector<Cord> region;
-                std::unordered_set<SignalType> borderSignals;
-
-                q.push(Cord(x, y));
-                visited[y][x] = true;
-                region.emplace_back(x, y);
-
-                while (!q.empty()) {
-                    Cord c = q.front(); q.pop();
-                    int cx = c.x();
-                    int cy = c.y();
-
-                    MetalCell &mtc = metalGrid[calMetalIdx(layer, cy, cx)];
-
-                    // Unrolled neighbor checks
-                    if (mtc.northCell) {
-                        MetalCell *mc = mtc.northCell;
-                        SignalType mcSignal = mc->signal;
-                        int nx = mc->canvasX;
-                        int ny = mc->canvasY;
-                        if (mcSignal == SignalType::EMPTY && !visited[ny][nx]) {
-                            visited[ny][nx] = true;
-                            q.emplace(nx, ny);
-                            region.emplace_back(nx, ny);
-                        } else if (mcSignal != SignalType::EMPTY && mcSignal != SignalType::OBSTACLE) {
-                            borderSignals.insert(mcSignal);
-                        }
-                    }
+    const int layerCellCount = static_cast<int>(m_metalGrid2DCount);
+    const int layerWidth = static_cast<int>(m_metalGridWidth);
+    std::vector<uint16_t> borderSignalMask;
 
-                    if (mtc.southCell) {
-                        MetalCell *mc = mtc.southCell;
-                        SignalType mcSignal = mc->signal;
-                        int nx = mc->canvasX;
-                        int ny = mc->canvasY;
-                        if (mcSignal == SignalType::EMPTY && !visited[ny][nx]) {
-                            visited[ny][nx] = true;
-                            q.emplace(nx, ny);
-                            region.emplace_back(nx, ny);
-                        } else if (mcSignal != SignalType::EMPTY && mcSignal != SignalType::OBSTACLE) {
-                            borderSignals.insert(mcSignal);
-                        }
-                    }
+    for (int layer = 0; layer < m_metalGridLayers; ++layer) {
+        const size_t layerBegin = calMetalIdx(layer, 0, 0);
 
-                    if (mtc.eastCell) {
-                        MetalCell *mc = mtc.eastCell;
-                        SignalType mcSignal = mc->signal;
-                        int nx = mc->canvasX;
-                        int ny = mc->canvasY;
-                        if (mcSignal == SignalType::EMPTY && !visited[ny][nx]) {
-                            visited[ny][nx] = true;
-                            q.emplace(nx, ny);
-                            region.emplace_back(nx, ny);
-                        } else if (mcSignal != SignalType::EMPTY && mcSignal != SignalType::OBSTACLE) {
-                            borderSignals.insert(mcSignal);
-                        }
-                    }
+        // first pass: unite empty neighbours within the layer
+        m_cellLabeller.reset(layerCellCount);
+        for (int i = 0; i < layerCellCount; ++i) {
+            const MetalCell &mc = metalGrid[layerBegin + i];
+            if (mc.signal != SignalType::EMPTY) continue;
+            if (mc.eastCell && mc.eastCell->signal == SignalType::EMPTY) m_cellLabeller.unite(i, i + 1);
+            if (mc.northCell && mc.northCell->signal == SignalType::EMPTY) m_cellLabeller.unite(i, i + layerWidth);
+        }
 
-                    if (mtc.westCell) {
-                        MetalCell *mc = mtc.westCell;
-                        SignalType mcSignal = mc->signal;
-                        int nx = mc->canvasX;
-                        int ny = mc->canvasY;
-                        if (mcSignal == SignalType::EMPTY && !visited[ny][nx]) {
-                            visited[ny][nx] = true;
-                            q.emplace(nx, ny);
-                            region.emplace_back(nx, ny);
-                        } else if (mcSignal != SignalType::EMPTY && mcSignal != SignalType::OBSTACLE) {
-                            borderSignals.insert(mcSignal);
-                        }
-                    }
-                }
+        // second pass: regions grow from the unoccupied cells
+        int regionCount = m_cellLabeller.resolve([&](int i){return metalGrid[layerBegin + i].type == CellType::EMPTY;});
+        borderSignalMask.assign(regionCount, 0);
 
-                // Only fill if not leaking and surrounded by one signal type
-                if (borderSignals.size() == 1) {
-                    SignalType fillType = *borderSignals.begin();
-                    for (const Cord &p : region) {
-                        size_t fillCellIdx = calMetalIdx(layer, p.y(), p.x());
-                        MetalCell &fillCell = metalGrid[fillCellIdx];
-                        fillCell.type = CellType::MARKED;
-                        fillCell.signal = fillType;
-                    }
-                }
+        auto markBorder = [&](int region, const MetalCell *mc){
+            if (mc == nullptr) return;
+            SignalType mcSignal = mc->signal;
+            if (mcSignal != SignalType::EMPTY && mcSignal != SignalType::OBSTACLE) {
+                borderSignalMask[region] |= static_cast<uint16_t>(1u << toIdx(mcSignal));
             }
+        };
+
+        for (int i = 0; i < layerCellCount; ++i) {
+            int region = m_cellLabeller.getLabel(i);
+            if (region == COMPONENT_LABEL_NONE) continue;
+            const MetalCell &mc = metalGrid[layerBegin + i];
+            markBorder(region, mc.northCell);
+            markBorder(region, mc.southCell);
+            markBorder(region, mc.eastCell);
+            markBorder(region, mc.westCell);
+        }
+
+        // Only fill if not leaking and surrounded by one signal type
+        for (int i = 0; i < layerCellCount; ++i) {
+            int region = m_cellLabeller.getLabel(i);
+            if (region == COMPONENT_LABEL_NONE) continue;
+            uint16_t mask = borderSignalMask[region];
+            if ((mask == 0) || ((mask & (mask - 1)) != 0)) continue;
+            MetalCell &fillCell = metalGrid[layerBegin + i];
+            fillCell.type = CellType::MARKED;
+            fillCell.signal = static_cast<SignalType>(std::countr_zero(mask));
         }
     }
 }
@@ -805,7 +787,7 @@ void DiffusionEngine::markHalfOccupiedMetalsAndPins(){
         MetalCell *vcDownURCell = vc.downURCell;
 
 
-        std::unordered_set<SignalType> allSignalTypes = {
+        EnumSet<SignalType> allSignalTypes = {
             vcSignal, 
             vcUpLLCell->signal, vcUpULCell->signal, vcUpLRCell->signal, vcUpURCell->signal,
             vcDownLLCell->signal, vcDownULCell->signal, vcDownLRCell->signal, vcDownURCell->signal
@@ -1371,6 +1353,117 @@ void DiffusionEngine::importResultsFromFile(const std::string &filePath){
     ifs.close();
 }
 
+namespace {
+    // host byte order, the cell sections follow it
+    struct DiffusionCheckpointHeader{
+        char magic[4];
+        uint32_t version;
+        uint64_t inputHash;
+        uint64_t metalCellCount;
+        uint64_t viaCellCount;
+        uint64_t metalCanvasCellCount;
+        uint64_t viaCanvasCellCount;
+    };
+}
+
+bool DiffusionEngine::exportCheckpoint(const std::string &filePath, uint64_t inputHash) const {
+    std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+    assert(ofs.is_open());
+    if(!ofs.is_open()) return false;
+
+    DiffusionCheckpointHeader header;
+    std::memcpy(header.magic, DIFFUSION_CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = DIFFUSION_CHECKPOINT_VERSION;
+    header.inputHash = inputHash;
+    header.metalCellCount = metalGrid.size();
+    header.viaCellCount = viaGrid.size();
+    header.metalCanvasCellCount = size_t(m_metalLayerCount) * m_gridHeight * m_gridWidth;
+    header.viaCanvasCellCount = size_t(m_viaLayerCount) * m_pinHeight * m_pinWidth;
+
+    std::vector<uint8_t> payload;
+    payload.reserve(2 * (header.metalCellCount + header.viaCellCount) + header.metalCanvasCellCount + header.viaCanvasCellCount);
+    for(const MetalCell &mc : metalGrid){
+        payload.push_back(static_cast<uint8_t>(mc.type));
+        payload.push_back(static_cast<uint8_t>(mc.signal));
+    }
+    for(const ViaCell &vc : viaGrid){
+        payload.push_back(static_cast<uint8_t>(vc.type));
+        payload.push_back(static_cast<uint8_t>(vc.signal));
+    }
+    for(int layer = 0; layer < m_metalLayerCount; ++layer){
+        for(const std::vector<SignalType> &row : metalLayers[layer].canvas){
+            for(SignalType st : row) payload.push_back(static_cast<uint8_t>(st));
+        }
+    }
+    for(int layer = 0; layer < m_viaLayerCount; ++layer){
+        for(const std::vector<SignalType> &row : viaLayers[layer].canvas){
+            for(SignalType st : row) payload.push_back(static_cast<uint8_t>(st));
+        }
+    }
+
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+    ofs.close();
+    return true;
+}
+
+bool DiffusionEngine::importCheckpoint(const std::string &filePath, uint64_t inputHash){
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+    if(!ifs.is_open()){
+        std::cout << "[PowerX:Checkpoint] Error: Cannot open checkpoint: " << filePath << std::endl;
+        return false;
+    }
+
+    DiffusionCheckpointHeader header;
+    if(!ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(header.magic, DIFFUSION_CHECKPOINT_MAGIC, sizeof(header.magic)) != 0){
+        std::cout << "[PowerX:Checkpoint] Error: Not a checkpoint file: " << filePath << std::endl;
+        return false;
+    }
+    if(header.version != DIFFUSION_CHECKPOINT_VERSION){
+        std::cout << "[PowerX:Checkpoint] Error: Checkpoint version " << header.version << " unsupported, expects " << DIFFUSION_CHECKPOINT_VERSION << std::endl;
+        return false;
+    }
+    if(header.inputHash != inputHash){
+        std::cout << "[PowerX:Checkpoint] Error: Checkpoint was taken with different inputs or configuration: " << filePath << std::endl;
+        return false;
+    }
+    bool sizesMatch = (header.metalCellCount == metalGrid.size()) && (header.viaCellCount == viaGrid.size()) &&
+                      (header.metalCanvasCellCount == size_t(m_metalLayerCount) * m_gridHeight * m_gridWidth) &&
+                      (header.viaCanvasCellCount == size_t(m_viaLayerCount) * m_pinHeight * m_pinWidth);
+    if(!sizesMatch){
+        std::cout << "[PowerX:Checkpoint] Error: Checkpoint dimensions differ from the case: " << filePath << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> payload(2 * (header.metalCellCount + header.viaCellCount) + header.metalCanvasCellCount + header.viaCanvasCellCount);
+    if(!ifs.read(reinterpret_cast<char *>(payload.data()), payload.size())){
+        std::cout << "[PowerX:Checkpoint] Error: Checkpoint truncated: " << filePath << std::endl;
+        return false;
+    }
+    ifs.close();
+
+    const uint8_t *cursor = payload.data();
+    for(MetalCell &mc : metalGrid){
+        mc.type = static_cast<CellType>(*cursor++);
+        mc.signal = static_cast<SignalType>(*cursor++);
+    }
+    for(ViaCell &vc : viaGrid){
+        vc.type = static_cast<CellType>(*cursor++);
+        vc.signal = static_cast<SignalType>(*cursor++);
+    }
+    for(int layer = 0; layer < m_metalLayerCount; ++layer){
+        for(std::vector<SignalType> &row : metalLayers[layer].canvas){
+            for(SignalType &st : row) st = static_cast<SignalType>(*cursor++);
+        }
+    }
+    for(int layer = 0; layer < m_viaLayerCount; ++layer){
+        for(std::vector<SignalType> &row : viaLayers[layer].canvas){
+            for(SignalType &st : row) st = static_cast<SignalType>(*cursor++);
+        }
+    }
+    return true;
+}
+
 void DiffusionEngine::runDiffusionTop(double diffusionRate){
 
     std::vector<std::string> timeSpan = {
@@ -1439,191 +1532,69 @@ void DiffusionEngine::runDiffusionTop(double diffusionRate){
 
 int DiffusionEngine::initialiseIndexing(){
 
-    cellLabelToSigType.clear();
-    sigTypeToAllCellLabels.clear();
-
-    cellLabelToSigType.push_back(SignalType::EMPTY);
-    CellLabel labelIdx = 1;
-
     size_t metalGridSize = metalGrid.size();
     size_t viaGridsize = viaGrid.size();
 
-    this->metalGridLabel = std::vector<CellLabel>(metalGridSize, CELL_LABEL_EMPTY);
-    this->viaGridLabel = std::vector<CellLabel>(viaGridsize, CELL_LABEL_EMPTY);
-    
     // a connected component with the same signal type (!emtpy) would own the same idx,
+    // first pass unites every pair of linked chambers that share a signal type
+    m_cellLabeller.reset(static_cast<int>(metalGridSize + viaGridsize));
+    for(size_t mcIdx = 0; mcIdx < metalGridSize; ++mcIdx){
+        const MetalCell &mc = this->metalGrid[mcIdx];
+        if((mc.eastCell != nullptr) && (mc.eastCell->signal == mc.signal)) m_cellLabeller.unite(mcIdx, mc.eastCellIdx);
+        if((mc.northCell != nullptr) && (mc.northCell->signal == mc.signal)) m_cellLabeller.unite(mcIdx, mc.northCellIdx);
+    }
 
-    std::vector<bool> metalVisited(metalGridSize, false);
-    std::vector<bool> viaVisited(viaGridsize, false);
-    // a pass of cellidx is sufficient to iterate all nodes
-    for(size_t cellIdx = 0; cellIdx < (metalGridSize + viaGridsize); ++cellIdx){
-        
-        bool processingMetal = (cellIdx < metalGridSize);
-
-        size_t viaIdx = cellIdx - metalGridSize;
-        
-        SignalType paintingType;
-        DiffusionChamber *dcPointer;
-        
-        
-        if(processingMetal){
-            MetalCell &mc = this->metalGrid[cellIdx];
-            if((mc.type == CellType::EMPTY) || metalVisited[cellIdx]) continue;
-            dcPointer = &mc;
-            paintingType = mc.signal;
-        }else{
-            ViaCell &vc = this->viaGrid[viaIdx];
-            if((vc.type == CellType::EMPTY) || viaVisited[viaIdx]) continue;
-            dcPointer = &vc;
-            paintingType = vc.signal;
-        }
-        
-
-        std::queue<DiffusionChamber *> q;
-        q.emplace(dcPointer);
-
-        if(processingMetal){
-            metalVisited[cellIdx] = true;
-            this->metalGridLabel[cellIdx] = labelIdx;
-        }else{
-            viaVisited[viaIdx] = true;
-            this->viaGridLabel[viaIdx] = labelIdx;
-        }
-
-
-        while(!q.empty()){
-            DiffusionChamber *dc = q.front(); q.pop();
-            assert(dc->metalViaType != DiffusionChamberType::UNKNOWN);
-            
-            if(dc->metalViaType == DiffusionChamberType::METAL){
-                MetalCell *mcPointer = static_cast<MetalCell *>(dc);
-                
-                MetalCell *mcNorthCell = mcPointer->northCell;
-                MetalCell *mcSouthCell = mcPointer->southCell;
-                MetalCell *mcEastCell = mcPointer->eastCell;
-                MetalCell *mcWestCell = mcPointer->westCell;
-
-                size_t mcNorthCellIdx = mcPointer->northCellIdx;
-                size_t mcSouthCellIdx = mcPointer->southCellIdx;
-                size_t mcEastCellIdx = mcPointer->eastCellIdx;
-                size_t mcWestCellIdx = mcPointer->westCellIdx;
-
-                ViaCell *mcUpCell = mcPointer->upCell;
-                ViaCell *mcDownCell = mcPointer->downCell;
-
-                size_t mcUpCellIdx = mcPointer->upCellIdx;
-                size_t mcDownCellIdx = mcPointer->downCellIdx;
-
-                if((mcNorthCell != nullptr) && (!metalVisited[mcNorthCellIdx]) && (mcNorthCell->signal == paintingType)){
-                    metalVisited[mcNorthCellIdx] = true;
-                    this->metalGridLabel[mcNorthCellIdx] = labelIdx;
-                    q.emplace(mcNorthCell);
-                }
+    for(size_t vcIdx = 0; vcIdx < viaGridsize; ++vcIdx){
+        const ViaCell &vc = this->viaGrid[vcIdx];
+        int vcElement = static_cast<int>(metalGridSize + vcIdx);
+        auto uniteMetal = [&](const MetalCell *mc, size_t mcIdx){
+            if((mc != nullptr) && (mc->signal == vc.signal)) m_cellLabeller.unite(vcElement, mcIdx);
+        };
 
-                if((mcSouthCell != nullptr) && (!metalVisited[mcSouthCellIdx]) && (mcSouthCell->signal == paintingType)){
-                    metalVisited[mcSouthCellIdx] = true;
-                    this->metalGridLabel[mcSouthCellIdx] = labelIdx;
-                    q.emplace(mcSouthCell);
-                }
+        uniteMetal(vc.upLLCell, vc.upLLCellIdx);
+        uniteMetal(vc.upULCell, vc.upULCellIdx);
+        uniteMetal(vc.upLRCell, vc.upLRCellIdx);
+        uniteMetal(vc.upURCell, vc.upURCellIdx);
 
-                if((mcEastCell != nullptr) && (!metalVisited[mcEastCellIdx]) && (mcEastCell->signal == paintingType)){
-                    metalVisited[mcEastCellIdx] = true;
-                    this->metalGridLabel[mcEastCellIdx] = labelIdx;
-                    q.emplace(mcEastCell);
-                }
+        uniteMetal(vc.downLLCell, vc.downLLCellIdx);
+        uniteMetal(vc.downULCell, vc.downULCellIdx);
+        uniteMetal(vc.downLRCell, vc.downLRCellIdx);
+        uniteMetal(vc.downURCell, vc.downURCellIdx);
+    }
 
-                if((mcWestCell != nullptr) && (!metalVisited[mcWestCellIdx]) && (mcWestCell->signal == paintingType)){
-                    metalVisited[mcWestCellIdx] = true;
-                    this->metalGridLabel[mcWestCellIdx] = labelIdx;
-                    q.emplace(mcWestCell);
-                }
+    // second pass: components holding a non-empty chamber are numbered in metal-then-via order, label 0 is reserved for empty
+    int componentCount = m_cellLabeller.resolve([&](int element){
+        size_t cellIdx = static_cast<size_t>(element);
+        if(cellIdx < metalGridSize) return this->metalGrid[cellIdx].type != CellType::EMPTY;
+        return this->viaGrid[cellIdx - metalGridSize].type != CellType::EMPTY;
+    });
+    assert((componentCount + 1) <= std::numeric_limits<CellLabel>::max());
 
-                if((mcUpCell != nullptr) && (!viaVisited[mcUpCellIdx]) && (mcUpCell->signal == paintingType)){
-                    viaVisited[mcUpCellIdx] = true;
-                    this->viaGridLabel[mcUpCellIdx] = labelIdx;
-                    q.emplace(mcUpCell);
-                }
+    cellLabelToSigType.assign(componentCount + 1, SignalType::EMPTY);
+    sigTypeToAllCellLabels.clear();
 
-                if((mcDownCell != nullptr) && (!viaVisited[mcDownCellIdx]) && (mcDownCell->signal == paintingType)){
-                    viaVisited[mcDownCellIdx] = true;
-                    this->viaGridLabel[mcDownCellIdx] = labelIdx;
-                    q.emplace(mcDownCell);
-                }
+    this->metalGridLabel.assign(metalGridSize, CELL_LABEL_EMPTY);
+    this->viaGridLabel.assign(viaGridsize, CELL_LABEL_EMPTY);
 
-            }else{ // DiffusionChamberType::VIA
-                ViaCell *vcPointer = static_cast<ViaCell *>(dc);
-
-                MetalCell *vcUpLLCell = vcPointer->upLLCell;
-                MetalCell *vcUpULCell = vcPointer->upULCell;
-                MetalCell *vcUpLRCell = vcPointer->upLRCell;
-                MetalCell *vcUpURCell = vcPointer->upURCell;
-
-                MetalCell *vcDownLLCell = vcPointer->downLLCell;
-                MetalCell *vcDownULCell = vcPointer->downULCell;
-                MetalCell *vcDownLRCell = vcPointer->downLRCell;
-                MetalCell *vcDownURCell = vcPointer->downURCell;
-
-                size_t vcUpLLCellIdx = vcPointer->upLLCellIdx;
-                size_t vcUpULCellIdx = vcPointer->upULCellIdx;
-                size_t vcUpLRCellIdx = vcPointer->upLRCellIdx;
-                size_t vcUpURCellIdx = vcPointer->upURCellIdx;
-
-                size_t vcDownLLCellIdx = vcPointer->downLLCellIdx;
-                size_t vcDownULCellIdx = vcPointer->downULCellIdx;
-                size_t vcDownLRCellIdx = vcPointer->downLRCellIdx;
-                size_t vcDownURCellIdx = vcPointer->downURCellIdx;
-
-                if((vcUpLLCell != nullptr) && (!metalVisited[vcUpLLCellIdx]) && (vcUpLLCell->signal == paintingType)){
-                    metalVisited[vcUpLLCellIdx] = true;
-                    this->metalGridLabel[vcUpLLCellIdx] = labelIdx;
-                    q.emplace(vcUpLLCell);
-                }
-                if((vcUpULCell != nullptr) && (!metalVisited[vcUpULCellIdx]) && (vcUpULCell->signal == paintingType)){
-                    metalVisited[vcUpULCellIdx] = true;
-                    this->metalGridLabel[vcUpULCellIdx] = labelIdx;
-                    q.emplace(vcUpULCell);
-                }
-                if((vcUpLRCell != nullptr) && (!metalVisited[vcUpLRCellIdx]) && (vcUpLRCell->signal == paintingType)){
-                    metalVisited[vcUpLRCellIdx] = true;
-                    this->metalGridLabel[vcUpLRCellIdx] = labelIdx;
-                    q.emplace(vcUpLRCell);
-                }
-                if((vcUpURCell != nullptr) && (!metalVisited[vcUpURCellIdx]) && (vcUpURCell->signal == paintingType)){
-                    metalVisited[vcUpURCellIdx] = true;
-                    this->metalGridLabel[vcUpURCellIdx] = labelIdx;
-                    q.emplace(vcUpURCell);
-                }
+    for(size_t mcIdx = 0; mcIdx < metalGridSize; ++mcIdx){
+        int component = m_cellLabeller.getLabel(static_cast<int>(mcIdx));
+        if(component == COMPONENT_LABEL_NONE) continue;
+        this->metalGridLabel[mcIdx] = static_cast<CellLabel>(component + 1);
+        cellLabelToSigType[component + 1] = this->metalGrid[mcIdx].signal;
+    }
 
-                if((vcDownLLCell != nullptr) && (!metalVisited[vcDownLLCellIdx]) && (vcDownLLCell->signal == paintingType)){
-                    metalVisited[vcDownLLCellIdx] = true;
-                    this->metalGridLabel[vcDownLLCellIdx] = labelIdx;
-                    q.emplace(vcDownLLCell);
-                }
-                if((vcDownULCell != nullptr) && (!metalVisited[vcDownULCellIdx]) && (vcDownULCell->signal == paintingType)){
-                    metalVisited[vcDownULCellIdx] = true;
-                    this->metalGridLabel[vcDownULCellIdx] = labelIdx;
-                    q.emplace(vcDownULCell);
-                }
-                if((vcDownLRCell != nullptr) && (!metalVisited[vcDownLRCellIdx]) && (vcDownLRCell->signal == paintingType)){
-                    metalVisited[vcDownLRCellIdx] = true;
-                    this->metalGridLabel[vcDownLRCellIdx] = labelIdx;
-                    q.emplace(vcDownLRCell);
-                }
-                if((vcDownURCell != nullptr) && (!metalVisited[vcDownURCellIdx]) && (vcDownURCell->signal == paintingType)){
-                    metalVisited[vcDownURCellIdx] = true;
-                    this->metalGridLabel[vcDownURCellIdx] = labelIdx;
-                    q.emplace(vcDownURCell);
-                }
-            }
-        }
-        
-        cellLabelToSigType.push_back(paintingType);
-        sigTypeToAllCellLabels[paintingType].emplace_back(labelIdx);
+    for(size_t vcIdx = 0; vcIdx < viaGridsize; ++vcIdx){
+        int component = m_cellLabeller.getLabel(static_cast<int>(metalGridSize + vcIdx));
+        if(component == COMPONENT_LABEL_NONE) continue;
+        this->viaGridLabel[vcIdx] = static_cast<CellLabel>(component + 1);
+        cellLabelToSigType[component + 1] = this->viaGrid[vcIdx].signal;
+    }
 
-        ++labelIdx;
+    for(int labelIdx = 1; labelIdx <= componentCount; ++labelIdx){
+        sigTypeToAllCellLabels[cellLabelToSigType[labelIdx]].emplace_back(static_cast<CellLabel>(labelIdx));
     }
 
-    return static_cast<int>(labelIdx);
+    return componentCount + 1;
 }
 
 void DiffusionEngine::placeDiffusionParticles(){
@@ -2117,7 +2088,7 @@ void DiffusionEngine::initialiseMCFSolver(){
 
 }
 
-void DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel){
+bool DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel, GRBEnv *sharedEnv, std::string *error){
    
     auto in2DRange = [&](int y, int x){
         return (y >= 0) && (y < m_metalGridHeight) && (x >= 0) && (x < m_metalGridWidth);
@@ -2125,11 +2096,20 @@ void DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel){
 
     try {
         /* Initialise Gubobi solver*/
-        GRBEnv GRBenv = GRBEnv(true);
-        GRBenv.set("LogFile", logFile);
-        GRBenv.set(GRB_IntParam_OutputFlag, outputLevel);
-        GRBenv.start();
-        GRBModel GRBmodel = GRBModel(GRBenv);
+        std::unique_ptr<GRBEnv> privateEnv;
+        if(sharedEnv == nullptr){
+            privateEnv = std::make_unique<GRBEnv>(true);
+            privateEnv->set("LogFile", logFile);
+            privateEnv->set(GRB_IntParam_OutputFlag, outputLevel);
+            privateEnv->start();
+        }
+        GRBModel GRBmodel = GRBModel((sharedEnv != nullptr)? *sharedEnv : *privateEnv);
+        // the model keeps its own copy of the parameters, the shared environment is left untouched
+        if(sharedEnv != nullptr){
+            GRBmodel.set(GRB_StringParam_LogFile, logFile);
+            GRBmodel.set(GRB_IntParam_OutputFlag, outputLevel);
+        }
+        ScopedTimer modelBuildTimer("MCF Model Build");
 
         /* construct the flow decision variables */
         // STEP 1. build metal layer decision variables, use the initialized markings
@@ -2520,8 +2500,12 @@ void DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel){
         }
 
 
+        modelBuildTimer.stop();
+
         // STEP 7. run the solver
+        ScopedTimer optimiseTimer("MCF Optimise");
         GRBmodel.optimize();
+        optimiseTimer.stop();
 
         if(outputLevel != 0){
 
@@ -2569,6 +2553,13 @@ void DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel){
                     break;
             }
         }
+        // an infeasible, interrupted or timed out model without an incumbent has nothing to extract
+        if(GRBmodel.get(GRB_IntAttr_SolCount) == 0){
+            std::string reason = "MCF model has no solution, Gurobi status " + std::to_string(GRBmodel.get(GRB_IntAttr_Status));
+            std::cerr << "[PowerX:DiffusionEngine] Error: " << reason << std::endl;
+            if(error != nullptr) *error = reason;
+            return false;
+        }
         /* Extract Results*/
         // write the results back:
         for(int layer = 0; layer < m_metalGridLayers; ++layer){
@@ -2639,62 +2630,150 @@ void DiffusionEngine::runMCFSolver(std::string logFile, int outputLevel){
 
     } catch (GRBException &e) {
         std::cerr << "Gurobi error: " << e.getMessage() << std::endl;
+        if(error != nullptr) *error = "Gurobi error " + std::to_string(e.getErrorCode()) + ": " + e.getMessage();
+        return false;
     }
+    return true;
 }
 
-void DiffusionEngine::findPostMCFLocalFlaws(std::vector<SignalType> &repairLocalDisconnectSignals){
-    
-    int totalIndexes = initialiseIndexing();
+int DiffusionEngine::getRoutedElement(const DiffusionChamber *dc) const {
+    assert(dc->metalViaType != DiffusionChamberType::UNKNOWN);
+    if(dc->metalViaType == DiffusionChamberType::METAL) return static_cast<int>(dc->index);
+    else return static_cast<int>(metalGrid.size() + dc->index);
+}
 
-    std::unordered_map<SignalType, std::unordered_set<CellLabel>> allLabels;
+void DiffusionEngine::buildRoutedConnectivity(){
+    size_t metalGridSize = metalGrid.size();
+    size_t viaGridSize = viaGrid.size();
 
-    for(size_t mcIdx = 0; mcIdx < metalGrid.size(); ++mcIdx){ 
-        MetalCell &mc = metalGrid[mcIdx];
-        if((mc.type != CellType::MARKED) && (mc.type != CellType::PREPLACED)) continue;
+    if(m_viaIdxOfPin.empty()){
+        m_viaIdxOfPin.assign(m_viaGridLayers * m_pinHeight * m_pinWidth, SIZE_T_INVALID);
+        for(const ViaCell &vc : viaGrid){
+            m_viaIdxOfPin[(vc.canvasLayer * m_pinHeight + vc.canvasY) * m_pinWidth + vc.canvasX] = vc.index;
+        }
+    }
 
-        SignalType mcSigType = mc.signal;
-        
-        CellLabel mcLabel = metalGridLabel[mcIdx];
-        allLabels[mcSigType].insert(mcLabel);
+    m_routedDSU.reset(static_cast<int>(metalGridSize + viaGridSize));
+    m_routedComponentCount.assign(toIdx(SignalType::UNKNOWN) + 1, 0);
+
+    // every routed chamber starts as a component of its own, each successful union removes one
+    auto uniteRouted = [&](int element, const DiffusionChamber *dc, const DiffusionChamber *neighbor, int neighborElement){
+        if((neighbor == nullptr) || !isRoutedChamber(neighbor) || (neighbor->signal != dc->signal)) return;
+        if(m_routedDSU.unite(element, neighborElement)) --m_routedComponentCount[toIdx(dc->signal)];
+    };
+
+    for(size_t mcIdx = 0; mcIdx < metalGridSize; ++mcIdx){
+        const MetalCell &mc = metalGrid[mcIdx];
+        if(!isRoutedChamber(&mc)) continue;
+        ++m_routedComponentCount[toIdx(mc.signal)];
+        uniteRouted(mcIdx, &mc, mc.eastCell, mc.eastCellIdx);
+        uniteRouted(mcIdx, &mc, mc.northCell, mc.northCellIdx);
     }
 
-    for(size_t vcIdx = 0; vcIdx < viaGrid.size(); ++ vcIdx){
-        ViaCell &vc = viaGrid[vcIdx];
-        if((vc.type != CellType::MARKED) && (vc.type != CellType::PREPLACED)) continue;
+    for(size_t vcIdx = 0; vcIdx < viaGridSize; ++vcIdx){
+        const ViaCell &vc = viaGrid[vcIdx];
+        if(!isRoutedChamber(&vc)) continue;
+        int vcElement = static_cast<int>(metalGridSize + vcIdx);
+        ++m_routedComponentCount[toIdx(vc.signal)];
+
+        uniteRouted(vcElement, &vc, vc.upLLCell, vc.upLLCellIdx);
+        uniteRouted(vcElement, &vc, vc.upULCell, vc.upULCellIdx);
+        uniteRouted(vcElement, &vc, vc.upLRCell, vc.upLRCellIdx);
+        uniteRouted(vcElement, &vc, vc.upURCell, vc.upURCellIdx);
+
+        uniteRouted(vcElement, &vc, vc.downLLCell, vc.downLLCellIdx);
+        uniteRouted(vcElement, &vc, vc.downULCell, vc.downULCellIdx);
+        uniteRouted(vcElement, &vc, vc.downLRCell, vc.downLRCellIdx);
+        uniteRouted(vcElement, &vc, vc.downURCell, vc.downURCellIdx);
+    }
 
-        SignalType vcSigType = vc.signal;
-        CellLabel vcLabel = viaGridLabel[vcIdx];
-        allLabels[vcSigType].insert(vcLabel);        
+    m_routedConnectivityValid = true;
+}
+
+void DiffusionEngine::insertRoutedChamber(DiffusionChamber *dc){
+    // an invalid structure is rebuilt from the grid on its next query
+    if(!m_routedConnectivityValid) return;
+    assert(isRoutedChamber(dc));
+
+    int element = getRoutedElement(dc);
+    ++m_routedComponentCount[toIdx(dc->signal)];
+
+    auto uniteRouted = [&](DiffusionChamber *neighbor){
+        if((neighbor == nullptr) || !isRoutedChamber(neighbor) || (neighbor->signal != dc->signal)) return;
+        if(m_routedDSU.unite(element, getRoutedElement(neighbor))) --m_routedComponentCount[toIdx(dc->signal)];
+    };
+
+    if(dc->metalViaType == DiffusionChamberType::METAL){
+        MetalCell *mc = static_cast<MetalCell *>(dc);
+        uniteRouted(mc->northCell);
+        uniteRouted(mc->southCell);
+        uniteRouted(mc->eastCell);
+        uniteRouted(mc->westCell);
+
+        // upCell/downCell only keep one of the (up to) four vias on the metal's corners
+        int x = mc->canvasX;
+        int y = mc->canvasY;
+        for(int viaLayer : {static_cast<int>(mc->canvasLayer) - 1, static_cast<int>(mc->canvasLayer)}){
+            if((viaLayer < 0) || (viaLayer >= static_cast<int>(m_viaGridLayers))) continue;
+            for(int pinY = y; pinY <= (y + 1); ++pinY){
+                for(int pinX = x; pinX <= (x + 1); ++pinX){
+                    size_t vcIdx = m_viaIdxOfPin[(viaLayer * m_pinHeight + pinY) * m_pinWidth + pinX];
+                    if(vcIdx != SIZE_T_INVALID) uniteRouted(&viaGrid[vcIdx]);
+                }
+            }
+        }
+    }else{ // DiffusionChamberType::VIA
+        ViaCell *vc = static_cast<ViaCell *>(dc);
+        uniteRouted(vc->upLLCell);
+        uniteRouted(vc->upULCell);
+        uniteRouted(vc->upLRCell);
+        uniteRouted(vc->upURCell);
+
+        uniteRouted(vc->downLLCell);
+        uniteRouted(vc->downULCell);
+        uniteRouted(vc->downLRCell);
+        uniteRouted(vc->downURCell);
     }
+}
 
-    std::unordered_map<SignalType, std::unordered_set<CellLabel>> disconnLabels(allLabels);
+void DiffusionEngine::paintRoutedChamber(DiffusionChamber *dc, SignalType st){
+    bool wasRouted = isRoutedChamber(dc);
+    SignalType prevSignal = dc->signal;
+
+    dc->type = CellType::MARKED;
+    dc->signal = st;
+
+    // a DSU cannot split, overwriting another signal's routed chamber falls back to a lazy rebuild
+    if(!wasRouted) insertRoutedChamber(dc);
+    else if(prevSignal != st) invalidateRoutedConnectivity();
+}
+
+void DiffusionEngine::findPostMCFLocalFlaws(std::vector<SignalType> &repairLocalDisconnectSignals){
     
+    if(!m_routedConnectivityValid) buildRoutedConnectivity();
+
+    // a routed component is disconnected unless it holds a c4 cluster representation
+    std::vector<int> disconnCount(m_routedComponentCount);
     for(const auto &[st, clusters] : c4.signalTypeToAllClusters){
+        std::unordered_set<int> connRoots;
         for(C4PinCluster *c4pc : clusters){
             Cord &rep = c4pc->representation;
             size_t cellIdx = calMetalIdx(m_c4ConnectedMetalLayerIdx, rep.y(), rep.x());
-            CellLabel cl = metalGridLabel[cellIdx];
+            const MetalCell &mc = metalGrid[cellIdx];
+            if(!isRoutedChamber(&mc) || (mc.signal != st)) continue;
 
-            disconnLabels[st].erase(cl);
-        }
-    }
-
-    std::unordered_map<SignalType, std::unordered_set<CellLabel>> connLabels(allLabels);
-    for(const auto&[st, _] : allLabels){
-        std::unordered_set<CellLabel> &stCL = connLabels[st];
-        for (auto it = stCL.begin(); it != stCL.end(); ) {
-            if (disconnLabels[st].count(*it)) it = connLabels[st].erase(it);
-            else ++it;
+            connRoots.insert(m_routedDSU.find(static_cast<int>(cellIdx)));
         }
+        disconnCount[toIdx(st)] -= static_cast<int>(connRoots.size());
     }
 
     repairLocalDisconnectSignals.clear();
 
-    for(const auto[st, us] : disconnLabels){
-        if(!us.empty()) repairLocalDisconnectSignals.push_back(st);
+    for(size_t sigIdx = 0; sigIdx < disconnCount.size(); ++sigIdx){
+        if(disconnCount[sigIdx] > 0) repairLocalDisconnectSignals.push_back(static_cast<SignalType>(sigIdx));
     }
-    std::sort(repairLocalDisconnectSignals.begin(), repairLocalDisconnectSignals.end(), [&](SignalType &st1, SignalType &st2){
-        return disconnLabels[st1].size() > disconnLabels[st2].size();
+    std::stable_sort(repairLocalDisconnectSignals.begin(), repairLocalDisconnectSignals.end(), [&](const SignalType &st1, const SignalType &st2){
+        return disconnCount[toIdx(st1)] > disconnCount[toIdx(st2)];
     });
 }
 
@@ -2794,6 +2873,9 @@ void DiffusionEngine::reportPostMCFLocalFlaws(){
 void DiffusionEngine::postMCFLocalRepairTop(bool verbose){
 
     if(verbose) std::cout << "Post MCF Local Repair" << std::endl;
+
+    // the routed connectivity is only trusted inside the repair loop, where every edit goes through paintRoutedChamber
+    invalidateRoutedConnectivity();
     
     std::vector<SignalType> repairLocalDisconnectSignals;
     findPostMCFLocalFlaws(repairLocalDisconnectSignals);
@@ -2818,6 +2900,8 @@ void DiffusionEngine::postMCFLocalRepairTop(bool verbose){
         findPostMCFLocalFlaws(repairLocalDisconnectSignals);
         // if(verbose) reportPostMCFLocalFlaws();
     }
+    invalidateRoutedConnectivity();
+
     if(verbose){
         std::cout << "Fixing Complete! " << std::endl;
         reportPostMCFLocalFlaws();
@@ -2828,13 +2912,16 @@ void DiffusionEngine::postMCFLocalRepairTop(bool verbose){
 
 void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
 
-    int totalIndexes = initialiseIndexing();
-    std::unordered_set<CellLabel> allLabels;
-    std::unordered_set<CellLabel> connLabels;
-    std::unordered_set<CellLabel> disconnLabels;
+    if(!m_routedConnectivityValid) buildRoutedConnectivity();
+    const size_t metalGridSize = metalGrid.size();
 
-    std::vector<CellLabel> colorToCellLabel = {CELL_LABEL_EMPTY}; // 0 is for supernode
-    std::unordered_map<CellLabel, int> CellLabelToColor;
+    // components are identified by their root in the routed connectivity instead of a global relabel
+    std::unordered_set<int> allLabels;
+    std::unordered_set<int> connLabels;
+    std::unordered_set<int> disconnLabels;
+
+    std::vector<int> colorToCellLabel = {-1}; // 0 is for supernode
+    std::unordered_map<int, int> CellLabelToColor;
 
     std::vector<bool> metalIsEmpty(metalGrid.size(), true);
     std::vector<bool> viaIsEmpty(viaGrid.size(), true);
@@ -2862,8 +2949,7 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
         }else if((mcCellType == CellType::MARKED) || (mcCellType == CellType::PREPLACED)){
             metalIsEmpty[mcIdx] = false;
             if(mc.signal == repairSt){
-                CellLabel mcLabel = metalGridLabel[mcIdx];
-                allLabels.insert(mcLabel);
+                allLabels.insert(m_routedDSU.find(static_cast<int>(mcIdx)));
             }
         }
     }
@@ -2877,8 +2963,7 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
         }else if((vcCellType == CellType::MARKED) || (vcCellType == CellType::PREPLACED)){
             viaIsEmpty[vcIdx] = false;  
             if(vc.signal == repairSt){
-                CellLabel vcLabel = viaGridLabel[vcIdx];
-                allLabels.insert(vcLabel);
+                allLabels.insert(m_routedDSU.find(static_cast<int>(metalGridSize + vcIdx)));
             }
         }
     }
@@ -2888,9 +2973,9 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
     for(C4PinCluster *c4pc : c4.signalTypeToAllClusters[repairSt]){
             Cord &rep = c4pc->representation;
             size_t cellIdx = calMetalIdx(m_c4ConnectedMetalLayerIdx, rep.y(), rep.x());
-            CellLabel cl = metalGridLabel[cellIdx];
+            if(!isRoutedChamber(&metalGrid[cellIdx])) continue;
 
-            disconnLabels.erase(cl);
+            disconnLabels.erase(m_routedDSU.find(static_cast<int>(cellIdx)));
     }
     
     if(disconnLabels.empty()) return;
@@ -2903,18 +2988,18 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
 
     int totalLabelCount = allLabels.size();
 
-    for(const CellLabel &cl : connLabels){
+    for(const int &cl : connLabels){
         CellLabelToColor[cl] = colorToCellLabel.size();
         colorToCellLabel.push_back(cl);
     }
-    for(const CellLabel &cl : disconnLabels){
+    for(const int &cl : disconnLabels){
         CellLabelToColor[cl] = colorToCellLabel.size();
         colorToCellLabel.push_back(cl);
     }
 
 
     DSU dsu(colorToCellLabel.size());
-    for(const CellLabel &cl : connLabels){
+    for(const int &cl : connLabels){
         dsu.unite(0, CellLabelToColor[cl]); // unite with super node;
     }
 
@@ -2944,8 +3029,8 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
     for(size_t i = 0; i < metalGrid.size(); ++i){
         if(!metalIsEmpty[i]){
             MetalCell &mc = metalGrid[i];
-            CellLabel mcCellLabel = metalGridLabel[i];
-            if(!allLabels.count(mcCellLabel)) continue;
+            if(!isRoutedChamber(&mc) || (mc.signal != repairSt)) continue;
+            int mcCellLabel = m_routedDSU.find(static_cast<int>(i));
             
             // check if any of it's neighbor is in the labels set
             int color = CellLabelToColor[mcCellLabel];
@@ -2963,8 +3048,8 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
     for(size_t i = 0; i < viaGrid.size(); ++i){
         if(!viaIsEmpty[i]){
             ViaCell &vc = viaGrid[i];
-            CellLabel vcCellLabel = viaGridLabel[i];
-            if(!allLabels.count(vcCellLabel)) continue;
+            if(!isRoutedChamber(&vc) || (vc.signal != repairSt)) continue;
+            int vcCellLabel = m_routedDSU.find(static_cast<int>(metalGridSize + i));
 
             // check if any of it's neighbor is in the labels set
             int color = CellLabelToColor[vcCellLabel];
@@ -2994,29 +3079,19 @@ void DiffusionEngine::postMCFLocalRepairSignal(SignalType repairSt){
     auto markBridgePath = [&](DiffusionChamber *start, int repSide, std::vector<DiffusionChamber *> &freshBridges){
         if(start == nullptr) return;
 
-        const CellLabel paintLabel = colorToCellLabel[repSide];
         DiffusionChamber *cur = start;
         while(cur != nullptr){
             size_t cellIndex = cur->index;
+            if(cur->type != CellType::EMPTY) break;
+            paintRoutedChamber(cur, repairSt);
 
             if(cur->metalViaType == DiffusionChamberType::METAL){
-                if(metalGridLabel[cellIndex] != 0) break;
-                MetalCell &mc = metalGrid[cellIndex];
-                mc.type = CellType::MARKED;
-                mc.signal = repairSt;
-
-                metalGridLabel[cellIndex] = paintLabel;
                 metalOwner[cellIndex] = repSide;
                 metalIsEmpty[cellIndex] = false;
                 freshBridges.push_back(cur);
                 cur = metalParent[cellIndex];
                 
             }else{ // DiffusionChamberType::VIA
-                if(viaGridLabel[cellIndex] != 0) break;
-                ViaCell &vc = viaGrid[cellIndex];
-                vc.type = CellType::MARKED;
-                vc.signal = repairSt;
-                viaGridLabel[cellIndex] = paintLabel;
                 viaOwner[cellIndex] = repSide;
                 viaIsEmpty[cellIndex] = false;
                 freshBridges.push_back(cur);
@@ -3341,9 +3416,7 @@ void DiffusionEngine::postMCFForceRepairSignal(SignalType repairSt){
 
             if(cur->metalViaType == DiffusionChamberType::METAL){
                 if(metalGridLabel[cellIndex] != 0) break;
-                MetalCell &mc = metalGrid[cellIndex];
-                mc.type = CellType::MARKED;
-                mc.signal = repairSt;
+                paintRoutedChamber(cur, repairSt);
 
                 metalGridLabel[cellIndex] = paintLabel;
                 metalOwner[cellIndex] = repSide;
@@ -3353,9 +3426,7 @@ void DiffusionEngine::postMCFForceRepairSignal(SignalType repairSt){
                 
             }else{ // DiffusionChamberType::VIA
                 if(viaGridLabel[cellIndex] != 0) break;
-                ViaCell &vc = viaGrid[cellIndex];
-                vc.type = CellType::MARKED;
-                vc.signal = repairSt;
+                paintRoutedChamber(cur, repairSt);
                 viaGridLabel[cellIndex] = paintLabel;
                 viaOwner[cellIndex] = repSide;
                 viaIsEmpty[cellIndex] = false;
@@ -5240,6 +5311,7 @@ void DiffusionEngine::evaluateAndFillX() {
     // --- Build ACTIVE nRed×nRed Laplacian, factor it, refresh W & pairWiseResistance; return Gact (caller destroys) ---
     auto buildGactFactorAndRefresh = [&](SignalType st) -> Mat {
         SignalTree &sigTree = this->signalTrees[st];
+        ScopedTimer assembleTimer("Assemble");
 
         // Active sizes & maps
         const PetscInt expSize = sigTree.exp_size;
@@ -5376,8 +5448,10 @@ void DiffusionEngine::evaluateAndFillX() {
         MatSetOption(Gact, MAT_SPD,       PETSC_TRUE);
         MatAssemblyBegin(Gact, MAT_FINAL_ASSEMBLY);
         MatAssemblyEnd  (Gact, MAT_FINAL_ASSEMBLY);
+        assembleTimer.stop();
 
         // KSP on ACTIVE
+        ScopedTimer factorTimer("Factor");
         if (!sigTree.ksp_n) {
             KSPCreate(PETSC_COMM_SELF, &sigTree.ksp_n);
             KSPSetType(sigTree.ksp_n, KSPPREONLY);
@@ -5392,8 +5466,10 @@ void DiffusionEngine::evaluateAndFillX() {
         }
         KSPSetOperators(sigTree.ksp_n, Gact, Gact);
         KSPSetUp(sigTree.ksp_n);
+        factorTimer.stop();
 
         // Baseline W = G^{-1} E_S (cheap; expSize+1 RHS)
+        ScopedTimer baselineTimer("Baseline Solve");
         MatDestroy(&sigTree.W);
         Mat E = nullptr, &W = sigTree.W;
         MatCreateDense(PETSC_COMM_SELF, PETSC_DECIDE, PETSC_DECIDE, nRed, expSize + 1, NULL, &E);
@@ -5450,6 +5526,7 @@ void DiffusionEngine::evaluateAndFillX() {
 
     while (!allCandidateNodes.empty()) {
         ++runIteration;
+        ScopedTimer iterationTimer("Iteration");
 
         std::vector<CandChamber> performanceVector;
         performanceVector.reserve(allCandidateNodes.size());
@@ -5460,6 +5537,7 @@ void DiffusionEngine::evaluateAndFillX() {
         std::unordered_map<SignalType, Mat> activeG;
 
         // ----------------- EVALUATION PHASE (batched) -----------------
+        ScopedTimer evaluateTimer("Evaluate");
         for (auto &[st, sigTree] : this->signalTrees) {
             if (sigTree.candidateNodes.empty()) continue;
 
@@ -5481,6 +5559,7 @@ void DiffusionEngine::evaluateAndFillX() {
             auto flush_chunk = [&](){
                 const int m = (int)chunk.size();
                 if (!m) return;
+                ScopedTimer solveTimer("Batched Solve");
 
                 // Build dense Bm (nRed × m) with 1s at neighbor rows
                 Mat Bm = nullptr, BetaM = nullptr;
@@ -5495,7 +5574,9 @@ void DiffusionEngine::evaluateAndFillX() {
                 MatCreateDense(PETSC_COMM_SELF, PETSC_DECIDE, PETSC_DECIDE, nRed, m, NULL, &BetaM);
                 { PC pc; KSPGetPC(sigTree.ksp_n, &pc); Mat F; PCFactorGetMatrix(pc, &F); MatMatSolve(F, Bm, BetaM); }
                 MatDestroy(&Bm);
+                solveTimer.stop();
 
+                ScopedTimer gainTimer("Gain");
                 const PetscScalar *BA = nullptr;
                 MatDenseGetArrayRead(BetaM, &BA);
                 auto Bcol = [&](int c, PetscInt row)->PetscScalar {
@@ -5597,8 +5678,10 @@ void DiffusionEngine::evaluateAndFillX() {
             // tail
             flush_chunk();
         } // end per-tree eval
+        evaluateTimer.stop();
 
         // ----------------- SELECT + COMMIT -----------------
+        ScopedTimer commitTimer("Commit");
 
         if(iterationCommitRate < maxCommitRate) iterationCommitRate += iterationCommitGrowth;
 
@@ -5649,8 +5732,10 @@ void DiffusionEngine::evaluateAndFillX() {
             MatDestroy(&Gact);
         }
         activeG.clear();
+        commitTimer.stop();
 
         // ----------------- UPDATE PHASE -----------------
+        ScopedTimer updateTimer("Update");
         for (auto &[st, nodes] : updatedNodes) {
             auto &sigTree = signalTrees[st];
             for (DiffusionChamber *dc : nodes) {
@@ -5701,7 +5786,10 @@ void DiffusionEngine::evaluateAndFillX() {
             }
         }
 
+        updateTimer.stop();
+
         // Recompute baselines for changed trees
+        ScopedTimer refreshTimer("Refresh");
         for (auto &[st, nodes] : updatedNodes) {
             if (!nodes.empty()) {
                 Mat Gact = buildGactFactorAndRefresh(st);
@@ -5710,6 +5798,8 @@ void DiffusionEngine::evaluateAndFillX() {
             }
         }
 
+        refreshTimer.stop();
+
         // --------- Metrics + one-line print ----------
         this->initWorseVdrop       = 0.0;
         this->initWeightedAvgVdrop = 0.0;
@@ -22,6 +22,9 @@
 // Dependencies
 // 1. C++ STL:
 #include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -43,9 +46,15 @@
 #include "candVertex.hpp"
 #include "signalTree.hpp"
 
+#include "dsu.hpp"
+#include "componentLabeller.hpp"
+
 // 4. Gurobi Library
 #include "gurobi_c++.h"
 
+constexpr char DIFFUSION_CHECKPOINT_MAGIC[4] = {'P', 'X', 'C', 'K'};
+constexpr uint32_t DIFFUSION_CHECKPOINT_VERSION = 1;
+
 class DiffusionEngine : public PowerDistributionNetwork{
 protected:
     size_t m_metalGridLayers;
@@ -58,14 +67,35 @@ protected:
 
     std::vector<size_t> m_viaGrid2DCount;
     std::vector<size_t> m_viaGrid2DAccumlateCount; // [2] = count[0] +..+count[2]
+
+    // shared by every labelling pass so repeated calls reuse its buffers, metal cells own [0, metalGrid.size()) and vias follow
+    ComponentLabeller m_cellLabeller;
+
+    // connectivity of routed (MARKED/PREPLACED) chambers kept alive through the post-MCF repair loop,
+    // insertions are united in place while any other edit invalidates it for a lazy rebuild
+    DSU m_routedDSU{0};
+    bool m_routedConnectivityValid = false;
+    std::vector<int> m_routedComponentCount; // indexed by toIdx(SignalType)
+    std::vector<size_t> m_viaIdxOfPin; // [viaLayer][pinY][pinX] -> viaGrid idx, SIZE_T_INVALID if absent
     
+    // key -> knob of every configuration, shared by the .config reader and applyConfigurations
+    std::unordered_map<std::string, double*> getConfigurationTable();
+    void finaliseConfigurations(const std::set<std::string> &seenKeys);
     void readConfigurations(const std::string &configFileName);
+    void applyConfigurations(const std::unordered_map<std::string, double> &configuration);
+
+    void initialiseGridCounts();
+    void initialiseCurrentBudget();
 
 public:
-    std::unordered_map<SignalType, double> currentBudget; // normalized to sum = 1
+    // knobs read by evaluateAndFillX only, a checkpoint taken before the filling stage does not depend on them
+    static const std::unordered_set<std::string> &getFillingOnlyConfigurations();
+    static bool isFillingOnlyConfiguration(const std::string &key);
+
+    EnumMap<SignalType, double> currentBudget; // normalized to sum = 1
 
     std::vector<SignalType> cellLabelToSigType;
-    std::unordered_map<SignalType, std::vector<CellLabel>> sigTypeToAllCellLabels;
+    EnumMap<SignalType, std::vector<CellLabel>> sigTypeToAllCellLabels;
 
     std::vector<MetalCell> metalGrid;
     std::vector<CellLabel> metalGridLabel;
@@ -101,7 +131,7 @@ public:
 
     // sorting by ascending order of current requirement
     std::vector<SignalType> flowSOIIdxToSig;
-    std::unordered_map<SignalType, int> flowSOISigToIdx;
+    EnumMap<SignalType, int> flowSOISigToIdx;
     std::vector<double> SOIBudget;
 
     std::vector<double> mustTouchTotalBudget;
@@ -116,7 +146,7 @@ public:
     
     std::vector<FlowNode> metalFlowNodeOwnership;
     std::vector<std::vector<std::vector<FlowNode *>>> metalFlowNodeArr;
-    std::unordered_map<SignalType, std::vector<FlowNode *>> superSourceConnectedNodes;
+    EnumMap<SignalType, std::vector<FlowNode *>> superSourceConnectedNodes;
     std::unordered_map<SignalType, std::vector<FlowNode *>> superSinkConnectedNodes;
 
     std::unordered_map<SignalType, std::vector<FlowNode *>> mustTouchNodes;
@@ -131,7 +161,7 @@ public:
     std::unordered_set<DiffusionChamber *> allCandidateNodes;
 
     std::unordered_map<DiffusionChamber *, std::vector<SignalType>> overlapNodes;
-    std::unordered_map<SignalType, SignalTree> signalTrees;
+    EnumMap<SignalType, SignalTree> signalTrees;
 
     size_t totalChipletCount;
     double sumCurrent;
@@ -153,6 +183,8 @@ public:
 
 
     DiffusionEngine(const std::string &fileName, const std::string &configFileName);
+    // the .pinout, ballouts, preplace files and .config taken from memory
+    explicit DiffusionEngine(const DesignSpec &spec);
 
     size_t calMetalIdx(size_t layer, size_t height, size_t width) const;
     size_t calMetalIdx(const MetalCord &cc) const;
@@ -196,6 +228,10 @@ public:
     void writeBackToPDN();
     void exportResultsToFile(const std::string &filePath);
     void importResultsFromFile(const std::string &filePath);
+    // binary state at a stage boundary: type and signal of every metal / via cell, then every metal and via canvas cell.
+    // inputHash identifies the inputs and configuration, a checkpoint with another hash is refused
+    bool exportCheckpoint(const std::string &filePath, uint64_t inputHash) const;
+    bool importCheckpoint(const std::string &filePath, uint64_t inputHash);
     
     /* These are functions for multi-source DFS (Diffusion)*/
     void runDiffusionTop(double diffusionRate);
@@ -208,10 +244,22 @@ public:
 
 
     /* These are functions for MCF (Multi-commodity Flow), outputLevel = 0(silent) 1(verbose) */
+    /* sharedEnv is a started environment owned by the caller and used by one thread at a time, nullptr starts a private one */
+    /* runMCFSolver is false when Gurobi fails or finds no solution, the canvas is then left as it was, with the reason in error */
     void initialiseMCFSolver();
-    void runMCFSolver(std::string logFile, int outputLevel);
+    bool runMCFSolver(std::string logFile, int outputLevel, GRBEnv *sharedEnv = nullptr, std::string *error = nullptr);
     
     void postMCFLocalRepairTop(bool verbose = false);
+
+    /* Incremental connectivity of routed chambers, metal cells own [0, metalGrid.size()) and vias follow */
+    inline bool isRoutedChamber(const DiffusionChamber *dc) const {return (dc->type == CellType::MARKED) || (dc->type == CellType::PREPLACED);}
+    int getRoutedElement(const DiffusionChamber *dc) const;
+    void buildRoutedConnectivity();
+    inline void invalidateRoutedConnectivity() {m_routedConnectivityValid = false;}
+    // unite a chamber that just became routed with its routed neighbours of the same signal
+    void insertRoutedChamber(DiffusionChamber *dc);
+    // mark dc as routed with st and keep the routed connectivity up to date
+    void paintRoutedChamber(DiffusionChamber *dc, SignalType st);
     
     void findPostMCFLocalFlaws(std::vector<SignalType> &repairLocalDisconnectSignals);
 
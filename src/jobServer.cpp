@@ -0,0 +1,370 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 16:05:31
+//  Module Name:        jobServer.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Unix domain socket front end of the daemon mode. Clients
+//                      on the same machine connect to the socket file (mode 0600,
+//                      no network listener) and send one request of text lines
+//                      closed by an empty line or by shutting down their write
+//                      side. Accepted jobs wait in a queue for one of the worker
+//                      threads, progress and the result are sent back on the
+//                      connection the request came in on
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <cassert>
+#include <cstring>
+#include <csignal>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <exception>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "jobServer.hpp"
+
+// 4. POSIX
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+namespace {
+    // a request is a handful of lines, anything longer is not a client of ours
+    constexpr size_t REQUEST_SIZE_LIMIT = 64 * 1024;
+    // a client that connects and says nothing is dropped after this long
+    constexpr int REQUEST_TIMEOUT_S = 5;
+    // how often the accept loop looks at the stop flags
+    constexpr int ACCEPT_POLL_MS = 250;
+
+    bool fillSocketAddress(const std::string &socketPath, sockaddr_un &address){
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if(socketPath.size() >= sizeof(address.sun_path)) return false;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        return true;
+    }
+}
+
+std::atomic<bool> JobServer::s_signalled(false);
+
+void JobServer::onSignal(int signal){
+    (void)signal;
+    s_signalled.store(true);
+}
+
+JobServer::JobServer(const std::string &socketPath, int workerCount)
+    : m_socketPath(socketPath), m_workerCount(std::max(1, workerCount)), m_listenFd(-1),
+      m_nextJobId(1), m_runningJobs(0), m_finishedJobs(0), m_stopping(false) {
+
+}
+
+JobServer::~JobServer(){
+    if(m_listenFd >= 0){
+        ::close(m_listenFd);
+        ::unlink(m_socketPath.c_str());
+    }
+}
+
+bool JobServer::open(){
+    sockaddr_un address;
+    if(!fillSocketAddress(m_socketPath, address)){
+        std::cout << "[PowerX:Daemon] Error: Socket path too long: " << m_socketPath << std::endl;
+        return false;
+    }
+
+    // a socket file nobody answers on is left over from a daemon that died
+    struct stat st;
+    if(::stat(m_socketPath.c_str(), &st) == 0){
+        if(!S_ISSOCK(st.st_mode)){
+            std::cout << "[PowerX:Daemon] Error: " << m_socketPath << " exists and is not a socket" << std::endl;
+            return false;
+        }
+        int probeFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        bool alive = (probeFd >= 0) && (::connect(probeFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+        if(probeFd >= 0) ::close(probeFd);
+        if(alive){
+            std::cout << "[PowerX:Daemon] Error: Another daemon is serving " << m_socketPath << std::endl;
+            return false;
+        }
+        ::unlink(m_socketPath.c_str());
+    }
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(m_listenFd < 0){
+        std::cout << "[PowerX:Daemon] Error: Cannot create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ::fcntl(m_listenFd, F_SETFD, FD_CLOEXEC);
+
+    // only the owner may connect, the socket is created 0600 rather than chmod-ed afterwards
+    mode_t previousMask = ::umask(0177);
+    int bound = ::bind(m_listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    ::umask(previousMask);
+    if((bound != 0) || (::listen(m_listenFd, 64) != 0)){
+        std::cout << "[PowerX:Daemon] Error: Cannot listen on " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    // a client that hangs up must not kill the daemon on the next write
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, JobServer::onSignal);
+    std::signal(SIGTERM, JobServer::onSignal);
+    return true;
+}
+
+bool JobServer::sendLine(int fd, const std::string &line){
+    std::string buffer = line + "\n";
+    size_t sent = 0;
+    while(sent < buffer.size()){
+        ssize_t n = ::send(fd, buffer.data() + sent, buffer.size() - sent, 0);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        sent += size_t(n);
+    }
+    return true;
+}
+
+bool JobServer::isRequestComplete(const std::string &text){
+    // up to the first empty line, a request other than RUN is its first line
+    if((text.find("\n\n") != std::string::npos) || (text.find("\n\r\n") != std::string::npos)) return true;
+    size_t firstEnd = text.find('\n');
+    return (firstEnd != std::string::npos) && (text.compare(0, 4, "RUN ") != 0);
+}
+
+bool JobServer::parseRequest(const std::string &text, std::string &verb, JobRequest &request, std::string &error){
+    std::istringstream lines(text);
+    std::string line;
+    while(std::getline(lines, line)){
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(line.empty()){
+            if(verb.empty()) continue;
+            break;
+        }
+
+        size_t space = line.find(' ');
+        std::string keyword = line.substr(0, space);
+        std::string argument = (space == std::string::npos)? std::string() : line.substr(space + 1);
+
+        if(verb.empty()){
+            if((keyword != "RUN") && (keyword != "PING") && (keyword != "STATUS") && (keyword != "SHUTDOWN")){
+                error = "unknown request \"" + keyword + "\", expected RUN, PING, STATUS or SHUTDOWN";
+                return false;
+            }
+            verb = keyword;
+            if(verb != "RUN") return true;
+            if(argument.empty()){
+                error = "RUN expects a case";
+                return false;
+            }
+            request.caseSpec = argument;
+        }else if(keyword == "SET"){
+            size_t equal = argument.find('=');
+            if((equal == std::string::npos) || (equal == 0)){
+                error = "SET expects <key>=<value>, got \"" + argument + "\"";
+                return false;
+            }
+            request.overrides.emplace_back(argument.substr(0, equal), argument.substr(equal + 1));
+        }else if(keyword == "OUTPUT"){
+            if(argument.empty()){
+                error = "OUTPUT expects a directory";
+                return false;
+            }
+            request.outputDir = argument;
+        }else{
+            error = "unknown RUN option \"" + keyword + "\", expected SET or OUTPUT";
+            return false;
+        }
+    }
+
+    if(verb.empty()){
+        error = "empty request";
+        return false;
+    }
+    return true;
+}
+
+// drains what the client has sent so far without blocking, true once the request is complete or cannot be
+bool JobServer::readPending(PendingClient &client){
+    char buffer[4096];
+    while(true){
+        ssize_t n = ::recv(client.fd, buffer, sizeof(buffer), 0);
+        if(n < 0 && errno == EINTR) continue;
+        if(n < 0){
+            if((errno == EAGAIN) || (errno == EWOULDBLOCK)) return isRequestComplete(client.text);
+            client.error = std::string("cannot read request: ") + std::strerror(errno);
+            return true;
+        }
+        if(n == 0) return true;
+        client.text.append(buffer, size_t(n));
+        if(client.text.size() > REQUEST_SIZE_LIMIT){
+            client.error = "request larger than " + std::to_string(REQUEST_SIZE_LIMIT) + " bytes";
+            return true;
+        }
+        if(isRequestComplete(client.text)) return true;
+    }
+}
+
+// a complete request is answered here, a job is queued and its connection handed to a worker
+void JobServer::handleClient(PendingClient &client){
+    // the replies of the job are written blocking from the worker
+    ::fcntl(client.fd, F_SETFL, ::fcntl(client.fd, F_GETFL) & ~O_NONBLOCK);
+
+    std::string verb, error = client.error;
+    JobRequest request;
+    if(!error.empty() || !parseRequest(client.text, verb, request, error)){
+        sendLine(client.fd, "ERROR " + error);
+        ::close(client.fd);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    if(verb == "PING"){
+        sendLine(client.fd, "PONG");
+    }else if(verb == "STATUS"){
+        sendLine(client.fd, "STATUS WORKERS " + std::to_string(m_workerCount) + " RUNNING " + std::to_string(m_runningJobs) +
+            " QUEUED " + std::to_string(m_queue.size()) + " FINISHED " + std::to_string(m_finishedJobs));
+    }else if(verb == "SHUTDOWN"){
+        m_stopping = true;
+        sendLine(client.fd, "BYE");
+    }else{
+        uint64_t jobId = m_nextJobId++;
+        sendLine(client.fd, "ACCEPTED " + std::to_string(jobId) + " QUEUED " + std::to_string(m_queue.size()));
+        m_queue.push_back(PendingJob{jobId, client.fd, std::move(request)});
+        lock.unlock();
+        m_queueCV.notify_one();
+        return;
+    }
+    lock.unlock();
+    ::close(client.fd);
+}
+
+void JobServer::workerLoop(int workerIdx, const JobHandler &handler){
+    while(true){
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_queueCV.wait(lock, [this]{return m_stopping || !m_queue.empty();});
+        if(m_stopping) return;
+        PendingJob job = std::move(m_queue.front());
+        m_queue.pop_front();
+        ++m_runningJobs;
+        lock.unlock();
+
+        // after the client hangs up the job keeps running, only the replies are dropped
+        bool clientGone = false;
+        JobReply reply = [&](const std::string &line){
+            if(!clientGone) clientGone = !sendLine(job.clientFd, line);
+            return !clientGone;
+        };
+
+        std::cout << "[PowerX:Daemon] Job " << job.id << " (" << job.request.caseSpec << ") started on worker " << workerIdx << std::endl;
+        reply("STARTED " + std::to_string(job.id) + " WORKER " + std::to_string(workerIdx));
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool succeeded = false;
+        try{
+            succeeded = handler(job.id, job.request, workerIdx, reply);
+        }catch(const std::exception &e){
+            reply(std::string("ERROR ") + e.what());
+        }catch(...){
+            reply("ERROR job aborted by an unknown exception");
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), " %s %.3lf", succeeded? "OK" : "FAILED", seconds);
+        reply("DONE " + std::to_string(job.id) + buffer);
+        ::close(job.clientFd);
+        std::cout << "[PowerX:Daemon] Job " << job.id << (succeeded? " finished" : " failed") << " in " << seconds << " s" << std::endl;
+
+        lock.lock();
+        --m_runningJobs;
+        ++m_finishedJobs;
+    }
+}
+
+void JobServer::serve(const JobHandler &handler){
+    assert(m_listenFd >= 0);
+
+    std::vector<std::thread> workers;
+    for(int w = 0; w < m_workerCount; ++w) workers.emplace_back(&JobServer::workerLoop, this, w, std::cref(handler));
+    std::cout << "[PowerX:Daemon] Listening on " << m_socketPath << " with " << m_workerCount << " workers" << std::endl;
+
+    // clients still sending their request, polled together with the listening socket so a slow one holds up nobody
+    std::vector<PendingClient> clients;
+    while(true){
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if(m_stopping) break;
+        }
+        if(s_signalled.load()) break;
+
+        std::vector<pollfd> pfds;
+        pfds.push_back(pollfd{m_listenFd, POLLIN, 0});
+        for(const PendingClient &client : clients) pfds.push_back(pollfd{client.fd, POLLIN, 0});
+        int ready = ::poll(pfds.data(), pfds.size(), ACCEPT_POLL_MS);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        std::vector<PendingClient> waiting;
+        for(size_t c = 0; c < clients.size(); ++c){
+            PendingClient &client = clients[c];
+            bool done = (ready > 0) && (pfds[c + 1].revents != 0) && readPending(client);
+            if(!done && (now >= client.deadline)){
+                client.error = "request not received within " + std::to_string(REQUEST_TIMEOUT_S) + " s";
+                done = true;
+            }
+            if(done) handleClient(client);
+            else waiting.push_back(std::move(client));
+        }
+        clients.swap(waiting);
+
+        if((ready > 0) && (pfds[0].revents & POLLIN)){
+            int clientFd = ::accept(m_listenFd, nullptr, nullptr);
+            if(clientFd < 0) continue;
+            ::fcntl(clientFd, F_SETFD, FD_CLOEXEC);
+            ::fcntl(clientFd, F_SETFL, ::fcntl(clientFd, F_GETFL) | O_NONBLOCK);
+            clients.push_back(PendingClient{clientFd, std::string(), std::string(), now + std::chrono::seconds(REQUEST_TIMEOUT_S)});
+        }
+    }
+    for(const PendingClient &client : clients){
+        sendLine(client.fd, "ERROR daemon shutting down");
+        ::close(client.fd);
+    }
+
+    // jobs still waiting are turned away, the running ones finish before the workers join
+    std::cout << "[PowerX:Daemon] Shutting down, waiting for running jobs" << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+        for(PendingJob &job : m_queue){
+            sendLine(job.clientFd, "ERROR daemon shutting down before job " + std::to_string(job.id) + " started");
+            ::close(job.clientFd);
+        }
+        m_queue.clear();
+    }
+    m_queueCV.notify_all();
+    for(std::thread &t : workers) t.join();
+
+    ::close(m_listenFd);
+    ::unlink(m_socketPath.c_str());
+    m_listenFd = -1;
+}
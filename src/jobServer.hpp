@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 16:05:31
+//  Module Name:        jobServer.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Unix domain socket front end of the daemon mode. Clients
+//                      on the same machine connect to the socket file (mode 0600,
+//                      no network listener) and send one request of text lines
+//                      closed by an empty line or by shutting down their write
+//                      side:
+//                          RUN <case>          case name or case directory
+//                          SET <key>=<value>   config override, repeatable
+//                          OUTPUT <dir>        output directory of the job
+//                      or a single PING, STATUS or SHUTDOWN. Accepted jobs wait
+//                      in a queue for one of the worker threads, the client
+//                      keeps its connection and reads the replies:
+//                          ACCEPTED <id> QUEUED <jobs ahead>
+//                          STARTED <id> WORKER <worker>
+//                          ... lines sent by the job handler ...
+//                          DONE <id> OK|FAILED <seconds>
+//                      and ERROR <message> for a request that cannot run. An
+//                      exception thrown by the handler fails only its job (the
+//                      parsers throw InputError for a malformed input file), but
+//                      a job that ends the process, by exit(), abort(), a failed
+//                      assert or a crash, takes the daemon and every running and
+//                      queued job down with it
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JOB_SERVER_H__
+#define __JOB_SERVER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+struct JobRequest{
+    std::string caseSpec;
+    // config overrides as given, later ones win
+    std::vector<std::pair<std::string, std::string>> overrides;
+    // empty picks the daemon default
+    std::string outputDir;
+};
+
+// one line to the client of the job, false once the client has gone (the job still runs to the end)
+typedef std::function<bool(const std::string &line)> JobReply;
+// runs one job on worker workerIdx, may throw, true when the job succeeded
+typedef std::function<bool(uint64_t jobId, const JobRequest &request, int workerIdx, const JobReply &reply)> JobHandler;
+
+class JobServer{
+private:
+    struct PendingJob{
+        uint64_t id;
+        int clientFd;
+        JobRequest request;
+    };
+
+    std::string m_socketPath;
+    int m_workerCount;
+    int m_listenFd;
+
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCV;
+    std::deque<PendingJob> m_queue;
+    uint64_t m_nextJobId;
+    size_t m_runningJobs;
+    size_t m_finishedJobs;
+    bool m_stopping;
+
+    static std::atomic<bool> s_signalled;
+    static void onSignal(int signal);
+
+    // a connection whose request is still arriving, error is set once it cannot be served
+    struct PendingClient{
+        int fd;
+        std::string text;
+        std::string error;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    static bool sendLine(int fd, const std::string &line);
+    static bool isRequestComplete(const std::string &text);
+    // false with the reason in error for a malformed request
+    static bool parseRequest(const std::string &text, std::string &verb, JobRequest &request, std::string &error);
+    static bool readPending(PendingClient &client);
+
+    void handleClient(PendingClient &client);
+    void workerLoop(int workerIdx, const JobHandler &handler);
+
+public:
+    JobServer(const std::string &socketPath, int workerCount);
+    ~JobServer();
+
+    // binds the socket, a stale socket file is replaced but a live daemon on the same path is not
+    bool open();
+    // accepts clients until SHUTDOWN, SIGINT or SIGTERM, then finishes the running jobs and drops the queued ones
+    void serve(const JobHandler &handler);
+};
+
+#endif // __JOB_SERVER_H__
@@ -1,18 +1,44 @@
 #include <iostream>
+#include <fstream>
 #include <string>
+#include <vector>
 #include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
 
 
 #include "colours.hpp"
 #include "timeProfiler.hpp"
+#include "perfCounters.hpp"
+#include "memoryProfiler.hpp"
 #include "visualiser.hpp"
+#include "visualisationWriter.hpp"
 
 #include "technology.hpp"
 #include "eqCktExtractor.hpp"
 #include "signalType.hpp"
+#include "inputTokenizer.hpp"
 
 #include "diffusionEngine.hpp"
 #include "circuitSolver.hpp"
+#include "pdnCircuit.hpp"
+#include "irDropAnalyser.hpp"
+#include "impedanceAnalyser.hpp"
+#include "transientSimulator.hpp"
+#include "macromodelReducer.hpp"
+#include "jobServer.hpp"
+#include "caseResolver.hpp"
 
 #include "gurobi_c++.h"
 
@@ -21,51 +47,349 @@ std::string FILEPATH_TCH;
 std::string FILEPATH_BUMPS;
 std::string FILEPATH_CONFIG;
 
+// parsed technology and the extractor built on it, only read by the pipeline so that daemon jobs can share one
+struct TechnologySetup{
+    Technology technology;
+    EqCktExtractor extractor;
+
+    explicit TechnologySetup(const std::string &tchPath): technology(tchPath), extractor(technology) {}
+};
+
+// one case of the run, --batch runs several of them concurrently each with its own DiffusionEngine
+struct CaseJob{
+    std::string name;
+    std::string tchPath;
+    std::string pinoutPath;
+    std::string configPath;
+    // prefix of every dump and export of the case, "outputs/" for a single case and "outputs/<case>/" in a batch
+    std::string outputPrefix;
+    // kept warm by the daemon, a job without one parses tchPath itself
+    std::shared_ptr<const TechnologySetup> technologySetup;
+    // daemon jobs stream stage progress and QoR lines to their client through it
+    std::function<void(const std::string &line)> report;
+};
+std::vector<CaseJob> CASE_JOBS;
+bool BATCH_MODE = false;
+// cases run at the same time, needs a PETSc configured --with-threadsafety above 1
+int BATCH_JOBS = 1;
+// serve jobs from local clients on a Unix domain socket instead of running the cases of the command line
+bool DAEMON_MODE = false;
+std::string DAEMON_SOCKET;
+// a job without OUTPUT writes to <root><job id>_<case>/
+std::string DAEMON_OUTPUT_ROOT;
+
+// stage boundaries of runMyAlgorithm that can be checkpointed and resumed from, in pipeline order
+const std::vector<std::string> CHECKPOINT_STAGES = {"filling", "postprocess", "physical"};
+std::string CHECKPOINT_DIR = "checkpoints/";
+std::string RESUME_STAGE;
+bool WRITE_CHECKPOINTS = false;
+// also rasterise every visualisation dump to .png next to the .txt
+bool RASTERISE_DUMPS = false;
+// record nested timers, written to <TRACE_PREFIX>_trace.json (Chrome trace) and <TRACE_PREFIX>_profile.csv
+bool WRITE_TRACE = false;
+// the trace covers the whole run: <output dir><case> for a single case, <output dir>batch for a batch and
+// <daemon output root>daemon_<pid> for a daemon, so that two daemons on the same root keep their own
+std::string TRACE_PREFIX;
+// hardware counters per TimeProfiler span, needs perf_event_open (Linux, perf_event_paranoid <= 2)
+bool READ_PERF_COUNTERS = false;
+// stage runtimes / memory and the QoR figures, written to <output prefix><case>_stages.csv and <output prefix><case>_qor.csv for utils/regressionHarness.py
+bool WRITE_QOR = false;
+// no visualisation dumps or circuit exports, for sweep trials that only need the QoR
+bool SKIP_DUMPS = false;
+// 1 kHz ~ 10 GHz impedance sweep per signal after the IR-drop analysis, off unless asked for
+bool RUN_IMPEDANCE = false;
+// 20 ns trapezoidal load-step transient per signal, off unless asked for
+bool RUN_TRANSIENT = false;
+// reduced-order macromodel per signal, its subcircuit and Touchstone exports follow the dumps, off unless asked for
+bool RUN_REDUCTION = false;
+
 void setCaseFromArgs(int argc, char **argv);
+bool resolveCase(const std::string &caseSpec, CaseJob &job);
+uint64_t hashInputFiles(const CaseJob &job, const std::string &stage);
 void printWelcomeBanner();
 void printExitBanner();
 void checkSetUp();
+bool writeQoRReport(const std::vector<std::pair<std::string, double>> &metrics, const std::string &filePath);
 void displayGridArrayWithPin(PowerDistributionNetwork &pdn, Technology &tch, bool upDownDisplay = false, const std::string &fileNamePrefix = "outputs/m");
 void exportEquivalentCircuits(PowerDistributionNetwork &pdn, Technology &tch, EqCktExtractor &EqCktExtor, const std::string &fileNamePrefix = "outputs/");
 
 void runVoronoiDiagramBasedAlgorithm(bool useFLUTERouting = false, bool displayIntermediateResults = false, bool displayFinalResult = true,  bool exportCircuit = false);
-void runMyAlgorithm(int *, char ***, bool displayIntermediateResults = false, bool displayFinalResult = true,  bool exportCircuit = false);
+bool runMyAlgorithm(const CaseJob &job, GRBEnv *grbEnv = nullptr, bool displayIntermediateResults = false, bool displayFinalResult = true,  bool exportCircuit = false);
+bool runBatch(int jobs);
+bool runDaemon(int jobs);
+bool startGurobiEnvironments(int count, std::vector<std::unique_ptr<GRBEnv>> &grbEnvs, const std::string &module);
+bool writeConfigWithOverrides(const std::string &baseConfigPath, const std::vector<std::pair<std::string, std::string>> &overrides, const std::string &filePath, std::string &error);
 
 int main(int argc, char **argv){
     setCaseFromArgs(argc, argv);
     printWelcomeBanner();
+    if(WRITE_TRACE) TraceRecorder::enable();
+    if(READ_PERF_COUNTERS) PerfCounters::open();
     
+    // once per process, every case of a batch shares it
+    PetscInitialize(&argc, &argv, NULL, NULL);
+
     // checkSetUp();
     // runVoronoiDiagramBasedAlgorithm(false, true, true, true);
-    runMyAlgorithm(&argc, &argv, true, true, true);
+    bool success = false;
+    try{
+        if(DAEMON_MODE) success = runDaemon(BATCH_JOBS);
+        else if(BATCH_MODE) success = runBatch(BATCH_JOBS);
+        else success = runMyAlgorithm(CASE_JOBS.front(), nullptr, !SKIP_DUMPS, !SKIP_DUMPS, !SKIP_DUMPS);
+    }catch(const InputError &e){
+        // a malformed input of the single case ends the run with the exit code the parsers have always used
+        std::cout << "[PowerX:" << e.getModule() << "] Error: " << e.what() << std::endl;
+        PetscFinalize();
+        return 4;
+    }
+
+    if(WRITE_TRACE){
+        TraceRecorder::disable();
+        TraceRecorder::writeChromeTrace(TRACE_PREFIX + "_trace.json");
+        TraceRecorder::writeSummaryCSV(TRACE_PREFIX + "_profile.csv");
+    }
+    PerfCounters::close();
+    PetscFinalize();
     
+    if(!success) return EXIT_FAILURE;
     printExitBanner();
 
 }
 
 void setCaseFromArgs(int argc, char **argv) {
+    const char *usage = "Usage: ./elf <case> [options]\n"
+                        "       ./elf --batch [--jobs N] <case> <case> ... [options]\n"
+                        "       ./elf --daemon <socket> [--jobs N] [options]\n"
+                        "  <case>   case01~case06, a case under inputs/, or a case directory holding <dir name>.tch/.pinout/.config\n"
+                        "  options  [--checkpoint] [--checkpoint-dir DIR] [--resume-from filling|postprocess|physical] [--png] [--trace] [--perf] [--qor]\n"
+                        "           [--config FILE] [--output-dir DIR] [--no-dumps] [--impedance] [--transient] [--reduce]\n"
+                        "       ./elf --list-filling-only-keys\n"
+                        "       ./elf --write-config <base config> <output config> [key=value ...]\n";
     if (argc < 2) {
-        std::cerr << "[Error] Missing case argument. Usage: ./elf case01~case06\n";
+        std::cerr << "[Error] Missing case argument. " << usage;
         std::exit(EXIT_FAILURE);
     }
 
-    std::string inputCase = argv[1];
-    std::unordered_set<std::string> validCases = {"case01", "case02", "case03", "case04", "case05", "case06"};
+    // queries of utils/hyperSweep.py, answered without running a case so the driver never keeps its own copy
+    if (std::string(argv[1]) == "--list-filling-only-keys") {
+        const std::unordered_set<std::string> &fillingOnlyKeys = DiffusionEngine::getFillingOnlyConfigurations();
+        std::vector<std::string> keys(fillingOnlyKeys.begin(), fillingOnlyKeys.end());
+        std::sort(keys.begin(), keys.end());
+        for (const std::string &key : keys) std::cout << key << "\n";
+        std::exit(EXIT_SUCCESS);
+    }
+    if (std::string(argv[1]) == "--write-config") {
+        if (argc < 4) {
+            std::cerr << "[Error] --write-config expects a base config and an output config. " << usage;
+            std::exit(EXIT_FAILURE);
+        }
+        std::vector<std::pair<std::string, std::string>> overrides;
+        for (int i = 4; i < argc; ++i) {
+            std::string override = argv[i];
+            size_t equal = override.find('=');
+            if ((equal == std::string::npos) || (equal == 0)) {
+                std::cerr << "[Error] --write-config expects key=value overrides, got \"" << override << "\".\n";
+                std::exit(EXIT_FAILURE);
+            }
+            overrides.emplace_back(override.substr(0, equal), override.substr(equal + 1));
+        }
+        std::string error;
+        if (!writeConfigWithOverrides(argv[2], overrides, argv[3], error)) {
+            std::cerr << "[Error] " << error << ".\n";
+            std::exit(EXIT_FAILURE);
+        }
+        std::exit(EXIT_SUCCESS);
+    }
 
-    bool valid = validCases.count(inputCase);
+    BATCH_MODE = (std::string(argv[1]) == "--batch");
+    DAEMON_MODE = (std::string(argv[1]) == "--daemon");
+    std::vector<std::string> caseSpecs;
+    int firstOption = 2;
+    if (DAEMON_MODE) {
+        if ((argc < 3) || (argv[2][0] == '-')) {
+            std::cerr << "[Error] --daemon expects a socket path. " << usage;
+            std::exit(EXIT_FAILURE);
+        }
+        DAEMON_SOCKET = argv[2];
+        firstOption = 3;
+    } else if (!BATCH_MODE) {
+        caseSpecs.push_back(argv[1]);
+    }
 
-    if (!valid) {
-        std::cerr << "[Error] Invalid case \"" << inputCase << "\". Allowed: case01 ~ case06.\n";
+    // checkpoint and dump options, anything else is left for PETSc. In a batch a plain word is a case unless it is the value of a PETSc option
+    bool afterPetscOption = false;
+    std::string configOverride, outputDir, checkpointDir;
+    for (int i = firstOption; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool petscOption = false;
+        if (arg == "--checkpoint") {
+            WRITE_CHECKPOINTS = true;
+        } else if (arg == "--resume-from") {
+            if ((i + 1 >= argc) || (std::find(CHECKPOINT_STAGES.begin(), CHECKPOINT_STAGES.end(), argv[i + 1]) == CHECKPOINT_STAGES.end())) {
+                std::cerr << "[Error] --resume-from expects one of: filling, postprocess, physical.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            RESUME_STAGE = argv[++i];
+        } else if (arg == "--png") {
+            RASTERISE_DUMPS = true;
+        } else if (arg == "--trace") {
+            WRITE_TRACE = true;
+        } else if (arg == "--perf") {
+            READ_PERF_COUNTERS = true;
+        } else if (arg == "--qor") {
+            WRITE_QOR = true;
+        } else if (arg == "--no-dumps") {
+            SKIP_DUMPS = true;
+        } else if (arg == "--impedance") {
+            RUN_IMPEDANCE = true;
+        } else if (arg == "--transient") {
+            RUN_TRANSIENT = true;
+        } else if (arg == "--reduce") {
+            RUN_REDUCTION = true;
+        } else if ((arg == "--config") || (arg == "--output-dir") || (arg == "--checkpoint-dir")) {
+            if ((i + 1 >= argc) || (argv[i + 1][0] == '-')) {
+                std::cerr << "[Error] " << arg << " expects a path.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            if (arg == "--config") configOverride = argv[++i];
+            else if (arg == "--output-dir") outputDir = argv[++i];
+            else checkpointDir = argv[++i];
+        } else if ((BATCH_MODE || DAEMON_MODE) && (arg == "--jobs")) {
+            if ((i + 1 >= argc) || (std::atoi(argv[i + 1]) < 1)) {
+                std::cerr << "[Error] --jobs expects a positive count.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            BATCH_JOBS = std::atoi(argv[++i]);
+        } else if (BATCH_MODE && (arg[0] != '-') && !afterPetscOption) {
+            caseSpecs.push_back(arg);
+        } else {
+            petscOption = (arg[0] == '-');
+        }
+        afterPetscOption = petscOption;
+    }
+
+    if (caseSpecs.empty() && !DAEMON_MODE) {
+        std::cerr << "[Error] --batch without any case. " << usage;
+        std::exit(EXIT_FAILURE);
+    }
+    // daemon jobs bring their config overrides with the request, and two jobs of one case would write or restore the same checkpoint
+    if (DAEMON_MODE && (!configOverride.empty() || WRITE_CHECKPOINTS || !RESUME_STAGE.empty())) {
+        std::cerr << "[Error] --config, --checkpoint and --resume-from do not apply to --daemon, send SET lines with the job instead.\n";
+        std::exit(EXIT_FAILURE);
+    }
+    if (!configOverride.empty() && !std::filesystem::exists(configOverride)) {
+        std::cerr << "[Error] Config file \"" << configOverride << "\" does not exist.\n";
         std::exit(EXIT_FAILURE);
     }
+    // the same path with or without a trailing "/"
+    auto asDirectory = [](std::string dir){
+        if (dir.back() != '/') dir.push_back('/');
+        return dir;
+    };
+    if (!checkpointDir.empty()) CHECKPOINT_DIR = asDirectory(checkpointDir);
+
+    const std::string outputRoot = outputDir.empty()? std::string("outputs/") : asDirectory(outputDir);
+    for (const std::string &caseSpec : caseSpecs) {
+        CaseJob job;
+        if (!resolveCase(caseSpec, job)) {
+            std::cerr << "[Error] Invalid case \"" << caseSpec << "\". Allowed: case01 ~ case06, a case under inputs/, or a case directory.\n";
+            std::exit(EXIT_FAILURE);
+        }
+        for (const CaseJob &other : CASE_JOBS) {
+            if (other.name == job.name) {
+                std::cerr << "[Error] Case \"" << job.name << "\" given twice, outputs and checkpoints are keyed by the case name.\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        if (!configOverride.empty()) job.configPath = configOverride;
+        // a batch keeps every case in its own sub-directory
+        job.outputPrefix = BATCH_MODE? (outputRoot + job.name + "/") : outputRoot;
+        std::filesystem::create_directories(job.outputPrefix);
+        CASE_JOBS.push_back(job);
+    }
+
+    if (DAEMON_MODE) {
+        CASE_NAME = "daemon";
+        DAEMON_OUTPUT_ROOT = outputDir.empty()? std::string("outputs/daemon/") : asDirectory(outputDir);
+        TRACE_PREFIX = DAEMON_OUTPUT_ROOT + "daemon_" + std::to_string(getpid());
+        if (WRITE_TRACE) std::filesystem::create_directories(DAEMON_OUTPUT_ROOT);
+        return;
+    }
 
-    // Assign the case
-    CASE_NAME = inputCase;
+    // Assign the case, a batch names its trace after the batch
+    CASE_NAME = BATCH_MODE? std::string("batch") : CASE_JOBS.front().name;
+    TRACE_PREFIX = outputRoot + CASE_NAME;
+    FILEPATH_TCH    = CASE_JOBS.front().tchPath;
+    FILEPATH_BUMPS  = CASE_JOBS.front().pinoutPath;
+    FILEPATH_CONFIG = CASE_JOBS.front().configPath;
+}
+
+// the files of caseSpec as resolveCaseFiles finds them, with the single case output prefix
+bool resolveCase(const std::string &caseSpec, CaseJob &job){
+    CaseFiles files;
+    if (!resolveCaseFiles(caseSpec, files)) return false;
+
+    job.name = files.name;
+    job.tchPath    = files.tchPath;
+    job.pinoutPath = files.pinoutPath;
+    job.configPath = files.configPath;
+    job.outputPrefix = "outputs/";
+    return true;
+}
+
+// metric,value with full precision, read back by utils/regressionHarness.py
+bool writeQoRReport(const std::vector<std::pair<std::string, double>> &metrics, const std::string &filePath){
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        std::cout << "[PowerX] Error: Cannot open QoR file " << filePath << std::endl;
+        return false;
+    }
 
-    // Update file paths
-    FILEPATH_TCH    = "inputs/" + CASE_NAME + "/" + CASE_NAME + ".tch";
-    FILEPATH_BUMPS  = "inputs/" + CASE_NAME + "/" + CASE_NAME + ".pinout";
-    FILEPATH_CONFIG = "inputs/" + CASE_NAME + "/" + CASE_NAME + ".config";
+    ofs << "metric,value\n";
+    char buffer[64];
+    for(const std::pair<std::string, double> &metric : metrics){
+        std::snprintf(buffer, sizeof(buffer), ",%.17g\n", metric.second);
+        ofs << metric.first << buffer;
+    }
+    ofs.close();
+    return true;
+}
+
+// FNV-1a over the case name and the technology, pinout and config files, keys the stage checkpoints.
+// The filling checkpoint is taken before any filling-only knob is read, so those config lines are left out
+// of its key and trials that differ only in filling knobs resume from one MCF result
+uint64_t hashInputFiles(const CaseJob &job, const std::string &stage){
+    constexpr uint64_t FNV_OFFSET_BASIS = 1469598103934665603ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    auto mix = [&](const std::string &bytes){
+        for(unsigned char c : bytes){
+            hash ^= c;
+            hash *= FNV_PRIME;
+        }
+        // separator so that moving bytes between files changes the hash
+        hash ^= 0xFF;
+        hash *= FNV_PRIME;
+    };
+
+    mix(job.name);
+    for(const std::string &filePath : {job.tchPath, job.pinoutPath}){
+        std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+        mix(std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()));
+    }
+
+    std::ifstream ifs(job.configPath, std::ios::in | std::ios::binary);
+    std::string configLine;
+    while(std::getline(ifs, configLine)){
+        if(stage == "filling"){
+            size_t pos = configLine.find('=');
+            std::string key = (pos == std::string::npos)? std::string() : std::string(InputTokenizer::trim(std::string_view(configLine).substr(0, pos)));
+            if(DiffusionEngine::isFillingOnlyConfiguration(key)) continue;
+        }
+        mix(configLine);
+    }
+    return hash;
 }
 
 void printWelcomeBanner(){
@@ -263,8 +587,8 @@ void runVoronoiDiagramBasedAlgorithm(bool useFLUTERouting, bool displayIntermedi
         if(displayIntermediateResults) displayGridArrayWithPin(vpg, technology, false, "outputs/postp_gawp_m");    
     timeProfiler.pauseTimer("Post-Processing");
 
-    vpg.writeSnapShot("snap.txt");
-    // vpg.readSnapShot("snap.txt");
+    vpg.writeSnapShot("snap.pxsn");
+    // vpg.readSnapShot("snap.pxsn");
     if(displayIntermediateResults) displayGridArrayWithPin(vpg, technology, false, "outputs/postp_gawp_m");    
 
     // Start Physical Implementation
@@ -283,67 +607,95 @@ void runVoronoiDiagramBasedAlgorithm(bool useFLUTERouting, bool displayIntermedi
 
 }
 
-void runMyAlgorithm(int *argc, char ***argv, bool displayIntermediateResults, bool displayFinalResult,  bool exportCircuit){
+// grbEnv is a started Gurobi environment reused by the MCF solve, nullptr starts one per solve
+bool runMyAlgorithm(const CaseJob &job, GRBEnv *grbEnv, bool displayIntermediateResults, bool displayFinalResult,  bool exportCircuit){
     
     TimeProfiler timeProfiler;
+    if(job.report){
+        timeProfiler.setListener([&job](const timeSpanName &timeSpan, bool started, double seconds){
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.3lf ", seconds);
+            job.report(started? ("STAGE START " + timeSpan) : ("STAGE DONE " + std::string(buffer) + timeSpan));
+        });
+    }
+    // intermediate dumps are snapshotted here and written by a background thread, stage timings exclude the disk
+    VisualisationWriter visualisationWriter(VISUALISATION_QUEUE_CAPACITY, RASTERISE_DUMPS);
+    MemoryProfiler::setThreadTag(MemoryTag::PARSING);
     timeProfiler.startTimer("Preprocessing");
 
-        Technology technology(FILEPATH_TCH);
-        EqCktExtractor EqCktExtor(technology);
-        DiffusionEngine dse(FILEPATH_BUMPS, FILEPATH_CONFIG);
+        std::shared_ptr<const TechnologySetup> technologySetup = job.technologySetup? job.technologySetup : std::make_shared<const TechnologySetup>(job.tchPath);
+        const Technology &technology = technologySetup->technology;
+        const EqCktExtractor &EqCktExtor = technologySetup->extractor;
+        DiffusionEngine dse(job.pinoutPath, job.configPath);
 
 
         auto displayPhysicalImplementation = [&](std::string fileNamePrefix){
-            for(int layer = 0; layer < dse.getMetalLayerCount(); ++layer){
-                std::string displayFileName = fileNamePrefix + std::to_string(layer) + ".txt";
-                visualisePhysicalImplementation(dse, layer, displayFileName);
-            }
+            visualisationWriter.dumpPhysicalImplementation(dse, fileNamePrefix);
         };
 
-        
-        PetscInitialize(argc, argv, NULL, NULL);
-        
+
         dse.markPreplacedAndInsertPadsOnCanvas();
-        if(displayIntermediateResults) displayGridArrayWithPin(dse, technology, false, "outputs/2init_gawp_m");
+        if(displayIntermediateResults) visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2init_gawp_m");
         
         dse.markObstaclesOnCanvas();
         dse.initialiseGraphWithPreplaced();
-        if(displayIntermediateResults) displayGridArrayWithPin(dse, technology, false, "outputs/2fillobst_gawp_m");
+        if(displayIntermediateResults) visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2fillobst_gawp_m");
         
         dse.fillEnclosedRegions();
         if(displayIntermediateResults){
             dse.writeBackToPDN();
-            displayGridArrayWithPin(dse, technology, false, "outputs/2fillEnclosed_gawp_m");
+            visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2fillEnclosed_gawp_m");
         } 
 
     timeProfiler.pauseTimer("Preprocessing");
 
+    // stages before the resume point are replaced by the checkpoint written at its boundary
+    const int resumeStageIdx = RESUME_STAGE.empty()? -1 : int(std::find(CHECKPOINT_STAGES.begin(), CHECKPOINT_STAGES.end(), RESUME_STAGE) - CHECKPOINT_STAGES.begin());
+    auto saveCheckpoint = [&](const std::string &stage){
+        if(!WRITE_CHECKPOINTS) return;
+        std::filesystem::create_directories(CHECKPOINT_DIR);
+        dse.exportCheckpoint(CHECKPOINT_DIR + job.name + "_" + stage + ".pxck", hashInputFiles(job, stage));
+    };
+
+    if(resumeStageIdx >= 0){
+        timeProfiler.startTimer("Checkpoint Restore");
+            std::cout << "[PowerX] Resume " << job.name << " from " << RESUME_STAGE << std::endl;
+            bool restored = dse.importCheckpoint(CHECKPOINT_DIR + job.name + "_" + RESUME_STAGE + ".pxck", hashInputFiles(job, RESUME_STAGE));
+        timeProfiler.pauseTimer("Checkpoint Restore");
+        if(!restored) return false;
+    }
 
-    timeProfiler.startTimer("MCF Stage");
-        dse.initialiseMCFSolver();
-        dse.runMCFSolver("", 1);
-        if(displayIntermediateResults){
-            dse.writeBackToPDN();
-            displayGridArrayWithPin(dse, technology, false, "outputs/2mcfraw_gawp_m");
-        }
+    if(resumeStageIdx < 0){
+        MemoryProfiler::setThreadTag(MemoryTag::MCF);
+        timeProfiler.startTimer("MCF Stage");
+            dse.initialiseMCFSolver();
+            bool routed = dse.runMCFSolver("", 1, grbEnv);
+            if(routed && displayIntermediateResults){
+                dse.writeBackToPDN();
+                visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2mcfraw_gawp_m");
+            }
 
-    timeProfiler.pauseTimer("MCF Stage");
+        timeProfiler.pauseTimer("MCF Stage");
+        // an unrouted canvas would only carry the failure into every later stage
+        if(!routed) return false;
 
-    timeProfiler.startTimer("Post-MCF Repair & WB");
+        timeProfiler.startTimer("Post-MCF Repair & WB");
 
-        dse.postMCFLocalRepairTop(true);
+            dse.postMCFLocalRepairTop(true);
         
-        if(displayIntermediateResults){
-            dse.writeBackToPDN();
-            displayGridArrayWithPin(dse, technology, false, "outputs/2mcffix_gawp_m");
-        } 
+            if(displayIntermediateResults){
+                dse.writeBackToPDN();
+                visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2mcffix_gawp_m");
+            } 
 
-        // dse.exportResultsToFile("outputs/result.txt");
-        // dse.importResultsFromFile("outputs/result.txt");
+            // dse.exportResultsToFile("outputs/result.txt");
+            // dse.importResultsFromFile("outputs/result.txt");
 
-    timeProfiler.pauseTimer("Post-MCF Repair & WB");
+        timeProfiler.pauseTimer("Post-MCF Repair & WB");
 
-    dse.writeBackToPDN();
+        dse.writeBackToPDN();
+        saveCheckpoint("filling");
+    }
     
     size_t blankCountMetal = 0;
     size_t blankCountVia = 0;
@@ -369,59 +721,333 @@ void runMyAlgorithm(int *argc, char ***argv, bool displayIntermediateResults, bo
     std::cout << "Empty Metal/Via Count = " << colours::GREEN << blankCountMetal << "/" << blankCountVia << colours::COLORRST << std::endl;
 
 
-    timeProfiler.startTimer("R-based Filling Stage");
-        dse.initialiseFiller();
-        // dse.checkFillerInitialisation();
+    if(resumeStageIdx < 1){
+        MemoryProfiler::setThreadTag(MemoryTag::FILLER);
+        timeProfiler.startTimer("R-based Filling Stage");
+            dse.initialiseFiller();
+            // dse.checkFillerInitialisation();
     
-        dse.initialiseSignalTreesX();
-        dse.runInitialEvaluationX();
+            dse.initialiseSignalTreesX();
+            dse.runInitialEvaluationX();
 
 
-        // dse.initialiseSignalTrees();
-        // dse.runInitialEvaluation();
+            // dse.initialiseSignalTrees();
+            // dse.runInitialEvaluation();
 
 
-    timeProfiler.pauseTimer("R-based Filling Stage");
+        timeProfiler.pauseTimer("R-based Filling Stage");
 
-    // // timeProfiler.startTimer("R-based Filling Iterate");
-    // //     dse.evaluateAndFill();
-    // //     if(displayIntermediateResults){
-    // //         dse.writeBackToPDN();
-    // //         displayGridArrayWithPin(dse, technology, false, "outputs/2rfill_gawp_m");
-    // //     }
-    // // timeProfiler.pauseTimer("R-based Filling Iterate");
+        // // timeProfiler.startTimer("R-based Filling Iterate");
+        // //     dse.evaluateAndFill();
+        // //     if(displayIntermediateResults){
+        // //         dse.writeBackToPDN();
+        // //         visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2rfill_gawp_m");
+        // //     }
+        // // timeProfiler.pauseTimer("R-based Filling Iterate");
     
-    timeProfiler.startTimer("R-based Filling Iterate");
-        dse.evaluateAndFillX();
-        if(displayIntermediateResults){
-            dse.writeBackToPDN();
-            displayGridArrayWithPin(dse, technology, false, "outputs/2rfill_gawp_m");
-        }
-    timeProfiler.pauseTimer("R-based Filling Iterate");
-
-
+        timeProfiler.startTimer("R-based Filling Iterate");
+            dse.evaluateAndFillX();
+            if(displayIntermediateResults){
+                dse.writeBackToPDN();
+                visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2rfill_gawp_m");
+            }
+        timeProfiler.pauseTimer("R-based Filling Iterate");
+        saveCheckpoint("postprocess");
+    }
 
+    if(resumeStageIdx < 2){
+        timeProfiler.startTimer("Post-Processing");
+            dse.assignVias();
+            for(int i = 0; i < dse.getMetalLayerCount(); ++i){
+                dse.removeFloatingPlanes(i);
+            }
+            if(displayIntermediateResults) visualisationWriter.dumpGridArrayWithPin(dse, technology, false, job.outputPrefix + "2postp_gawp_m");    
+        timeProfiler.pauseTimer("Post-Processing");
+        saveCheckpoint("physical");
+    }
 
-    timeProfiler.startTimer("Post-Processing");
-        dse.assignVias();
+    // QoR of the filled canvas, the filler figures are only known when the filling stage ran in this process
+    std::vector<std::pair<std::string, double>> qorMetrics;
+    if(WRITE_QOR || job.report){
+        if(resumeStageIdx < 1){
+            qorMetrics.emplace_back("worst_vdrop", dse.initWorseVdrop);
+            qorMetrics.emplace_back("weighted_avg_vdrop", dse.initWeightedAvgVdrop);
+            qorMetrics.emplace_back("power_loss", dse.initTotalPowerLoss);
+        }
+        qorMetrics.emplace_back("empty_metal", double(blankCountMetal));
+        qorMetrics.emplace_back("empty_via", double(blankCountVia));
         for(int i = 0; i < dse.getMetalLayerCount(); ++i){
-            dse.removeFloatingPlanes(i);
+            qorMetrics.emplace_back("one_piece_m" + std::to_string(i), dse.checkOnePiece(i)? 1.0 : 0.0);
         }
-        if(displayIntermediateResults) displayGridArrayWithPin(dse, technology, false, "outputs/2postp_gawp_m");    
-    timeProfiler.pauseTimer("Post-Processing");
+    }
 
     // Start Physical Implementation
+    MemoryProfiler::setThreadTag(MemoryTag::PHYSICAL);
     timeProfiler.startTimer("Physcial Realisation");
         dse.buildPhysicalImplementation();
-        if(displayIntermediateResults) displayPhysicalImplementation("outputs/2phyrlz_pi_m");
+        if(displayIntermediateResults) displayPhysicalImplementation(job.outputPrefix + "2phyrlz_pi_m");
         dse.connectivityAwareAssignment();
-        if(displayIntermediateResults) displayPhysicalImplementation("outputs/2phyrlz_pi2_m");
+        if(displayIntermediateResults) displayPhysicalImplementation(job.outputPrefix + "2phyrlz_pi2_m");
     timeProfiler.pauseTimer("Physcial Realisation");
 
 
-    if(displayFinalResult) displayPhysicalImplementation("outputs/2fnl_fnl_m");
-    if(exportCircuit) dse.exportPhysicalToCircuit(technology, EqCktExtor, "outputs/");
+    if(displayFinalResult) displayPhysicalImplementation(job.outputPrefix + "2fnl_fnl_m");
+    if(exportCircuit) dse.exportPhysicalToCircuit(technology, EqCktExtor, job.outputPrefix);
+
+    MemoryProfiler::setThreadTag(MemoryTag::ANALYSIS);
+    const std::vector<double> sweepFrequencies = ImpedanceAnalyser::getLogSpacedFrequencies(1e3, 1e10, 10);
+    for(SignalType st : dse.phySOI){
+        PDNCircuit circuit;
+        circuit.build(dse, st, technology, EqCktExtor);
+
+        timeProfiler.startTimer("IR-Drop Analysis");
+            IRDropAnalyser irDropAnalyser(circuit, technology);
+            if(irDropAnalyser.solve()) irDropAnalyser.printReport();
+        timeProfiler.pauseTimer("IR-Drop Analysis");
+
+        if(RUN_IMPEDANCE){
+            timeProfiler.startTimer("Impedance Sweep");
+                ImpedanceAnalyser impedanceAnalyser(circuit);
+                if(impedanceAnalyser.sweep(sweepFrequencies)){
+                    impedanceAnalyser.printReport();
+                    if(exportCircuit) impedanceAnalyser.exportProfiles(job.outputPrefix + to_string(st) + "_zf.csv");
+                }
+            timeProfiler.pauseTimer("Impedance Sweep");
+        }
+
+        if(RUN_TRANSIENT){
+            timeProfiler.startTimer("Transient Simulation");
+                TransientSimulator transientSimulator(circuit, IntegrationMethod::TRAPEZOIDAL, 20e-12, 20e-9);
+                if(transientSimulator.run()){
+                    transientSimulator.printReport();
+                    if(exportCircuit) transientSimulator.writeWaveforms(job.outputPrefix + to_string(st) + "_tran.pxwf");
+                }
+            timeProfiler.pauseTimer("Transient Simulation");
+        }
+
+        if(RUN_REDUCTION){
+            timeProfiler.startTimer("Model-Order Reduction");
+                MacromodelReducer macromodelReducer(circuit);
+                if(macromodelReducer.reduce()){
+                    macromodelReducer.printReport();
+                    if(exportCircuit){
+                        macromodelReducer.exportSubcircuit(job.outputPrefix + to_string(st) + "_rom.inc", std::string(to_string(st)) + "_ROM");
+                        macromodelReducer.exportTouchstone(job.outputPrefix + to_string(st) + "_rom.s" + std::to_string(macromodelReducer.getPortCount()) + "p", sweepFrequencies);
+                    }
+                }
+            timeProfiler.pauseTimer("Model-Order Reduction");
+        }
+    }
+
+    MemoryProfiler::setThreadTag(MemoryTag::GENERAL);
+    timeProfiler.startTimer("Visualisation Drain");
+        visualisationWriter.drain();
+    timeProfiler.pauseTimer("Visualisation Drain");
 
     timeProfiler.printTimingReport();
+    visualisationWriter.printReport();
+
+    if(job.report){
+        char buffer[64];
+        for(const std::pair<std::string, double> &metric : qorMetrics){
+            std::snprintf(buffer, sizeof(buffer), " %.17g", metric.second);
+            job.report("QOR " + metric.first + buffer);
+        }
+    }
+
+    if(WRITE_QOR){
+        timeProfiler.writeStageCSV(job.outputPrefix + job.name + "_stages.csv");
+        writeQoRReport(qorMetrics, job.outputPrefix + job.name + "_qor.csv");
+    }
+
+    return true;
+}
+
+// cases are taken in order by BATCH_JOBS worker threads, each case gets its own DiffusionEngine and TimeProfiler
+bool runBatch(int jobs){
+#ifndef PETSC_HAVE_THREADSAFETY
+    if(jobs > 1){
+        std::cout << "[PowerX:Batch] Warning: PETSc is not configured --with-threadsafety, cases run one at a time" << std::endl;
+        jobs = 1;
+    }
+#endif
+    jobs = std::min<int>(jobs, CASE_JOBS.size());
+
+    std::vector<std::unique_ptr<GRBEnv>> grbEnvs;
+    if(!startGurobiEnvironments(jobs, grbEnvs, "Batch")) return false;
+
+    std::cout << "[PowerX:Batch] " << CASE_JOBS.size() << " cases on " << jobs << " workers" << std::endl;
+    std::atomic<size_t> nextJob(0);
+    std::vector<char> succeeded(CASE_JOBS.size(), 0);
+    std::vector<double> runtimes(CASE_JOBS.size(), 0.0);
+
+    auto worker = [&](int workerIdx){
+        for(size_t jobIdx = nextJob++; jobIdx < CASE_JOBS.size(); jobIdx = nextJob++){
+            const CaseJob &job = CASE_JOBS[jobIdx];
+            std::cout << "[PowerX:Batch] Start " << job.name << " on worker " << workerIdx << std::endl;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try{
+                succeeded[jobIdx] = runMyAlgorithm(job, grbEnvs[workerIdx].get(), false, true, true);
+            }catch(const InputError &e){
+                // only this case fails, the other workers carry on
+                std::cout << "[PowerX:" << e.getModule() << "] Error: " << job.name << ": " << e.what() << std::endl;
+            }
+            runtimes[jobIdx] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "[PowerX:Batch] " << (succeeded[jobIdx]? "Finished " : "Failed ") << job.name << " in " << runtimes[jobIdx] << " s" << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(int w = 1; w < jobs; ++w) workers.emplace_back(worker, w);
+    worker(0);
+    for(std::thread &t : workers) t.join();
+
+    bool allSucceeded = true;
+    printf("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║ Case                         │ Status   │  Runtime (s) │ Outputs%-66s║\n", "");
+    printf("╟──────────────────────────────│──────────│──────────────│──────────────────────────────────────────────────────────────────────────╢\n");
+    for(size_t i = 0; i < CASE_JOBS.size(); ++i){
+        std::string caseName = " " + CASE_JOBS[i].name;
+        printf("║%-30s│ %-8s │ %12.3lf │ %-73s║\n", caseName.c_str(), succeeded[i]? "done" : "FAILED", runtimes[i], CASE_JOBS[i].outputPrefix.c_str());
+        allSucceeded = allSucceeded && succeeded[i];
+    }
+    printf("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+    return allSucceeded;
+}
+
+// one started environment per worker, a Gurobi environment must not be used by two threads at once
+bool startGurobiEnvironments(int count, std::vector<std::unique_ptr<GRBEnv>> &grbEnvs, const std::string &module){
+    try{
+        for(int w = 0; w < count; ++w){
+            grbEnvs.push_back(std::make_unique<GRBEnv>(true));
+            grbEnvs.back()->set("LogFile", "");
+            grbEnvs.back()->set(GRB_IntParam_OutputFlag, 1);
+            grbEnvs.back()->start();
+        }
+    }catch(GRBException &e){
+        std::cout << "[PowerX:" << module << "] Error: Cannot start Gurobi environment: " << e.getMessage() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// the base config with the overridden keys rewritten in place, keys the base does not have are appended
+bool writeConfigWithOverrides(const std::string &baseConfigPath, const std::vector<std::pair<std::string, std::string>> &overrides, const std::string &filePath, std::string &error){
+    std::unordered_map<std::string, std::string> pending;
+    std::vector<std::string> appendOrder;
+    for(const std::pair<std::string, std::string> &kv : overrides){
+        std::string key(InputTokenizer::trim(kv.first));
+        std::string value(InputTokenizer::trim(kv.second));
+        char *end = nullptr;
+        std::strtod(value.c_str(), &end);
+        if(value.empty() || (*end != '\0')){
+            error = "value of " + key + " is not a number: \"" + value + "\"";
+            return false;
+        }
+        if(!pending.count(key)) appendOrder.push_back(key);
+        pending[key] = value;
+    }
+
+    std::ifstream ifs(baseConfigPath, std::ios::in);
+    if(!ifs.is_open()){
+        error = "cannot open config " + baseConfigPath;
+        return false;
+    }
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        error = "cannot write config " + filePath;
+        return false;
+    }
+
+    std::string line;
+    while(std::getline(ifs, line)){
+        size_t pos = line.find('=');
+        std::string key = (pos == std::string::npos)? std::string() : std::string(InputTokenizer::trim(std::string_view(line).substr(0, pos)));
+        std::unordered_map<std::string, std::string>::iterator it = pending.find(key);
+        if(it == pending.end()){
+            ofs << line << "\n";
+            continue;
+        }
+        ofs << key << " = " << it->second << "\n";
+        pending.erase(it);
+    }
+    for(const std::string &key : appendOrder){
+        if(pending.count(key)) ofs << key << " = " << pending[key] << "\n";
+    }
+    ofs.close();
+    return true;
+}
+
+// PETSc, one Gurobi environment per worker and every parsed technology stay alive between jobs
+bool runDaemon(int jobs){
+#ifndef PETSC_HAVE_THREADSAFETY
+    if(jobs > 1){
+        std::cout << "[PowerX:Daemon] Warning: PETSc is not configured --with-threadsafety, jobs run one at a time" << std::endl;
+        jobs = 1;
+    }
+#endif
+
+    std::vector<std::unique_ptr<GRBEnv>> grbEnvs;
+    if(!startGurobiEnvironments(jobs, grbEnvs, "Daemon")) return false;
+
+    // keyed by path, a .tch edited since it was parsed is parsed again
+    struct WarmTechnology{
+        std::filesystem::file_time_type modified;
+        std::shared_ptr<const TechnologySetup> setup;
+    };
+    std::mutex technologyMutex;
+    std::unordered_map<std::string, WarmTechnology> technologyCache;
+    auto getTechnology = [&](const std::string &tchPath){
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(tchPath);
+        std::lock_guard<std::mutex> lock(technologyMutex);
+        std::unordered_map<std::string, WarmTechnology>::iterator it = technologyCache.find(tchPath);
+        if((it != technologyCache.end()) && (it->second.modified == modified)) return it->second.setup;
+        std::shared_ptr<const TechnologySetup> setup = std::make_shared<const TechnologySetup>(tchPath);
+        technologyCache[tchPath] = WarmTechnology{modified, setup};
+        return setup;
+    };
+
+    JobHandler handler = [&](uint64_t jobId, const JobRequest &request, int workerIdx, const JobReply &reply){
+        CaseJob job;
+        if(!resolveCase(request.caseSpec, job)){
+            reply("ERROR invalid case \"" + request.caseSpec + "\"");
+            return false;
+        }
+
+        std::string outputDir = request.outputDir.empty()? (DAEMON_OUTPUT_ROOT + std::to_string(jobId) + "_" + job.name) : request.outputDir;
+        if(outputDir.back() != '/') outputDir.push_back('/');
+        std::error_code ec;
+        std::filesystem::create_directories(outputDir, ec);
+        if(ec){
+            reply("ERROR cannot create " + outputDir + ": " + ec.message());
+            return false;
+        }
+        job.outputPrefix = outputDir;
+
+        if(!request.overrides.empty()){
+            std::string error;
+            std::string configPath = outputDir + job.name + ".config";
+            if(!writeConfigWithOverrides(job.configPath, request.overrides, configPath, error)){
+                reply("ERROR " + error);
+                return false;
+            }
+            job.configPath = configPath;
+        }
+
+        job.technologySetup = getTechnology(job.tchPath);
+        job.report = reply;
+        reply("OUTPUT " + job.outputPrefix);
+        try{
+            return runMyAlgorithm(job, grbEnvs[workerIdx].get(), false, !SKIP_DUMPS, !SKIP_DUMPS);
+        }catch(const InputError &e){
+            // a malformed .pinout, ballout or preplace file fails the job, the daemon and the queue stay up
+            reply("ERROR " + e.getModule() + ": " + e.what());
+            return false;
+        }
+    };
 
+    JobServer server(DAEMON_SOCKET, jobs);
+    if(!server.open()) return false;
+    server.serve(handler);
+    return true;
 }
@@ -0,0 +1,222 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 00:31:47
+//  Module Name:        memoryProfiler.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Memory figures for the TimeProfiler span borders: current
+//                      and peak resident set size from the OS, and, when built
+//                      with -DCOUNT_ALLOCATIONS, a counting global operator new
+//                      that tags every allocation with the MemoryTag of the
+//                      calling thread. Only C++ allocations are counted, PETSc
+//                      and Gurobi allocate through malloc and show up in RSS only
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <fstream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "memoryProfiler.hpp"
+
+// 4. POSIX
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+namespace {
+    thread_local MemoryTag t_threadTag = MemoryTag::GENERAL;
+
+    // zero initialised before any dynamic initialisation, so allocations of static constructors are counted too
+    std::atomic<size_t> g_allocatedBytes;
+    std::atomic<size_t> g_peakAllocatedBytes;
+    std::atomic<size_t> g_tagCurrentBytes[MEMORY_TAG_COUNT];
+    std::atomic<size_t> g_tagPeakBytes[MEMORY_TAG_COUNT];
+    std::atomic<size_t> g_tagAllocationCount[MEMORY_TAG_COUNT];
+
+    inline void raisePeak(std::atomic<size_t> &peak, size_t value){
+        size_t observed = peak.load(std::memory_order_relaxed);
+        while((value > observed) && !peak.compare_exchange_weak(observed, value, std::memory_order_relaxed));
+    }
+}
+
+#ifdef COUNT_ALLOCATIONS
+
+namespace {
+    // keeps the pointer handed out aligned for any fundamental type
+    struct alignas(alignof(std::max_align_t)) AllocationHeader{
+        size_t size;
+        MemoryTag tag;
+    };
+
+    inline void *countedAllocate(size_t size){
+        if(size == 0) size = 1;
+        void *raw = std::malloc(sizeof(AllocationHeader) + size);
+        if(raw == nullptr) return nullptr;
+
+        AllocationHeader *header = static_cast<AllocationHeader *>(raw);
+        header->size = size;
+        header->tag = t_threadTag;
+
+        int tagIdx = static_cast<int>(header->tag);
+        raisePeak(g_peakAllocatedBytes, g_allocatedBytes.fetch_add(size, std::memory_order_relaxed) + size);
+        raisePeak(g_tagPeakBytes[tagIdx], g_tagCurrentBytes[tagIdx].fetch_add(size, std::memory_order_relaxed) + size);
+        g_tagAllocationCount[tagIdx].fetch_add(1, std::memory_order_relaxed);
+        return header + 1;
+    }
+
+    inline void countedFree(void *ptr){
+        if(ptr == nullptr) return;
+        AllocationHeader *header = static_cast<AllocationHeader *>(ptr) - 1;
+        g_allocatedBytes.fetch_sub(header->size, std::memory_order_relaxed);
+        g_tagCurrentBytes[static_cast<int>(header->tag)].fetch_sub(header->size, std::memory_order_relaxed);
+        std::free(header);
+    }
+}
+
+// the array, nothrow and sized forms of the standard library forward to these
+void *operator new(size_t size){
+    void *ptr = countedAllocate(size);
+    if(ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size){
+    void *ptr = countedAllocate(size);
+    if(ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {countedFree(ptr);}
+void operator delete[](void *ptr) noexcept {countedFree(ptr);}
+void operator delete(void *ptr, size_t) noexcept {countedFree(ptr);}
+void operator delete[](void *ptr, size_t) noexcept {countedFree(ptr);}
+
+bool MemoryProfiler::isCountingAllocations(){
+    return true;
+}
+
+#else
+
+bool MemoryProfiler::isCountingAllocations(){
+    return false;
+}
+
+#endif
+
+size_t MemoryProfiler::getCurrentRSS(){
+#if defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) return 0;
+    return size_t(info.resident_size);
+#elif defined(__linux__)
+    // second field of statm is the resident page count
+    std::ifstream ifs("/proc/self/statm");
+    size_t totalPages = 0, residentPages = 0;
+    if(!(ifs >> totalPages >> residentPages)) return 0;
+    return residentPages * size_t(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+size_t MemoryProfiler::getPeakRSS(){
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    // bytes on darwin
+    return size_t(usage.ru_maxrss);
+#else
+    // kilobytes on linux
+    return size_t(usage.ru_maxrss) * 1024;
+#endif
+}
+
+size_t MemoryProfiler::getAllocatedBytes(){
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryProfiler::getPeakAllocatedBytes(){
+    return g_peakAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+MemoryTagUsage MemoryProfiler::getTagUsage(MemoryTag tag){
+    int tagIdx = static_cast<int>(tag);
+    MemoryTagUsage usage;
+    usage.currentBytes = g_tagCurrentBytes[tagIdx].load(std::memory_order_relaxed);
+    usage.peakBytes = g_tagPeakBytes[tagIdx].load(std::memory_order_relaxed);
+    usage.allocationCount = g_tagAllocationCount[tagIdx].load(std::memory_order_relaxed);
+    return usage;
+}
+
+MemoryTag MemoryProfiler::getThreadTag(){
+    return t_threadTag;
+}
+
+void MemoryProfiler::setThreadTag(MemoryTag tag){
+    t_threadTag = tag;
+}
+
+const char *MemoryProfiler::getTagName(MemoryTag tag){
+    switch(tag){
+        case MemoryTag::GENERAL:    return "General";
+        case MemoryTag::PARSING:    return "Parsing";
+        case MemoryTag::MCF:        return "MCF";
+        case MemoryTag::FILLER:     return "Filler";
+        case MemoryTag::PHYSICAL:   return "Physical";
+        case MemoryTag::ANALYSIS:   return "Analysis";
+        default:                    return "Unknown";
+    }
+}
+
+void MemoryProfiler::formatBytes(size_t bytes, char *buffer, size_t bufferSize){
+    const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double value = double(bytes);
+    int unitIdx = 0;
+    while((value >= 1024.0) && (unitIdx < 4)){
+        value /= 1024.0;
+        ++unitIdx;
+    }
+    if(unitIdx == 0) std::snprintf(buffer, bufferSize, "%zu %s", bytes, units[0]);
+    else std::snprintf(buffer, bufferSize, "%.2lf %s", value, units[unitIdx]);
+}
+
+void MemoryProfiler::printTagReport(){
+    if(!isCountingAllocations()) return;
+
+    char current[32], peak[32];
+    printf("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║ Subsystem                    │ %14s │ %14s │ %14s%51s║\n", "Live Heap", "Peak Heap", "Allocations", "");
+    printf("╟──────────────────────────────│────────────────────────────────────────────────────────────────────────────────────────────────────╢\n");
+    for(int i = 0; i < MEMORY_TAG_COUNT; ++i){
+        MemoryTagUsage usage = getTagUsage(MemoryTag(i));
+        formatBytes(usage.currentBytes, current, sizeof(current));
+        formatBytes(usage.peakBytes, peak, sizeof(peak));
+        std::string tagName = std::string(" ") + getTagName(MemoryTag(i));
+        printf("║%-30s│ %14s │ %14s │ %14zu%51s║\n", tagName.c_str(), current, peak, usage.allocationCount, "");
+    }
+    formatBytes(getAllocatedBytes(), current, sizeof(current));
+    formatBytes(getPeakAllocatedBytes(), peak, sizeof(peak));
+    printf("╟──────────────────────────────│────────────────────────────────────────────────────────────────────────────────────────────────────╢\n");
+    printf("║ Summary                      │ %14s │ %14s │ %14s%51s║\n", current, peak, "", "");
+    printf("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+}
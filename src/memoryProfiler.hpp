@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 00:31:47
+//  Module Name:        memoryProfiler.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Memory figures for the TimeProfiler span borders: current
+//                      and peak resident set size from the OS, and, when built
+//                      with -DCOUNT_ALLOCATIONS, a counting global operator new
+//                      that tags every allocation with the MemoryTag of the
+//                      calling thread. Only C++ allocations are counted, PETSc
+//                      and Gurobi allocate through malloc and show up in RSS only
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __MEMORY_PROFILER_H__
+#define __MEMORY_PROFILER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstddef>
+#include <cstdint>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+enum class MemoryTag : uint8_t{
+    GENERAL, PARSING, MCF, FILLER, PHYSICAL, ANALYSIS
+};
+constexpr int MEMORY_TAG_COUNT = 6;
+
+struct MemoryTagUsage{
+    size_t currentBytes = 0;
+    size_t peakBytes = 0;
+    size_t allocationCount = 0;
+};
+
+class MemoryProfiler{
+public:
+    // bytes, 0 when the platform gives no answer
+    static size_t getCurrentRSS();
+    static size_t getPeakRSS();
+
+    // true when the counting allocator is compiled in
+    static bool isCountingAllocations();
+    // live bytes from operator new and their high-water mark, 0 without the counting allocator
+    static size_t getAllocatedBytes();
+    static size_t getPeakAllocatedBytes();
+    static MemoryTagUsage getTagUsage(MemoryTag tag);
+
+    static MemoryTag getThreadTag();
+    static void setThreadTag(MemoryTag tag);
+    static const char *getTagName(MemoryTag tag);
+
+    // "1.23 GiB" style, buffer of at least 16 characters
+    static void formatBytes(size_t bytes, char *buffer, size_t bufferSize);
+
+    // per tag current / peak / allocations, nothing without the counting allocator
+    static void printTagReport();
+};
+
+// tags allocations of the calling thread for the enclosing block
+class MemoryScope{
+private:
+    MemoryTag m_previousTag;
+
+public:
+    explicit MemoryScope(MemoryTag tag): m_previousTag(MemoryProfiler::getThreadTag()) {MemoryProfiler::setThreadTag(tag);}
+    ~MemoryScope() {MemoryProfiler::setThreadTag(m_previousTag);}
+
+    MemoryScope(const MemoryScope &other) = delete;
+    MemoryScope &operator=(const MemoryScope &other) = delete;
+};
+
+#endif // __MEMORY_PROFILER_H__
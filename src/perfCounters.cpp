@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 23:58:12
+//  Module Name:        perfCounters.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Process-wide hardware and software event counters through
+//                      Linux perf_event_open, read at TimeProfiler span borders.
+//                      Each counter is opened on its own and inherited by threads
+//                      created later (the OpenMP pool), counters the kernel or the
+//                      container refuses are marked unavailable and the rest keep
+//                      working. On other platforms nothing opens
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "perfCounters.hpp"
+
+// 4. POSIX
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+std::array<int, PERF_EVENT_COUNT> PerfCounters::s_fds = {-1, -1, -1, -1, -1};
+bool PerfCounters::s_opened = false;
+
+const char *PerfCounters::getName(PerfEvent event){
+    switch(event){
+        case PerfEvent::CYCLES:         return "cycles";
+        case PerfEvent::INSTRUCTIONS:   return "instructions";
+        case PerfEvent::LLC_MISSES:     return "LLC misses";
+        case PerfEvent::BRANCH_MISSES:  return "branch misses";
+        case PerfEvent::PAGE_FAULTS:    return "page faults";
+        default:                        return "unknown";
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+    struct EventSpec{
+        uint32_t type;
+        uint64_t config;
+    };
+
+    // same order as PerfEvent
+    constexpr EventSpec EVENT_SPECS[PERF_EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}
+    };
+
+    struct ReadFormat{
+        uint64_t value;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+    };
+}
+
+bool PerfCounters::open(){
+    if(s_opened) return true;
+
+    int openedCount = 0;
+    for(int i = 0; i < PERF_EVENT_COUNT; ++i){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = EVENT_SPECS[i].type;
+        attr.config = EVENT_SPECS[i].config;
+        // user space only, works under the default perf_event_paranoid = 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if(fd < 0){
+            std::cout << "[PowerX:PerfCounters] Warning: " << getName(PerfEvent(i)) << " unavailable (" << std::strerror(errno) << ")" << std::endl;
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        s_fds[i] = fd;
+        ++openedCount;
+    }
+
+    s_opened = (openedCount != 0);
+    if(!s_opened) std::cout << "[PowerX:PerfCounters] Warning: No counter available, the timing report shows wall-clock only" << std::endl;
+    return s_opened;
+}
+
+void PerfCounters::close(){
+    for(int &fd : s_fds){
+        if(fd >= 0) ::close(fd);
+        fd = -1;
+    }
+    s_opened = false;
+}
+
+PerfSample PerfCounters::read(){
+    PerfSample sample;
+    if(!s_opened) return sample;
+
+    for(int i = 0; i < PERF_EVENT_COUNT; ++i){
+        if(s_fds[i] < 0) continue;
+        ReadFormat rf;
+        if(::read(s_fds[i], &rf, sizeof(rf)) != ssize_t(sizeof(rf))) continue;
+        // the counter only ran for part of the time when the PMU was multiplexed
+        if((rf.timeRunning != 0) && (rf.timeRunning < rf.timeEnabled)) rf.value = uint64_t(double(rf.value) * double(rf.timeEnabled) / double(rf.timeRunning));
+        sample.values[i] = rf.value;
+    }
+    return sample;
+}
+
+#else
+
+bool PerfCounters::open(){
+    std::cout << "[PowerX:PerfCounters] Warning: perf_event_open is Linux only, the timing report shows wall-clock only" << std::endl;
+    return false;
+}
+
+void PerfCounters::close(){
+    s_opened = false;
+}
+
+PerfSample PerfCounters::read(){
+    return PerfSample();
+}
+
+#endif
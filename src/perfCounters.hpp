@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 23:58:12
+//  Module Name:        perfCounters.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Process-wide hardware and software event counters through
+//                      Linux perf_event_open, read at TimeProfiler span borders.
+//                      Each counter is opened on its own and inherited by threads
+//                      created later (the OpenMP pool), counters the kernel or the
+//                      container refuses are marked unavailable and the rest keep
+//                      working. On other platforms nothing opens
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __PERF_COUNTERS_H__
+#define __PERF_COUNTERS_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <array>
+#include <cstdint>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+enum class PerfEvent : uint8_t{
+    CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, PAGE_FAULTS
+};
+constexpr int PERF_EVENT_COUNT = 5;
+
+// counter values at one instant, multiplexing already scaled out
+struct PerfSample{
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+};
+
+class PerfCounters{
+private:
+    static std::array<int, PERF_EVENT_COUNT> s_fds;
+    static bool s_opened;
+
+public:
+    // opens every counter it can, returns false when none is available
+    static bool open();
+    static void close();
+
+    static inline bool isOpen() {return s_opened;}
+    static inline bool isAvailable(PerfEvent event) {return s_fds[static_cast<int>(event)] >= 0;}
+    static const char *getName(PerfEvent event);
+
+    // all zero when closed, unavailable counters stay zero
+    static PerfSample read();
+};
+
+#endif // __PERF_COUNTERS_H__
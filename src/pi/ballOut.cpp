@@ -31,12 +31,20 @@
 #include <algorithm>
 #include <algorithm>
 #include <cctype>
+#include <memory>
+#include <mutex>
+#include <iostream>
+#include <string_view>
 
 // 2. Boost Library:
 
 // 3. Texo Library:
 #include "cord.hpp"
 #include "ballOut.hpp"
+#include "inputTokenizer.hpp"
+
+// 4. POSIX
+#include <sys/stat.h>
 
 std::ostream& operator<<(std::ostream& os, BallOutRotation bor) {
     return os << to_string(bor);
@@ -85,71 +93,58 @@ BallOut::BallOut(): m_name(""), m_ballOutWidth(0), m_ballOutHeight(0),m_maxCurre
 }
 
 BallOut::BallOut(const std::string &filePath): m_rotation(BallOutRotation::R0) {
-    std::unordered_map<char, int> magnitude_map = {{'f', -15}, {'p', -12}, {'n', -9}, {'u', -6}, {'m', -3}, {'c', -2}};
-    std::ifstream file(filePath);
+    MappedFile file(filePath);
     assert(file.is_open());
-    
-    std::string buffer;
-    while(std::getline(file, buffer)){
-        std::size_t start = 0;
-        while (start < buffer.size() && std::isspace(static_cast<unsigned char>(buffer[start]))) {
-            ++start;
-        }
-        // Trim trailing whitespace
-        size_t end = buffer.size();
-        while (end > start && std::isspace(static_cast<unsigned char>(buffer[end - 1]))) {
-            --end;
-        }
-        buffer = buffer.substr(start, end - start);
-
-        // Split by whitespace
-        std::istringstream iss(buffer);
-        std::vector<std::string> tokens;
-        std::string token;
-        while (iss >> token) {
-            tokens.push_back(token);
-        }
+    InputTokenizer tokenizer(file.view());
+
+    std::string_view lineBuffer;
+    std::vector<std::string_view> tokens;
+    while(tokenizer.nextLine(lineBuffer)){
+        InputTokenizer::split(lineBuffer, tokens);
+
         if(tokens[0] == "BEGIN_CHIPLET"){
-            this->m_name = tokens[1];
-            this->m_ballOutWidth = std::stoi(tokens[2]);
-            this->m_ballOutHeight = std::stoi(tokens[3]);
+            this->m_name = std::string(tokens[1]);
+            this->m_ballOutWidth = InputTokenizer::parseInt(tokens[2]);
+            this->m_ballOutHeight = InputTokenizer::parseInt(tokens[3]);
             ballOutArray.resize(this->m_ballOutHeight, std::vector<SignalType>(this->m_ballOutWidth, SignalType::EMPTY));
             break;
         }
 
-        std::unordered_map<std::string, std::string>::const_iterator cit = this->m_privateAttributeStandardUnits.find(tokens[0]);
+        std::unordered_map<std::string, std::string>::const_iterator cit = this->m_privateAttributeStandardUnits.find(std::string(tokens[0]));
         if(cit == m_privateAttributeStandardUnits.end()){
             std::cout << "[PowerX:BallOutParser] Error: Unrocognized private ballout attribute: " << tokens[0]  << std::endl;
             abort();
         }
 
-        std::string standardUnit = cit->second;
-        if(tokens[3] != standardUnit){
-            std::cout << "[PowerX:BallOutParser] Error: Private ballout attribute: " << tokens[0] << " using unit " << tokens[3] << " instead of standard unit: " << standardUnit << std::endl;
+        const std::string &standardUnit = cit->second;
+        if((tokens.size() < 4) || (tokens[3] != standardUnit)){
+            std::cout << "[PowerX:BallOutParser] Error: Private ballout attribute: " << tokens[0] << " using unit " << ((tokens.size() < 4)? std::string_view() : tokens[3]) << " instead of standard unit: " << standardUnit << std::endl;
             abort();
         }
 
         if(tokens[0] == "MAX_CURRENT"){
-            this->m_maxCurrent = std::stod(tokens[2]);
+            this->m_maxCurrent = InputTokenizer::parseDouble(tokens[2]);
         }else if(tokens[0] == "SERIES_RESISTANCE"){
-            this->m_seriesResistance = std::stod(tokens[2]);
+            this->m_seriesResistance = InputTokenizer::parseDouble(tokens[2]);
         }else if(tokens[0] == "SERIES_INDUCTANCE"){
-            this->m_seriesInductance = std::stod(tokens[2]);
+            this->m_seriesInductance = InputTokenizer::parseDouble(tokens[2]);
         }else if(tokens[0] == "SHUNT_CAPACITANCE"){
-            this->m_shuntCapacitance = std::stod(tokens[2]);
+            this->m_shuntCapacitance = InputTokenizer::parseDouble(tokens[2]);
         }
     }
-            
+
+    std::string_view buffer;
     for(int j = 0; j < this->m_ballOutHeight; ++j){
         for(int i = 0; i < this->m_ballOutWidth; ++i){
 
-            file >> buffer;
+            bool hasCell = tokenizer.nextWord(buffer);
+            assert(hasCell);
 
             // parse the string, keep only substring after ','
             size_t position = buffer.find(',');
-            assert(position != std::string::npos);
+            assert(position != std::string_view::npos);
             
-            Cord pinLocation = CSVCellToCord(buffer.substr(0, position));
+            Cord pinLocation = CSVCellToCord(std::string(buffer.substr(0, position)));
 
             if(pinLocation != Cord(i, j)){
                 std::cout << "[PowerX:BallOutParser] Error: Discontinuous CSV Cell position value: " << buffer.substr(0, position)  << std::endl;
@@ -157,7 +152,7 @@ BallOut::BallOut(const std::string &filePath): m_rotation(BallOutRotation::R0) {
 
             }
 
-            SignalType signaltp = convertToSignalType(buffer.substr(position + 1));
+            SignalType signaltp = convertToSignalType(std::string(buffer.substr(position + 1)));
 
             if((signaltp == SignalType::EMPTY) || ((signaltp == SignalType::UNKNOWN))){
                 std::cout << "[PowerX:BallOutParser] Error: Unknown Signal Type: " << buffer.substr(position + 1)  << std::endl;
@@ -178,8 +173,60 @@ BallOut::BallOut(const std::string &filePath): m_rotation(BallOutRotation::R0) {
             }
         }
     }
+}
+
+BallOut::BallOut(const std::string &name, const std::vector<std::vector<SignalType>> &array, double maxCurrent, double seriesResistance, double seriesInductance, double shuntCapacitance)
+    : m_name(name), m_ballOutHeight(static_cast<int>(array.size())), m_rotation(BallOutRotation::R0),
+    m_maxCurrent(maxCurrent), m_seriesResistance(seriesResistance), m_seriesInductance(seriesInductance), m_shuntCapacitance(shuntCapacitance), ballOutArray(array) {
+
+    assert(!array.empty());
+    this->m_ballOutWidth = static_cast<int>(array[0].size());
+
+    for(int j = 0; j < this->m_ballOutHeight; ++j){
+        assert(static_cast<int>(array[j].size()) == this->m_ballOutWidth);
+        for(int i = 0; i < this->m_ballOutWidth; ++i){
+            SignalType signaltp = array[j][i];
+            assert((signaltp != SignalType::EMPTY) && (signaltp != SignalType::UNKNOWN));
+            allSignalTypes.insert(signaltp);
+            SignalTypeToAllCords[signaltp].insert(Cord(i, j));
+        }
+    }
+}
+
+std::shared_ptr<const BallOut> BallOut::loadCached(const std::string &filePath){
+    struct CachedBallOut{
+        long long modifyTimeNs;
+        long long fileSize;
+        std::shared_ptr<const BallOut> ballOut;
+    };
+    static std::mutex cacheMutex;
+    static std::unordered_map<std::string, CachedBallOut> cache;
+
+    struct stat fileStat;
+    if(stat(filePath.c_str(), &fileStat) != 0){
+        throw InputError("BallOutParser", "Cannot open ballout file: " + filePath);
+    }
+    // nanosecond resolution, an edit within the same second and at the same size is still seen
+#ifdef __APPLE__
+    const struct timespec &modifyTime = fileStat.st_mtimespec;
+#else
+    const struct timespec &modifyTime = fileStat.st_mtim;
+#endif
+    long long modifyTimeNs = static_cast<long long>(modifyTime.tv_sec) * 1000000000LL + static_cast<long long>(modifyTime.tv_nsec);
+    long long fileSize = static_cast<long long>(fileStat.st_size);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::unordered_map<std::string, CachedBallOut>::iterator it = cache.find(filePath);
+    if((it != cache.end()) && (it->second.modifyTimeNs == modifyTimeNs) && (it->second.fileSize == fileSize)){
+        return it->second.ballOut;
+    }
 
-    file.close();
+    // an edited file is parsed again, callers still holding the stale prototype keep it alive through their shared_ptr
+    CachedBallOut &entry = cache[filePath];
+    entry.modifyTimeNs = modifyTimeNs;
+    entry.fileSize = fileSize;
+    entry.ballOut = std::make_shared<const BallOut>(filePath);
+    return entry.ballOut;
 }
 
 BallOut::BallOut(const BallOut &ref, enum BallOutRotation rotation) :m_name(ref.m_name), m_maxCurrent(ref.m_maxCurrent), m_seriesResistance(ref.m_seriesResistance), m_seriesInductance(ref.m_seriesInductance), m_shuntCapacitance(ref.m_shuntCapacitance),
@@ -24,7 +24,7 @@
 // Dependencies
 // 1. C++ STL:
 #include <string>
-
+#include <memory>
 #include <ostream>
 #include <vector>
 #include <unordered_map>
@@ -89,6 +89,11 @@ public:
     BallOut();
     explicit BallOut(const std::string &filePath);
     explicit BallOut(const BallOut &ref, enum BallOutRotation rotation);
+    // in-memory prototype, array[y][x] with row 0 at the bottom (the order of ballOutArray), EMPTY cells are not allowed
+    BallOut(const std::string &name, const std::vector<std::vector<SignalType>> &array, double maxCurrent, double seriesResistance, double seriesInductance, double shuntCapacitance);
+
+    // parses filePath once per process (again if the file changes on disk), the prototype is shared and never modified
+    static std::shared_ptr<const BallOut> loadCached(const std::string &filePath);
 
     inline std::string getName() const {return this->m_name;}
     inline int getBallOutWidth() const {return this->m_ballOutWidth;}
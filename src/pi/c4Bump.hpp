@@ -35,6 +35,8 @@
 #include "signalType.hpp"
 #include "ballOut.hpp"
 #include "objectArray.hpp"
+#include "inputTokenizer.hpp"
+#include "designSpec.hpp"
 
 struct C4PinCluster {
     Cord representation; // usually the center of the cluster
@@ -66,6 +68,9 @@ private:
     int m_upBorder;
     int m_downBorder;
 
+    // checks the attributes, rotates the ballout and lays out the clusters on the canvas
+    void buildClusters(BallOutRotation c4Rotation);
+
 public:
     std::unordered_set<SignalType> allSignalTypes;
     std::unordered_map<SignalType, std::unordered_set<Cord>> signalTypeToAllCords;
@@ -76,6 +81,9 @@ public:
     
     C4Bump();
     explicit C4Bump(const std::string &fileName);
+    // parses the C4 section of an already mapped .pinout
+    explicit C4Bump(const MappedFile &pinoutFile);
+    explicit C4Bump(const DesignSpec &spec);
     ~C4Bump();
 
     inline int getClusterPinCountWidth() const {return this->m_clusterPinCountWidth;}
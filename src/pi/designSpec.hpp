@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 19:12:44
+//  Module Name:        designSpec.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        In-memory counterpart of a .pinout, its ballout .csv
+//                      files, the PDN_PREPLACE blockage files and the .config
+//                      file. MicroBump, C4Bump, PowerDistributionNetwork and
+//                      DiffusionEngine are built from it without touching the
+//                      filesystem, see powerxLibrary.hpp for the checks done
+//                      before a DesignSpec is handed to them
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __DESIGN_SPEC_H__
+#define __DESIGN_SPEC_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "cord.hpp"
+#include "signalType.hpp"
+#include "ballOut.hpp"
+
+// the C4_* attributes of the C4 section, in pins
+struct C4Layout{
+    int clusterPinCountWidth = -1;
+    int clusterPinCountHeight = -1;
+    int clusterPitchWidth = -1;
+    int clusterPitchHeight = -1;
+    int clusterCountWidth = -1;
+    int clusterCountHeight = -1;
+    int leftBorder = -1;
+    int rightBorder = -1;
+    int upBorder = -1;
+    int downBorder = -1;
+};
+
+// one CHIPLET line of the MICROBUMP section, (x, y) is the lower left pin of the rotated ballout
+struct ChipletPlacement{
+    std::string instanceName;
+    std::string ballOutName;
+    BallOutRotation rotation = BallOutRotation::R0;
+    len_t x = 0;
+    len_t y = 0;
+};
+
+struct DesignSpec{
+    // TECHNOLOGY section, the pin array is one larger than the grid in both directions
+    int gridWidth = -1;
+    int gridHeight = -1;
+    int metalLayerCount = -1;
+
+    // MICROBUMP section, ballOuts are the prototypes the chiplets refer to by name
+    std::vector<BallOut> ballOuts;
+    std::vector<ChipletPlacement> chiplets;
+
+    // C4 section, clusters take their signal from c4BallOut.ballOutArray[j][i] after rotation
+    BallOut c4BallOut;
+    BallOutRotation c4Rotation = BallOutRotation::R0;
+    C4Layout c4Layout;
+
+    // PDN_PREPLACE section, index is the layer, metal cords are grid cords and via cords are pin cords
+    std::vector<std::unordered_map<SignalType, std::vector<Cord>>> metalPreplaced;
+    std::vector<std::unordered_map<SignalType, std::vector<Cord>>> viaPreplaced;
+
+    // the key value pairs of a .config file, missing keys keep the DiffusionEngine defaults
+    std::unordered_map<std::string, double> configuration;
+};
+
+#endif // __DESIGN_SPEC_H__
@@ -0,0 +1,223 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 13:40:18
+//  Module Name:        enumMap.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Dense map/set keyed by a small enum, backed by a fixed
+//                      array and a presence bitmask. Mirrors the subset of
+//                      std::unordered_map/unordered_set used across the tree,
+//                      iteration visits present keys in ascending enum order
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ENUMMAP_H__
+#define __ENUMMAP_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <utility>
+#include <memory>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <initializer_list>
+#include <type_traits>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+// specialise with `static constexpr size_t count` (enum values must be 0..count-1)
+template <typename E>
+struct EnumTraits;
+
+template <typename E>
+class EnumSet{
+public:
+    static constexpr size_t N = EnumTraits<E>::count;
+    static_assert(N <= 32, "EnumSet supports at most 32 enum values");
+
+    class const_iterator{
+    private:
+        uint32_t m_rest;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const E *;
+        using reference = E;
+
+        constexpr explicit const_iterator(uint32_t rest = 0): m_rest(rest) {}
+        constexpr E operator*() const {return static_cast<E>(std::countr_zero(m_rest));}
+        constexpr const_iterator &operator++() {m_rest &= (m_rest - 1); return *this;}
+        constexpr const_iterator operator++(int) {const_iterator tmp = *this; ++(*this); return tmp;}
+        constexpr bool operator==(const const_iterator &other) const {return m_rest == other.m_rest;}
+        constexpr bool operator!=(const const_iterator &other) const {return m_rest != other.m_rest;}
+    };
+    using iterator = const_iterator;
+
+private:
+    uint32_t m_mask;
+    static constexpr uint32_t bit(E e) {return uint32_t(1) << static_cast<uint32_t>(e);}
+
+public:
+    constexpr EnumSet(): m_mask(0) {}
+    constexpr EnumSet(std::initializer_list<E> il): m_mask(0) {
+        for(E e : il) m_mask |= bit(e);
+    }
+
+    constexpr size_t count(E e) const {return (m_mask & bit(e)) ? 1 : 0;}
+    constexpr bool contains(E e) const {return (m_mask & bit(e)) != 0;}
+    constexpr size_t size() const {return static_cast<size_t>(std::popcount(m_mask));}
+    constexpr bool empty() const {return m_mask == 0;}
+    constexpr uint32_t getMask() const {return m_mask;}
+
+    // returns true if e was newly inserted
+    constexpr bool insert(E e) {bool fresh = !contains(e); m_mask |= bit(e); return fresh;}
+    // returns the number of elements removed (0 or 1)
+    constexpr size_t erase(E e) {size_t had = count(e); m_mask &= ~bit(e); return had;}
+    constexpr void clear() {m_mask = 0;}
+
+    constexpr const_iterator begin() const {return const_iterator(m_mask);}
+    constexpr const_iterator end() const {return const_iterator(0);}
+};
+
+template <typename E, typename T>
+class EnumMap{
+public:
+    static constexpr size_t N = EnumTraits<E>::count;
+    static_assert(N <= 32, "EnumMap supports at most 32 enum values");
+
+    using key_type = E;
+    using mapped_type = T;
+    using slot_type = std::pair<const E, T>;
+    using value_type = slot_type;
+
+    template <bool IsConst>
+    class basic_iterator{
+    private:
+        using slots_pointer = std::conditional_t<IsConst, const slot_type *, slot_type *>;
+        slots_pointer m_slots;
+        uint32_t m_rest;
+
+        friend class EnumMap;
+        friend class basic_iterator<!IsConst>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = slot_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const slot_type *, slot_type *>;
+        using reference = std::conditional_t<IsConst, const slot_type &, slot_type &>;
+
+        basic_iterator(): m_slots(nullptr), m_rest(0) {}
+        basic_iterator(slots_pointer slots, uint32_t rest): m_slots(slots), m_rest(rest) {}
+        // iterator -> const_iterator
+        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+        basic_iterator(const basic_iterator<WasConst> &other): m_slots(other.m_slots), m_rest(other.m_rest) {}
+
+        reference operator*() const {return m_slots[std::countr_zero(m_rest)];}
+        pointer operator->() const {return &m_slots[std::countr_zero(m_rest)];}
+        basic_iterator &operator++() {m_rest &= (m_rest - 1); return *this;}
+        basic_iterator operator++(int) {basic_iterator tmp = *this; ++(*this); return tmp;}
+        bool operator==(const basic_iterator &other) const {return m_rest == other.m_rest;}
+        bool operator!=(const basic_iterator &other) const {return m_rest != other.m_rest;}
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    std::array<value_type, N> m_slots;
+    uint32_t m_mask;
+
+    static constexpr uint32_t bit(E e) {return uint32_t(1) << static_cast<uint32_t>(e);}
+    static constexpr size_t idx(E e) {return static_cast<size_t>(e);}
+
+    template <size_t... I>
+    static std::array<value_type, N> makeSlots(std::index_sequence<I...>) {
+        return {{value_type(static_cast<E>(I), T())...}};
+    }
+
+    // destroy and rebuild so owners with non-trivial destructors release their resources as unordered_map::erase would
+    void resetSlot(size_t i) {
+        T *valuePtr = &m_slots[i].second;
+        std::destroy_at(valuePtr);
+        std::construct_at(valuePtr);
+    }
+
+public:
+    EnumMap(): m_slots(makeSlots(std::make_index_sequence<N>{})), m_mask(0) {}
+    EnumMap(std::initializer_list<std::pair<E, T>> il): EnumMap() {
+        for(const auto &[key, value] : il) (*this)[key] = value;
+    }
+    // the keys of a slot are const, so assignment goes value by value instead of through the defaulted std::array one
+    EnumMap(const EnumMap &other) = default;
+    EnumMap(EnumMap &&other) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
+    EnumMap &operator=(const EnumMap &other){
+        for(size_t i = 0; i < N; ++i) m_slots[i].second = other.m_slots[i].second;
+        m_mask = other.m_mask;
+        return *this;
+    }
+    EnumMap &operator=(EnumMap &&other) noexcept(std::is_nothrow_move_assignable_v<T>){
+        for(size_t i = 0; i < N; ++i) m_slots[i].second = std::move(other.m_slots[i].second);
+        m_mask = other.m_mask;
+        return *this;
+    }
+    ~EnumMap() = default;
+
+    // inserts a default value if key is absent, as std::unordered_map does
+    T &operator[](E key) {m_mask |= bit(key); return m_slots[idx(key)].second;}
+
+    T &at(E key) {
+        if(!contains(key)) throw std::out_of_range("EnumMap::at");
+        return m_slots[idx(key)].second;
+    }
+    const T &at(E key) const {
+        if(!contains(key)) throw std::out_of_range("EnumMap::at");
+        return m_slots[idx(key)].second;
+    }
+
+    size_t count(E key) const {return (m_mask & bit(key)) ? 1 : 0;}
+    bool contains(E key) const {return (m_mask & bit(key)) != 0;}
+    size_t size() const {return static_cast<size_t>(std::popcount(m_mask));}
+    bool empty() const {return m_mask == 0;}
+    EnumSet<E> keys() const {
+        EnumSet<E> ks;
+        for(uint32_t rest = m_mask; rest != 0; rest &= (rest - 1)) ks.insert(static_cast<E>(std::countr_zero(rest)));
+        return ks;
+    }
+
+    size_t erase(E key) {
+        if(!contains(key)) return 0;
+        resetSlot(idx(key));
+        m_mask &= ~bit(key);
+        return 1;
+    }
+    void clear() {
+        for(uint32_t rest = m_mask; rest != 0; rest &= (rest - 1)) resetSlot(std::countr_zero(rest));
+        m_mask = 0;
+    }
+
+    iterator find(E key) {return contains(key)? iterator(m_slots.data(), m_mask & ~(bit(key) - 1)) : end();}
+    const_iterator find(E key) const {return contains(key)? const_iterator(m_slots.data(), m_mask & ~(bit(key) - 1)) : end();}
+
+    iterator begin() {return iterator(m_slots.data(), m_mask);}
+    iterator end() {return iterator(m_slots.data(), 0);}
+    const_iterator begin() const {return const_iterator(m_slots.data(), m_mask);}
+    const_iterator end() const {return const_iterator(m_slots.data(), 0);}
+    const_iterator cbegin() const {return begin();}
+    const_iterator cend() const {return end();}
+};
+
+#endif // __ENUMMAP_H__
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 15:02:37
+//  Module Name:        epochMarker.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Dense visited set over element ids 0..n-1, every element
+//                      stores the epoch it was last marked in so that the whole
+//                      set is cleared in O(1) by advancing the epoch
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __EPOCH_MARKER_H__
+#define __EPOCH_MARKER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+class EpochMarker{
+private:
+    std::vector<uint32_t> m_stamps;
+    uint32_t m_epoch;
+
+public:
+    EpochMarker(): m_epoch(1) {}
+    explicit EpochMarker(size_t elementCount): m_stamps(elementCount, 0), m_epoch(1) {}
+
+    void reset(size_t elementCount){
+        m_stamps.assign(elementCount, 0);
+        m_epoch = 1;
+    }
+
+    // unmark every element, the stamp array is only rewritten when the epoch wraps around
+    void clear(){
+        if(++m_epoch == 0){
+            std::fill(m_stamps.begin(), m_stamps.end(), 0);
+            m_epoch = 1;
+        }
+    }
+
+    inline bool isMarked(size_t idx) const {return m_stamps[idx] == m_epoch;}
+
+    // returns true if idx was newly marked
+    inline bool mark(size_t idx){
+        if(m_stamps[idx] == m_epoch) return false;
+        m_stamps[idx] = m_epoch;
+        return true;
+    }
+
+    inline size_t getElementCount() const {return m_stamps.size();}
+};
+
+#endif // __EPOCH_MARKER_H__
@@ -0,0 +1,270 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 17:03:26
+//  Module Name:        impedanceAnalyser.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Frequency-domain impedance sweep Z(f) seen from every
+//                      chiplet port of an extracted PDNCircuit. The complex nodal
+//                      system is stored as its real 2x2 block equivalent so that a
+//                      real PETSc build suffices, the sparsity pattern and the
+//                      symbolic LU factorisation are built once and reused across
+//                      every frequency point
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <cassert>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <omp.h>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+#include "impedanceAnalyser.hpp"
+
+// 4. PETSc
+#include "petscksp.h"
+
+ImpedanceAnalyser::ImpedanceAnalyser(const PDNCircuit &circuit): m_circuit(circuit), m_elapsedMs(0.0) {
+    buildPattern();
+}
+
+void ImpedanceAnalyser::buildPattern(){
+    const int nodeCount = m_circuit.getNodeCount();
+
+    std::vector<std::vector<PetscInt>> rowCols(nodeCount);
+    for(int n = 0; n < nodeCount; ++n) rowCols[n].push_back(n);
+    for(const PDNBranch &b : m_circuit.branches){
+        if(b.n0 == PDN_CIRCUIT_GROUND || b.n1 == PDN_CIRCUIT_GROUND) continue;
+        rowCols[b.n0].push_back(b.n1);
+        rowCols[b.n1].push_back(b.n0);
+    }
+
+    m_rowPtr.assign(nodeCount + 1, 0);
+    m_colIdx.clear();
+    for(int n = 0; n < nodeCount; ++n){
+        std::vector<PetscInt> &cols = rowCols[n];
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        m_colIdx.insert(m_colIdx.end(), cols.begin(), cols.end());
+        m_rowPtr[n + 1] = static_cast<PetscInt>(m_colIdx.size());
+    }
+
+    auto findSlot = [&](int row, int col) -> long long {
+        if(row == PDN_CIRCUIT_GROUND || col == PDN_CIRCUIT_GROUND) return -1;
+        auto first = m_colIdx.begin() + m_rowPtr[row];
+        auto last = m_colIdx.begin() + m_rowPtr[row + 1];
+        auto it = std::lower_bound(first, last, col);
+        assert(it != last && *it == col);
+        return static_cast<long long>(it - m_colIdx.begin());
+    };
+
+    m_branchSlots.clear();
+    m_branchSlots.reserve(m_circuit.branches.size());
+    for(const PDNBranch &b : m_circuit.branches){
+        m_branchSlots.push_back({findSlot(b.n0, b.n0), findSlot(b.n1, b.n1), findSlot(b.n0, b.n1), findSlot(b.n1, b.n0)});
+    }
+}
+
+std::vector<double> ImpedanceAnalyser::getLogSpacedFrequencies(double startFrequency, double stopFrequency, int pointsPerDecade){
+    assert(startFrequency > 0.0 && stopFrequency >= startFrequency && pointsPerDecade > 0);
+    std::vector<double> frequencies;
+    double decades = std::log10(stopFrequency / startFrequency);
+    int pointCount = static_cast<int>(std::floor(decades * pointsPerDecade + 1e-9)) + 1;
+    for(int i = 0; i < pointCount; ++i){
+        frequencies.push_back(startFrequency * std::pow(10.0, static_cast<double>(i) / pointsPerDecade));
+    }
+    return frequencies;
+}
+
+bool ImpedanceAnalyser::sweep(const std::vector<double> &frequencies, int threadCount){
+    auto startTime = std::chrono::steady_clock::now();
+
+    const PDNCircuit &ckt = m_circuit;
+    const PetscInt nodeCount = ckt.getNodeCount();
+    const int portCount = ckt.getPortCount();
+    const int frequencyCount = static_cast<int>(frequencies.size());
+
+    m_frequencies = frequencies;
+    m_portImpedance.assign(portCount, std::vector<std::complex<double>>(frequencyCount));
+    if(frequencyCount == 0 || nodeCount == 0) return true;
+
+    if(threadCount <= 0) threadCount = omp_get_max_threads();
+#if !defined(PETSC_HAVE_THREADSAFETY)
+    // PETSc keeps global logging state that is not guarded unless it is built thread safe
+    threadCount = 1;
+#endif
+    threadCount = std::max(1, std::min(threadCount, frequencyCount));
+
+    PetscInt maxRowLength = 0;
+    for(PetscInt n = 0; n < nodeCount; ++n) maxRowLength = std::max(maxRowLength, m_rowPtr[n + 1] - m_rowPtr[n]);
+    std::vector<PetscInt> blockRowNonZeros(nodeCount);
+    for(PetscInt n = 0; n < nodeCount; ++n) blockRowNonZeros[n] = m_rowPtr[n + 1] - m_rowPtr[n];
+
+    // every worker owns a matrix, its factor and work vectors, all created before the parallel region
+    struct Worker{
+        Mat K;
+        Mat F;
+        IS rowPerm;
+        IS colPerm;
+        MatFactorInfo info;
+        Vec b;
+        Vec x;
+        std::vector<std::complex<double>> entries;
+        std::vector<PetscScalar> rowValues;
+        bool symbolicDone;
+    };
+    std::vector<Worker> workers(threadCount);
+
+    for(Worker &w : workers){
+        MatCreateSeqBAIJ(PETSC_COMM_SELF, 2, 2 * nodeCount, 2 * nodeCount, 0, blockRowNonZeros.data(), &w.K);
+        MatSetOption(w.K, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+        MatGetFactor(w.K, MATSOLVERPETSC, MAT_FACTOR_LU, &w.F);
+        MatFactorInfoInitialize(&w.info);
+        VecCreateSeq(PETSC_COMM_SELF, 2 * nodeCount, &w.b);
+        VecDuplicate(w.b, &w.x);
+        w.entries.resize(m_colIdx.size());
+        w.rowValues.resize(4 * maxRowLength);
+        w.symbolicDone = false;
+    }
+
+    bool allSolved = true;
+
+    #pragma omp parallel for schedule(dynamic) num_threads(threadCount)
+    for(int fi = 0; fi < frequencyCount; ++fi){
+        Worker &w = workers[omp_get_thread_num()];
+        const double omega = 2.0 * M_PI * frequencies[fi];
+
+        // complex nodal admittance matrix at omega, on the shared pattern
+        std::fill(w.entries.begin(), w.entries.end(), std::complex<double>(0.0, 0.0));
+        for(size_t bi = 0; bi < ckt.branches.size(); ++bi){
+            std::complex<double> y = ckt.branches[bi].getAdmittance(omega);
+            const std::array<long long, 4> &slots = m_branchSlots[bi];
+            if(slots[0] >= 0) w.entries[slots[0]] += y;
+            if(slots[1] >= 0) w.entries[slots[1]] += y;
+            if(slots[2] >= 0) w.entries[slots[2]] -= y;
+            if(slots[3] >= 0) w.entries[slots[3]] -= y;
+        }
+
+        // a + jb becomes the block [a -b; b a], rows of a block row are given one after another
+        for(PetscInt n = 0; n < nodeCount; ++n){
+            PetscInt rowBegin = m_rowPtr[n];
+            PetscInt rowLength = m_rowPtr[n + 1] - rowBegin;
+            PetscScalar *upper = w.rowValues.data();
+            PetscScalar *lower = w.rowValues.data() + 2 * rowLength;
+            for(PetscInt k = 0; k < rowLength; ++k){
+                const std::complex<double> &entry = w.entries[rowBegin + k];
+                upper[2 * k] = entry.real();
+                upper[2 * k + 1] = -entry.imag();
+                lower[2 * k] = entry.imag();
+                lower[2 * k + 1] = entry.real();
+            }
+            MatSetValuesBlocked(w.K, 1, &n, rowLength, m_colIdx.data() + rowBegin, w.rowValues.data(), INSERT_VALUES);
+        }
+        MatAssemblyBegin(w.K, MAT_FINAL_ASSEMBLY);
+        MatAssemblyEnd(w.K, MAT_FINAL_ASSEMBLY);
+
+        if(!w.symbolicDone){
+            MatGetOrdering(w.K, MATORDERINGND, &w.rowPerm, &w.colPerm);
+            MatLUFactorSymbolic(w.F, w.K, w.rowPerm, w.colPerm, &w.info);
+            w.symbolicDone = true;
+        }
+        PetscErrorCode ierr = MatLUFactorNumeric(w.F, w.K, &w.info);
+        if(ierr != 0){
+            #pragma omp critical
+            {
+                std::cout << "[Impedance] Numeric factorisation fails at " << frequencies[fi] << " Hz" << std::endl;
+                allSolved = false;
+            }
+            continue;
+        }
+
+        // unit current injected at each port, Z_kk is the complex voltage it develops there
+        for(int k = 0; k < portCount; ++k){
+            PetscInt realRow = 2 * ckt.portNodes[k];
+            VecZeroEntries(w.b);
+            VecSetValue(w.b, realRow, 1.0, INSERT_VALUES);
+            VecAssemblyBegin(w.b);
+            VecAssemblyEnd(w.b);
+            MatSolve(w.F, w.b, w.x);
+
+            const PetscScalar *xv;
+            VecGetArrayRead(w.x, &xv);
+            m_portImpedance[k][fi] = std::complex<double>(PetscRealPart(xv[realRow]), PetscRealPart(xv[realRow + 1]));
+            VecRestoreArrayRead(w.x, &xv);
+        }
+    }
+
+    for(Worker &w : workers){
+        if(w.symbolicDone){
+            ISDestroy(&w.rowPerm);
+            ISDestroy(&w.colPerm);
+        }
+        VecDestroy(&w.x);
+        VecDestroy(&w.b);
+        MatDestroy(&w.F);
+        MatDestroy(&w.K);
+    }
+
+    m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return allSolved;
+}
+
+double ImpedanceAnalyser::getPeakImpedance(int port, double *peakFrequency) const {
+    double peak = 0.0;
+    for(size_t fi = 0; fi < m_frequencies.size(); ++fi){
+        double magnitude = std::abs(m_portImpedance[port][fi]);
+        if(magnitude > peak){
+            peak = magnitude;
+            if(peakFrequency != nullptr) *peakFrequency = m_frequencies[fi];
+        }
+    }
+    return peak;
+}
+
+void ImpedanceAnalyser::printReport(std::ostream &os) const {
+    os << "[Impedance] " << m_circuit.signal << ": " << m_frequencies.size() << " frequency points in " << m_elapsedMs << " ms" << std::endl;
+    if(m_frequencies.empty()) return;
+    for(int k = 0; k < m_circuit.getPortCount(); ++k){
+        double peakFrequency = 0.0;
+        double peak = getPeakImpedance(k, &peakFrequency);
+        os << "[Impedance]     " << m_circuit.portNames[k] << ": |Z(" << m_frequencies.front() << " Hz)| = " << std::abs(m_portImpedance[k].front()) * 1e3 << " mOhm, ";
+        os << "peak |Z| = " << peak * 1e3 << " mOhm at " << peakFrequency << " Hz" << std::endl;
+    }
+}
+
+bool ImpedanceAnalyser::exportProfiles(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out);
+    assert(ofs.is_open());
+    if(!ofs.is_open()) return false;
+
+    ofs << "port,frequency,magnitude,phase,real,imag" << std::endl;
+    for(int k = 0; k < m_circuit.getPortCount(); ++k){
+        for(size_t fi = 0; fi < m_frequencies.size(); ++fi){
+            const std::complex<double> &z = m_portImpedance[k][fi];
+            ofs << m_circuit.portNames[k] << "," << m_frequencies[fi] << "," << std::abs(z) << "," << std::arg(z) * 180.0 / M_PI << ",";
+            ofs << z.real() << "," << z.imag() << std::endl;
+        }
+    }
+
+    ofs.close();
+    return true;
+}
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 17:03:26
+//  Module Name:        impedanceAnalyser.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Frequency-domain impedance sweep Z(f) seen from every
+//                      chiplet port of an extracted PDNCircuit. The complex nodal
+//                      system is stored as its real 2x2 block equivalent so that a
+//                      real PETSc build suffices, the sparsity pattern and the
+//                      symbolic LU factorisation are built once and reused across
+//                      every frequency point
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __IMPEDANCE_ANALYSER_H__
+#define __IMPEDANCE_ANALYSER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <array>
+#include <complex>
+#include <ostream>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+
+// 4. PETSc
+#include "petscksp.h"
+
+class ImpedanceAnalyser{
+private:
+    const PDNCircuit &m_circuit;
+
+    // complex nodal pattern in CSR form (ground eliminated), shared by every frequency point
+    std::vector<PetscInt> m_rowPtr;
+    std::vector<PetscInt> m_colIdx;
+    // per branch: positions of (n0,n0), (n1,n1), (n0,n1), (n1,n0) in m_colIdx, -1 where an end is grounded
+    std::vector<std::array<long long, 4>> m_branchSlots;
+
+    std::vector<double> m_frequencies;
+    // [port][frequency], self impedance of each chiplet port
+    std::vector<std::vector<std::complex<double>>> m_portImpedance;
+    double m_elapsedMs;
+
+    void buildPattern();
+
+public:
+    explicit ImpedanceAnalyser(const PDNCircuit &circuit);
+
+    static std::vector<double> getLogSpacedFrequencies(double startFrequency, double stopFrequency, int pointsPerDecade);
+
+    // frequencies in Hz and strictly positive. threadCount <= 0 uses every OpenMP thread, frequency points
+    // only run concurrently when PETSc is configured with --with-threadsafety
+    bool sweep(const std::vector<double> &frequencies, int threadCount = 0);
+
+    inline const std::vector<double> &getFrequencies() const {return m_frequencies;}
+    inline const std::vector<std::complex<double>> &getPortImpedance(int port) const {return m_portImpedance[port];}
+    inline double getElapsedMs() const {return m_elapsedMs;}
+
+    // largest |Z| over the sweep, and the frequency it occurs at
+    double getPeakImpedance(int port, double *peakFrequency = nullptr) const;
+
+    void printReport(std::ostream &os = std::cout) const;
+    bool exportProfiles(const std::string &filePath) const;
+};
+
+#endif // __IMPEDANCE_ANALYSER_H__
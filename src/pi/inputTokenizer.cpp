@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 22:05:17
+//  Module Name:        inputTokenizer.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Shared reader for every PowerX input file (.pinout, ballout
+//                      CSV, preplace, .tch and .config). The file is mapped
+//                      read-only and walked in place, lines and words are handed
+//                      out as string_views into the mapping and integers are
+//                      converted with std::from_chars, no line is ever copied
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "inputTokenizer.hpp"
+
+// 4. POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+    inline bool isBlank(char c){
+        return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\v') || (c == '\f');
+    }
+    // longest numeric literal accepted by toDouble()
+    constexpr size_t MAX_DOUBLE_LITERAL = 63;
+}
+
+MappedFile::MappedFile(const std::string &filePath): m_filePath(filePath), m_fd(-1), m_data(nullptr), m_size(0) {
+    m_fd = ::open(filePath.c_str(), O_RDONLY);
+    if(m_fd < 0) return;
+
+    struct stat fileStat;
+    if(fstat(m_fd, &fileStat) != 0){
+        ::close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    // mmap refuses a zero length mapping, an empty file simply has an empty view
+    m_size = static_cast<size_t>(fileStat.st_size);
+    if(m_size == 0) return;
+
+    void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if(mapping == MAP_FAILED){
+        ::close(m_fd);
+        m_fd = -1;
+        m_size = 0;
+        return;
+    }
+    madvise(mapping, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(mapping);
+}
+
+MappedFile::~MappedFile(){
+    if(m_data != nullptr) munmap(const_cast<char *>(m_data), m_size);
+    if(m_fd >= 0) ::close(m_fd);
+}
+
+InputTokenizer::InputTokenizer(std::string_view text): m_text(text), m_pos(0), m_lineNumber(0) {
+
+}
+
+bool InputTokenizer::nextLine(std::string_view &line){
+    while(m_pos < m_text.size()){
+        size_t lineEnd = m_text.find('\n', m_pos);
+        if(lineEnd == std::string_view::npos) lineEnd = m_text.size();
+
+        std::string_view rawLine = m_text.substr(m_pos, lineEnd - m_pos);
+        m_pos = lineEnd + 1;
+        ++m_lineNumber;
+
+        size_t commentPos = rawLine.find('#');
+        if(commentPos != std::string_view::npos) rawLine = rawLine.substr(0, commentPos);
+
+        line = trim(rawLine);
+        if(!line.empty()) return true;
+    }
+    return false;
+}
+
+bool InputTokenizer::nextWord(std::string_view &word){
+    while((m_pos < m_text.size()) && isBlank(m_text[m_pos])){
+        if(m_text[m_pos] == '\n') ++m_lineNumber;
+        ++m_pos;
+    }
+    if(m_pos >= m_text.size()) return false;
+
+    size_t wordBegin = m_pos;
+    while((m_pos < m_text.size()) && !isBlank(m_text[m_pos])) ++m_pos;
+    word = m_text.substr(wordBegin, m_pos - wordBegin);
+    return true;
+}
+
+std::string_view InputTokenizer::trim(std::string_view text){
+    size_t begin = 0;
+    while((begin < text.size()) && isBlank(text[begin])) ++begin;
+    size_t end = text.size();
+    while((end > begin) && isBlank(text[end - 1])) --end;
+    return text.substr(begin, end - begin);
+}
+
+size_t InputTokenizer::split(std::string_view line, std::vector<std::string_view> &words){
+    words.clear();
+    size_t pos = 0;
+    while(pos < line.size()){
+        while((pos < line.size()) && isBlank(line[pos])) ++pos;
+        if(pos >= line.size()) break;
+        size_t wordBegin = pos;
+        while((pos < line.size()) && !isBlank(line[pos])) ++pos;
+        words.push_back(line.substr(wordBegin, pos - wordBegin));
+    }
+    return words.size();
+}
+
+std::string_view InputTokenizer::unquote(std::string_view text){
+    // the quotes of an input path only ever wrap it, so trimming both ends is enough
+    while(!text.empty() && (text.front() == '"')) text.remove_prefix(1);
+    while(!text.empty() && (text.back() == '"')) text.remove_suffix(1);
+    return text;
+}
+
+bool InputTokenizer::toDouble(std::string_view text, double &value){
+    // floating point std::from_chars is missing from the libc++ we build against, strtod needs a terminator
+    if(text.empty() || (text.size() > MAX_DOUBLE_LITERAL)) return false;
+    char literal[MAX_DOUBLE_LITERAL + 1];
+    std::memcpy(literal, text.data(), text.size());
+    literal[text.size()] = '\0';
+
+    char *end = nullptr;
+    double parsed = std::strtod(literal, &end);
+    if(end != literal + text.size()) return false;
+    value = parsed;
+    return true;
+}
+
+int InputTokenizer::parseInt(std::string_view text){
+    int value;
+    if(!toInteger(text, value)){
+        throw InputError("InputTokenizer", "Expecting an integer: " + std::string(text));
+    }
+    return value;
+}
+
+double InputTokenizer::parseDouble(std::string_view text){
+    double value;
+    if(!toDouble(text, value)){
+        throw InputError("InputTokenizer", "Expecting a number: " + std::string(text));
+    }
+    return value;
+}
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 22:05:17
+//  Module Name:        inputTokenizer.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Shared reader for every PowerX input file (.pinout, ballout
+//                      CSV, preplace, .tch and .config). The file is mapped
+//                      read-only and walked in place, lines and words are handed
+//                      out as string_views into the mapping and integers are
+//                      converted with std::from_chars, no line is ever copied
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __INPUT_TOKENIZER_H__
+#define __INPUT_TOKENIZER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <type_traits>
+#include <stdexcept>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+// a malformed or missing input file, the parsers throw it instead of exiting so that a long running caller (the
+// daemon, a batch worker) fails only the job that read the file, the CLI still reports it and exits with code 4
+class InputError : public std::runtime_error{
+private:
+    std::string m_module;
+
+public:
+    InputError(const std::string &module, const std::string &message): std::runtime_error(message), m_module(module) {}
+    inline const std::string &getModule() const {return this->m_module;}
+};
+
+class MappedFile{
+private:
+    std::string m_filePath;
+    int m_fd;
+    const char *m_data;
+    size_t m_size;
+
+public:
+    explicit MappedFile(const std::string &filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    // an empty file is open but has an empty view
+    inline bool is_open() const {return m_fd >= 0;}
+    inline const std::string &getFilePath() const {return this->m_filePath;}
+    inline std::string_view view() const {return std::string_view(m_data, m_size);}
+};
+
+class InputTokenizer{
+private:
+    std::string_view m_text;
+    size_t m_pos;
+    size_t m_lineNumber;
+
+public:
+    explicit InputTokenizer(std::string_view text);
+
+    // next line that still holds text once the "#" comment is cut off, trimmed on both ends
+    bool nextLine(std::string_view &line);
+    // next whitespace separated word, comments are not recognised
+    bool nextWord(std::string_view &word);
+
+    // 1-based number of the line last returned by nextLine()
+    inline size_t getLineNumber() const {return this->m_lineNumber;}
+
+    static std::string_view trim(std::string_view text);
+    // splits on whitespace into words, returns the number of words
+    static size_t split(std::string_view line, std::vector<std::string_view> &words);
+    // strips the leading and trailing '"'s, "inputs/a.csv" -> inputs/a.csv, a quote inside the text is kept
+    static std::string_view unquote(std::string_view text);
+
+    // whole text must be the number, no sign prefix '+' and no surrounding space
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    static bool toInteger(std::string_view text, T &value){
+        if(text.empty()) return false;
+        std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return (result.ec == std::errc()) && (result.ptr == text.data() + text.size());
+    }
+    static bool toDouble(std::string_view text, double &value);
+
+    // converts a whole word, throws InputError naming the offending text on failure
+    static int parseInt(std::string_view text);
+    static double parseDouble(std::string_view text);
+};
+
+#endif // __INPUT_TOKENIZER_H__
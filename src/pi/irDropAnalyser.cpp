@@ -0,0 +1,258 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 16:18:52
+//  Module Name:        irDropAnalyser.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        In-process DC IR-drop analysis of an extracted PDNCircuit,
+//                      the PCB output is held at the supply voltage (where the
+//                      HSPICE deck measures its drops from) and every chiplet
+//                      draws its maximum current
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "technology.hpp"
+#include "pdnNode.hpp"
+#include "pdnCircuit.hpp"
+#include "dsu.hpp"
+#include "irDropAnalyser.hpp"
+
+// 4. PETSc
+#include "petscksp.h"
+
+IRDropAnalyser::IRDropAnalyser(const PDNCircuit &circuit, const Technology &tch): m_circuit(circuit), m_elapsedMs(0.0) {
+    double metalWidth = tch.getInterposerMetalWidth();
+    m_edgeCrossSection = metalWidth * tch.getInterposerMetalThickness();
+    // vias are modelled as cylinders of the metal width, as in EqCktExtractor
+    m_viaCrossSection = M_PI * (metalWidth / 2) * (metalWidth / 2);
+}
+
+bool IRDropAnalyser::solve(){
+    auto startTime = std::chrono::steady_clock::now();
+
+    const PDNCircuit &ckt = m_circuit;
+    const int nodeCount = ckt.getNodeCount();
+    const double supplyVoltage = ckt.supplyVoltage;
+
+    // the PCB is replaced by the fixed supply node, capacitive branches are open at DC
+    auto isDCBranch = [](const PDNBranch &b){
+        return (b.type != PDNBranchType::PCB) && b.conductsDC();
+    };
+
+    // nodes without a DC path to the supply would make the system singular, leave them floating
+    DSU dsu(nodeCount);
+    for(const PDNBranch &b : ckt.branches){
+        if(!isDCBranch(b)) continue;
+        assert(b.n0 != PDN_CIRCUIT_GROUND && b.n1 != PDN_CIRCUIT_GROUND);
+        dsu.unite(b.n0, b.n1);
+    }
+    const int supplyRoot = dsu.find(ckt.supplyNode);
+
+    std::vector<PetscInt> nodeToRow(nodeCount, -1);
+    PetscInt rowCount = 0;
+    for(int n = 0; n < nodeCount; ++n){
+        if((n != ckt.supplyNode) && (dsu.find(n) == supplyRoot)) nodeToRow[n] = rowCount++;
+    }
+
+    m_nodeVoltages.assign(nodeCount, std::numeric_limits<double>::quiet_NaN());
+    m_nodeVoltages[ckt.supplyNode] = supplyVoltage;
+
+    if(rowCount != 0){
+        std::vector<PetscInt> rowNonZeros(rowCount, 1);
+        for(const PDNBranch &b : ckt.branches){
+            if(!isDCBranch(b)) continue;
+            PetscInt r0 = nodeToRow[b.n0];
+            PetscInt r1 = nodeToRow[b.n1];
+            if(r0 >= 0 && r1 >= 0){
+                rowNonZeros[r0]++;
+                rowNonZeros[r1]++;
+            }
+        }
+
+        Mat G;
+        Vec I, V;
+        MatCreateSeqAIJ(PETSC_COMM_SELF, rowCount, rowCount, 0, rowNonZeros.data(), &G);
+        VecCreateSeq(PETSC_COMM_SELF, rowCount, &I);
+        VecDuplicate(I, &V);
+        VecSet(I, 0.0);
+
+        // stamp conductances, branches into the supply move to the right hand side
+        for(const PDNBranch &b : ckt.branches){
+            if(!isDCBranch(b)) continue;
+            PetscScalar g = 1.0 / b.resistance;
+            PetscInt r0 = nodeToRow[b.n0];
+            PetscInt r1 = nodeToRow[b.n1];
+
+            if(r0 >= 0) MatSetValue(G, r0, r0, g, ADD_VALUES);
+            if(r1 >= 0) MatSetValue(G, r1, r1, g, ADD_VALUES);
+            if(r0 >= 0 && r1 >= 0){
+                MatSetValue(G, r0, r1, -g, ADD_VALUES);
+                MatSetValue(G, r1, r0, -g, ADD_VALUES);
+            }else if(r0 >= 0 && b.n1 == ckt.supplyNode){
+                VecSetValue(I, r0, g * supplyVoltage, ADD_VALUES);
+            }else if(r1 >= 0 && b.n0 == ckt.supplyNode){
+                VecSetValue(I, r1, g * supplyVoltage, ADD_VALUES);
+            }
+        }
+
+        // chiplet loads sink their maximum current
+        for(int k = 0; k < ckt.getPortCount(); ++k){
+            PetscInt row = nodeToRow[ckt.portLoadNodes[k]];
+            if(row >= 0) VecSetValue(I, row, -ckt.portCurrents[k], ADD_VALUES);
+        }
+
+        MatAssemblyBegin(G, MAT_FINAL_ASSEMBLY);
+        MatAssemblyEnd(G, MAT_FINAL_ASSEMBLY);
+        MatSetOption(G, MAT_SPD, PETSC_TRUE);
+        VecAssemblyBegin(I);
+        VecAssemblyEnd(I);
+
+        KSP ksp;
+        KSPCreate(PETSC_COMM_SELF, &ksp);
+        KSPSetOperators(ksp, G, G);
+        KSPSetType(ksp, KSPPREONLY);
+
+        PC pc;
+        KSPGetPC(ksp, &pc);
+        PCSetType(pc, PCCHOLESKY);
+        PCFactorSetMatSolverType(pc, MATSOLVERCHOLMOD);
+        KSPSetFromOptions(ksp);
+
+        KSPSolve(ksp, I, V);
+
+        KSPConvergedReason reason;
+        KSPGetConvergedReason(ksp, &reason);
+        bool solved = (reason >= 0);
+
+        if(solved){
+            const PetscScalar *v;
+            VecGetArrayRead(V, &v);
+            for(int n = 0; n < nodeCount; ++n){
+                if(nodeToRow[n] >= 0) m_nodeVoltages[n] = PetscRealPart(v[nodeToRow[n]]);
+            }
+            VecRestoreArrayRead(V, &v);
+        }
+
+        KSPDestroy(&ksp);
+        VecDestroy(&V);
+        VecDestroy(&I);
+        MatDestroy(&G);
+
+        if(!solved){
+            std::cout << "[IR-Drop] DC solve of " << ckt.signal << " fails, KSP reason = " << reason << std::endl;
+            return false;
+        }
+    }
+
+    // per-chiplet drops
+    m_chipletDrops.clear();
+    for(int k = 0; k < ckt.getPortCount(); ++k){
+        ChipletIRDrop cd;
+        cd.name = ckt.portNames[k];
+        cd.current = ckt.portCurrents[k];
+        cd.connected = (nodeToRow[ckt.portNodes[k]] >= 0);
+
+        if(cd.connected){
+            cd.portDrop = supplyVoltage - m_nodeVoltages[ckt.portNodes[k]];
+            cd.worstBumpDrop = 0.0;
+            double sumBumpDrop = 0.0;
+            int bumpCount = 0;
+            for(int bumpNode : ckt.portBumpNodes[k]){
+                if(nodeToRow[bumpNode] < 0) continue;
+                double drop = supplyVoltage - m_nodeVoltages[bumpNode];
+                cd.worstBumpDrop = std::max(cd.worstBumpDrop, drop);
+                sumBumpDrop += drop;
+                bumpCount++;
+            }
+            cd.averageBumpDrop = (bumpCount != 0)? (sumBumpDrop / bumpCount) : 0.0;
+        }else{
+            cd.portDrop = cd.worstBumpDrop = cd.averageBumpDrop = std::numeric_limits<double>::infinity();
+        }
+        m_chipletDrops.push_back(cd);
+    }
+
+    // per-edge currents of the physical edges
+    m_edgeCurrents.clear();
+    for(const PDNBranch &b : ckt.branches){
+        if(b.edge == PDN_EDGE_NONE) continue;
+        if(nodeToRow[b.n0] < 0 || nodeToRow[b.n1] < 0) continue;
+
+        EdgeCurrent ec;
+        ec.edge = b.edge;
+        ec.isVia = (b.type == PDNBranchType::VIA);
+        ec.current = (m_nodeVoltages[b.n0] - m_nodeVoltages[b.n1]) / b.resistance;
+        ec.currentDensity = std::abs(ec.current) * 1e3 / (ec.isVia? m_viaCrossSection : m_edgeCrossSection);
+        m_edgeCurrents.push_back(ec);
+    }
+
+    m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return true;
+}
+
+double IRDropAnalyser::getWorstDrop() const {
+    double worst = 0.0;
+    for(const ChipletIRDrop &cd : m_chipletDrops){
+        worst = std::max(worst, cd.worstBumpDrop);
+    }
+    return worst;
+}
+
+const EdgeCurrent *IRDropAnalyser::getMaxCurrentDensityEdge() const {
+    const EdgeCurrent *maxEdge = nullptr;
+    for(const EdgeCurrent &ec : m_edgeCurrents){
+        if(maxEdge == nullptr || ec.currentDensity > maxEdge->currentDensity) maxEdge = &ec;
+    }
+    return maxEdge;
+}
+
+void IRDropAnalyser::printReport(std::ostream &os) const {
+    os << "[IR-Drop] " << m_circuit.signal << ": " << m_circuit.getNodeCount() << " nodes, " << m_circuit.branches.size() << " branches, solved in " << m_elapsedMs << " ms" << std::endl;
+    for(const ChipletIRDrop &cd : m_chipletDrops){
+        if(!cd.connected){
+            os << "[IR-Drop]     " << cd.name << " is not connected to the supply" << std::endl;
+            continue;
+        }
+        os << "[IR-Drop]     " << cd.name << " (" << cd.current << " A): port = " << cd.portDrop * 1e3 << " mV, ";
+        os << "worst bump = " << cd.worstBumpDrop * 1e3 << " mV, average bump = " << cd.averageBumpDrop * 1e3 << " mV" << std::endl;
+    }
+    const EdgeCurrent *maxEdge = getMaxCurrentDensityEdge();
+    if(maxEdge != nullptr){
+        os << "[IR-Drop]     max current density = " << maxEdge->currentDensity << " mA/um^2 on " << (maxEdge->isVia? "via " : "edge ") << maxEdge->edge << std::endl;
+    }
+}
+
+bool IRDropAnalyser::exportEdgeCurrents(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out);
+    assert(ofs.is_open());
+    if(!ofs.is_open()) return false;
+
+    ofs << "EDGE_CURRENTS " << m_circuit.signal << " " << m_edgeCurrents.size() << std::endl;
+    for(const EdgeCurrent &ec : m_edgeCurrents){
+        ofs << ec.edge << " " << (ec.isVia? "VIA" : "EDGE") << " " << ec.current << " " << ec.currentDensity << std::endl;
+    }
+
+    ofs.close();
+    return true;
+}
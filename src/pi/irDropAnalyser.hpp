@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 16:18:52
+//  Module Name:        irDropAnalyser.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        In-process DC IR-drop analysis of an extracted PDNCircuit,
+//                      the PCB output is held at the supply voltage (where the
+//                      HSPICE deck measures its drops from) and every chiplet
+//                      draws its maximum current
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __IR_DROP_ANALYSER_H__
+#define __IR_DROP_ANALYSER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "technology.hpp"
+#include "pdnNode.hpp"
+#include "pdnCircuit.hpp"
+
+struct ChipletIRDrop{
+    std::string name;
+    bool connected;
+    double current;         // A
+    double portDrop;        // V, V(pcb_out) - V(chiplet_o) as measured by the HSPICE deck
+    double worstBumpDrop;   // V, over the chiplet's uBump landing nodes
+    double averageBumpDrop; // V
+};
+
+struct EdgeCurrent{
+    pdn_edge_t edge;
+    bool isVia;
+    double current;         // A, positive from n0 to n1 of the PDNEdge
+    double currentDensity;  // mA/um^2
+};
+
+class IRDropAnalyser{
+private:
+    const PDNCircuit &m_circuit;
+    double m_edgeCrossSection;  // um^2
+    double m_viaCrossSection;   // um^2
+
+    std::vector<double> m_nodeVoltages;
+    std::vector<ChipletIRDrop> m_chipletDrops;
+    std::vector<EdgeCurrent> m_edgeCurrents;
+    double m_elapsedMs;
+
+public:
+    IRDropAnalyser(const PDNCircuit &circuit, const Technology &tch);
+
+    // assembles and factorises the nodal conductance system, returns false if the solve fails
+    bool solve();
+
+    // NaN for nodes without a DC path to the supply
+    inline const std::vector<double> &getNodeVoltages() const {return m_nodeVoltages;}
+    inline const std::vector<ChipletIRDrop> &getChipletDrops() const {return m_chipletDrops;}
+    inline const std::vector<EdgeCurrent> &getEdgeCurrents() const {return m_edgeCurrents;}
+    inline double getElapsedMs() const {return m_elapsedMs;}
+
+    double getWorstDrop() const;
+    const EdgeCurrent *getMaxCurrentDensityEdge() const;
+
+    void printReport(std::ostream &os = std::cout) const;
+    bool exportEdgeCurrents(const std::string &filePath) const;
+};
+
+#endif // __IR_DROP_ANALYSER_H__
@@ -0,0 +1,484 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 19:08:37
+//  Module Name:        macromodelReducer.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        PRIMA-style model-order reduction of the interposer part of
+//                      an extracted PDNCircuit (TSVs, metal edges, vias, uBumps and
+//                      grid capacitance) to a port macromodel. The ports are the
+//                      interposer side of every C4 bump and every chiplet_o node.
+//                      The MNA system (G + sC)x = Bu, y = B^T x is projected by
+//                      congruence onto a block Krylov subspace expanded at a real
+//                      shift, which matches the leading moments and keeps the
+//                      reduced model passive
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <omp.h>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+#include "macromodelReducer.hpp"
+
+// 4. PETSc
+#include "petscksp.h"
+
+namespace {
+    // Krylov columns whose norm drops below this fraction after orthogonalisation are deflated
+    constexpr double DEFLATION_TOLERANCE = 1e-10;
+    // entries below this fraction of the largest entry are not written to the subcircuit
+    constexpr double EXPORT_DROP_TOLERANCE = 1e-12;
+
+    inline bool isInterposerBranch(PDNBranchType type){
+        return (type == PDNBranchType::UBUMP) || (type == PDNBranchType::VIA) || (type == PDNBranchType::EDGE) ||
+               (type == PDNBranchType::TSV) || (type == PDNBranchType::GRID_CAP);
+    }
+
+    double dot(const std::vector<double> &a, const std::vector<double> &b){
+        double sum = 0.0;
+        for(size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+        return sum;
+    }
+
+    // solves a x = b in place by Gaussian elimination with partial pivoting, a is n x n and b is n x rhsCount, both column-major
+    void solveDense(std::vector<std::complex<double>> &a, std::vector<std::complex<double>> &b, int n, int rhsCount){
+        for(int k = 0; k < n; ++k){
+            int pivot = k;
+            for(int i = k + 1; i < n; ++i){
+                if(std::abs(a[i + k * n]) > std::abs(a[pivot + k * n])) pivot = i;
+            }
+            if(pivot != k){
+                for(int j = 0; j < n; ++j) std::swap(a[k + j * n], a[pivot + j * n]);
+                for(int j = 0; j < rhsCount; ++j) std::swap(b[k + j * n], b[pivot + j * n]);
+            }
+
+            const std::complex<double> diagonal = a[k + k * n];
+            for(int i = k + 1; i < n; ++i){
+                std::complex<double> factor = a[i + k * n] / diagonal;
+                if(factor == 0.0) continue;
+                for(int j = k + 1; j < n; ++j) a[i + j * n] -= factor * a[k + j * n];
+                for(int j = 0; j < rhsCount; ++j) b[i + j * n] -= factor * b[k + j * n];
+            }
+        }
+
+        for(int j = 0; j < rhsCount; ++j){
+            for(int k = n - 1; k >= 0; --k){
+                std::complex<double> sum = b[k + j * n];
+                for(int i = k + 1; i < n; ++i) sum -= a[k + i * n] * b[i + j * n];
+                b[k + j * n] = sum / a[k + k * n];
+            }
+        }
+    }
+}
+
+MacromodelReducer::MacromodelReducer(const PDNCircuit &circuit):
+    m_circuit(circuit), m_nodeStateCount(0), m_stateCount(0), m_order(0), m_blockMoments(0), m_expansionFrequency(0.0), m_elapsedMs(0.0) {
+    buildStates();
+}
+
+void MacromodelReducer::buildStates(){
+    const PDNCircuit &ckt = m_circuit;
+    m_circuitToState.assign(ckt.getNodeCount(), -1);
+
+    auto addNodeState = [&](int n){
+        if(n == PDN_CIRCUIT_GROUND || m_circuitToState[n] != -1) return;
+        m_circuitToState[n] = static_cast<int>(m_stateToCircuit.size());
+        m_stateToCircuit.push_back(n);
+    };
+
+    for(size_t bi = 0; bi < ckt.branches.size(); ++bi){
+        const PDNBranch &b = ckt.branches[bi];
+        if(!isInterposerBranch(b.type)) continue;
+        // capacitors of the interposer are pure, every other branch is a series R-L
+        assert(b.conductsDC() || (b.resistance == 0.0 && b.inductance == 0.0));
+        m_interposerBranches.push_back(bi);
+        addNodeState(b.n0);
+        addNodeState(b.n1);
+    }
+    m_nodeStateCount = static_cast<int>(m_stateToCircuit.size());
+
+    m_stateCount = m_nodeStateCount;
+    m_inductorState.assign(m_interposerBranches.size(), -1);
+    for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+        const PDNBranch &b = ckt.branches[m_interposerBranches[i]];
+        if(b.conductsDC() && b.inductance > 0.0) m_inductorState[i] = m_stateCount++;
+    }
+
+    // C4 bumps hang from pcb_out, their other end is the interposer side port
+    for(const PDNBranch &b : ckt.branches){
+        if(b.type != PDNBranchType::C4 || m_circuitToState[b.n1] == -1) continue;
+        m_portNames.push_back(ckt.nodeNames[b.n1]);
+        m_portStates.push_back(m_circuitToState[b.n1]);
+    }
+    for(int k = 0; k < ckt.getPortCount(); ++k){
+        int state = m_circuitToState[ckt.portNodes[k]];
+        if(state == -1) continue;
+        m_portNames.push_back(ckt.nodeNames[ckt.portNodes[k]]);
+        m_portStates.push_back(state);
+    }
+}
+
+void MacromodelReducer::applyG(const double *x, double *y) const {
+    std::fill(y, y + m_stateCount, 0.0);
+    for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+        const PDNBranch &b = m_circuit.branches[m_interposerBranches[i]];
+        if(!b.conductsDC()) continue;
+
+        int r0 = (b.n0 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n0];
+        int r1 = (b.n1 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n1];
+        double v0 = (r0 == -1)? 0.0 : x[r0];
+        double v1 = (r1 == -1)? 0.0 : x[r1];
+
+        int k = m_inductorState[i];
+        if(k == -1){
+            double current = (v0 - v1) / b.resistance;
+            if(r0 != -1) y[r0] += current;
+            if(r1 != -1) y[r1] -= current;
+        }else{
+            // KCL picks up the branch current, the branch row is -(v0 - v1) + R i
+            if(r0 != -1) y[r0] += x[k];
+            if(r1 != -1) y[r1] -= x[k];
+            y[k] += b.resistance * x[k] - (v0 - v1);
+        }
+    }
+}
+
+void MacromodelReducer::applyC(const double *x, double *y) const {
+    std::fill(y, y + m_stateCount, 0.0);
+    for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+        const PDNBranch &b = m_circuit.branches[m_interposerBranches[i]];
+        int k = m_inductorState[i];
+        if(k != -1){
+            y[k] += b.inductance * x[k];
+            continue;
+        }
+        if(b.conductsDC()) continue;
+
+        int r0 = (b.n0 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n0];
+        int r1 = (b.n1 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n1];
+        double charge = b.capacitance * (((r0 == -1)? 0.0 : x[r0]) - ((r1 == -1)? 0.0 : x[r1]));
+        if(r0 != -1) y[r0] += charge;
+        if(r1 != -1) y[r1] -= charge;
+    }
+}
+
+bool MacromodelReducer::reduce(int blockMoments, double expansionFrequency){
+    assert(blockMoments >= 1 && expansionFrequency > 0.0);
+    auto startTime = std::chrono::steady_clock::now();
+
+    m_blockMoments = blockMoments;
+    m_expansionFrequency = expansionFrequency;
+    m_order = 0;
+    m_reducedG.clear();
+    m_reducedC.clear();
+    m_reducedB.clear();
+
+    const int portCount = getPortCount();
+    if(portCount == 0 || m_nodeStateCount == 0){
+        std::cout << "[MOR] " << m_circuit.signal << " has no interposer ports to reduce" << std::endl;
+        return false;
+    }
+
+    const PDNCircuit &ckt = m_circuit;
+    const double s0 = 2.0 * M_PI * expansionFrequency;
+
+    // 1. G + s0 C, with the inductor currents eliminated, is the SPD nodal matrix with every R-L branch
+    //    stamped as 1 / (R + s0 L) and every capacitor as s0 C. It is factorised once
+    std::vector<double> branchAdmittance(m_interposerBranches.size());
+    std::vector<PetscInt> rowNonZeros(m_nodeStateCount, 1);
+    for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+        const PDNBranch &b = ckt.branches[m_interposerBranches[i]];
+        branchAdmittance[i] = b.conductsDC()? 1.0 / (b.resistance + s0 * b.inductance) : s0 * b.capacitance;
+        if(b.n0 != PDN_CIRCUIT_GROUND && b.n1 != PDN_CIRCUIT_GROUND){
+            rowNonZeros[m_circuitToState[b.n0]]++;
+            rowNonZeros[m_circuitToState[b.n1]]++;
+        }
+    }
+
+    Mat Y;
+    Vec rhs, solution;
+    MatCreateSeqAIJ(PETSC_COMM_SELF, m_nodeStateCount, m_nodeStateCount, 0, rowNonZeros.data(), &Y);
+    VecCreateSeq(PETSC_COMM_SELF, m_nodeStateCount, &rhs);
+    VecDuplicate(rhs, &solution);
+
+    for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+        const PDNBranch &b = ckt.branches[m_interposerBranches[i]];
+        PetscScalar y = branchAdmittance[i];
+        PetscInt r0 = (b.n0 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n0];
+        PetscInt r1 = (b.n1 == PDN_CIRCUIT_GROUND)? -1 : m_circuitToState[b.n1];
+        if(r0 >= 0) MatSetValue(Y, r0, r0, y, ADD_VALUES);
+        if(r1 >= 0) MatSetValue(Y, r1, r1, y, ADD_VALUES);
+        if(r0 >= 0 && r1 >= 0){
+            MatSetValue(Y, r0, r1, -y, ADD_VALUES);
+            MatSetValue(Y, r1, r0, -y, ADD_VALUES);
+        }
+    }
+    MatAssemblyBegin(Y, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(Y, MAT_FINAL_ASSEMBLY);
+    MatSetOption(Y, MAT_SPD, PETSC_TRUE);
+
+    KSP ksp;
+    KSPCreate(PETSC_COMM_SELF, &ksp);
+    KSPSetOperators(ksp, Y, Y);
+    KSPSetType(ksp, KSPPREONLY);
+    PC pc;
+    KSPGetPC(ksp, &pc);
+    PCSetType(pc, PCCHOLESKY);
+    PCFactorSetMatSolverType(pc, MATSOLVERCHOLMOD);
+    KSPSetFromOptions(ksp);
+    KSPSetUp(ksp);
+
+    // x = (G + s0 C)^-1 b through the Schur complement on the node voltages
+    bool solved = true;
+    auto solveShifted = [&](std::vector<double> &x){
+        PetscScalar *r;
+        VecGetArray(rhs, &r);
+        std::copy(x.begin(), x.begin() + m_nodeStateCount, r);
+        for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+            int k = m_inductorState[i];
+            if(k == -1) continue;
+            const PDNBranch &b = ckt.branches[m_interposerBranches[i]];
+            double flow = x[k] * branchAdmittance[i];
+            if(b.n0 != PDN_CIRCUIT_GROUND) r[m_circuitToState[b.n0]] -= flow;
+            if(b.n1 != PDN_CIRCUIT_GROUND) r[m_circuitToState[b.n1]] += flow;
+        }
+        VecRestoreArray(rhs, &r);
+
+        KSPSolve(ksp, rhs, solution);
+        KSPConvergedReason reason;
+        KSPGetConvergedReason(ksp, &reason);
+        if(reason < 0) solved = false;
+
+        const PetscScalar *v;
+        VecGetArrayRead(solution, &v);
+        for(int n = 0; n < m_nodeStateCount; ++n) x[n] = PetscRealPart(v[n]);
+        VecRestoreArrayRead(solution, &v);
+
+        for(size_t i = 0; i < m_interposerBranches.size(); ++i){
+            int k = m_inductorState[i];
+            if(k == -1) continue;
+            const PDNBranch &b = ckt.branches[m_interposerBranches[i]];
+            double v0 = (b.n0 == PDN_CIRCUIT_GROUND)? 0.0 : x[m_circuitToState[b.n0]];
+            double v1 = (b.n1 == PDN_CIRCUIT_GROUND)? 0.0 : x[m_circuitToState[b.n1]];
+            x[k] = (x[k] + v0 - v1) * branchAdmittance[i];
+        }
+    };
+
+    // 2. block Arnoldi: span{R, AR, ..., A^(q-1)R} with R = (G + s0 C)^-1 B and A = (G + s0 C)^-1 C,
+    //    orthonormalised by modified Gram-Schmidt applied twice
+    std::vector<std::vector<double>> basis;
+    auto appendOrthonormal = [&](std::vector<double> &w) -> bool {
+        double initialNorm = std::sqrt(dot(w, w));
+        if(initialNorm == 0.0) return false;
+        for(int pass = 0; pass < 2; ++pass){
+            for(const std::vector<double> &q : basis){
+                double projection = dot(q, w);
+                for(int i = 0; i < m_stateCount; ++i) w[i] -= projection * q[i];
+            }
+        }
+        double norm = std::sqrt(dot(w, w));
+        if(norm <= DEFLATION_TOLERANCE * initialNorm) return false;
+        for(double &value : w) value /= norm;
+        basis.push_back(std::move(w));
+        return true;
+    };
+
+    size_t blockBegin = 0;
+    for(int p = 0; p < portCount && solved; ++p){
+        std::vector<double> w(m_stateCount, 0.0);
+        w[m_portStates[p]] = 1.0;
+        solveShifted(w);
+        appendOrthonormal(w);
+    }
+    for(int moment = 1; moment < blockMoments && solved; ++moment){
+        size_t blockEnd = basis.size();
+        if(blockBegin == blockEnd) break;
+        for(size_t col = blockBegin; col < blockEnd && solved; ++col){
+            std::vector<double> w(m_stateCount);
+            applyC(basis[col].data(), w.data());
+            solveShifted(w);
+            appendOrthonormal(w);
+        }
+        blockBegin = blockEnd;
+    }
+
+    KSPDestroy(&ksp);
+    VecDestroy(&solution);
+    VecDestroy(&rhs);
+    MatDestroy(&Y);
+
+    if(!solved){
+        std::cout << "[MOR] Shifted solve of " << m_circuit.signal << " fails" << std::endl;
+        return false;
+    }
+
+    // 3. congruence projection Gr = X^T G X, Cr = X^T C X, Br = X^T B
+    const int order = static_cast<int>(basis.size());
+    m_reducedG.assign(static_cast<size_t>(order) * order, 0.0);
+    m_reducedC.assign(static_cast<size_t>(order) * order, 0.0);
+    m_reducedB.assign(static_cast<size_t>(order) * portCount, 0.0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int j = 0; j < order; ++j){
+        std::vector<double> gx(m_stateCount), cx(m_stateCount);
+        applyG(basis[j].data(), gx.data());
+        applyC(basis[j].data(), cx.data());
+        for(int i = 0; i < order; ++i){
+            m_reducedG[i + static_cast<size_t>(j) * order] = dot(basis[i], gx);
+            m_reducedC[i + static_cast<size_t>(j) * order] = dot(basis[i], cx);
+        }
+    }
+    for(int p = 0; p < portCount; ++p){
+        for(int i = 0; i < order; ++i) m_reducedB[i + static_cast<size_t>(p) * order] = basis[i][m_portStates[p]];
+    }
+    m_order = order;
+
+    m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return true;
+}
+
+std::vector<std::complex<double>> MacromodelReducer::evaluate(double frequency) const {
+    assert(m_order > 0);
+    const int portCount = getPortCount();
+    const std::complex<double> s(0.0, 2.0 * M_PI * frequency);
+
+    std::vector<std::complex<double>> a(m_reducedG.size());
+    for(size_t i = 0; i < a.size(); ++i) a[i] = m_reducedG[i] + s * m_reducedC[i];
+    std::vector<std::complex<double>> x(m_reducedB.begin(), m_reducedB.end());
+    solveDense(a, x, m_order, portCount);
+
+    // Z = Br^T (Gr + sCr)^-1 Br
+    std::vector<std::complex<double>> z(static_cast<size_t>(portCount) * portCount);
+    for(int row = 0; row < portCount; ++row){
+        for(int col = 0; col < portCount; ++col){
+            std::complex<double> sum = 0.0;
+            for(int i = 0; i < m_order; ++i) sum += m_reducedB[i + static_cast<size_t>(row) * m_order] * x[i + static_cast<size_t>(col) * m_order];
+            z[row * portCount + col] = sum;
+        }
+    }
+    return z;
+}
+
+void MacromodelReducer::printReport(std::ostream &os) const {
+    os << "[MOR] " << m_circuit.signal << ": " << m_stateCount << " states -> " << m_order << " states, " << getPortCount() << " ports, ";
+    os << m_blockMoments << " block moments at " << m_expansionFrequency << " Hz in " << m_elapsedMs << " ms" << std::endl;
+}
+
+bool MacromodelReducer::exportSubcircuit(const std::string &filePath, const std::string &subcircuitName) const {
+    assert(m_order > 0);
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()) return false;
+
+    const int portCount = getPortCount();
+    auto threshold = [](const std::vector<double> &values){
+        double maxAbs = 0.0;
+        for(double v : values) maxAbs = std::max(maxAbs, std::fabs(v));
+        return maxAbs * EXPORT_DROP_TOLERANCE;
+    };
+    const double gThreshold = threshold(m_reducedG);
+    const double cThreshold = threshold(m_reducedC);
+    const double bThreshold = threshold(m_reducedB);
+
+    ofs << "* Reduced interposer macromodel of " << m_circuit.signal << ": " << m_stateCount << " -> " << m_order << " states" << std::endl;
+    ofs << "* each state x_j is a node obeying sum_k Gr_jk x_k + Cr_jk dx_k/dt = sum_p Br_jp I_p, port voltage V_p = sum_j Br_jp x_j" << std::endl;
+    ofs << std::scientific << std::setprecision(9);
+
+    ofs << ".SUBCKT " << subcircuitName;
+    for(const std::string &portName : m_portNames) ofs << std::endl << "+ " << portName;
+    ofs << std::endl;
+
+    // port p: a sense source in series with V_p, its current is fed back into the state equations
+    for(int p = 0; p < portCount; ++p){
+        std::vector<int> states;
+        for(int j = 0; j < m_order; ++j){
+            if(std::fabs(m_reducedB[j + static_cast<size_t>(p) * m_order]) > bThreshold) states.push_back(j);
+        }
+
+        ofs << "Vrom_p" << p << " " << m_portNames[p] << " rom_m" << p << " 0" << std::endl;
+        if(states.empty()){
+            ofs << "Erom_p" << p << " rom_m" << p << " 0 0" << std::endl;
+            continue;
+        }
+        ofs << "Erom_p" << p << " rom_m" << p << " 0 POLY(" << states.size() << ")";
+        for(int j : states) ofs << std::endl << "+ rom_x" << j << " 0";
+        ofs << std::endl << "+ 0";
+        for(int j : states) ofs << std::endl << "+ " << m_reducedB[j + static_cast<size_t>(p) * m_order];
+        ofs << std::endl;
+        for(int j : states){
+            ofs << "From_b" << j << "_" << p << " 0 rom_x" << j << " Vrom_p" << p << " " << m_reducedB[j + static_cast<size_t>(p) * m_order] << std::endl;
+        }
+    }
+
+    // dx_k/dt is the current of a unit capacitor driven to x_k, sensed by Vrom_c<k>
+    for(int k = 0; k < m_order; ++k){
+        ofs << "Rrom_x" << k << " rom_x" << k << " 0 1e12" << std::endl;
+        ofs << "Erom_h" << k << " rom_h" << k << " 0 rom_x" << k << " 0 1" << std::endl;
+        ofs << "Vrom_c" << k << " rom_h" << k << " rom_c" << k << " 0" << std::endl;
+        ofs << "Crom_c" << k << " rom_c" << k << " 0 1" << std::endl;
+    }
+
+    for(int j = 0; j < m_order; ++j){
+        for(int k = 0; k < m_order; ++k){
+            double g = m_reducedG[j + static_cast<size_t>(k) * m_order];
+            if(std::fabs(g) > gThreshold) ofs << "Grom_g" << j << "_" << k << " rom_x" << j << " 0 rom_x" << k << " 0 " << g << std::endl;
+            double c = m_reducedC[j + static_cast<size_t>(k) * m_order];
+            if(std::fabs(c) > cThreshold) ofs << "From_c" << j << "_" << k << " rom_x" << j << " 0 Vrom_c" << k << " " << c << std::endl;
+        }
+    }
+
+    ofs << ".ENDS " << subcircuitName << std::endl;
+    ofs.close();
+    return true;
+}
+
+bool MacromodelReducer::exportTouchstone(const std::string &filePath, const std::vector<double> &frequencies) const {
+    assert(m_order > 0);
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()) return false;
+
+    const int portCount = getPortCount();
+    ofs << "! Z parameters of the reduced interposer macromodel of " << m_circuit.signal << std::endl;
+    for(int p = 0; p < portCount; ++p) ofs << "! port " << (p + 1) << ": " << m_portNames[p] << std::endl;
+    ofs << "# Hz Z RI R 1" << std::endl;
+    ofs << std::scientific << std::setprecision(9);
+
+    // Z is symmetric, so the column-major order of two-port files and the row-major order of larger ones coincide
+    for(double frequency : frequencies){
+        std::vector<std::complex<double>> z = evaluate(frequency);
+        ofs << frequency;
+        for(int row = 0; row < portCount; ++row){
+            for(int col = 0; col < portCount; ++col){
+                bool newLine = (portCount > 2) && (col % 4 == 0) && !(row == 0 && col == 0);
+                if(newLine) ofs << std::endl;
+                const std::complex<double> &value = z[row * portCount + col];
+                ofs << " " << value.real() << " " << value.imag();
+            }
+        }
+        ofs << std::endl;
+    }
+
+    ofs.close();
+    return true;
+}
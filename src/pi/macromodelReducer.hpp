@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 19:08:37
+//  Module Name:        macromodelReducer.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        PRIMA-style model-order reduction of the interposer part of
+//                      an extracted PDNCircuit (TSVs, metal edges, vias, uBumps and
+//                      grid capacitance) to a port macromodel. The ports are the
+//                      interposer side of every C4 bump and every chiplet_o node.
+//                      The MNA system (G + sC)x = Bu, y = B^T x is projected by
+//                      congruence onto a block Krylov subspace expanded at a real
+//                      shift, which matches the leading moments and keeps the
+//                      reduced model passive
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __MACROMODEL_REDUCER_H__
+#define __MACROMODEL_REDUCER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <complex>
+#include <ostream>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+
+class MacromodelReducer{
+private:
+    const PDNCircuit &m_circuit;
+
+    // full MNA unknowns: voltages of the interposer nodes, then the currents of the branches that carry an inductance
+    std::vector<int> m_circuitToState;
+    std::vector<int> m_stateToCircuit;
+    std::vector<size_t> m_interposerBranches;
+    std::vector<int> m_inductorState;
+    int m_nodeStateCount;
+    int m_stateCount;
+
+    std::vector<std::string> m_portNames;
+    std::vector<int> m_portStates;
+
+    // reduced system (Gr + sCr)xr = Br u, dense and column-major, m_order x m_order and m_order x port count
+    int m_order;
+    int m_blockMoments;
+    double m_expansionFrequency;
+    std::vector<double> m_reducedG;
+    std::vector<double> m_reducedC;
+    std::vector<double> m_reducedB;
+    double m_elapsedMs;
+
+    void buildStates();
+    void applyG(const double *x, double *y) const;
+    void applyC(const double *x, double *y) const;
+
+public:
+    explicit MacromodelReducer(const PDNCircuit &circuit);
+
+    // blockMoments block moments of every port are matched around expansionFrequency (Hz, > 0: the interposer alone has
+    // no DC path to ground so the expansion cannot sit at s = 0). The reduced order is at most blockMoments x port count,
+    // columns that become linearly dependent are deflated
+    bool reduce(int blockMoments = 4, double expansionFrequency = 1e9);
+
+    inline int getPortCount() const {return static_cast<int>(m_portNames.size());}
+    inline const std::vector<std::string> &getPortNames() const {return m_portNames;}
+    inline int getFullOrder() const {return m_stateCount;}
+    inline int getReducedOrder() const {return m_order;}
+    inline double getElapsedMs() const {return m_elapsedMs;}
+
+    // port impedance matrix of the reduced model at frequency (Hz), row-major port count x port count
+    std::vector<std::complex<double>> evaluate(double frequency) const;
+
+    void printReport(std::ostream &os = std::cout) const;
+
+    // SPICE subcircuit realising the reduced equations with controlled sources, one pin per port (in port order)
+    bool exportSubcircuit(const std::string &filePath, const std::string &subcircuitName) const;
+    // Touchstone 1.0 table of the Z parameters of the reduced model, name it *.s<ports>p: readers take the port
+    // count from the extension and the "# Hz Z RI R 1" option line marks the data as Z
+    bool exportTouchstone(const std::string &filePath, const std::vector<double> &frequencies) const;
+};
+
+#endif // __MACROMODEL_REDUCER_H__
@@ -23,6 +23,9 @@
 #include <string>
 #include <ostream>
 #include <fstream>
+#include <string_view>
+#include <memory>
+#include <vector>
 
 // 2. Boost Library:
 
@@ -32,17 +35,24 @@
 #include "technology.hpp"
 #include "ballOut.hpp"
 #include "microBump.hpp"
+#include "inputTokenizer.hpp"
+#include "designSpec.hpp"
 
 MicroBump::MicroBump(): ObjectArray(0, 0), m_interposerSizeRectangle(Rectangle(0, 0, 0, 0)) {
 
 }
 
-MicroBump::MicroBump(const std::string &fileName) {
+MicroBump::MicroBump(const std::string &fileName): MicroBump(MappedFile(fileName)) {
+
+}
+
+MicroBump::MicroBump(const MappedFile &pinoutFile) {
     
-    std::ifstream file(fileName);
-    assert(file.is_open());
+    assert(pinoutFile.is_open());
+    InputTokenizer tokenizer(pinoutFile.view());
 
-    std::string lineBuffer;
+    std::string_view lineBuffer;
+    std::vector<std::string_view> splitLine;
 
     bool readMicrobump = false;
     bool readTechnology = false;
@@ -52,24 +62,9 @@ MicroBump::MicroBump(const std::string &fileName) {
     len_t pinWidth = -1, pinHeight = -1;
     len_t metalLayers = -1;
 
-    while(std::getline(file, lineBuffer)){
+    while(tokenizer.nextLine(lineBuffer)){
 
-        if (lineBuffer.empty()|| lineBuffer[0] == '#') continue; // whole line comment
-
-        
-        size_t comment_pos = lineBuffer.find_first_of("#");
-        if (comment_pos != std::string::npos) {
-                lineBuffer = lineBuffer.substr(0, comment_pos);  // Remove everything after "#"
-        }
-
-        // process line: std::cout << lineBuffer << std::endl;
-        std::vector<std::string> splitLine;
-        std::istringstream stream(lineBuffer);
-        std::string wordBuffer;
-    
-        while (stream >> wordBuffer) { // Extract words by spaces and newlines
-            splitLine.push_back(wordBuffer);
-        }
+        InputTokenizer::split(lineBuffer, splitLine);
 
         // parse TECHNOLOGY part
         if(!finishTechnologyParsing){
@@ -85,26 +80,20 @@ MicroBump::MicroBump(const std::string &fileName) {
                 assert(pinHeight == (gridHeight + 1));
                 assert(metalLayers >= 2);
 
-                this->m_width = pinWidth;
-                this->m_height = pinHeight;
-                m_interposerSizeRectangle = Rectangle(0, 0,((pinWidth > 1)? pinWidth-1 : 0), ((pinHeight > 1)? pinHeight-1 : 0));
-
-
-                this->canvas = std::vector<std::vector<SignalType>>(this->m_height, std::vector<SignalType>(this->m_width, SignalType::EMPTY));
+                initialiseInterposer(pinWidth, pinHeight);
 
                 finishTechnologyParsing = true;
                 continue;
             }
 
             
-            if(splitLine[0] == "GRID_WIDTH") gridWidth = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "GRID_HEIGHT") gridHeight = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "PIN_WIDTH") pinWidth = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "PIN_HEIGHT") pinHeight = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "LAYERS") metalLayers = std::stoi(splitLine[2]);
+            if(splitLine[0] == "GRID_WIDTH") gridWidth = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "GRID_HEIGHT") gridHeight = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "PIN_WIDTH") pinWidth = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "PIN_HEIGHT") pinHeight = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "LAYERS") metalLayers = InputTokenizer::parseInt(splitLine[2]);
             else{
-                std::cout << "[PowerX:MicroBumpParser] Error: Unrecognizted Technology details: " << lineBuffer << std::endl;
-                exit(4);
+                throw InputError("MicroBumpParser", "Unrecognizted Technology details: " + std::string(lineBuffer));
             }
 
             continue;
@@ -116,89 +105,117 @@ MicroBump::MicroBump(const std::string &fileName) {
         }
         if(!readMicrobump) continue;
         
-        if(splitLine[0] == "MICROBUMP_END"){
-            file.close();
-            break;
-        }
+        if(splitLine[0] == "MICROBUMP_END") break;
 
         if(splitLine[0] == "include"){
-            splitLine[1].erase(std::remove(splitLine[1].begin(), splitLine[1].end(), '"'), splitLine[1].end());
-            BallOut *newBallOut = new BallOut(splitLine[1]);
-
-            bool repeatedBallOut = false;
-            for(const BallOut *const &bo : this->m_allBallouts[0]){
-                if(bo->getName() == newBallOut->getName()){
-                    std::cout << "[PowerX:PinParser] Warning: Repeated ballout included: " << bo->getName() << std::endl;
-                    repeatedBallOut = true;
-                }
-            }
-            if(!repeatedBallOut){
-                m_allBallouts[0].push_back(newBallOut);
-                allSignalTypes.insert(newBallOut->allSignalTypes.begin(), newBallOut->allSignalTypes.end());
-            }
+            // the prototype is parsed once per file and shared with every later case that includes it
+            std::shared_ptr<const BallOut> cachedBallOut = BallOut::loadCached(std::string(InputTokenizer::unquote(splitLine[1])));
+
+            addBallOut(*cachedBallOut);
             
         }else if(splitLine[0] == "CHIPLET"){
 
-            BallOut *prototype = nullptr;
-            for(BallOut *&bo : m_allBallouts[0]){
-                if(bo->getName() == splitLine[1]){
-                    prototype = bo;
-                    break;
-                } 
+            BallOutRotation rotation = convertToBallOutRotation(std::string(splitLine[3]));
+            if((rotation == BallOutRotation::EMPTY) || (rotation == BallOutRotation::UNKNOWN)){
+                throw InputError("PinParser", "Unknown Rotation " + std::string(lineBuffer));
             }
 
-            if(prototype == nullptr){
-                std::cout << "[PowerX:PinParser] Error: Unknown chiplet " << lineBuffer << std::endl;
-                exit(4);
-            }
+            // "(x," and "y)" of the placement, the parenthesis and comma are glued to the numbers
+            std::string_view xText = splitLine[4];
+            while(!xText.empty() && (xText.front() == '(')) xText.remove_prefix(1);
+            while(!xText.empty() && (xText.back() == ',')) xText.remove_suffix(1);
+            len_t xDiff = InputTokenizer::parseInt(xText);
 
-            BallOutRotation rotation = convertToBallOutRotation(splitLine[3]);
-            if((rotation == BallOutRotation::EMPTY) || (rotation == BallOutRotation::UNKNOWN)){
-                std::cout << "[PowerX:PinParser] Error: Unknown Rotation " << lineBuffer << std::endl;
-                exit(4);
-            }else if(rotation != BallOutRotation::R0){
-                prototype = new BallOut(*prototype, rotation);
-                m_allBallouts[rotation].push_back(prototype);
-            }
+            std::string_view yText = splitLine[5];
+            while(!yText.empty() && (yText.back() == ')')) yText.remove_suffix(1);
+            len_t yDiff = InputTokenizer::parseInt(yText);
 
-            splitLine[4].erase(std::remove(splitLine[4].begin(), splitLine[4].end(), '('), splitLine[4].end());
-            splitLine[4].erase(std::remove(splitLine[4].begin(), splitLine[4].end(), ','), splitLine[4].end());
-            len_t xDiff = std::stoi(splitLine[4]);
+            placeChiplet(std::string(splitLine[2]), std::string(splitLine[1]), rotation, xDiff, yDiff);
 
-            splitLine[5].erase(std::remove(splitLine[5].begin(), splitLine[5].end(), ')'), splitLine[5].end());
-            len_t yDiff = std::stoi(splitLine[5]);
+        }else{
+            std::cout << "[PowerX:PinParser] Unmatch string: " << lineBuffer << std::endl;
+        }
+    }
+}
 
-            len_t instRectWidth = (prototype->getBallOutWidth() > 1)? prototype->getBallOutWidth() - 1 : 0;
-            len_t instRectHeight = (prototype->getBallOutHeight() > 1) ? prototype->getBallOutHeight() - 1 : 0;
-            Rectangle instanceRect(xDiff, yDiff, xDiff + instRectWidth, yDiff + instRectHeight);
-            assert(rec::isContained(this->m_interposerSizeRectangle, instanceRect));
+MicroBump::MicroBump(const DesignSpec &spec) {
+    initialiseInterposer(spec.gridWidth + 1, spec.gridHeight + 1);
+    for(const BallOut &ballOut : spec.ballOuts){
+        addBallOut(ballOut);
+    }
+    for(const ChipletPlacement &chiplet : spec.chiplets){
+        placeChiplet(chiplet.instanceName, chiplet.ballOutName, chiplet.rotation, chiplet.x, chiplet.y);
+    }
+}
 
-            allSignalTypes.insert(prototype->allSignalTypes.begin(), prototype->allSignalTypes.end());
-            for(const SignalType &st : prototype->allSignalTypes){
-                if(signalTypeToAllCords.count(st) == 0) signalTypeToAllCords[st] = {};
-                if(signalTypeToInstances.count(st) == 0) signalTypeToInstances[st] = {};
-                if(preplacedCords.count(st) == 0) this->preplacedCords[st] = {};
-            }
+void MicroBump::initialiseInterposer(len_t pinWidth, len_t pinHeight){
+    this->m_width = pinWidth;
+    this->m_height = pinHeight;
+    m_interposerSizeRectangle = Rectangle(0, 0,((pinWidth > 1)? pinWidth-1 : 0), ((pinHeight > 1)? pinHeight-1 : 0));
 
-            instanceToRectangleMap[splitLine[2]] = instanceRect;
-            instanceToBallOutMap[splitLine[2]] = prototype;
-            instanceToRotationMap[splitLine[2]] = rotation;
 
-            for(int j = 0; j < prototype->getBallOutHeight(); ++j){
-                for(int i = 0; i < prototype->getBallOutWidth(); ++i){
-                    Cord transformedCord(xDiff + i, yDiff + j);
-                    SignalType transformedCordType = prototype->ballOutArray[j][i];
+    this->canvas = std::vector<std::vector<SignalType>>(this->m_height, std::vector<SignalType>(this->m_width, SignalType::EMPTY));
+}
 
-                    setCanvas(transformedCord, transformedCordType);
-                    this->preplacedCords[transformedCordType].push_back(transformedCord);
+void MicroBump::addBallOut(const BallOut &prototype){
+    bool repeatedBallOut = false;
+    for(const BallOut *const &bo : this->m_allBallouts[0]){
+        if(bo->getName() == prototype.getName()){
+            std::cout << "[PowerX:PinParser] Warning: Repeated ballout included: " << bo->getName() << std::endl;
+            repeatedBallOut = true;
+        }
+    }
+    if(!repeatedBallOut){
+        BallOut *newBallOut = new BallOut(prototype);
+        m_allBallouts[0].push_back(newBallOut);
+        allSignalTypes.insert(newBallOut->allSignalTypes.begin(), newBallOut->allSignalTypes.end());
+    }
+}
 
-                    signalTypeToAllCords[transformedCordType].insert(transformedCord);
-                    signalTypeToInstances[transformedCordType].insert(splitLine[2]);
-                }
-            }
+void MicroBump::placeChiplet(const std::string &instanceName, const std::string &ballOutName, BallOutRotation rotation, len_t xDiff, len_t yDiff){
+    BallOut *prototype = nullptr;
+    for(BallOut *&bo : m_allBallouts[0]){
+        if(bo->getName() == ballOutName){
+            prototype = bo;
+            break;
+        } 
+    }
 
-        }else{
-            std::cout << "[PowerX:PinParser] Unmatch string: " << lineBuffer << std::endl;
+    if(prototype == nullptr){
+        throw InputError("PinParser", "Unknown chiplet " + ballOutName + " of instance " + instanceName);
+    }
+
+    if(rotation != BallOutRotation::R0){
+        prototype = new BallOut(*prototype, rotation);
+        m_allBallouts[rotation].push_back(prototype);
+    }
+
+    len_t instRectWidth = (prototype->getBallOutWidth() > 1)? prototype->getBallOutWidth() - 1 : 0;
+    len_t instRectHeight = (prototype->getBallOutHeight() > 1) ? prototype->getBallOutHeight() - 1 : 0;
+    Rectangle instanceRect(xDiff, yDiff, xDiff + instRectWidth, yDiff + instRectHeight);
+    assert(rec::isContained(this->m_interposerSizeRectangle, instanceRect));
+
+    allSignalTypes.insert(prototype->allSignalTypes.begin(), prototype->allSignalTypes.end());
+    for(const SignalType &st : prototype->allSignalTypes){
+        if(signalTypeToAllCords.count(st) == 0) signalTypeToAllCords[st] = {};
+        if(signalTypeToInstances.count(st) == 0) signalTypeToInstances[st] = {};
+        if(preplacedCords.count(st) == 0) this->preplacedCords[st] = {};
+    }
+
+    instanceToRectangleMap[instanceName] = instanceRect;
+    instanceToBallOutMap[instanceName] = prototype;
+    instanceToRotationMap[instanceName] = rotation;
+
+    for(int j = 0; j < prototype->getBallOutHeight(); ++j){
+        for(int i = 0; i < prototype->getBallOutWidth(); ++i){
+            Cord transformedCord(xDiff + i, yDiff + j);
+            SignalType transformedCordType = prototype->ballOutArray[j][i];
+
+            setCanvas(transformedCord, transformedCordType);
+            this->preplacedCords[transformedCordType].push_back(transformedCord);
+
+            signalTypeToAllCords[transformedCordType].insert(transformedCord);
+            signalTypeToInstances[transformedCordType].insert(instanceName);
         }
     }
 }
@@ -36,12 +36,19 @@
 #include "signalType.hpp"
 #include "ballOut.hpp"
 #include "objectArray.hpp"
+#include "inputTokenizer.hpp"
+#include "designSpec.hpp"
 
 class MicroBump: public ObjectArray{
 private:
     Rectangle m_interposerSizeRectangle;
     std::vector<BallOut *> m_allBallouts[BALLOUT_ROTATION_COUNT];
 
+    // shared by the .pinout parser and the DesignSpec constructor
+    void initialiseInterposer(len_t pinWidth, len_t pinHeight);
+    void addBallOut(const BallOut &prototype);
+    void placeChiplet(const std::string &instanceName, const std::string &ballOutName, BallOutRotation rotation, len_t xDiff, len_t yDiff);
+
 public:
     std::unordered_set<SignalType> allSignalTypes;
     std::unordered_map<SignalType, std::unordered_set<Cord>> signalTypeToAllCords;
@@ -54,6 +61,9 @@ public:
 
     MicroBump();
     explicit MicroBump(const std::string &fileName);
+    // parses the MICROBUMP section of an already mapped .pinout
+    explicit MicroBump(const MappedFile &pinoutFile);
+    explicit MicroBump(const DesignSpec &spec);
     ~MicroBump();
 
     friend bool visualiseMicroBump(const MicroBump &microBump, const Technology &tch, const std::string &filePath);
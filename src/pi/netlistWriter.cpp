@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 20:14:52
+//  Module Name:        netlistWriter.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Buffered writer for SPICE netlists. Text is collected in a
+//                      large buffer and handed to the file in big blocks, numbers
+//                      are formatted with std::to_chars (same text as the default
+//                      ostream format) and nothing is flushed per line. Physical
+//                      node names are interned once in a NodeNameTable and shared
+//                      by every signal that is exported
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <charconv>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnNode.hpp"
+#include "netlistWriter.hpp"
+
+namespace {
+    // significant digits of the default ostream floating point format
+    constexpr int DEFAULT_STREAM_PRECISION = 6;
+    // longest text of a double in general format, with sign, exponent and terminator to spare
+    constexpr size_t MAX_DOUBLE_CHARS = 32;
+}
+
+NodeNameTable::NodeNameTable(const std::vector<PDNNode> &nodes){
+    m_offsets.reserve(nodes.size() + 1);
+    // "n" + three numbers of mostly a few digits + two separators
+    m_chars.reserve(nodes.size() * 12);
+
+    char digits[16];
+    auto appendNumber = [&](long long value){
+        char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        m_chars.append(digits, end);
+    };
+
+    m_offsets.push_back(0);
+    for(const PDNNode &node : nodes){
+        m_chars.push_back('n');
+        appendNumber(node.x);
+        m_chars.push_back('_');
+        appendNumber(node.y);
+        m_chars.push_back('_');
+        appendNumber(node.layer);
+        m_offsets.push_back(m_chars.size());
+    }
+}
+
+NetlistWriter::NetlistWriter(const std::string &filePath, size_t bufferSize): m_ofs(filePath, std::ios::out | std::ios::binary), m_buffer(bufferSize), m_used(0) {
+    assert(bufferSize >= MAX_DOUBLE_CHARS);
+}
+
+NetlistWriter::~NetlistWriter(){
+    close();
+}
+
+void NetlistWriter::reserve(size_t bytes){
+    if(m_used + bytes > m_buffer.size()) flush();
+    if(bytes > m_buffer.size()) m_buffer.resize(bytes);
+}
+
+NetlistWriter &NetlistWriter::operator<<(std::string_view text){
+    // text longer than the buffer bypasses it
+    if(text.size() > m_buffer.size()){
+        flush();
+        m_ofs.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return *this;
+    }
+    reserve(text.size());
+    std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+    m_used += text.size();
+    return *this;
+}
+
+NetlistWriter &NetlistWriter::operator<<(char c){
+    reserve(1);
+    m_buffer[m_used++] = c;
+    return *this;
+}
+
+NetlistWriter &NetlistWriter::operator<<(double value){
+    reserve(MAX_DOUBLE_CHARS);
+    char *end = std::to_chars(m_buffer.data() + m_used, m_buffer.data() + m_buffer.size(), value, std::chars_format::general, DEFAULT_STREAM_PRECISION).ptr;
+    m_used = static_cast<size_t>(end - m_buffer.data());
+    return *this;
+}
+
+NetlistWriter &NetlistWriter::operator<<(const GridNodeName &node){
+    return (*this) << 'n' << node.x << '_' << node.y << '_' << node.layer;
+}
+
+void NetlistWriter::flush(){
+    if(m_used == 0) return;
+    m_ofs.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+    m_used = 0;
+}
+
+void NetlistWriter::close(){
+    if(!m_ofs.is_open()) return;
+    flush();
+    m_ofs.close();
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 20:14:52
+//  Module Name:        netlistWriter.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Buffered writer for SPICE netlists. Text is collected in a
+//                      large buffer and handed to the file in big blocks, numbers
+//                      are formatted with std::to_chars (same text as the default
+//                      ostream format) and nothing is flushed per line. Physical
+//                      node names are interned once in a NodeNameTable and shared
+//                      by every signal that is exported
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __NETLIST_WRITER_H__
+#define __NETLIST_WRITER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <charconv>
+#include <type_traits>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnNode.hpp"
+
+constexpr size_t NETLIST_WRITER_BUFFER_SIZE = 1 << 20;
+
+// the node name "n<x>_<y>_<layer>" of a grid point, written without building a std::string
+struct GridNodeName{
+    long long x;
+    long long y;
+    int layer;
+};
+
+// names of every physical node, to_string(physicalNodes[i]), stored back to back in one allocation
+class NodeNameTable{
+private:
+    std::string m_chars;
+    std::vector<size_t> m_offsets;
+
+public:
+    explicit NodeNameTable(const std::vector<PDNNode> &nodes);
+
+    inline std::string_view operator[](size_t nodeIdx) const {
+        return std::string_view(m_chars.data() + m_offsets[nodeIdx], m_offsets[nodeIdx + 1] - m_offsets[nodeIdx]);
+    }
+    inline size_t size() const {return m_offsets.size() - 1;}
+};
+
+class NetlistWriter{
+private:
+    std::ofstream m_ofs;
+    std::vector<char> m_buffer;
+    size_t m_used;
+
+    void reserve(size_t bytes);
+
+public:
+    explicit NetlistWriter(const std::string &filePath, size_t bufferSize = NETLIST_WRITER_BUFFER_SIZE);
+    ~NetlistWriter();
+
+    NetlistWriter(const NetlistWriter &other) = delete;
+    NetlistWriter &operator=(const NetlistWriter &other) = delete;
+
+    inline bool is_open() const {return m_ofs.is_open();}
+
+    NetlistWriter &operator<<(std::string_view text);
+    NetlistWriter &operator<<(char c);
+    NetlistWriter &operator<<(double value);
+    NetlistWriter &operator<<(const GridNodeName &node);
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>>>
+    NetlistWriter &operator<<(T value){
+        reserve(24);
+        char *end = std::to_chars(m_buffer.data() + m_used, m_buffer.data() + m_buffer.size(), value).ptr;
+        m_used = static_cast<size_t>(end - m_buffer.data());
+        return *this;
+    }
+
+    void flush();
+    void close();
+};
+
+#endif // __NETLIST_WRITER_H__
@@ -22,11 +22,10 @@
 
 // Dependencies
 // 1. C++ STL:
-#include <cassert>
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <regex>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 // 2. Boost Library:
@@ -34,6 +33,7 @@
 // 3. Texo Library:
 #include "cord.hpp"
 #include "objectArray.hpp"
+#include "inputTokenizer.hpp"
 
 ObjectArray::ObjectArray(): m_width(0), m_height(0) {
 
@@ -44,56 +44,39 @@ ObjectArray::ObjectArray(int width, int height): m_width(width), m_height(height
 }
 
 void ObjectArray::readBlockages(const std::string &fileName){
-    std::ifstream file(fileName);
-    assert(file.is_open());
-
-    // lambda for checking if a string is a valid integer
-    auto isInteger = [](const std::string& s) -> bool {
-        try {
-            size_t pos;
-            std::stoi(s, &pos);
-            return pos == s.size();
-        } catch (...) {
-            return false;
-        }
-    };
-
-    // Lambda to trim leading and trailing whitespace
-    auto trimWhiteSpace = [](const std::string& s) -> std::string {
-        size_t start = 0;
-        while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start]))) {
-            ++start;
-        }
-
-        size_t end = s.size();
-        while (end > start && std::isspace(static_cast<unsigned char>(s[end - 1]))) {
-            --end;
-        }
-
-        return s.substr(start, end - start);
+    MappedFile file(fileName);
+    if(!file.is_open()) throw InputError("ObjectArray", "Cannot open preplace file: " + fileName);
+    InputTokenizer tokenizer(file.view());
+
+    // consumes "Cord(x, y)" from the front of text, whitespace is allowed around every token
+    auto consumeCord = [](std::string_view &text, std::string_view &sx, std::string_view &sy) -> bool {
+        text = InputTokenizer::trim(text);
+        if(text.substr(0, 5) != "Cord(") return false;
+        text.remove_prefix(5);
+
+        size_t comma = text.find(',');
+        if(comma == std::string_view::npos) return false;
+        sx = InputTokenizer::trim(text.substr(0, comma));
+        text.remove_prefix(comma + 1);
+
+        size_t close = text.find(')');
+        if(close == std::string_view::npos) return false;
+        sy = InputTokenizer::trim(text.substr(0, close));
+        text.remove_prefix(close + 1);
+        return !sx.empty() && !sy.empty();
     };
 
     bool readPreplace = false;
     bool readFirstSP = false;
     SignalType processingSP;
 
-    std::string lineBuffer;
+    std::string_view lineBuffer;
     std::unordered_set<Cord> allPreplaceCords;
     std::unordered_set<Cord> preplaceCord;
     
-    const std::string signalPrefix = "SIGNAL:";
-    std::regex singlePattern(R"(^\s*Cord\(\s*([^\s,]+)\s*,\s*([^\s\)]+)\s*\)\s*$)");
-    std::regex doublePattern(R"(^\s*Cord\(\s*([^\s,]+)\s*,\s*([^\s\)]+)\s*\)\s*to\s*Cord\(\s*([^\s,]+)\s*,\s*([^\s\)]+)\s*\)\s*$)");
-    std::smatch match;
-
-    while(std::getline(file, lineBuffer)){
-        if (lineBuffer.empty()|| lineBuffer[0] == '#') continue; // whole line comment
-        
-        size_t comment_pos = lineBuffer.find_first_of("#");
-        if (comment_pos != std::string::npos) {
-                lineBuffer = lineBuffer.substr(0, comment_pos);  // Remove everything after "#"
-        }
+    constexpr std::string_view signalPrefix = "SIGNAL:";
 
+    while(tokenizer.nextLine(lineBuffer)){
         if(lineBuffer == "BEGIN_PREPLACE"){
             readPreplace = true; 
             continue;
@@ -105,7 +88,7 @@ void ObjectArray::readBlockages(const std::string &fileName){
         }
         
         std::size_t pos = lineBuffer.find(signalPrefix);
-        if (pos != std::string::npos) {
+        if (pos != std::string_view::npos) {
 
             if(readFirstSP){
                 // write latched data
@@ -115,39 +98,41 @@ void ObjectArray::readBlockages(const std::string &fileName){
                 readFirstSP = true;
             }
 
-            std::string rest = lineBuffer.substr(pos + signalPrefix.length());
-            std::string signalTypeStr = trimWhiteSpace(rest);
+            std::string signalTypeStr(InputTokenizer::trim(lineBuffer.substr(pos + signalPrefix.length())));
             processingSP = convertToSignalType(signalTypeStr);
             
             if(processingSP == SignalType::UNKNOWN){
-                std::cout << "[PowerX:ObjectArray] Error: Unknown preplace SignalType " << signalTypeStr << std::endl;
-                exit(4);
+                throw InputError("ObjectArray", "Unknown preplace SignalType " + signalTypeStr);
             }
 
             continue;
         }
 
+        std::string_view rest = lineBuffer;
+        std::string_view sx1, sy1, sx2, sy2;
+        if(!consumeCord(rest, sx1, sy1)){
+            throw InputError("ObjectArray", "Blockage format unrecognized: " + std::string(lineBuffer));
+        }
 
+        rest = InputTokenizer::trim(rest);
+        bool singleCord = rest.empty();
+        bool lineOfCords = false;
+        if(!singleCord && (rest.substr(0, 2) == "to")){
+            rest.remove_prefix(2);
+            lineOfCords = consumeCord(rest, sx2, sy2) && InputTokenizer::trim(rest).empty();
+        }
 
-        if(std::regex_match(lineBuffer, match, singlePattern)){ // Cord(x, y)
-            std::string sx = match[1];
-            std::string sy = match[2];
-
-            if (!isInteger(sx) || !isInteger(sy)) {
-                std::cout << "[PowerX:ObjectArray] Error: Coordinates must be integers: " << lineBuffer << std::endl;
-                exit(4);
+        if(singleCord){ // Cord(x, y)
+            int x, y;
+            if (!InputTokenizer::toInteger(sx1, x) || !InputTokenizer::toInteger(sy1, y)) {
+                throw InputError("ObjectArray", "Coordinates must be integers: " + std::string(lineBuffer));
             }
 
-            int x = std::stoi(sx);
-            int y = std::stoi(sy);
             if (x < 0 || x >= m_width) {
-                std::cout << "[PowerX:ObjectArray] Error: X Coordinates must be within range: [0, " << m_width-1 << "]: " << lineBuffer << std::endl;
-                exit(4);
-
+                throw InputError("ObjectArray", "X Coordinates must be within range: [0, " + std::to_string(m_width-1) + "]: " + std::string(lineBuffer));
             }
             if(y < 0 || y >= m_height){
-                std::cout << "[PowerX:ObjectArray] Error: Y Coordinates must be within range: [0, " << m_height-1 << "]: " << lineBuffer << std::endl;
-                exit(4);
+                throw InputError("ObjectArray", "Y Coordinates must be within range: [0, " + std::to_string(m_height-1) + "]: " + std::string(lineBuffer));
             }
             Cord newCord(x, y);
             if(allPreplaceCords.count(newCord) == 0){
@@ -156,28 +141,17 @@ void ObjectArray::readBlockages(const std::string &fileName){
             }
 
 
-        }else if(std::regex_match(lineBuffer, match, doublePattern)){ // Cord(x1, y1) to Cord(x2, y2)
-            std::string sx1 = match[1];
-            std::string sy1 = match[2];
-            std::string sx2 = match[3];
-            std::string sy2 = match[4];
-
-            if (!isInteger(sx1) || !isInteger(sy1) || !isInteger(sx2) || !isInteger(sy2)) {
-                std::cout << "[PowerX:ObjectArray] Error: Coordinates must be integers: " << lineBuffer << std::endl;
-                exit(4);
+        }else if(lineOfCords){ // Cord(x1, y1) to Cord(x2, y2)
+            int x1, y1, x2, y2;
+            if (!InputTokenizer::toInteger(sx1, x1) || !InputTokenizer::toInteger(sy1, y1) || !InputTokenizer::toInteger(sx2, x2) || !InputTokenizer::toInteger(sy2, y2)) {
+                throw InputError("ObjectArray", "Coordinates must be integers: " + std::string(lineBuffer));
             }
-            int x1 = std::stoi(sx1);
-            int y1 = std::stoi(sy1);
-            int x2 = std::stoi(sx2);
-            int y2 = std::stoi(sy2);
 
             if(x1 < 0 || x1 >= m_width || x2 < 0 || x2 >= m_width){
-                std::cout << "[PowerX:ObjectArray] Error: X Coordinates must be within range: [0, " << m_width-1 << "]: " << lineBuffer << std::endl;
-                exit(4); 
+                throw InputError("ObjectArray", "X Coordinates must be within range: [0, " + std::to_string(m_width-1) + "]: " + std::string(lineBuffer));
             }
             if(y1 < 0 || y1 >= m_height || y2 < 0 || y2 >= m_height){
-                std::cout << "[PowerX:ObjectArray] Error: Y Coordinates must be within range: [0, " << m_height-1 << "]: " << lineBuffer << std::endl;
-                exit(4);
+                throw InputError("ObjectArray", "Y Coordinates must be within range: [0, " + std::to_string(m_height-1) + "]: " + std::string(lineBuffer));
             }
             if(x1 == x2){ // vertical line
                 if(y1 > y2) std::swap(y1, y2);
@@ -198,13 +172,11 @@ void ObjectArray::readBlockages(const std::string &fileName){
                     }
                 }
             }else{
-                std::cout << "[PowerX:ObjectArray] In Line mode, Cord(x1, y1) to Cord(x2, y2), only horizontal or vertical line accepted" << lineBuffer << std::endl;
-                exit(4);
+                throw InputError("ObjectArray", "In Line mode, Cord(x1, y1) to Cord(x2, y2), only horizontal or vertical line accepted: " + std::string(lineBuffer));
             }
 
         }else{
-            std::cout << "[PowerX:ObjectArray] Error: Blockage format unrecognized: " << lineBuffer << std::endl;
-            exit(4);
+            throw InputError("ObjectArray", "Blockage format unrecognized: " + std::string(lineBuffer));
         }
     }
 
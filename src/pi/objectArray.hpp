@@ -47,6 +47,7 @@ public:
     ObjectArray();
     explicit ObjectArray(int width, int height);
     
+    // throws InputError on a missing or malformed preplace file
     void readBlockages(const std::string &fileName);
 
     inline int getWidth() const {return this->m_width;}
@@ -0,0 +1,201 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 15:41:09
+//  Module Name:        pdnCircuit.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The extracted equivalent circuit of one signal of the
+//                      physical implementation, the same network that
+//                      exportPhysicalToCircuitBySignal writes out, held as a list
+//                      of series R-L-C branches for the in-process analysers
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <string>
+#include <vector>
+#include <complex>
+#include <iostream>
+#include <ostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "cord.hpp"
+#include "rectangle.hpp"
+#include "signalType.hpp"
+#include "technology.hpp"
+#include "eqCktExtractor.hpp"
+#include "ballOut.hpp"
+#include "pdnNode.hpp"
+#include "pdnEdge.hpp"
+#include "powerDistributionNetwork.hpp"
+#include "pdnCircuit.hpp"
+
+// the unit suffixes used by exportPhysicalToCircuitBySignal
+namespace {
+    constexpr double UOHM = 1e-6;
+    constexpr double MOHM = 1e-3;
+    constexpr double PH = 1e-12;
+    constexpr double NH = 1e-9;
+    constexpr double FF = 1e-15;
+    constexpr double PF = 1e-12;
+    constexpr double NF = 1e-9;
+    constexpr double UF = 1e-6;
+}
+
+std::ostream &operator<<(std::ostream &os, PDNBranchType type){
+    switch (type){
+        case PDNBranchType::UBUMP:          os << "UBUMP"; break;
+        case PDNBranchType::VIA:            os << "VIA"; break;
+        case PDNBranchType::EDGE:           os << "EDGE"; break;
+        case PDNBranchType::TSV:            os << "TSV"; break;
+        case PDNBranchType::C4:             os << "C4"; break;
+        case PDNBranchType::GRID_CAP:       os << "GRID_CAP"; break;
+        case PDNBranchType::CHIPLET_LOAD:   os << "CHIPLET_LOAD"; break;
+        case PDNBranchType::PCB:            os << "PCB"; break;
+        default:                            os << "UNKNOWN"; break;
+    }
+    return os;
+}
+
+std::complex<double> PDNBranch::getAdmittance(double omega) const {
+    if(capacitance != 0.0){
+        if(omega == 0.0) return {0.0, 0.0};
+        return 1.0 / std::complex<double>(resistance, omega * inductance - 1.0 / (omega * capacitance));
+    }
+    return 1.0 / std::complex<double>(resistance, omega * inductance);
+}
+
+PDNCircuit::PDNCircuit(): signal(SignalType::EMPTY), supplyVoltage(1.0), vrmNode(PDN_CIRCUIT_GROUND), supplyNode(PDN_CIRCUIT_GROUND) {}
+
+int PDNCircuit::addNode(const std::string &name){
+    nodeNames.push_back(name);
+    return static_cast<int>(nodeNames.size()) - 1;
+}
+
+int PDNCircuit::getPhysicalNode(const PowerDistributionNetwork &pdn, size_t physicalNodeIdx){
+    int &circuitNode = m_physicalToCircuit[physicalNodeIdx];
+    if(circuitNode == PDN_CIRCUIT_GROUND) circuitNode = addNode(to_string(pdn.physicalNodes[physicalNodeIdx]));
+    return circuitNode;
+}
+
+void PDNCircuit::addBranch(PDNBranchType type, int n0, int n1, double resistance, double inductance, double capacitance, pdn_edge_t edge){
+    // a branch conducting DC must have a resistance, otherwise its admittance is unbounded
+    assert((resistance > 0.0) || (capacitance != 0.0));
+    branches.push_back(PDNBranch{type, n0, n1, resistance, inductance, capacitance, edge});
+}
+
+void PDNCircuit::build(const PowerDistributionNetwork &pdn, SignalType st, const Technology &tch, const EqCktExtractor &extor){
+    signal = st;
+    supplyVoltage = 1.0;
+    nodeNames.clear();
+    branches.clear();
+    portNames.clear();
+    portNodes.clear();
+    portLoadNodes.clear();
+    portCurrents.clear();
+    portBumpNodes.clear();
+    m_physicalToCircuit.assign(pdn.physicalNodes.size(), PDN_CIRCUIT_GROUND);
+
+    // PCB model, vrm_high is folded into the series source of the branch from vrm_low to pcb_out
+    vrmNode = addNode("vrm_low");
+    supplyNode = addNode("pcb_out");
+    addBranch(PDNBranchType::PCB, vrmNode, supplyNode, tch.getPCBResistance() * UOHM, tch.getPCBInductance() * PH, 0.0);
+    branches.back().seriesVoltage = supplyVoltage;
+    addBranch(PDNBranchType::PCB, vrmNode, PDN_CIRCUIT_GROUND, tch.getPCBResistance() * UOHM, tch.getPCBInductance() * PH, 0.0);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, tch.getPCBDecapResistance() * UOHM, tch.getPCBDecapInductance() * NH, tch.getPCBDecapCapacitance() * UF);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, 0.05, 0.0, 1.0 * UF);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, 0.1, 0.0, 100.0 * NF);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, 0.2, 0.0, 10.0 * NF);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, 0.3, 0.0, 1.0 * NF);
+    addBranch(PDNBranchType::PCB, supplyNode, PDN_CIRCUIT_GROUND, 0.5, 0.0, 100.0 * PF);
+
+    // C4 bumps and the TSVs of every pin in their cluster
+    auto clusterIt = pdn.c4.signalTypeToAllClusters.find(st);
+    if(clusterIt != pdn.c4.signalTypeToAllClusters.end()){
+        for(const C4PinCluster *cluster : clusterIt->second){
+            const Cord &rep = cluster->representation;
+            int c4Node = addNode("n" + std::to_string(rep.x()) + "_" + std::to_string(rep.y()) + "_" + std::to_string(pdn.getMetalLayerCount()));
+            addBranch(PDNBranchType::C4, supplyNode, c4Node, tch.getC4Resistance() * MOHM, tch.getC4Inductance() * PH, 0.0);
+            for(const Cord &c : cluster->pins){
+                int pinNode = getPhysicalNode(pdn, pdn.calPhysicalNodeIdx(pdn.getc4ConnectedmetalLayerIdx(), c.y(), c.x()));
+                addBranch(PDNBranchType::TSV, c4Node, pinNode, tch.getTsvResistance() * MOHM, tch.getTsvInductance() * PH, 0.0);
+            }
+        }
+    }
+
+    // metal edges and vias of the signal
+    for(size_t e = 0; e < pdn.pdnEdges.size(); ++e){
+        const PDNEdge &edge = pdn.pdnEdges[e];
+        if(edge.signal != st) continue;
+        int n0 = getPhysicalNode(pdn, edge.n0);
+        int n1 = getPhysicalNode(pdn, edge.n1);
+        if(edge.isVia){
+            addBranch(PDNBranchType::VIA, n0, n1, extor.getInterposerViaResistance() * MOHM, extor.getInterposerViaInductance() * PH, 0.0, static_cast<pdn_edge_t>(e));
+        }else{
+            addBranch(PDNBranchType::EDGE, n0, n1, 2 * extor.getInterposerResistance() * MOHM, 2 * extor.getInterposerInductance() * PH, 0.0, static_cast<pdn_edge_t>(e));
+        }
+    }
+
+    // chiplet ports: uBumps into chiplet_o, then the chiplet's series R-L to the die node that carries the on-die capacitance and the load
+    auto chipletIt = pdn.phyChipletNames.find(st);
+    if(chipletIt != pdn.phyChipletNames.end()){
+        for(const std::string &chipletName : chipletIt->second){
+            int portNode = addNode(chipletName + "_o");
+            const BallOut *bt = pdn.uBump.instanceToBallOutMap.at(chipletName);
+            assert(bt != nullptr);
+
+            std::vector<int> bumpNodes;
+            for(size_t physicalNodeIdx : pdn.phyChipletNodes.at(chipletName)){
+                int bumpNode = getPhysicalNode(pdn, physicalNodeIdx);
+                bumpNodes.push_back(bumpNode);
+                addBranch(PDNBranchType::UBUMP, portNode, bumpNode, tch.getMicrobumpResistance() * MOHM, tch.getMicrobumpInductance() * PH, 0.0);
+            }
+            // a ballout without SERIES_RESISTANCE is a short, the load then sits on the port node itself
+            int dieNode = portNode;
+            if(bt->getSeriesResistance() > 0.0){
+                dieNode = addNode(chipletName + "_die");
+                addBranch(PDNBranchType::CHIPLET_LOAD, portNode, dieNode, bt->getSeriesResistance() * MOHM, bt->getSeriesInductance() * NH, 0.0);
+            }else if(bt->getSeriesInductance() != 0.0){
+                std::cout << "[PowerX:PDNCircuit] Warning: Chiplet " << chipletName << " has no series resistance, its series inductance is dropped" << std::endl;
+            }
+            if(bt->getShuntCapacitance() != 0.0){
+                addBranch(PDNBranchType::CHIPLET_LOAD, dieNode, PDN_CIRCUIT_GROUND, 0.0, 0.0, bt->getShuntCapacitance() * PF);
+            }
+
+            portNames.push_back(chipletName);
+            portNodes.push_back(portNode);
+            portLoadNodes.push_back(dieNode);
+            portCurrents.push_back(bt->getMaxCurrent());
+            portBumpNodes.push_back(bumpNodes);
+        }
+    }
+
+    // grid capacitance of every physical node that belongs to the network
+    const int pinXMax = pdn.physicalGridWidth - 1;
+    const int pinYMax = pdn.physicalGridHeight - 1;
+    for(size_t physicalNodeIdx = 0; physicalNodeIdx < m_physicalToCircuit.size(); ++physicalNodeIdx){
+        int circuitNode = m_physicalToCircuit[physicalNodeIdx];
+        if(circuitNode == PDN_CIRCUIT_GROUND) continue;
+
+        const PDNNode &node = pdn.physicalNodes[physicalNodeIdx];
+        bool xOnEdge = (node.x == 0) || (node.x == pinXMax);
+        bool yOnEdge = (node.y == 0) || (node.y == pinYMax);
+        double cellCapacitance;
+        if(xOnEdge && yOnEdge) cellCapacitance = extor.getInterposerCapacitanceCornerCell();
+        else if(xOnEdge || yOnEdge) cellCapacitance = extor.getInterposerCapacitanceEdgeCell();
+        else cellCapacitance = extor.getInterposerCapacitanceCenterCell();
+
+        addBranch(PDNBranchType::GRID_CAP, circuitNode, PDN_CIRCUIT_GROUND, 0.0, 0.0, cellCapacitance / 4.0 * FF);
+    }
+}
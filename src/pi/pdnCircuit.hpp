@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 15:41:09
+//  Module Name:        pdnCircuit.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The extracted equivalent circuit of one signal of the
+//                      physical implementation, the same network that
+//                      exportPhysicalToCircuitBySignal writes out, held as a list
+//                      of series R-L-C branches for the in-process analysers
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __PDN_CIRCUIT_H__
+#define __PDN_CIRCUIT_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <complex>
+#include <ostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "technology.hpp"
+#include "eqCktExtractor.hpp"
+#include "pdnNode.hpp"
+#include "powerDistributionNetwork.hpp"
+
+constexpr int PDN_CIRCUIT_GROUND = -1;
+
+enum class PDNBranchType : uint8_t{
+    UBUMP, VIA, EDGE, TSV, C4, GRID_CAP, CHIPLET_LOAD, PCB
+};
+
+std::ostream &operator<<(std::ostream &os, PDNBranchType type);
+
+// a resistor, inductor, capacitor and ideal voltage source in series between n0 and n1, all values in SI units
+// an absent element has value 0 (a capacitor of 0 is treated as a short, not an open)
+struct PDNBranch{
+    PDNBranchType type;
+    int n0;
+    int n1;
+    double resistance;
+    double inductance;
+    double capacitance;
+    // the physical edge realised by this branch, PDN_EDGE_NONE for lumped components
+    pdn_edge_t edge;
+    // series source raising n0 towards n1, only the VRM carries one (it is a short in AC)
+    double seriesVoltage = 0.0;
+
+    inline bool conductsDC() const {return capacitance == 0.0;}
+    std::complex<double> getAdmittance(double omega) const;
+};
+
+class PDNCircuit{
+private:
+    std::vector<int> m_physicalToCircuit;
+
+    int addNode(const std::string &name);
+    int getPhysicalNode(const PowerDistributionNetwork &pdn, size_t physicalNodeIdx);
+    void addBranch(PDNBranchType type, int n0, int n1, double resistance, double inductance, double capacitance, pdn_edge_t edge = PDN_EDGE_NONE);
+
+public:
+    SignalType signal;
+    double supplyVoltage;
+
+    std::vector<std::string> nodeNames;
+    std::vector<PDNBranch> branches;
+
+    // VRM low terminal (the source sits in series on the branch towards pcb_out) and PCB output,
+    // where HSPICE measures the drop from
+    int vrmNode;
+    int supplyNode;
+
+    // one port per chiplet of the signal: its uBump side node (chiplet_o), the on-die node behind the chiplet's
+    // series R-L where the load current is drawn (the port node itself when the ballout has no series resistance),
+    // its maximum current (A) and the circuit nodes of its uBumps
+    std::vector<std::string> portNames;
+    std::vector<int> portNodes;
+    std::vector<int> portLoadNodes;
+    std::vector<double> portCurrents;
+    std::vector<std::vector<int>> portBumpNodes;
+
+    PDNCircuit();
+    void build(const PowerDistributionNetwork &pdn, SignalType st, const Technology &tch, const EqCktExtractor &extor);
+
+    inline int getNodeCount() const {return static_cast<int>(nodeNames.size());}
+    inline int getPortCount() const {return static_cast<int>(portNodes.size());}
+};
+
+#endif // __PDN_CIRCUIT_H__
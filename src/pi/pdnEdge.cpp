@@ -24,7 +24,7 @@
 #include "signalType.hpp"
 #include "pdnEdge.hpp"
 
-PDNEdge::PDNEdge(): n0(nullptr), n1(nullptr), signal(SignalType::EMPTY), isVia(false) {}
+PDNEdge::PDNEdge(): n0(0), n1(0), signal(SignalType::EMPTY), isVia(false) {}
 
-PDNEdge::PDNEdge(PDNNode *n0, PDNNode *n1): n0(n0), n1(n1), signal(SignalType::EMPTY), isVia(false) {}
+PDNEdge::PDNEdge(size_t n0, size_t n1): n0(n0), n1(n1), signal(SignalType::EMPTY), isVia(false) {}
 
@@ -20,6 +20,7 @@
 
 // Dependencies
 // 1. C++ STL:
+#include <cstddef>
 
 // 2. Boost Library:
 
@@ -27,19 +28,20 @@
 #include "cord.hpp"
 #include "signalType.hpp"
 
-class PDNNode;
-
 class PDNEdge{
 public:
 
-    PDNNode *n0;
-    PDNNode *n1;
+    // node ids in the owning network's node array
+    size_t n0;
+    size_t n1;
 
     SignalType signal;
     bool isVia;
 
     PDNEdge();
-    PDNEdge(PDNNode *n0, PDNNode *n1);
+    PDNEdge(size_t n0, size_t n1);
+
+    inline size_t getOtherNode(size_t node) const {return (n0 == node)? n1 : n0;}
 
 };
 
@@ -17,6 +17,7 @@
 
 // Dependencies
 // 1. C++ STL:
+#include <string>
 
 // 2. Boost Library:
 
@@ -26,16 +27,16 @@
 #include "pdnNode.hpp"
 
 PDNNode::PDNNode(): layer(LEN_T_MAX), y(LEN_T_MAX), x(LEN_T_MAX), signal(SignalType::EMPTY),
-    north(nullptr), south(nullptr), east(nullptr), west(nullptr), up(nullptr), down(nullptr) {}
+    north(PDN_EDGE_NONE), south(PDN_EDGE_NONE), east(PDN_EDGE_NONE), west(PDN_EDGE_NONE), up(PDN_EDGE_NONE), down(PDN_EDGE_NONE) {}
 
 PDNNode::PDNNode(len_t layer, len_t x, len_t y): layer(layer), y(y), x(x), signal(SignalType::EMPTY),
-    north(nullptr), south(nullptr), east(nullptr), west(nullptr), up(nullptr), down(nullptr) {}
+    north(PDN_EDGE_NONE), south(PDN_EDGE_NONE), east(PDN_EDGE_NONE), west(PDN_EDGE_NONE), up(PDN_EDGE_NONE), down(PDN_EDGE_NONE) {}
 
 Cord PDNNode::getLayerCord() const {
     return Cord(x, y);
 }
 
-std::string to_string(PDNNode *node){
-    return "n" + std::to_string(node->x) + "_" + std::to_string(node->y) + "_" + std::to_string(node->layer);
+std::string to_string(const PDNNode &node){
+    return "n" + std::to_string(node.x) + "_" + std::to_string(node.y) + "_" + std::to_string(node.layer);
 }
 
@@ -20,6 +20,8 @@
 
 // Dependencies
 // 1. C++ STL:
+#include <cstdint>
+#include <string>
 
 // 2. Boost Library:
 
@@ -27,7 +29,9 @@
 #include "cord.hpp"
 #include "signalType.hpp"
 
-class PDNEdge;
+// index of an edge in the owning network's edge array
+typedef int32_t pdn_edge_t;
+constexpr pdn_edge_t PDN_EDGE_NONE = -1;
 
 class PDNNode{
 public:
@@ -38,13 +42,13 @@ public:
 
     SignalType signal;
 
-    PDNEdge *north;
-    PDNEdge *south;
-    PDNEdge *east;
-    PDNEdge *west;
+    pdn_edge_t north;
+    pdn_edge_t south;
+    pdn_edge_t east;
+    pdn_edge_t west;
 
-    PDNEdge *up;
-    PDNEdge *down;
+    pdn_edge_t up;
+    pdn_edge_t down;
 
     PDNNode();
     PDNNode(len_t layer, len_t x, len_t y);
@@ -54,6 +58,6 @@ public:
 
 };
 
-std::string to_string(PDNNode *node);
+std::string to_string(const PDNNode &node);
 
 #endif // __PDN_NODE_H__
\ No newline at end of file
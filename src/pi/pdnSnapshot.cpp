@@ -0,0 +1,218 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 21:03:40
+//  Module Name:        pdnSnapshot.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Versioned binary snapshot of the metal and via canvases of a
+//                      PowerDistributionNetwork. A fixed 64 byte header carries the
+//                      dimensions and a hash of the case, followed by every metal
+//                      cell then every via cell in (layer, y, x) order, one byte or
+//                      one nibble per cell. PDNSnapshot maps a file read-only and
+//                      indexes the cells in place, nothing is parsed
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "objectArray.hpp"
+#include "pdnSnapshot.hpp"
+
+// 4. POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(EnumTraits<SignalType>::count <= 16, "BINARY_PACKED snapshots store a SignalType in 4 bits");
+
+PDNSnapshot::PDNSnapshot(): m_fd(-1), m_data(nullptr), m_size(0), m_header(nullptr), m_cells(nullptr) {}
+
+PDNSnapshot::~PDNSnapshot(){
+    close();
+}
+
+bool PDNSnapshot::isSnapshotFile(const std::string &fileName){
+    std::ifstream ifs(fileName, std::ios::in | std::ios::binary);
+    char magic[sizeof(PDN_SNAPSHOT_MAGIC)];
+    if(!ifs.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, PDN_SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
+
+bool PDNSnapshot::write(const std::string &fileName, const std::vector<ObjectArray> &metalLayers, const std::vector<ObjectArray> &viaLayers, uint64_t caseHash, bool packed){
+    assert(!metalLayers.empty() && !metalLayers[0].canvas.empty());
+
+    PDNSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PDN_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = PDN_SNAPSHOT_VERSION;
+    header.packed = packed? 1 : 0;
+    header.metalLayerCount = metalLayers.size();
+    header.gridHeight = metalLayers[0].canvas.size();
+    header.gridWidth = metalLayers[0].canvas[0].size();
+    header.viaLayerCount = viaLayers.size();
+    header.pinHeight = viaLayers.empty()? 0 : viaLayers[0].canvas.size();
+    header.pinWidth = viaLayers.empty()? 0 : viaLayers[0].canvas[0].size();
+    header.caseHash = caseHash;
+    header.cellCount = uint64_t(header.metalLayerCount) * header.gridHeight * header.gridWidth +
+                       uint64_t(header.viaLayerCount) * header.pinHeight * header.pinWidth;
+    header.payloadBytes = packed? (header.cellCount + 1) / 2 : header.cellCount;
+
+    std::vector<uint8_t> payload(header.payloadBytes, 0);
+    size_t cellIdx = 0;
+    auto appendCanvas = [&](const std::vector<std::vector<SignalType>> &canvas){
+        for(const std::vector<SignalType> &row : canvas){
+            for(SignalType st : row){
+                uint8_t value = static_cast<uint8_t>(st);
+                if(packed) payload[cellIdx >> 1] |= (cellIdx & 1)? uint8_t(value << 4) : value;
+                else payload[cellIdx] = value;
+                ++cellIdx;
+            }
+        }
+    };
+    for(const ObjectArray &layer : metalLayers) appendCanvas(layer.canvas);
+    for(const ObjectArray &layer : viaLayers) appendCanvas(layer.canvas);
+    assert(cellIdx == header.cellCount);
+
+    std::ofstream ofs(fileName, std::ios::out | std::ios::binary);
+    assert(ofs.is_open());
+    if(!ofs.is_open()) return false;
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+    ofs.close();
+    return true;
+}
+
+bool PDNSnapshot::countCells(const PDNSnapshotHeader &header, uint64_t &cellCount){
+    // every product is checked, dimensions come straight from the file
+    auto multiply = [](uint64_t a, uint64_t b, uint64_t &product) -> bool {
+        if((a != 0) && (b > UINT64_MAX / a)) return false;
+        product = a * b;
+        return true;
+    };
+    uint64_t metalCells, viaCells;
+    if(!multiply(header.metalLayerCount, header.gridHeight, metalCells) || !multiply(metalCells, header.gridWidth, metalCells)) return false;
+    if(!multiply(header.viaLayerCount, header.pinHeight, viaCells) || !multiply(viaCells, header.pinWidth, viaCells)) return false;
+    if(metalCells > UINT64_MAX - viaCells) return false;
+    cellCount = metalCells + viaCells;
+    return true;
+}
+
+bool PDNSnapshot::open(const std::string &fileName){
+    close();
+
+    m_fd = ::open(fileName.c_str(), O_RDONLY);
+    if(m_fd < 0){
+        std::cout << "[PowerX:Snapshot] Error: Cannot open snapshot: " << fileName << std::endl;
+        return false;
+    }
+
+    struct stat fileStat;
+    if(fstat(m_fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(PDNSnapshotHeader)){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot too short: " << fileName << std::endl;
+        close();
+        return false;
+    }
+    m_size = static_cast<size_t>(fileStat.st_size);
+
+    void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if(mapping == MAP_FAILED){
+        std::cout << "[PowerX:Snapshot] Error: Cannot map snapshot: " << fileName << std::endl;
+        m_size = 0;
+        close();
+        return false;
+    }
+    m_data = static_cast<const uint8_t *>(mapping);
+
+    const PDNSnapshotHeader *header = reinterpret_cast<const PDNSnapshotHeader *>(m_data);
+    if(std::memcmp(header->magic, PDN_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0){
+        std::cout << "[PowerX:Snapshot] Error: Not a snapshot file: " << fileName << std::endl;
+        close();
+        return false;
+    }
+    if(header->version != PDN_SNAPSHOT_VERSION){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot version " << header->version << " unsupported, expects " << PDN_SNAPSHOT_VERSION << std::endl;
+        close();
+        return false;
+    }
+    if(header->packed > 1){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot packing flag " << header->packed << " invalid: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    // the cell count and payload size follow from the dimensions, a header disagreeing with them is corrupted
+    uint64_t cellCount = 0;
+    if(!countCells(*header, cellCount) || (header->cellCount != cellCount)){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot cell count " << header->cellCount << " does not match its dimensions: " << fileName << std::endl;
+        close();
+        return false;
+    }
+    uint64_t payloadBytes = header->packed? (cellCount + 1) / 2 : cellCount;
+    if(header->payloadBytes != payloadBytes){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot payload size " << header->payloadBytes << " does not match " << payloadBytes << " cells: " << fileName << std::endl;
+        close();
+        return false;
+    }
+    if(m_size - sizeof(PDNSnapshotHeader) < payloadBytes){
+        std::cout << "[PowerX:Snapshot] Error: Snapshot truncated: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    m_header = header;
+    m_cells = m_data + sizeof(PDNSnapshotHeader);
+    return true;
+}
+
+void PDNSnapshot::close(){
+    if(m_data != nullptr) munmap(const_cast<uint8_t *>(m_data), m_size);
+    if(m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_cells = nullptr;
+}
+
+SignalType PDNSnapshot::getCell(size_t cellIdx) const {
+    assert(isOpen() && cellIdx < m_header->cellCount);
+    if(cellIdx >= m_header->cellCount) return SignalType::UNKNOWN;
+
+    uint8_t value;
+    if(!m_header->packed) value = m_cells[cellIdx];
+    else value = (cellIdx & 1)? (m_cells[cellIdx >> 1] >> 4) : (m_cells[cellIdx >> 1] & 0x0F);
+    // a byte outside SignalType comes from a corrupted payload
+    if(value >= EnumTraits<SignalType>::count) return SignalType::UNKNOWN;
+    return static_cast<SignalType>(value);
+}
+
+SignalType PDNSnapshot::getMetalCell(int layer, int y, int x) const {
+    size_t cellIdx = (size_t(layer) * m_header->gridHeight + y) * m_header->gridWidth + x;
+    return getCell(cellIdx);
+}
+
+SignalType PDNSnapshot::getViaCell(int layer, int y, int x) const {
+    size_t metalCells = size_t(m_header->metalLayerCount) * m_header->gridHeight * m_header->gridWidth;
+    size_t cellIdx = metalCells + (size_t(layer) * m_header->pinHeight + y) * m_header->pinWidth + x;
+    return getCell(cellIdx);
+}
@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 21:03:40
+//  Module Name:        pdnSnapshot.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Versioned binary snapshot of the metal and via canvases of a
+//                      PowerDistributionNetwork. A fixed 64 byte header carries the
+//                      dimensions and a hash of the case, followed by every metal
+//                      cell then every via cell in (layer, y, x) order, one byte or
+//                      one nibble per cell. PDNSnapshot maps a file read-only and
+//                      indexes the cells in place, nothing is parsed
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __PDN_SNAPSHOT_H__
+#define __PDN_SNAPSHOT_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "objectArray.hpp"
+
+constexpr char PDN_SNAPSHOT_MAGIC[4] = {'P', 'X', 'S', 'N'};
+constexpr uint32_t PDN_SNAPSHOT_VERSION = 1;
+
+enum class SnapshotFormat : uint8_t{
+    // the original one token per line text format
+    TEXT,
+    // one byte per cell
+    BINARY,
+    // two cells per byte, SignalType has 16 values (low nibble holds the even cell)
+    BINARY_PACKED
+};
+
+// host byte order, the cells start right after it
+struct PDNSnapshotHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t packed;
+    uint32_t metalLayerCount;
+    uint32_t gridWidth;
+    uint32_t gridHeight;
+    uint32_t viaLayerCount;
+    uint32_t pinWidth;
+    uint32_t pinHeight;
+    uint32_t reserved;
+    uint64_t caseHash;
+    uint64_t cellCount;
+    uint64_t payloadBytes;
+};
+static_assert(sizeof(PDNSnapshotHeader) == 64, "PDNSnapshotHeader layout is part of the file format");
+
+class PDNSnapshot{
+private:
+    int m_fd;
+    const uint8_t *m_data;
+    size_t m_size;
+    const PDNSnapshotHeader *m_header;
+    const uint8_t *m_cells;
+
+    // metal plus via cells the header dimensions describe, false on overflow
+    static bool countCells(const PDNSnapshotHeader &header, uint64_t &cellCount);
+    // out of range indices and values outside SignalType read as UNKNOWN
+    SignalType getCell(size_t cellIdx) const;
+
+public:
+    PDNSnapshot();
+    ~PDNSnapshot();
+
+    PDNSnapshot(const PDNSnapshot &other) = delete;
+    PDNSnapshot &operator=(const PDNSnapshot &other) = delete;
+
+    static bool isSnapshotFile(const std::string &fileName);
+    static bool write(const std::string &fileName, const std::vector<ObjectArray> &metalLayers, const std::vector<ObjectArray> &viaLayers, uint64_t caseHash, bool packed);
+
+    // maps the file and checks magic, version, the cell count and payload size against the dimensions and the file size,
+    // the mapping lives until close() or destruction
+    bool open(const std::string &fileName);
+    void close();
+
+    inline bool isOpen() const {return m_header != nullptr;}
+    inline const PDNSnapshotHeader &getHeader() const {return *m_header;}
+
+    SignalType getMetalCell(int layer, int y, int x) const;
+    SignalType getViaCell(int layer, int y, int x) const;
+};
+
+#endif // __PDN_SNAPSHOT_H__
@@ -23,7 +23,11 @@
 #include <vector>
 #include <unordered_map>
 #include <fstream>
-#include <queue>
+#include <bit>
+#include <array>
+#include <string_view>
+#include <utility>
+#include <exception>
 // 2. Boost Library:
 #include "boost/polygon/polygon.hpp"
 
@@ -37,6 +41,9 @@
 #include "eqCktExtractor.hpp"
 #include "microBump.hpp"
 #include "c4Bump.hpp"
+#include "componentLabeller.hpp"
+#include "epochMarker.hpp"
+#include "inputTokenizer.hpp"
 
 // Initialize the static const unordered_map
 const std::unordered_map<SignalType, SignalType> PowerDistributionNetwork::defulatuBumpSigPadMap = {
@@ -68,33 +75,29 @@ const std::unordered_map<SignalType, SignalType> PowerDistributionNetwork::deful
     { SignalType::OBSTACLE, SignalType::OBSTACLE}
 };
 
-PowerDistributionNetwork::PowerDistributionNetwork(const std::string &fileName): uBump(fileName), c4(fileName) {
+PowerDistributionNetwork::PowerDistributionNetwork(const std::string &fileName): PowerDistributionNetwork(MappedFile(fileName)) {
+
+}
+
+PowerDistributionNetwork::PowerDistributionNetwork(const MappedFile &pinoutFile): 
+    m_gridWidth(-1), m_gridHeight(-1), m_pinWidth(-1), m_pinHeight(-1), m_metalLayerCount(-1), uBump(pinoutFile), c4(pinoutFile) {
     
-    std::ifstream file(fileName);
-    assert(file.is_open());
+    // the .pinout is mapped once and shared by the uBump, C4 and PDN sections
+    assert(pinoutFile.is_open());
+    InputTokenizer tokenizer(pinoutFile.view());
 
-    std::string lineBuffer;
+    std::string_view lineBuffer;
+    std::vector<std::string_view> splitLine;
     
     bool readPDN = false;
     bool readTechnology = false;
     bool finishTechnologyParsing = false;
 
-    while(std::getline(file, lineBuffer)){
-        if (lineBuffer.empty()|| lineBuffer[0] == '#') continue; // whole line comment
-        
-        size_t comment_pos = lineBuffer.find_first_of("#");
-        if (comment_pos != std::string::npos) {
-                lineBuffer = lineBuffer.substr(0, comment_pos);  // Remove everything after "#"
-        }
+    // preplace files of different layers are independent, they are collected here and read in parallel below
+    std::vector<std::pair<ObjectArray *, std::string>> blockageFiles;
 
-        // process line: std::cout << lineBuffer << std::endl;
-        std::vector<std::string> splitLine;
-        std::istringstream stream(lineBuffer);
-        std::string wordBuffer;
-    
-        while (stream >> wordBuffer) { // Extract words by spaces and newlines
-            splitLine.push_back(wordBuffer);
-        }
+    while(tokenizer.nextLine(lineBuffer)){
+        InputTokenizer::split(lineBuffer, splitLine);
 
         // parse TECHNOLOGY part
         if(!finishTechnologyParsing){
@@ -111,25 +114,19 @@ PowerDistributionNetwork::PowerDistributionNetwork(const std::string &fileName):
                 assert(m_metalLayerCount >= 2);
 
 
-                m_viaLayerCount = m_metalLayerCount - 1;
-                m_ubumpConnectedMetalLayerIdx = 0;
-                m_c4ConnectedMetalLayerIdx = m_metalLayerCount - 1;
-
-                this->metalLayers = std::vector<ObjectArray>(m_metalLayerCount, ObjectArray(m_gridWidth, m_gridHeight));
-                this->viaLayers = std::vector<ObjectArray>(m_viaLayerCount, ObjectArray(m_pinWidth, m_pinHeight));
+                initialiseLayers();
                 finishTechnologyParsing = true;
                 continue;
             }
 
             
-            if(splitLine[0] == "GRID_WIDTH") m_gridWidth = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "GRID_HEIGHT") m_gridHeight = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "PIN_WIDTH") m_pinWidth = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "PIN_HEIGHT") m_pinHeight = std::stoi(splitLine[2]);
-            else if(splitLine[0] == "LAYERS") m_metalLayerCount = std::stoi(splitLine[2]);
+            if(splitLine[0] == "GRID_WIDTH") m_gridWidth = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "GRID_HEIGHT") m_gridHeight = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "PIN_WIDTH") m_pinWidth = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "PIN_HEIGHT") m_pinHeight = InputTokenizer::parseInt(splitLine[2]);
+            else if(splitLine[0] == "LAYERS") m_metalLayerCount = InputTokenizer::parseInt(splitLine[2]);
             else{
-                std::cout << "[PowerX:PDNParser] Error: Unrecognizted Technology details: " << lineBuffer << std::endl;
-                exit(4);
+                throw InputError("PDNParser", "Unrecognizted Technology details: " + std::string(lineBuffer));
             }
             continue;
         }
@@ -146,57 +143,86 @@ PowerDistributionNetwork::PowerDistributionNetwork(const std::string &fileName):
         }
 
         if(splitLine[0] == "METAL_LAYER"){
-            int targetLayer = std::stoi(splitLine[1]);
+            int targetLayer = InputTokenizer::parseInt(splitLine[1]);
             if(targetLayer >= this->m_metalLayerCount){
-                std::cout << "[PowerX:PDNParser] Error: PDN metal preplace layer idx: " << targetLayer << "should be less than total layers: " << this->m_metalLayerCount << std::endl;
-                exit(4);
+                throw InputError("PDNParser", "PDN metal preplace layer idx: " + std::to_string(targetLayer) + " should be less than total layers: " + std::to_string(this->m_metalLayerCount));
             }
-            splitLine[2].erase(std::remove(splitLine[2].begin(), splitLine[2].end(), '"'), splitLine[2].end());
-            if(!splitLine[2].empty()) metalLayers[targetLayer].readBlockages(splitLine[2]);
+            std::string_view blockageFile = (splitLine.size() > 2)? InputTokenizer::unquote(splitLine[2]) : std::string_view();
+            if(!blockageFile.empty()) blockageFiles.emplace_back(&metalLayers[targetLayer], std::string(blockageFile));
 
         }else if(splitLine[0] == "VIA_LAYER"){
-            int targetLayer = std::stoi(splitLine[1]);
+            int targetLayer = InputTokenizer::parseInt(splitLine[1]);
             if(targetLayer >= this->m_viaLayerCount){
-                std::cout << "[PowerX:PDNParser] Error: PDN via preplace layer idx: " << targetLayer << "should be less than total layers: " << this->m_viaLayerCount << std::endl;
-                exit(4);  
+                throw InputError("PDNParser", "PDN via preplace layer idx: " + std::to_string(targetLayer) + " should be less than total layers: " + std::to_string(this->m_viaLayerCount));
             }
-            splitLine[2].erase(std::remove(splitLine[2].begin(), splitLine[2].end(), '"'), splitLine[2].end());
-            if(!splitLine[2].empty()) viaLayers[targetLayer].readBlockages(splitLine[2]);
+            std::string_view blockageFile = (splitLine.size() > 2)? InputTokenizer::unquote(splitLine[2]) : std::string_view();
+            if(!blockageFile.empty()) blockageFiles.emplace_back(&viaLayers[targetLayer], std::string(blockageFile));
 
         }else{
-            std::cout << "[PowerX:PDNParser] Error: Unrecognizted label in PDN preplace area: " << lineBuffer << std::endl;
-            exit(4);
+            throw InputError("PDNParser", "Unrecognizted label in PDN preplace area: " + std::string(lineBuffer));
         }
     }
 
-    file.close();
-
     assert(readTechnology);
     assert(finishTechnologyParsing);
-}
-
-PowerDistributionNetwork::~PowerDistributionNetwork(){
-    
-    for(PDNEdge *eg : pdnEdgeOwner){
-        delete(eg);
-    }
 
-    for(size_t layer = 0; layer < physicalGridLayer; ++layer){
-        for(size_t y = 0; y < physicalGridHeight; ++y){
-            for(size_t x = 0; x < physicalGridHeight; ++x){
-                delete(physicalNodes[layer][y][x]);
-            }
+    // each job owns a distinct layer, a layer listed twice keeps the sequential last-one-wins order
+    std::unordered_map<const ObjectArray *, size_t> lastJobOfLayer;
+    for(size_t jobIdx = 0; jobIdx < blockageFiles.size(); ++jobIdx) lastJobOfLayer[blockageFiles[jobIdx].first] = jobIdx;
+
+    // an exception must not leave the parallel region, it is kept and the first failing file in listed order is rethrown
+    std::vector<std::exception_ptr> failures(blockageFiles.size());
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t jobIdx = 0; jobIdx < blockageFiles.size(); ++jobIdx){
+        if(lastJobOfLayer.at(blockageFiles[jobIdx].first) != jobIdx) continue;
+        try{
+            blockageFiles[jobIdx].first->readBlockages(blockageFiles[jobIdx].second);
+        }catch(...){
+            failures[jobIdx] = std::current_exception();
         }
     }
+    for(const std::exception_ptr &failure : failures){
+        if(failure) std::rethrow_exception(failure);
+    }
+}
+
+PowerDistributionNetwork::PowerDistributionNetwork(const DesignSpec &spec): 
+    m_gridWidth(spec.gridWidth), m_gridHeight(spec.gridHeight), m_pinWidth(spec.gridWidth + 1), m_pinHeight(spec.gridHeight + 1), m_metalLayerCount(spec.metalLayerCount), uBump(spec), c4(spec) {
+
+    assert(m_gridWidth > 0);
+    assert(m_gridHeight > 0);
+    assert(m_metalLayerCount >= 2);
+    assert(spec.metalPreplaced.size() <= static_cast<size_t>(m_metalLayerCount));
+    assert(spec.viaPreplaced.size() <= static_cast<size_t>(m_metalLayerCount - 1));
+
+    initialiseLayers();
+    for(size_t layer = 0; layer < spec.metalPreplaced.size(); ++layer) metalLayers[layer].preplacedCords = spec.metalPreplaced[layer];
+    for(size_t layer = 0; layer < spec.viaPreplaced.size(); ++layer) viaLayers[layer].preplacedCords = spec.viaPreplaced[layer];
+}
+
+void PowerDistributionNetwork::initialiseLayers(){
+    m_viaLayerCount = m_metalLayerCount - 1;
+    m_ubumpConnectedMetalLayerIdx = 0;
+    m_c4ConnectedMetalLayerIdx = m_metalLayerCount - 1;
+
+    this->metalLayers = std::vector<ObjectArray>(m_metalLayerCount, ObjectArray(m_gridWidth, m_gridHeight));
+    this->viaLayers = std::vector<ObjectArray>(m_viaLayerCount, ObjectArray(m_pinWidth, m_pinHeight));
+}
+
+PowerDistributionNetwork::~PowerDistributionNetwork(){
 
 }
 
 bool PowerDistributionNetwork::checkOnePiece(int metalLayerIdx){
-    std::unordered_map<SignalType, DoughnutPolygonSet> dpsMap = collectDoughnutPolygons(metalLayers[metalLayerIdx].canvas);
-    for(std::unordered_map<SignalType, DoughnutPolygonSet>::const_iterator cit = dpsMap.begin(); cit != dpsMap.end(); ++cit){
-        SignalType st = cit->first;
+    std::vector<int> labels;
+    std::vector<SignalType> labelSignals;
+    int labelCount = labelCanvas(metalLayers[metalLayerIdx].canvas, labels, labelSignals);
+
+    std::vector<int> pieceCount(toIdx(SignalType::UNKNOWN) + 1, 0);
+    for(int cl = 0; cl < labelCount; ++cl){
+        SignalType st = labelSignals[cl];
         if(POWER_SIGNAL_SET.count(st) == 0) continue;
-        if(dps::getShapesCount(cit->second) > 1) return false;
+        if(++pieceCount[toIdx(st)] > 1) return false;
     }
 
     return true;
@@ -284,58 +310,41 @@ void PowerDistributionNetwork::checkVias(){
 }
 
 void PowerDistributionNetwork::fillEnclosedRegionsonCanvas(){
-    std::vector<std::vector<bool>> visited;
-    const std::vector<Cord> directions = {Cord(-1, 0), Cord(1, 0), Cord(0, -1), Cord(0, 1)};
-
-    auto inBounds = [&](int x, int y) {
-        return y >= 0 && y < m_gridHeight && x >= 0 && x < m_gridWidth;
-    };
-
-    for (int layer = 0; layer < m_metalLayerCount ; ++layer) {
-        visited.assign(m_gridHeight, std::vector<bool>(m_gridWidth, false));
-        
-        for (int y = 0; y < m_gridHeight; ++y) {
-            for (int x = 0; x < m_gridWidth; ++x) {
-                if (metalLayers[layer].canvas[y][x] != SignalType::EMPTY || visited[y][x]) continue;
+    std::vector<int> labels;
+    std::vector<uint16_t> borderSignalMask;
 
-                std::queue<Cord> q;
-                std::vector<Cord> region;
-                std::unordered_set<SignalType> borderSignals;
-                bool touchesBoundary = false;
-
-                q.push(Cord(x, y));
-                visited[y][x] = true;
-                region.emplace_back(x, y);
-
-                while (!q.empty()) {
-                    Cord c = q.front(); q.pop();
-
-                    for (const Cord& d : directions) {
-                        int ny = c.y() + d.y();
-                        int nx = c.x() + d.x();
-
-                        if (!inBounds(nx, ny)) {
-                            continue;
-                        }
-
-                        SignalType neighborType = metalLayers[layer].canvas[ny][nx];
+    for(int layer = 0; layer < m_metalLayerCount; ++layer){
+        std::vector<std::vector<SignalType>> &canvas = metalLayers[layer].canvas;
+        int regionCount = labelCanvasSignal(canvas, SignalType::EMPTY, labels);
+        borderSignalMask.assign(regionCount, 0);
+
+        // collect the signals bordering each empty region as a bitmask over SignalType
+        auto markBorder = [&](int region, int x, int y){
+            SignalType neighborType = canvas[y][x];
+            if((neighborType != SignalType::EMPTY) && (neighborType != SignalType::OBSTACLE)){
+                borderSignalMask[region] |= static_cast<uint16_t>(1u << toIdx(neighborType));
+            }
+        };
 
-                        if (neighborType == SignalType::EMPTY && !visited[ny][nx]) {
-                            visited[ny][nx] = true;
-                            q.push(Cord(nx, ny));
-                            region.emplace_back(nx, ny);
-                        } else if (neighborType != SignalType::EMPTY && neighborType != SignalType::OBSTACLE) {
-                            borderSignals.insert(neighborType);
-                        }
-                    }
-                }
+        for(int y = 0; y < m_gridHeight; ++y){
+            for(int x = 0; x < m_gridWidth; ++x){
+                int region = labels[y * m_gridWidth + x];
+                if(region == COMPONENT_LABEL_NONE) continue;
+                if(x != 0) markBorder(region, x - 1, y);
+                if(x != (m_gridWidth - 1)) markBorder(region, x + 1, y);
+                if(y != 0) markBorder(region, x, y - 1);
+                if(y != (m_gridHeight - 1)) markBorder(region, x, y + 1);
+            }
+        }
 
-                if (borderSignals.size() == 1) {
-                    SignalType fillType = *borderSignals.begin();
-                    for (const Cord& p : region) {
-                        metalLayers[layer].canvas[p.y()][p.x()] = fillType;
-                    }
-                }
+        // regions enclosed by exactly one signal are absorbed by that signal
+        for(int y = 0; y < m_gridHeight; ++y){
+            for(int x = 0; x < m_gridWidth; ++x){
+                int region = labels[y * m_gridWidth + x];
+                if(region == COMPONENT_LABEL_NONE) continue;
+                uint16_t mask = borderSignalMask[region];
+                if((mask == 0) || ((mask & (mask - 1)) != 0)) continue;
+                canvas[y][x] = static_cast<SignalType>(std::countr_zero(mask));
             }
         }
     }
@@ -374,7 +383,7 @@ void PowerDistributionNetwork::removeFloatingPlanes(int layer){
     assert(layer <= m_c4ConnectedMetalLayerIdx);
 
 
-    std::unordered_map<SignalType, std::unordered_set<Cord>> requiredCords;
+    EnumMap<SignalType, std::unordered_set<Cord>> requiredCords;
     
     // insert the preplaced
     for(auto cit = metalLayers[layer].preplacedCords.begin(); cit != metalLayers[layer].preplacedCords.end(); ++cit){
@@ -428,28 +437,27 @@ void PowerDistributionNetwork::removeFloatingPlanes(int layer){
         }
     }
 
-    std::unordered_map<SignalType, DoughnutPolygonSet> layerDPS = collectDoughnutPolygons(metalLayers[layer].canvas);
-    for(std::unordered_map<SignalType, DoughnutPolygonSet>::iterator it = layerDPS.begin(); it != layerDPS.end(); ++it){
-        SignalType st = it->first;
-        if((st == SignalType::EMPTY) || (st == SignalType::OBSTACLE)) continue;
-
+    std::vector<int> labels;
+    std::vector<SignalType> labelSignals;
+    int labelCount = labelCanvas(metalLayers[layer].canvas, labels, labelSignals);
+
+    // a fragment is kept if any of its grids is required by its signal
+    std::vector<bool> isRequired(labelCount, false);
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            int cl = labels[j * m_gridWidth + i];
+            if(isRequired[cl]) continue;
+            EnumMap<SignalType, std::unordered_set<Cord>>::const_iterator cit = requiredCords.find(labelSignals[cl]);
+            if((cit != requiredCords.end()) && (cit->second.count(Cord(i, j)) != 0)) isRequired[cl] = true;
+        }
+    }
 
-        for(int dpidx = 0; dpidx < dps::getShapesCount(it->second); ++dpidx){
-            std::vector<Cord>fragmentGrids = dp::getContainedGrids(it->second.at(dpidx));
-            if(requiredCords.count(st) == 0){
-                for(const Cord &c : fragmentGrids) metalLayers[layer].setCanvas(c, SignalType::EMPTY);
-            }else{
-                bool isRequired = false;
-                for(const Cord &c : fragmentGrids){
-                    if(requiredCords[st].count(c) != 0){
-                        isRequired = true;
-                        break;
-                    }
-                }
-                if(!isRequired){
-                    for(const Cord &c : fragmentGrids) metalLayers[layer].setCanvas(c, SignalType::EMPTY);
-                }
-            }
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            int cl = labels[j * m_gridWidth + i];
+            SignalType st = labelSignals[cl];
+            if((st == SignalType::EMPTY) || (st == SignalType::OBSTACLE)) continue;
+            if(!isRequired[cl]) metalLayers[layer].setCanvas(j, i, SignalType::EMPTY);
         }
     }
     
@@ -457,50 +465,50 @@ void PowerDistributionNetwork::removeFloatingPlanes(int layer){
 
 void PowerDistributionNetwork::exportEquivalentCircuit(const SignalType st, const Technology &tch, const EqCktExtractor &extor, const std::string &filePath){
  
-    std::ofstream ofs(filePath, std::ios::out);
+    NetlistWriter ofs(filePath);
     assert(ofs.is_open());
 
-    auto pointToNode = [](int layer, const Cord &c) -> std::string {
-        return "n" + std::to_string(c.x()) + "_" + std::to_string(c.y()) + "_" + std::to_string(layer);
+    auto pointToNode = [](int layer, const Cord &c) -> GridNodeName {
+        return GridNodeName{c.x(), c.y(), layer};
     };
 
-    ofs << "****** Equivalent Circuit Components ******" << std::endl;
-    ofs << ".SUBCKT ubump in out" << std::endl;
-    ofs << "R1 in mid " << tch.getMicrobumpResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getMicrobumpInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
+    ofs << "****** Equivalent Circuit Components ******" << '\n';
+    ofs << ".SUBCKT ubump in out" << '\n';
+    ofs << "R1 in mid " << tch.getMicrobumpResistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getMicrobumpInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
     
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".SUBCKT via in out" << std::endl;
-    ofs << "R1 in mid " << extor.getInterposerViaResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << extor.getInterposerViaInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
+    ofs << ".SUBCKT via in out" << '\n';
+    ofs << "R1 in mid " << extor.getInterposerViaResistance() << "m" << '\n';
+    ofs << "L1 mid out " << extor.getInterposerViaInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
 
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".SUBCKT edge in out" << std::endl;
-    ofs << "R1 in mid " << 2*extor.getInterposerResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << 2*extor.getInterposerInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
+    ofs << ".SUBCKT edge in out" << '\n';
+    ofs << "R1 in mid " << 2*extor.getInterposerResistance() << "m" << '\n';
+    ofs << "L1 mid out " << 2*extor.getInterposerInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
 
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".SUBCKT tsv in out" << std::endl;
-    ofs << "R1 in mid " << tch.getTsvResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getTsvInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
+    ofs << ".SUBCKT tsv in out" << '\n';
+    ofs << "R1 in mid " << tch.getTsvResistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getTsvInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
 
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".SUBCKT cfour in out" << std::endl;
-    ofs << "R1 in mid " << tch.getC4Resistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getC4Inductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
+    ofs << ".SUBCKT cfour in out" << '\n';
+    ofs << "R1 in mid " << tch.getC4Resistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getC4Inductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
     
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << "****** Equivalent Circuit ******" << std::endl;
+    ofs << "****** Equivalent Circuit ******" << '\n';
     int chipletcount = uBump.signalTypeToInstances[st].size();
     assert(chipletcount > 0);
     std::vector<std::string> chipletTitles(uBump.signalTypeToInstances[st].begin(), uBump.signalTypeToInstances[st].end());
@@ -517,28 +525,28 @@ void PowerDistributionNetwork::exportEquivalentCircuit(const SignalType st, cons
         ofs << chipletTitles[i] << "_o ";
     }
 
-    ofs << "vss" << std::endl;
-    ofs << "*** MicroBumps ***" << std::endl;
+    ofs << "vss" << '\n';
+    ofs << "*** MicroBumps ***" << '\n';
     for(int ubidx = 0; ubidx < chipletcount; ++ubidx){
         std::string instanceName = chipletTitles[ubidx];
         Cord llbase(rec::getLL(uBump.instanceToRectangleMap.at(instanceName)));
         for(const Cord &c : uBump.instanceToBallOutMap[instanceName]->SignalTypeToAllCords[st]){
             ofs << "Xubump" << uBumpCounter++ << "_" <<  pointToNode(m_ubumpConnectedMetalLayerIdx, Cord(c.x() + llbase.x(), c.y() + llbase.y())) << " ";
-            ofs << chipletTitles[ubidx] << "_o " << pointToNode(m_ubumpConnectedMetalLayerIdx, Cord(c.x() + llbase.x(), c.y() + llbase.y())) << " ubump" << std::endl;
+            ofs << chipletTitles[ubidx] << "_o " << pointToNode(m_ubumpConnectedMetalLayerIdx, Cord(c.x() + llbase.x(), c.y() + llbase.y())) << " ubump" << '\n';
         }
     }
 
-    ofs << "*** C4 Bumps ***" << std::endl;
+    ofs << "*** C4 Bumps ***" << '\n';
     for(const C4PinCluster *cluster : c4.signalTypeToAllClusters[st]){
-        std::string c4Node = pointToNode(m_metalLayerCount, cluster->representation);
-        ofs << "Xcfour" << c4Counter++ << " in " << c4Node << " cfour" << std::endl;
+        GridNodeName c4Node = pointToNode(m_metalLayerCount, cluster->representation);
+        ofs << "Xcfour" << c4Counter++ << " in " << c4Node << " cfour" << '\n';
         for(const Cord &c : cluster->pins){
             ofs << "Xtsv" << tsvCounter++ << "_" << pointToNode(m_c4ConnectedMetalLayerIdx, c) << " ";
-            ofs << c4Node << " " << pointToNode(m_c4ConnectedMetalLayerIdx, c) << " tsv" << std::endl;
+            ofs << c4Node << " " << pointToNode(m_c4ConnectedMetalLayerIdx, c) << " tsv" << '\n';
         }
     }
 
-    ofs << "*** Metal Layers ***" << std::endl;
+    ofs << "*** Metal Layers ***" << '\n';
     len_t pinXMin = 0;
     len_t pinXMax = m_pinWidth-1;
     len_t pinYMin = 0;
@@ -577,11 +585,11 @@ void PowerDistributionNetwork::exportEquivalentCircuit(const SignalType st, cons
                     bool yOnEdge = (candc.y() == pinYMin) || (candc.y() == pinYMax);
 
                     if(xOnEdge && yOnEdge){
-                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceCornerCell()/4.0 << "f" << std::endl;
+                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceCornerCell()/4.0 << "f" << '\n';
                     }else if(xOnEdge || yOnEdge){
-                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceEdgeCell()/4.0 << "f" << std::endl;
+                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceEdgeCell()/4.0 << "f" << '\n';
                     }else{
-                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceCenterCell()/4.0 << "f" << std::endl;
+                        ofs << "C" << capCounter++ << " " << pointToNode(mLayerIdx, candc) << " vss " << extor.getInterposerCapacitanceCenterCell()/4.0 << "f" << '\n';
                     }
                 }
 
@@ -591,117 +599,117 @@ void PowerDistributionNetwork::exportEquivalentCircuit(const SignalType st, cons
                     if(collectedLines.count(candl) != 0) continue;
                     collectedLines.insert(candl);
                     ofs << "Xedge" << edgeCounter++ << "_" << pointToNode(mLayerIdx, candl.getLow()) << "_" << pointToNode(mLayerIdx, candl.getHigh()) << " ";
-                    ofs << pointToNode(mLayerIdx, candl.getLow()) << " " << pointToNode(mLayerIdx, candl.getHigh()) << " edge" << std::endl;
+                    ofs << pointToNode(mLayerIdx, candl.getLow()) << " " << pointToNode(mLayerIdx, candl.getHigh()) << " edge" << '\n';
                 }
             }
         }
     }
 
-    ofs << "*** Vias ***" << std::endl;
+    ofs << "*** Vias ***" << '\n';
     for(int viaLayerIdx = 0; viaLayerIdx < m_viaLayerCount; ++ viaLayerIdx){
         for(int j = 0; j < m_pinHeight; ++j){
             for(int i = 0; i < m_pinWidth; ++i){
                 if(viaLayers[viaLayerIdx].canvas[j][i] == st){
                     ofs << "Xvia" << viaCounter++ << "_" << pointToNode(viaLayerIdx, Cord(i, j)) << "_" << pointToNode(viaLayerIdx+1, Cord(i, j)) << " ";
-                    ofs << pointToNode(viaLayerIdx, Cord(i, j)) << " " << pointToNode(viaLayerIdx+1, Cord(i, j)) << " via" << std::endl;
+                    ofs << pointToNode(viaLayerIdx, Cord(i, j)) << " " << pointToNode(viaLayerIdx+1, Cord(i, j)) << " via" << '\n';
                 }
             }
         }
     }
-    // ofs << "Xubump1 in R8_o ubump" << std::endl;
-    // ofs << "Xubump2 in R7_o ubump" << std::endl;
-    // ofs << "Xubump3 in R6_o ubump" << std::endl;
-    // ofs << "Xubump4 in R5_o ubump" << std::endl;
-    // ofs << "Xubump5 in R4_o ubump" << std::endl;
-    // ofs << "Xubump6 in R3_o ubump" << std::endl;
-    // ofs << "Xubump7 in R2_o ubump" << std::endl;
-    // ofs << "Xubump8 in R1_o ubump" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << "****** Chiplet Load Model ******" << std::endl;
-    ofs << ".SUBCKT chiplet in vss Rval=50m Lval=200n Cval=30p Iload=1.0" << std::endl;
-    ofs << "Rpath in n1 Rval" << std::endl;
-    ofs << "Lpath n1 n2 Lval" << std::endl;
-    ofs << "Cpath n2 vss Cval" << std::endl;
-    ofs << "ILOAD n2 vss DC Iload" << std::endl;
-    ofs << ".ENDS" << std::endl;
-
-    ofs << std::endl;
-
-    ofs << "****** Input PCB model Model ******" << std::endl;
-    ofs << ".SUBCKT pcb vrm_low vrm_high out vss" << std::endl;
-    ofs << "Lpcbh vrm_high n1 " << tch.getPCBInductance() << "p" << std::endl;
-    ofs << "Rpcbh n1 out " << tch.getPCBResistance() << "u" << std::endl;
-    ofs << "Ldecaph out n2 " << tch.getPCBDecapInductance() <<  "n" << std::endl;
-    ofs << "Cdecap n2 n3 " << tch.getPCBDecapCapacitance() << "u" << std::endl;
-    ofs << "Rdecapl n3 vss " << tch.getPCBDecapResistance() << "u" << std::endl;
-    ofs << "Rpcbl n4 vss " << tch.getPCBResistance() << "u" << std::endl;
-    ofs << "Lpcbl vrm_low n4 " << tch.getPCBInductance() << "p" << std::endl;
+    // ofs << "Xubump1 in R8_o ubump" << '\n';
+    // ofs << "Xubump2 in R7_o ubump" << '\n';
+    // ofs << "Xubump3 in R6_o ubump" << '\n';
+    // ofs << "Xubump4 in R5_o ubump" << '\n';
+    // ofs << "Xubump5 in R4_o ubump" << '\n';
+    // ofs << "Xubump6 in R3_o ubump" << '\n';
+    // ofs << "Xubump7 in R2_o ubump" << '\n';
+    // ofs << "Xubump8 in R1_o ubump" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << "****** Chiplet Load Model ******" << '\n';
+    ofs << ".SUBCKT chiplet in vss Rval=50m Lval=200n Cval=30p Iload=1.0" << '\n';
+    ofs << "Rpath in n1 Rval" << '\n';
+    ofs << "Lpath n1 n2 Lval" << '\n';
+    ofs << "Cpath n2 vss Cval" << '\n';
+    ofs << "ILOAD n2 vss DC Iload" << '\n';
+    ofs << ".ENDS" << '\n';
+
+    ofs << '\n';
+
+    ofs << "****** Input PCB model Model ******" << '\n';
+    ofs << ".SUBCKT pcb vrm_low vrm_high out vss" << '\n';
+    ofs << "Lpcbh vrm_high n1 " << tch.getPCBInductance() << "p" << '\n';
+    ofs << "Rpcbh n1 out " << tch.getPCBResistance() << "u" << '\n';
+    ofs << "Ldecaph out n2 " << tch.getPCBDecapInductance() <<  "n" << '\n';
+    ofs << "Cdecap n2 n3 " << tch.getPCBDecapCapacitance() << "u" << '\n';
+    ofs << "Rdecapl n3 vss " << tch.getPCBDecapResistance() << "u" << '\n';
+    ofs << "Rpcbl n4 vss " << tch.getPCBResistance() << "u" << '\n';
+    ofs << "Lpcbl vrm_low n4 " << tch.getPCBInductance() << "p" << '\n';
     
-    ofs << "* --- Decap Bank for Broadband Z(f) Control ---" << std::endl;
-    ofs << "* 1 μF decap (low freq bulk, moderately damped)" << std::endl;
-    ofs << "Rdecap1u out n1u 0.05" << std::endl;
-    ofs << "Cdecap1u n1u vss 1u" << std::endl;
-    ofs << "* 100 nF decap (mid-low freq)" << std::endl;
-    ofs << "Rdecap100n out n100n 0.1" << std::endl;
-    ofs << "Cdecap100n n100n vss 100n" << std::endl;
-    ofs << "* 10 nF decap (mid freq)" << std::endl;
-    ofs << "Rdecap10n out n10n 0.2" << std::endl;
-    ofs << "Cdecap10n n10n vss 10n" << std::endl;
-    ofs << "* 1 nF decap (high freq)" << std::endl;
-    ofs << "Rdecap1n out n1n 0.3" << std::endl;
-    ofs << "Cdecap1n n1n vss 1n" << std::endl;
-    ofs << "* 100 pF decap (GHz damping)" << std::endl;
-    ofs << "Rdecap100p out n100p 0.5" << std::endl;
-    ofs << "Cdecap100p n100p vss 100p" << std::endl;
+    ofs << "* --- Decap Bank for Broadband Z(f) Control ---" << '\n';
+    ofs << "* 1 μF decap (low freq bulk, moderately damped)" << '\n';
+    ofs << "Rdecap1u out n1u 0.05" << '\n';
+    ofs << "Cdecap1u n1u vss 1u" << '\n';
+    ofs << "* 100 nF decap (mid-low freq)" << '\n';
+    ofs << "Rdecap100n out n100n 0.1" << '\n';
+    ofs << "Cdecap100n n100n vss 100n" << '\n';
+    ofs << "* 10 nF decap (mid freq)" << '\n';
+    ofs << "Rdecap10n out n10n 0.2" << '\n';
+    ofs << "Cdecap10n n10n vss 10n" << '\n';
+    ofs << "* 1 nF decap (high freq)" << '\n';
+    ofs << "Rdecap1n out n1n 0.3" << '\n';
+    ofs << "Cdecap1n n1n vss 1n" << '\n';
+    ofs << "* 100 pF decap (GHz damping)" << '\n';
+    ofs << "Rdecap100p out n100p 0.5" << '\n';
+    ofs << "Cdecap100p n100p vss 100p" << '\n';
     
-    ofs << ".ENDS" << std::endl;
+    ofs << ".ENDS" << '\n';
 
-    ofs << std::endl << std::endl;
-    ofs << "****** Main ******" << std::endl;
-    ofs << ".param VDD=1.0" << std::endl;
-    ofs << "VVRM vrm_high vrm_low DC VDD" << std::endl;
-    ofs << "Xpcb vrm_low vrm_high pcb_out 0 pcb" << std::endl;
+    ofs << '\n' << '\n';
+    ofs << "****** Main ******" << '\n';
+    ofs << ".param VDD=1.0" << '\n';
+    ofs << "VVRM vrm_high vrm_low DC VDD" << '\n';
+    ofs << "Xpcb vrm_low vrm_high pcb_out 0 pcb" << '\n';
     
     ofs << "Xeqckt pcb_out ";
     for(int i = 0; i < chipletcount; ++i){
         ofs << chipletTitles[i] << "_o ";
     }
-    ofs << "0" << " " << "eqckt" << std::endl;
+    ofs << "0" << " " << "eqckt" << '\n';
     
     for(int i = 0; i < chipletcount; ++i){
         ofs << "Xchiplet" << i << " " << chipletTitles[i] << "_o " << "0 chiplet ";
         BallOut *bt = uBump.instanceToBallOutMap.at(chipletTitles[i]);
         assert(bt != nullptr);
         ofs << "Rval=" << bt->getSeriesResistance() << "m Lval=" << bt->getSeriesInductance() << "n Cval=" << bt->getShuntCapacitance() << "p ";
-        ofs << "Iload=" << bt->getMaxCurrent() << std::endl;
+        ofs << "Iload=" << bt->getMaxCurrent() << '\n';
     }
 
-    ofs << std::endl;
-    ofs << "****** DC IR-Drop test ******" << std::endl;
-    ofs << ".OPTION POST=2 INGOLD=2 RUNLVL=6" << std::endl;
-    ofs << std::endl << ".op" << std::endl;
-    ofs << ".DC VDD 1.5 1.5 0.5" << std::endl;
+    ofs << '\n';
+    ofs << "****** DC IR-Drop test ******" << '\n';
+    ofs << ".OPTION POST=2 INGOLD=2 RUNLVL=6" << '\n';
+    ofs << '\n' << ".op" << '\n';
+    ofs << ".DC VDD 1.5 1.5 0.5" << '\n';
     
     ofs << ".print V(vrm_low) V(vrm_high) V(pcb_out) ";
     for(int i = 0; i < chipletcount; ++i){
         ofs << "V(" << chipletTitles[i] << "_o" << ") ";
     }
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".measure DC irdroppcb param=\'V(vrm_high) - V(pcb_out)\'" << std::endl;
+    ofs << ".measure DC irdroppcb param=\'V(vrm_high) - V(pcb_out)\'" << '\n';
     for(int i = 0; i < chipletcount; ++i){
         Rectangle chpletPlacement = uBump.instanceToRectangleMap[chipletTitles[i]];
         Cord chipletLL = rec::getLL(chpletPlacement);
 
         ofs << ".measure DC IRDrop" << chipletTitles[i] << "_" <<  chipletLL.x() << "_" << chipletLL.y() << "_" << rec::getWidth(chpletPlacement) << "_" << rec::getHeight(chpletPlacement);
-        ofs << " param=\'V(pcb_out) - V(" << chipletTitles[i] << "_o" << ")\'" << std::endl;
+        ofs << " param=\'V(pcb_out) - V(" << chipletTitles[i] << "_o" << ")\'" << '\n';
     }
-    ofs << std::endl;
+    ofs << '\n';
 
-    // ofs << ".OPTION RELTOL=1e-4 ABSTOL=1e-8 VNTOL=1e-6" << std::endl;
-    ofs << ".end" << std::endl;
+    // ofs << ".OPTION RELTOL=1e-4 ABSTOL=1e-8 VNTOL=1e-6" << '\n';
+    ofs << ".end" << '\n';
     ofs.close();
 }
 
@@ -711,11 +719,14 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
     physicalGridWidth = m_gridWidth + 1;
     physicalGridHeight = m_gridHeight + 1;
 
-    auto inPhysicalGrid = [&](size_t y, size_t x){
-        return (y >= 0) && (y < physicalGridHeight) && (x >= 0) && (x < physicalGridWidth);
-    };
+    // nodes are pushed in (layer, y, x) order so that their position equals calPhysicalNodeIdx(layer, y, x)
+    physicalNodes.clear();
+    physicalNodes.reserve(size_t(physicalGridLayer) * physicalGridHeight * physicalGridWidth);
 
-    physicalNodes.assign(physicalGridLayer, std::vector<std::vector<PDNNode*>>(physicalGridHeight, std::vector<PDNNode*>(physicalGridWidth, nullptr)));
+    // upper bound: every east/north metal edge plus a via on every pin
+    pdnEdges.clear();
+    pdnEdges.reserve(size_t(physicalGridLayer) * (size_t(physicalGridHeight) * (physicalGridWidth - 1) + size_t(physicalGridHeight - 1) * physicalGridWidth) +
+        size_t(m_viaLayerCount) * m_pinHeight * m_pinWidth);
 
     auto inCanvas = [&](int cy, int cx) -> bool {
         return (0 <= cy && cy < static_cast<int>(m_gridHeight) && 0 <= cx && cx < static_cast<int>(m_gridWidth));
@@ -725,7 +736,7 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
         for (size_t y = 0; y < physicalGridHeight; ++y) {
             for (size_t x = 0; x < physicalGridWidth; ++x) {
 
-                PDNNode* newNode = new PDNNode(layer, x, y);
+                PDNNode &newNode = physicalNodes.emplace_back(layer, x, y);
 
                 SignalType curSig = SignalType::EMPTY;
                 bool mixSignal = false;
@@ -757,14 +768,12 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
                 checkCell(static_cast<int>(y),     static_cast<int>(x));
 
                 if (isObstacle) {
-                    newNode->signal = SignalType::OBSTACLE;   // ensure enum name matches
+                    newNode.signal = SignalType::OBSTACLE;   // ensure enum name matches
                 } else if (!mixSignal) {
-                    newNode->signal = curSig;
+                    newNode.signal = curSig;
                 } else {
-                    newNode->signal = SignalType::EMPTY;
+                    newNode.signal = SignalType::EMPTY;
                 }
-
-                physicalNodes[layer][y][x] = newNode;
             }
         }
     }
@@ -775,31 +784,27 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
     for (size_t layer = 0; layer < m_metalLayerCount; ++layer){
         for (size_t y = 0; y < physicalGridHeight; ++y){
             for (size_t x = 0; x < physicalGridWidth; ++x){
-                PDNNode *centreNode = physicalNodes[layer][y][x];
-                SignalType centreNodeSignal = centreNode->signal;
+                size_t centreIdx = calPhysicalNodeIdx(layer, y, x);
+                SignalType centreNodeSignal = physicalNodes[centreIdx].signal;
                 if(centreNodeSignal == SignalType::OBSTACLE || centreNodeSignal == SignalType::SIGNAL) continue;
 
                 if(x != physicalGridWidthRightBorder){
-                    PDNNode *rightNode = physicalNodes[layer][y][x+1];
-                    SignalType rightNodeSig = rightNode->signal;
+                    size_t rightIdx = centreIdx + 1;
+                    SignalType rightNodeSig = physicalNodes[rightIdx].signal;
                     if(rightNodeSig != SignalType::OBSTACLE && rightNodeSig != SignalType::SIGNAL){
-                        PDNEdge *newEdge = new PDNEdge(centreNode, rightNode);
-                        newEdge->isVia = false;
-                        centreNode->east = newEdge;
-                        rightNode->west = newEdge;
-                        this->pdnEdgeOwner.push_back(newEdge);
+                        pdn_edge_t newEdge = addPhysicalEdge(centreIdx, rightIdx, false);
+                        physicalNodes[centreIdx].east = newEdge;
+                        physicalNodes[rightIdx].west = newEdge;
                     }
                 }
 
                 if(y != physicalGridHeightUpBorder){
-                    PDNNode *upNode = physicalNodes[layer][y+1][x];
-                    SignalType upNodeSig = upNode->signal;
+                    size_t upIdx = centreIdx + physicalGridWidth;
+                    SignalType upNodeSig = physicalNodes[upIdx].signal;
                     if(upNodeSig != SignalType::OBSTACLE && upNodeSig != SignalType::SIGNAL){
-                        PDNEdge *newEdge = new PDNEdge(centreNode, upNode);
-                        newEdge->isVia = false;
-                        centreNode->north = newEdge;
-                        upNode->south = newEdge;
-                        this->pdnEdgeOwner.push_back(newEdge);
+                        pdn_edge_t newEdge = addPhysicalEdge(centreIdx, upIdx, false);
+                        physicalNodes[centreIdx].north = newEdge;
+                        physicalNodes[upIdx].south = newEdge;
                     }
                 }
             }
@@ -812,19 +817,17 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
                 SignalType curSig = viaLayers[viaLayer].canvas[y][x];
                 if(POWER_SIGNAL_SET.count(curSig) == 0 && curSig != SignalType::EMPTY) continue;
                 
-                PDNNode *downNode = this->physicalNodes[viaLayer+1][y][x];
-                PDNNode *upNode = this->physicalNodes[viaLayer][y][x];
+                size_t downIdx = calPhysicalNodeIdx(viaLayer+1, y, x);
+                size_t upIdx = calPhysicalNodeIdx(viaLayer, y, x);
 
-                PDNEdge *newEdge = new PDNEdge(downNode, upNode);
-                newEdge->signal = curSig;
+                pdn_edge_t newEdge = addPhysicalEdge(downIdx, upIdx, true);
+                pdnEdges[newEdge].signal = curSig;
                 if(curSig != SignalType::EMPTY){
-                    upNode->signal = curSig;    
-                    downNode->signal = curSig;
+                    physicalNodes[upIdx].signal = curSig;    
+                    physicalNodes[downIdx].signal = curSig;
                 }
-                newEdge->isVia = true;
-                downNode->up = newEdge;
-                upNode->down = newEdge;
-                this->pdnEdgeOwner.push_back(newEdge);
+                physicalNodes[downIdx].up = newEdge;
+                physicalNodes[upIdx].down = newEdge;
             }
         }
     }
@@ -841,28 +844,37 @@ void PowerDistributionNetwork::buildPhysicalImplementation(){
             for(const Cord &c : uBump.instanceToBallOutMap[name]->SignalTypeToAllCords[st]){
                 len_t mx = chipletLL.x() + c.x();
                 len_t my = chipletLL.y() + c.y();
-                phyChipletNodes[name].push_back(physicalNodes[0][my][mx]);
-                assert(physicalNodes[0][my][mx]->signal == st);
+                size_t nodeIdx = calPhysicalNodeIdx(0, my, mx);
+                phyChipletNodes[name].push_back(nodeIdx);
+                assert(physicalNodes[nodeIdx].signal == st);
             }
         }
     }
 
     for(SignalType st : phySOI){
         for(const Cord &c : c4.signalTypeToAllCords[st]){
-            phySignalInNodes[st].push_back(physicalNodes[physicalGridLayer-1][c.y()][c.x()]);
-            assert(physicalNodes[physicalGridLayer-1][c.y()][c.x()]->signal == st);
+            size_t nodeIdx = calPhysicalNodeIdx(physicalGridLayer-1, c.y(), c.x());
+            phySignalInNodes[st].push_back(nodeIdx);
+            assert(physicalNodes[nodeIdx].signal == st);
         }
     }
 
 }
 
+pdn_edge_t PowerDistributionNetwork::addPhysicalEdge(size_t n0, size_t n1, bool isVia){
+    assert(pdnEdges.size() < pdnEdges.capacity());
+    PDNEdge &newEdge = pdnEdges.emplace_back(n0, n1);
+    newEdge.isVia = isVia;
+    return static_cast<pdn_edge_t>(pdnEdges.size() - 1);
+}
+
 void PowerDistributionNetwork::growPDNNodeEdges(){
-    for(PDNEdge *eg : pdnEdgeOwner){
-        SignalType n0Sig = eg->n0->signal;
-        SignalType n1Sig = eg->n1->signal;
+    for(PDNEdge &eg : pdnEdges){
+        SignalType n0Sig = physicalNodes[eg.n0].signal;
+        SignalType n1Sig = physicalNodes[eg.n1].signal;
 
         if((n0Sig == n1Sig) && (n0Sig != SignalType::EMPTY && n0Sig != SignalType::OBSTACLE)){
-            eg->signal = n0Sig;
+            eg.signal = n0Sig;
         }
     }
 }
@@ -908,91 +920,80 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
 
 
 
-    auto checkConnectivity = [&](SignalType st, const std::vector<PDNNode *> &destinations) -> bool {
-        
-        std::unordered_set<PDNNode *> destinationSet(destinations.begin(), destinations.end());
-        std::unordered_set<PDNNode *> visisted;
-        std::queue<PDNNode *> q;
+    // traversal context shared by every search below. Node ids are dense, so the visited set is an
+    // epoch-stamped array cleared in O(1) and the BFS queue doubles as the list of visited nodes
+    const size_t nodeCount = physicalNodes.size();
+    EpochMarker visited(nodeCount);
+    std::vector<size_t> bfsQueue;
+    bfsQueue.reserve(nodeCount);
 
-        for(PDNNode *node : phySignalInNodes[st]){
-            visisted.insert(node);
-            q.push(node);
-        }
+    // destination bitmap of the signal under work, maps a uBump node to its chiplet's position in phyChipletNames[st]
+    std::vector<int> destinationChiplet(nodeCount, -1);
 
-        auto pushNieghbors = [&](PDNNode *node, PDNEdge *neighborEdge){
-            if(neighborEdge == nullptr || neighborEdge->signal != st) return false;
-            
-            PDNNode *neighborNode = (neighborEdge->n0 == node)? neighborEdge->n1 : neighborEdge->n0;
-            if(destinationSet.count(neighborNode) != 0) return true;
-            if(visisted.count(neighborNode) == 0){
-                visisted.insert(neighborNode);
-                q.push(neighborNode);
-            }
-            return false;
-        };
+    auto getNodeEdges = [&](size_t node) -> std::array<pdn_edge_t, 6> {
+        const PDNNode &pnode = physicalNodes[node];
+        return {pnode.north, pnode.south, pnode.east, pnode.west, pnode.up, pnode.down};
+    };
 
-        while(!q.empty()){
-            PDNNode *node = q.front(); q.pop();
+    // multi-target bfs along edges of st: one sweep from the sources answers every chiplet of the signal
+    auto checkConnectivity = [&](SignalType st, std::vector<bool> &chipletReached) -> size_t {
+        visited.clear();
+        bfsQueue.clear();
+        size_t reachedCount = 0;
+        for(size_t i = 0; i < chipletReached.size(); ++i) chipletReached[i] = false;
 
-            if(pushNieghbors(node, node->north)) return true;
-            if(pushNieghbors(node, node->south)) return true;
-            if(pushNieghbors(node, node->east)) return true;
-            if(pushNieghbors(node, node->west)) return true;
+        for(size_t node : phySignalInNodes[st]){
+            if(visited.mark(node)) bfsQueue.push_back(node);
+        }
 
-            if(pushNieghbors(node, node->up)) return true;
-            if(pushNieghbors(node, node->down)) return true;
+        for(size_t head = 0; (head < bfsQueue.size()) && (reachedCount < chipletReached.size()); ++head){
+            size_t node = bfsQueue[head];
+            for(pdn_edge_t neighborEdge : getNodeEdges(node)){
+                if(neighborEdge == PDN_EDGE_NONE || pdnEdges[neighborEdge].signal != st) continue;
+
+                size_t neighborNode = pdnEdges[neighborEdge].getOtherNode(node);
+                int chipletIdx = destinationChiplet[neighborNode];
+                if((chipletIdx != -1) && !chipletReached[chipletIdx]){
+                    chipletReached[chipletIdx] = true;
+                    ++reachedCount;
+                }
+                if(visited.mark(neighborNode)) bfsQueue.push_back(neighborNode);
+            }
         }
 
-        return false;
+        return reachedCount;
     };
 
-    auto fixConnectivity = [&](SignalType st, const std::vector<PDNNode *> &destinations) -> bool {
-        std::unordered_set<PDNNode *> destinationSet(destinations.begin(), destinations.end());
-        std::unordered_set<PDNNode *> visisted;
-        std::queue<PDNNode *> q;
+    auto fixConnectivity = [&](SignalType st, int chipletIdx) -> bool {
+        visited.clear();
+        bfsQueue.clear();
 
-        for(PDNNode *node : phySignalInNodes[st]){
-            visisted.insert(node);
-            q.push(node);
+        for(size_t node : phySignalInNodes[st]){
+            if(visited.mark(node)) bfsQueue.push_back(node);
         }
 
-        auto pushNieghbors = [&](PDNNode *node, PDNEdge *neighborEdge){
-            
-            if(neighborEdge == nullptr) return false;
-            if((neighborEdge->signal != st) && (neighborEdge->signal != SignalType::EMPTY)) return false;
-            
-            PDNNode *neighborNode = (neighborEdge->n0 == node)? neighborEdge->n1 : neighborEdge->n0;
-            if((neighborNode->signal != st) && (neighborNode->signal != SignalType::EMPTY)) return false;
-            
-            
-            if(destinationSet.count(neighborNode) != 0){
-                // commit all visited nodes
-                for(PDNNode *vnode : visisted){
-                    vnode->signal = st;
-                }
-                growPDNNodeEdges();
+        for(size_t head = 0; head < bfsQueue.size(); ++head){
+            size_t node = bfsQueue[head];
+            for(pdn_edge_t neighborEdge : getNodeEdges(node)){
+                if(neighborEdge == PDN_EDGE_NONE) continue;
+                if((pdnEdges[neighborEdge].signal != st) && (pdnEdges[neighborEdge].signal != SignalType::EMPTY)) continue;
 
-                return true;
-            }
-            
-            if(visisted.count(neighborNode) == 0){
-                visisted.insert(neighborNode);
-                q.push(neighborNode);
-            }
-            return false;
-        };
+                size_t neighborNode = pdnEdges[neighborEdge].getOtherNode(node);
+                SignalType neighborSig = physicalNodes[neighborNode].signal;
+                if((neighborSig != st) && (neighborSig != SignalType::EMPTY)) continue;
 
-        bool haveFix = false;
-        while(!q.empty()){
-            PDNNode *node = q.front(); q.pop();
+                if(destinationChiplet[neighborNode] == chipletIdx){
+                    // commit all visited nodes
+                    for(size_t vnode : bfsQueue){
+                        physicalNodes[vnode].signal = st;
+                    }
+                    growPDNNodeEdges();
 
-            if(pushNieghbors(node, node->north)) return true;
-            if(pushNieghbors(node, node->south)) return true;
-            if(pushNieghbors(node, node->east)) return true;
-            if(pushNieghbors(node, node->west)) return true;
+                    return true;
+                }
 
-            if(pushNieghbors(node, node->up)) return true;
-            if(pushNieghbors(node, node->down)) return true;
+                if(visited.mark(neighborNode)) bfsQueue.push_back(neighborNode);
+            }
         }
 
         return false;
@@ -1000,58 +1001,61 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
     };
 
     for(SignalType st : modifiedPriority){
-        for(const std::string &chipletName : phyChipletNames[st]){
-            if(!checkConnectivity(st, phyChipletNodes[chipletName])){
-                if(!fixConnectivity(st, phyChipletNodes[chipletName])){
-                    std::cout << "[Physical Implementation] Chiplet " << chipletName << " of " << st << " fails to connect to current source! " << std::endl;
-                    // return false;
-                }
+        const std::vector<std::string> &chipletNames = phyChipletNames[st];
+        for(size_t i = 0; i < chipletNames.size(); ++i){
+            for(size_t node : phyChipletNodes[chipletNames[i]]){
+                assert(destinationChiplet[node] == -1);
+                destinationChiplet[node] = static_cast<int>(i);
+            }
+        }
+
+        std::vector<bool> chipletReached(chipletNames.size(), false);
+        checkConnectivity(st, chipletReached);
+        for(size_t i = 0; i < chipletNames.size(); ++i){
+            if(chipletReached[i]) continue;
+            if(fixConnectivity(st, static_cast<int>(i))){
+                // the committed region may also connect later chiplets, refresh them with one more sweep
+                checkConnectivity(st, chipletReached);
+            }else{
+                std::cout << "[Physical Implementation] Chiplet " << chipletNames[i] << " of " << st << " fails to connect to current source! " << std::endl;
+                // return false;
             }
         }
+
+        for(const std::string &chipletName : chipletNames){
+            for(size_t node : phyChipletNodes[chipletName]) destinationChiplet[node] = -1;
+        }
     }
 
     std::cout << "[Physical Implementation] All chiplet Passes connectivity test" << std::endl;
     
 
+    // node attributes below are plain flags indexed by node id
+    std::vector<bool> sourceReachableNodes(nodeCount, false);
+    std::vector<bool> sinkUsedNodes(nodeCount, false);
 
-    std::unordered_set<PDNNode *> sourceReachableNodes;
-    std::unordered_set<PDNNode *> sinkUsedNodes;
-
-    std::unordered_set<PDNNode *> mustExistNodes;
-    std::unordered_set<PDNNode *> notWorthGrowingNodes;
+    std::vector<bool> mustExistNodes(nodeCount, false);
+    std::vector<bool> notWorthGrowingNodes(nodeCount, false);
 
     
-    auto markReachableNodes = [&](SignalType st, const std::vector<PDNNode *> &seedNodes, std::unordered_set<PDNNode *> &reachableNodes){
-        std::unordered_set<PDNNode *> visisted;
-        std::queue<PDNNode *> q;
+    auto markReachableNodes = [&](SignalType st, const std::vector<size_t> &seedNodes, std::vector<bool> &reachableNodes){
+        visited.clear();
+        bfsQueue.clear();
 
-        for(PDNNode *node : seedNodes){
-            visisted.insert(node);
-            q.push(node);
+        for(size_t node : seedNodes){
+            if(visited.mark(node)) bfsQueue.push_back(node);
         }
 
-        auto pushNieghbors = [&](PDNNode *node, PDNEdge *neighborEdge){
-            if(neighborEdge == nullptr || neighborEdge->signal != st) return;
-            
-            PDNNode *neighborNode = (neighborEdge->n0 == node)? neighborEdge->n1 : neighborEdge->n0;
-            if(visisted.count(neighborNode) == 0){
-                visisted.insert(neighborNode);
-                q.push(neighborNode);
+        for(size_t head = 0; head < bfsQueue.size(); ++head){
+            size_t node = bfsQueue[head];
+            reachableNodes[node] = true;
+            for(pdn_edge_t neighborEdge : getNodeEdges(node)){
+                if(neighborEdge == PDN_EDGE_NONE || pdnEdges[neighborEdge].signal != st) continue;
+                
+                size_t neighborNode = pdnEdges[neighborEdge].getOtherNode(node);
+                if(visited.mark(neighborNode)) bfsQueue.push_back(neighborNode);
             }
-        };
-
-        while(!q.empty()){
-            PDNNode *node = q.front(); q.pop();
-
-            pushNieghbors(node, node->north);
-            pushNieghbors(node, node->south);
-            pushNieghbors(node, node->east);
-            pushNieghbors(node, node->west);
-
-            pushNieghbors(node, node->up);
-            pushNieghbors(node, node->down);
         }
-        reachableNodes.insert(visisted.begin(), visisted.end());
     };
 
     for(SignalType st : modifiedPriority){
@@ -1061,82 +1065,79 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
         
         
         // backward pass, from sink side bfs
-        std::vector<PDNNode *> signalAllSinks;
+        std::vector<size_t> signalAllSinks;
         for(const std::string &chipletName : phyChipletNames[st]){
-            for(PDNNode *node : phyChipletNodes[chipletName]){
+            for(size_t node : phyChipletNodes[chipletName]){
                 signalAllSinks.push_back(node);
             }
         }
         markReachableNodes(st, signalAllSinks, sinkUsedNodes);
 
-        mustExistNodes.insert(phySignalInNodes[st].begin(), phySignalInNodes[st].end());
-        mustExistNodes.insert(signalAllSinks.begin(), signalAllSinks.end());
+        for(size_t node : phySignalInNodes[st]) mustExistNodes[node] = true;
+        for(size_t node : signalAllSinks) mustExistNodes[node] = true;
     }
 
     
-    for(size_t layer = 0; layer < physicalGridLayer; ++layer){
-        for(size_t y = 0; y < physicalGridHeight; ++y){
-            for(size_t x = 0; x < physicalGridWidth; ++x){
-                PDNNode *node = physicalNodes[layer][y][x];
-                if(mustExistNodes.count(node)){
-                    if(!sourceReachableNodes.count(node) || !sinkUsedNodes.count(node)) notWorthGrowingNodes.insert(node);
-                    continue;
-                }
-                SignalType nodeSt = node->signal;
-
-                if(POWER_SIGNAL_SET.count(nodeSt) && (!sourceReachableNodes.count(node) || !sinkUsedNodes.count(node))){
-                    node->signal = SignalType::EMPTY;
-                    if(node->north != nullptr && POWER_SIGNAL_SET.count(node->north->signal)) node->north->signal = SignalType::EMPTY;
-                    if(node->south != nullptr && POWER_SIGNAL_SET.count(node->south->signal)) node->south->signal = SignalType::EMPTY;
-                    if(node->east != nullptr && POWER_SIGNAL_SET.count(node->east->signal)) node->east->signal = SignalType::EMPTY;
-                    if(node->west != nullptr && POWER_SIGNAL_SET.count(node->west->signal)) node->west->signal = SignalType::EMPTY;
-                    if(node->up != nullptr && POWER_SIGNAL_SET.count(node->up->signal)) node->up->signal = SignalType::EMPTY;
-                    if(node->down != nullptr && POWER_SIGNAL_SET.count(node->down->signal)) node->down->signal = SignalType::EMPTY;
-                }
-            }
+    auto clearPowerEdge = [&](pdn_edge_t e){
+        if(e != PDN_EDGE_NONE && POWER_SIGNAL_SET.count(pdnEdges[e].signal)) pdnEdges[e].signal = SignalType::EMPTY;
+    };
+
+    for(size_t nodeIdx = 0; nodeIdx < nodeCount; ++nodeIdx){
+        PDNNode &node = physicalNodes[nodeIdx];
+        bool onSourceSinkPath = sourceReachableNodes[nodeIdx] && sinkUsedNodes[nodeIdx];
+        if(mustExistNodes[nodeIdx]){
+            if(!onSourceSinkPath) notWorthGrowingNodes[nodeIdx] = true;
+            continue;
         }
-    }
 
-    // monitor empty nodes
-    std::unordered_set<PDNNode *> emptyNodes;
-    for(size_t layer = 0; layer < physicalGridLayer; ++layer){
-        for(size_t y = 0; y < physicalGridHeight; ++y){
-            for(size_t x = 0; x < physicalGridWidth; ++x){
-                PDNNode *node = physicalNodes[layer][y][x];
-                if(node->signal == SignalType::EMPTY) emptyNodes.insert(node);
-            }
+        if(POWER_SIGNAL_SET.count(node.signal) && !onSourceSinkPath){
+            node.signal = SignalType::EMPTY;
+            clearPowerEdge(node.north);
+            clearPowerEdge(node.south);
+            clearPowerEdge(node.east);
+            clearPowerEdge(node.west);
+            clearPowerEdge(node.up);
+            clearPowerEdge(node.down);
         }
     }
 
+    // monitor empty nodes, kept in node id order
+    std::vector<size_t> emptyNodes;
+    for(size_t nodeIdx = 0; nodeIdx < nodeCount; ++nodeIdx){
+        if(physicalNodes[nodeIdx].signal == SignalType::EMPTY) emptyNodes.push_back(nodeIdx);
+    }
+
     const int maxIteration = std::max(physicalGridWidth, physicalGridHeight);
     
     int iterationCounter = 0;
     while (!emptyNodes.empty() && (iterationCounter++ < maxIteration)) {
         // std::cout << "empty node cout = " << emptyNodes.size() << std::endl;
     
-        for (auto it = emptyNodes.begin(); it != emptyNodes.end(); ) {
-            PDNNode* node = *it;
+        size_t keptCount = 0;
+        for (size_t nodeIdx : emptyNodes) {
+            PDNNode &node = physicalNodes[nodeIdx];
 
             // Count neighboring power signals
             std::unordered_map<SignalType, int> edgeCount;
             edgeCount.reserve(6); // up to 6 neighbors
 
-            auto bump = [&](PDNEdge* p) {
-                if(p == nullptr) return;
-                PDNNode *neighbor = (p->n0 == node)? p->n1 : p->n0;
-                if(notWorthGrowingNodes.count(neighbor)) return;
+            auto bump = [&](pdn_edge_t p) {
+                if(p == PDN_EDGE_NONE) return;
+                size_t neighbor = pdnEdges[p].getOtherNode(nodeIdx);
+                if(notWorthGrowingNodes[neighbor]) return;
 
-                if (POWER_SIGNAL_SET.count(neighbor->signal)) {
-                    ++edgeCount[neighbor->signal];
+                SignalType neighborSig = physicalNodes[neighbor].signal;
+                if (POWER_SIGNAL_SET.count(neighborSig)) {
+                    ++edgeCount[neighborSig];
                 }
             };
 
-            bump(node->north);
-            bump(node->south);
-            bump(node->east);
-            bump(node->west);
-            bump(node->up);
-            bump(node->down);
+            bump(node.north);
+            bump(node.south);
+            bump(node.east);
+            bump(node.west);
+            bump(node.up);
+            bump(node.down);
 
             if (!edgeCount.empty()) {
                 if(priorityEmpty){
@@ -1145,7 +1146,7 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
                     for (auto itEC = std::next(edgeCount.begin()); itEC != edgeCount.end(); ++itEC) {
                         if (itEC->second > itMax->second) itMax = itEC;
                     }
-                    node->signal = itMax->first;
+                    node.signal = itMax->first;
 
                 }else{
                     // use priority logic to fill empty nodes
@@ -1158,13 +1159,13 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
                     for (auto itEC = std::next(edgeCount.begin()); itEC != edgeCount.end(); ++itEC) {
                         if (itEC->second > itMax->second) itMax = itEC;
                     }
-                    node->signal = itMax->first;
+                    node.signal = itMax->first;
                 }
-                it = emptyNodes.erase(it);
             } else {
-                ++it; // nothing to do for this node
+                emptyNodes[keptCount++] = nodeIdx; // nothing to do for this node
             }
         }
+        emptyNodes.resize(keptCount);
         growPDNNodeEdges();
     }
     std::cout << "[Physical Implementation] Complete Physical Implementation Empty Assignments" << std::endl;
@@ -1174,48 +1175,56 @@ bool PowerDistributionNetwork::connectivityAwareAssignment(const std::vector<Sig
 }
 
 void PowerDistributionNetwork::exportPhysicalToCircuitBySignal(SignalType st, const Technology &tch, const EqCktExtractor &extor, const std::string &filePath){
-    std::ofstream ofs(filePath, std::ios::out);
+    NodeNameTable nodeNames(physicalNodes);
+    exportPhysicalToCircuitBySignal(st, tch, extor, filePath, nodeNames);
+}
+
+void PowerDistributionNetwork::exportPhysicalToCircuitBySignal(SignalType st, const Technology &tch, const EqCktExtractor &extor, const std::string &filePath, const NodeNameTable &nodeNames) const {
+    NetlistWriter ofs(filePath);
     assert(ofs.is_open());
 
-    auto pointToNode = [](int layer, const Cord &c) -> std::string {
-        return "n" + std::to_string(c.x()) + "_" + std::to_string(c.y()) + "_" + std::to_string(layer);
+    auto pointToNode = [](int layer, const Cord &c) -> GridNodeName {
+        return GridNodeName{c.x(), c.y(), layer};
     };
 
-    ofs << "****** Equivalent Circuit Components ******" << std::endl;
-    ofs << ".SUBCKT ubump in out" << std::endl;
-    ofs << "R1 in mid " << tch.getMicrobumpResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getMicrobumpInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << ".SUBCKT via in out" << std::endl;
-    ofs << "R1 in mid " << extor.getInterposerViaResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << extor.getInterposerViaInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << ".SUBCKT edge in out" << std::endl;
-    ofs << "R1 in mid " << 2*extor.getInterposerResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << 2*extor.getInterposerInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << ".SUBCKT tsv in out" << std::endl;
-    ofs << "R1 in mid " << tch.getTsvResistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getTsvInductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << ".SUBCKT cfour in out" << std::endl;
-    ofs << "R1 in mid " << tch.getC4Resistance() << "m" << std::endl;
-    ofs << "L1 mid out " << tch.getC4Inductance() << "p" << std::endl;
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << "****** Equivalent Circuit ******" << std::endl;
-    int chipletcount = phyChipletNames[st].size();
+    ofs << "****** Equivalent Circuit Components ******" << '\n';
+    ofs << ".SUBCKT ubump in out" << '\n';
+    ofs << "R1 in mid " << tch.getMicrobumpResistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getMicrobumpInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << ".SUBCKT via in out" << '\n';
+    ofs << "R1 in mid " << extor.getInterposerViaResistance() << "m" << '\n';
+    ofs << "L1 mid out " << extor.getInterposerViaInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << ".SUBCKT edge in out" << '\n';
+    ofs << "R1 in mid " << 2*extor.getInterposerResistance() << "m" << '\n';
+    ofs << "L1 mid out " << 2*extor.getInterposerInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << ".SUBCKT tsv in out" << '\n';
+    ofs << "R1 in mid " << tch.getTsvResistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getTsvInductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << ".SUBCKT cfour in out" << '\n';
+    ofs << "R1 in mid " << tch.getC4Resistance() << "m" << '\n';
+    ofs << "L1 mid out " << tch.getC4Inductance() << "p" << '\n';
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << "****** Equivalent Circuit ******" << '\n';
+    // only find/at below: concurrent exports must not insert into the shared maps
+    auto chipletNamesIt = phyChipletNames.find(st);
+    assert(chipletNamesIt != phyChipletNames.end());
+    const std::vector<std::string> &chipletTitles = chipletNamesIt->second;
+    int chipletcount = chipletTitles.size();
     assert(chipletcount > 0);
-    std::vector<std::string> &chipletTitles = phyChipletNames[st];
 
     int uBumpCounter = 0;
     int viaCounter = 0;
@@ -1228,27 +1237,30 @@ void PowerDistributionNetwork::exportPhysicalToCircuitBySignal(SignalType st, co
     for(int i = 0; i < chipletcount; ++i){
         ofs << chipletTitles[i] << "_o ";
     }
-    ofs << "vss" << std::endl;
+    ofs << "vss" << '\n';
 
-    ofs << "*** MicroBumps ***" << std::endl;
+    ofs << "*** MicroBumps ***" << '\n';
     for(int ubidx = 0; ubidx < chipletcount; ++ubidx){
-        std::string instanceName = chipletTitles[ubidx];
-        for(PDNNode *pnode : phyChipletNodes[instanceName]){
-            ofs << "Xubump" << uBumpCounter++ << "_" <<  to_string(pnode) << " " << chipletTitles[ubidx] << "_o " << to_string(pnode) << " ubump" << std::endl;
+        const std::string &instanceName = chipletTitles[ubidx];
+        for(size_t pnode : phyChipletNodes.at(instanceName)){
+            std::string_view nodeName = nodeNames[pnode];
+            ofs << "Xubump" << uBumpCounter++ << "_" <<  nodeName << " " << chipletTitles[ubidx] << "_o " << nodeName << " ubump" << '\n';
         }
     }
 
-    ofs << "*** C4 Bumps ***" << std::endl;
-    for(const C4PinCluster *cluster : c4.signalTypeToAllClusters[st]){
-        std::string c4Node = pointToNode(m_metalLayerCount, cluster->representation);
-        ofs << "Xcfour" << c4Counter++ << " in " << c4Node << " cfour" << std::endl;
+    ofs << "*** C4 Bumps ***" << '\n';
+    static const std::unordered_set<C4PinCluster *> noClusters;
+    auto clustersIt = c4.signalTypeToAllClusters.find(st);
+    for(const C4PinCluster *cluster : ((clustersIt != c4.signalTypeToAllClusters.end())? clustersIt->second : noClusters)){
+        GridNodeName c4Node = pointToNode(m_metalLayerCount, cluster->representation);
+        ofs << "Xcfour" << c4Counter++ << " in " << c4Node << " cfour" << '\n';
         for(const Cord &c : cluster->pins){
-            ofs << "Xtsv" << tsvCounter++ << "_" << pointToNode(m_c4ConnectedMetalLayerIdx, c) << " ";
-            ofs << c4Node << " " << pointToNode(m_c4ConnectedMetalLayerIdx, c) << " tsv" << std::endl;
+            ofs << "Xtsv" << tsvCounter++ << "_" << nodeNames[calPhysicalNodeIdx(m_c4ConnectedMetalLayerIdx, c.y(), c.x())] << " ";
+            ofs << c4Node << " " << nodeNames[calPhysicalNodeIdx(m_c4ConnectedMetalLayerIdx, c.y(), c.x())] << " tsv" << '\n';
         }
     }
 
-    ofs << "*** Metal and Vias ***" << std::endl;
+    ofs << "*** Metal and Vias ***" << '\n';
     len_t pinXMin = 0;
     len_t pinXMax = physicalGridWidth - 1;
     len_t pinYMin = 0;
@@ -1260,115 +1272,117 @@ void PowerDistributionNetwork::exportPhysicalToCircuitBySignal(SignalType st, co
                 bool yOnEdge = (y == pinYMin) || (y == pinYMax);
 
                 if(xOnEdge && yOnEdge){
-                    ofs << "C" << capCounter++ << " " << pointToNode(layer, Cord(x, y)) << " vss " << extor.getInterposerCapacitanceCornerCell()/4.0 << "f" << std::endl;
+                    ofs << "C" << capCounter++ << " " << nodeNames[calPhysicalNodeIdx(layer, y, x)] << " vss " << extor.getInterposerCapacitanceCornerCell()/4.0 << "f" << '\n';
                 }else if(xOnEdge || yOnEdge){
-                    ofs << "C" << capCounter++ << " " << pointToNode(layer, Cord(x, y)) << " vss " << extor.getInterposerCapacitanceEdgeCell()/4.0 << "f" << std::endl;
+                    ofs << "C" << capCounter++ << " " << nodeNames[calPhysicalNodeIdx(layer, y, x)] << " vss " << extor.getInterposerCapacitanceEdgeCell()/4.0 << "f" << '\n';
                 }else{
-                    ofs << "C" << capCounter++ << " " << pointToNode(layer, Cord(x, y)) << " vss " << extor.getInterposerCapacitanceCenterCell()/4.0 << "f" << std::endl;
+                    ofs << "C" << capCounter++ << " " << nodeNames[calPhysicalNodeIdx(layer, y, x)] << " vss " << extor.getInterposerCapacitanceCenterCell()/4.0 << "f" << '\n';
                 }
             }
         }
     }
     
-    for(PDNEdge *edge : pdnEdgeOwner){
-        if(edge->signal != st) continue;
+    for(const PDNEdge &edge : pdnEdges){
+        if(edge.signal != st) continue;
         
-        if(edge->isVia){
-            ofs << "Xvia" << viaCounter++ << "_" << to_string(edge->n0) << "_" << to_string(edge->n1) << " ";
-            ofs << to_string(edge->n0) << " " << to_string(edge->n1) << " via" << std::endl;
+        std::string_view n0Name = nodeNames[edge.n0];
+        std::string_view n1Name = nodeNames[edge.n1];
+        if(edge.isVia){
+            ofs << "Xvia" << viaCounter++ << "_" << n0Name << "_" << n1Name << " ";
+            ofs << n0Name << " " << n1Name << " via" << '\n';
         }else{
-            ofs << "Xedge" << edgeCounter++ << "_" << to_string(edge->n0) << "_" << to_string(edge->n1) << " ";
-            ofs << to_string(edge->n0) << " " << to_string(edge->n1) << " edge" << std::endl;
+            ofs << "Xedge" << edgeCounter++ << "_" << n0Name << "_" << n1Name << " ";
+            ofs << n0Name << " " << n1Name << " edge" << '\n';
         }
     }
 
-    ofs << ".ENDS" << std::endl;
-    ofs << std::endl;
-
-    ofs << "****** Chiplet Load Model ******" << std::endl;
-    ofs << ".SUBCKT chiplet in vss Rval=50m Lval=200n Cval=30p Iload=1.0" << std::endl;
-    ofs << "Rpath in n1 Rval" << std::endl;
-    ofs << "Lpath n1 n2 Lval" << std::endl;
-    ofs << "Cpath n2 vss Cval" << std::endl;
-    ofs << "ILOAD n2 vss DC Iload" << std::endl;
-    ofs << ".ENDS" << std::endl;
-
-    ofs << std::endl;
-
-    ofs << "****** Input PCB model Model ******" << std::endl;
-    ofs << ".SUBCKT pcb vrm_low vrm_high out vss" << std::endl;
-    ofs << "Lpcbh vrm_high n1 " << tch.getPCBInductance() << "p" << std::endl;
-    ofs << "Rpcbh n1 out " << tch.getPCBResistance() << "u" << std::endl;
-    ofs << "Ldecaph out n2 " << tch.getPCBDecapInductance() <<  "n" << std::endl;
-    ofs << "Cdecap n2 n3 " << tch.getPCBDecapCapacitance() << "u" << std::endl;
-    ofs << "Rdecapl n3 vss " << tch.getPCBDecapResistance() << "u" << std::endl;
-    ofs << "Rpcbl n4 vss " << tch.getPCBResistance() << "u" << std::endl;
-    ofs << "Lpcbl vrm_low n4 " << tch.getPCBInductance() << "p" << std::endl;
+    ofs << ".ENDS" << '\n';
+    ofs << '\n';
+
+    ofs << "****** Chiplet Load Model ******" << '\n';
+    ofs << ".SUBCKT chiplet in vss Rval=50m Lval=200n Cval=30p Iload=1.0" << '\n';
+    ofs << "Rpath in n1 Rval" << '\n';
+    ofs << "Lpath n1 n2 Lval" << '\n';
+    ofs << "Cpath n2 vss Cval" << '\n';
+    ofs << "ILOAD n2 vss DC Iload" << '\n';
+    ofs << ".ENDS" << '\n';
+
+    ofs << '\n';
+
+    ofs << "****** Input PCB model Model ******" << '\n';
+    ofs << ".SUBCKT pcb vrm_low vrm_high out vss" << '\n';
+    ofs << "Lpcbh vrm_high n1 " << tch.getPCBInductance() << "p" << '\n';
+    ofs << "Rpcbh n1 out " << tch.getPCBResistance() << "u" << '\n';
+    ofs << "Ldecaph out n2 " << tch.getPCBDecapInductance() <<  "n" << '\n';
+    ofs << "Cdecap n2 n3 " << tch.getPCBDecapCapacitance() << "u" << '\n';
+    ofs << "Rdecapl n3 vss " << tch.getPCBDecapResistance() << "u" << '\n';
+    ofs << "Rpcbl n4 vss " << tch.getPCBResistance() << "u" << '\n';
+    ofs << "Lpcbl vrm_low n4 " << tch.getPCBInductance() << "p" << '\n';
     
-    ofs << "* --- Decap Bank for Broadband Z(f) Control ---" << std::endl;
-    ofs << "* 1 μF decap (low freq bulk, moderately damped)" << std::endl;
-    ofs << "Rdecap1u out n1u 0.05" << std::endl;
-    ofs << "Cdecap1u n1u vss 1u" << std::endl;
-    ofs << "* 100 nF decap (mid-low freq)" << std::endl;
-    ofs << "Rdecap100n out n100n 0.1" << std::endl;
-    ofs << "Cdecap100n n100n vss 100n" << std::endl;
-    ofs << "* 10 nF decap (mid freq)" << std::endl;
-    ofs << "Rdecap10n out n10n 0.2" << std::endl;
-    ofs << "Cdecap10n n10n vss 10n" << std::endl;
-    ofs << "* 1 nF decap (high freq)" << std::endl;
-    ofs << "Rdecap1n out n1n 0.3" << std::endl;
-    ofs << "Cdecap1n n1n vss 1n" << std::endl;
-    ofs << "* 100 pF decap (GHz damping)" << std::endl;
-    ofs << "Rdecap100p out n100p 0.5" << std::endl;
-    ofs << "Cdecap100p n100p vss 100p" << std::endl;
+    ofs << "* --- Decap Bank for Broadband Z(f) Control ---" << '\n';
+    ofs << "* 1 μF decap (low freq bulk, moderately damped)" << '\n';
+    ofs << "Rdecap1u out n1u 0.05" << '\n';
+    ofs << "Cdecap1u n1u vss 1u" << '\n';
+    ofs << "* 100 nF decap (mid-low freq)" << '\n';
+    ofs << "Rdecap100n out n100n 0.1" << '\n';
+    ofs << "Cdecap100n n100n vss 100n" << '\n';
+    ofs << "* 10 nF decap (mid freq)" << '\n';
+    ofs << "Rdecap10n out n10n 0.2" << '\n';
+    ofs << "Cdecap10n n10n vss 10n" << '\n';
+    ofs << "* 1 nF decap (high freq)" << '\n';
+    ofs << "Rdecap1n out n1n 0.3" << '\n';
+    ofs << "Cdecap1n n1n vss 1n" << '\n';
+    ofs << "* 100 pF decap (GHz damping)" << '\n';
+    ofs << "Rdecap100p out n100p 0.5" << '\n';
+    ofs << "Cdecap100p n100p vss 100p" << '\n';
     
-    ofs << ".ENDS" << std::endl;
+    ofs << ".ENDS" << '\n';
 
-    ofs << std::endl << std::endl;
-    ofs << "****** Main ******" << std::endl;
-    ofs << ".param VDD=1.0" << std::endl;
-    ofs << "VVRM vrm_high vrm_low DC VDD" << std::endl;
-    ofs << "Xpcb vrm_low vrm_high pcb_out 0 pcb" << std::endl;
+    ofs << '\n' << '\n';
+    ofs << "****** Main ******" << '\n';
+    ofs << ".param VDD=1.0" << '\n';
+    ofs << "VVRM vrm_high vrm_low DC VDD" << '\n';
+    ofs << "Xpcb vrm_low vrm_high pcb_out 0 pcb" << '\n';
     
     ofs << "Xeqckt pcb_out ";
     for(int i = 0; i < chipletcount; ++i){
         ofs << chipletTitles[i] << "_o ";
     }
-    ofs << "0" << " " << "eqckt" << std::endl;
+    ofs << "0" << " " << "eqckt" << '\n';
     
     for(int i = 0; i < chipletcount; ++i){
         ofs << "Xchiplet" << i << " " << chipletTitles[i] << "_o " << "0 chiplet ";
-        BallOut *bt = uBump.instanceToBallOutMap.at(chipletTitles[i]);
+        const BallOut *bt = uBump.instanceToBallOutMap.at(chipletTitles[i]);
         assert(bt != nullptr);
         ofs << "Rval=" << bt->getSeriesResistance() << "m Lval=" << bt->getSeriesInductance() << "n Cval=" << bt->getShuntCapacitance() << "p ";
-        ofs << "Iload=" << bt->getMaxCurrent() << std::endl;
+        ofs << "Iload=" << bt->getMaxCurrent() << '\n';
     }
 
-    ofs << std::endl;
-    ofs << "****** DC IR-Drop test ******" << std::endl;
-    ofs << ".OPTION POST=2 INGOLD=2 RUNLVL=6" << std::endl;
-    ofs << std::endl << ".op" << std::endl;
-    ofs << ".DC VDD 1.5 1.5 0.5" << std::endl;
+    ofs << '\n';
+    ofs << "****** DC IR-Drop test ******" << '\n';
+    ofs << ".OPTION POST=2 INGOLD=2 RUNLVL=6" << '\n';
+    ofs << '\n' << ".op" << '\n';
+    ofs << ".DC VDD 1.5 1.5 0.5" << '\n';
     
     ofs << ".print V(vrm_low) V(vrm_high) V(pcb_out) ";
     for(int i = 0; i < chipletcount; ++i){
         ofs << "V(" << chipletTitles[i] << "_o" << ") ";
     }
-    ofs << std::endl;
+    ofs << '\n';
 
-    ofs << ".measure DC irdroppcb param=\'V(vrm_high) - V(pcb_out)\'" << std::endl;
+    ofs << ".measure DC irdroppcb param=\'V(vrm_high) - V(pcb_out)\'" << '\n';
     for(int i = 0; i < chipletcount; ++i){
-        Rectangle chpletPlacement = uBump.instanceToRectangleMap[chipletTitles[i]];
+        Rectangle chpletPlacement = uBump.instanceToRectangleMap.at(chipletTitles[i]);
         Cord chipletLL = rec::getLL(chpletPlacement);
 
         ofs << ".measure DC IRDrop" << chipletTitles[i] << "_" <<  chipletLL.x() << "_" << chipletLL.y() << "_" << rec::getWidth(chpletPlacement) << "_" << rec::getHeight(chpletPlacement);
-        ofs << "_" << uBump.instanceToBallOutMap[chipletTitles[i]]->getMaxCurrent();
-        ofs << " param=\'V(pcb_out) - V(" << chipletTitles[i] << "_o" << ")\'" << std::endl;
+        ofs << "_" << uBump.instanceToBallOutMap.at(chipletTitles[i])->getMaxCurrent();
+        ofs << " param=\'V(pcb_out) - V(" << chipletTitles[i] << "_o" << ")\'" << '\n';
     }
-    ofs << std::endl;
+    ofs << '\n';
 
-    // ofs << ".OPTION RELTOL=1e-4 ABSTOL=1e-8 VNTOL=1e-6" << std::endl;
-    ofs << ".end" << std::endl;
+    // ofs << ".OPTION RELTOL=1e-4 ABSTOL=1e-8 VNTOL=1e-6" << '\n';
+    ofs << ".end" << '\n';
     ofs.close();
 }
 
@@ -1381,22 +1395,59 @@ void PowerDistributionNetwork::exportPhysicalToCircuit(const Technology &tch, co
     }
     
     
-    for(SignalType st : signalsToExport){
+    // node names are interned once, then every signal goes to its own file on its own thread
+    const NodeNameTable nodeNames(physicalNodes);
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i = 0; i < signalsToExport.size(); ++i){
+        SignalType st = signalsToExport[i];
         std::string filePath = filePathPrefix + to_string(st) + ".sp";
-        exportPhysicalToCircuitBySignal(st, tch, extor, filePath);
+        exportPhysicalToCircuitBySignal(st, tch, extor, filePath, nodeNames);
     }
 }
 
-void PowerDistributionNetwork::writeSnapShot(const std::string &fileName){
+uint64_t PowerDistributionNetwork::getCaseHash() const {
+    constexpr uint64_t FNV_OFFSET_BASIS = 1469598103934665603ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    auto mix = [&](uint64_t value){
+        for(int byte = 0; byte < 8; ++byte){
+            hash ^= (value >> (8 * byte)) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+    };
+
+    mix(m_gridWidth);
+    mix(m_gridHeight);
+    mix(m_metalLayerCount);
+    mix(m_viaLayerCount);
+    mix(m_ubumpConnectedMetalLayerIdx);
+    mix(m_c4ConnectedMetalLayerIdx);
+    for(const ObjectArray *pins : {static_cast<const ObjectArray *>(&uBump), static_cast<const ObjectArray *>(&c4)}){
+        for(const std::vector<SignalType> &row : pins->canvas){
+            for(SignalType st : row){
+                hash ^= static_cast<uint8_t>(st);
+                hash *= FNV_PRIME;
+            }
+        }
+    }
+    return hash;
+}
+
+bool PowerDistributionNetwork::writeSnapShot(const std::string &fileName, SnapshotFormat format) const {
+    if(format != SnapshotFormat::TEXT){
+        return PDNSnapshot::write(fileName, metalLayers, viaLayers, getCaseHash(), format == SnapshotFormat::BINARY_PACKED);
+    }
+
     std::ofstream ofs(fileName, std::ios::out);
 
     assert(ofs.is_open());
-    if(!ofs.is_open()) return;
+    if(!ofs.is_open()) return false;
 
     for(int layer = 0; layer < m_metalLayerCount; ++layer){
         for(int y = 0; y < m_gridHeight; ++y){
             for(int x = 0; x < m_gridWidth; ++x){
-                ofs << metalLayers[layer].canvas[y][x] << std::endl;
+                ofs << metalLayers[layer].canvas[y][x] << '\n';
             }
         }
     }
@@ -1404,20 +1455,55 @@ void PowerDistributionNetwork::writeSnapShot(const std::string &fileName){
     for(int layer = 0; layer < m_viaLayerCount; ++layer){
         for(int y = 0; y < m_pinHeight; ++y){
             for(int x = 0; x < m_pinWidth; ++x){
-                ofs << viaLayers[layer].canvas[y][x] << std::endl;
+                ofs << viaLayers[layer].canvas[y][x] << '\n';
             }
         }
     }
 
     ofs.close();
+    return true;
 }
 
-void PowerDistributionNetwork::readSnapShot(const std::string &fileName){
+bool PowerDistributionNetwork::readSnapShot(const std::string &fileName){
+
+    if(PDNSnapshot::isSnapshotFile(fileName)){
+        PDNSnapshot snapshot;
+        if(!snapshot.open(fileName)) return false;
+
+        const PDNSnapshotHeader &header = snapshot.getHeader();
+        bool dimensionsMatch = (int(header.metalLayerCount) == m_metalLayerCount) && (int(header.gridWidth) == m_gridWidth) && (int(header.gridHeight) == m_gridHeight) &&
+                               (int(header.viaLayerCount) == m_viaLayerCount) && (int(header.pinWidth) == m_pinWidth) && (int(header.pinHeight) == m_pinHeight);
+        if(!dimensionsMatch){
+            std::cout << "[PowerX:Snapshot] Error: Snapshot dimensions differ from the case: " << fileName << std::endl;
+            return false;
+        }
+        if(header.caseHash != getCaseHash()){
+            std::cout << "[PowerX:Snapshot] Error: Snapshot was taken from a different case: " << fileName << std::endl;
+            return false;
+        }
+
+        for(int layer = 0; layer < m_metalLayerCount; ++layer){
+            for(int y = 0; y < m_gridHeight; ++y){
+                for(int x = 0; x < m_gridWidth; ++x){
+                    metalLayers[layer].canvas[y][x] = snapshot.getMetalCell(layer, y, x);
+                }
+            }
+        }
+
+        for(int layer = 0; layer < m_viaLayerCount; ++layer){
+            for(int y = 0; y < m_pinHeight; ++y){
+                for(int x = 0; x < m_pinWidth; ++x){
+                    viaLayers[layer].canvas[y][x] = snapshot.getViaCell(layer, y, x);
+                }
+            }
+        }
+        return true;
+    }
     
     std::ifstream ifs(fileName, std::ios::in);
 
     assert(ifs.is_open());
-    if(!ifs.is_open()) return;
+    if(!ifs.is_open()) return false;
 
     for(int layer = 0; layer < m_metalLayerCount; ++layer){
         for(int y = 0; y < m_gridHeight; ++y){
@@ -1436,9 +1522,10 @@ void PowerDistributionNetwork::readSnapShot(const std::string &fileName){
     }
 
     ifs.close();
+    return true;
 }
 
-void markPinPadsWithoutSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const std::unordered_set<SignalType> &avoidSignalTypes){
+void markPinPadsWithoutSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const EnumSet<SignalType> &avoidSignalTypes){
     len_t gridHeight = gridCanvas.size();
     assert(gridHeight > 0);
     len_t gridWidth = gridCanvas[0].size();
@@ -1465,7 +1552,7 @@ void markPinPadsWithoutSignals(std::vector<std::vector<SignalType>> &gridCanvas,
     }
 }
 
-void markPinPadsWithSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const std::unordered_set<SignalType> &signalTypes){
+void markPinPadsWithSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const EnumSet<SignalType> &signalTypes){
     len_t gridHeight = gridCanvas.size();
     assert(gridHeight > 0);
     len_t gridWidth = gridCanvas[0].size();
@@ -1497,56 +1584,22 @@ void runClustering(const std::vector<std::vector<SignalType>> &canvas, std::vect
     if (rows == 0) return;
     const int cols = static_cast<int>(canvas[0].size());
 
-    // [NEW] Clear label map
     label.clear();
 
-    // Resize cluster to match canvas and initialize all to -1
-    cluster.resize(rows);
-    for (std::size_t i = 0; i < cluster.size(); ++i) {
-        cluster[i].resize(cols, -1);
-    }
+    std::vector<int> flatLabels;
+    std::vector<SignalType> labelSignals;
+    int labelCount = labelCanvas(canvas, flatLabels, labelSignals);
 
-    int currentLabel = 0;
-    
-    const int dRow[4] = {-1, 1, 0, 0};
-    const int dCol[4] = {0, 0, -1, 1};
-    
+    cluster.assign(rows, std::vector<int>(cols, -1));
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
-            if (cluster[i][j] != -1) continue;
-            
-            SignalType currentType = canvas[i][j];
-            
-            std::queue<std::pair<int, int>> bfsQueue;
-            bfsQueue.push(std::make_pair(i, j));
-            cluster[i][j] = currentLabel;
-            
-            while (!bfsQueue.empty()) {
-                std::pair<int, int> cell = bfsQueue.front();
-                bfsQueue.pop();
-                int x = cell.first;
-                int y = cell.second;
-                
-                for (int dir = 0; dir < 4; ++dir) {
-                    int newX = x + dRow[dir];
-                    int newY = y + dCol[dir];
-                    
-                    if (newX < 0 || newX >= rows || newY < 0 || newY >= cols)
-                        continue;
-                    if (canvas[newX][newY] != currentType)
-                        continue;
-                    if (cluster[newX][newY] != -1)
-                        continue;
-                    
-                    cluster[newX][newY] = currentLabel;
-                    bfsQueue.push(std::make_pair(newX, newY));
-                }
-            }
-            
-            label[currentType].push_back(currentLabel);
-            ++currentLabel;
+            cluster[i][j] = flatLabels[i * cols + j];
         }
     }
+
+    for (int cl = 0; cl < labelCount; ++cl) {
+        label[labelSignals[cl]].push_back(cl);
+    }
 }
 
 std::unordered_map<SignalType, DoughnutPolygonSet> collectDoughnutPolygons(const std::vector<std::vector<SignalType>> &canvas){
@@ -42,6 +42,10 @@
 
 #include "pdnNode.hpp"
 #include "pdnEdge.hpp"
+#include "netlistWriter.hpp"
+#include "pdnSnapshot.hpp"
+#include "inputTokenizer.hpp"
+#include "designSpec.hpp"
 
 class PowerDistributionNetwork{
 protected:
@@ -55,6 +59,9 @@ protected:
     int m_ubumpConnectedMetalLayerIdx;
     int m_c4ConnectedMetalLayerIdx;
 
+    // derives the via count and connected layers from the grid and allocates the layer arrays
+    void initialiseLayers();
+
 public:
     MicroBump uBump;
     C4Bump c4;
@@ -72,13 +79,20 @@ public:
 
     std::vector<SignalType> phySOI;
     std::unordered_map<SignalType, std::vector<std::string>> phyChipletNames;
-    std::unordered_map<std::string, std::vector<PDNNode *>> phyChipletNodes; 
-    std::unordered_map<SignalType, std::vector<PDNNode *>> phySignalInNodes;
+    std::unordered_map<std::string, std::vector<size_t>> phyChipletNodes; 
+    EnumMap<SignalType, std::vector<size_t>> phySignalInNodes;
 
-    std::vector<PDNEdge *> pdnEdgeOwner;
-    std::vector<std::vector<std::vector<PDNNode *>>> physicalNodes;
+    // flat physical network, node ids are derived from (layer, y, x) by calPhysicalNodeIdx
+    // and edges are referenced by their position in pdnEdges
+    std::vector<PDNNode> physicalNodes;
+    std::vector<PDNEdge> pdnEdges;
 
     PowerDistributionNetwork(const std::string &fileName);
+    // reads the TECHNOLOGY, PDN_PREPLACE, MICROBUMP and C4 sections from one mapping of the .pinout, a malformed
+    // section, ballout or preplace file throws InputError
+    explicit PowerDistributionNetwork(const MappedFile &pinoutFile);
+    // the same sections taken from memory, spec is expected to be checked already (see PowerXDesign::validate)
+    explicit PowerDistributionNetwork(const DesignSpec &spec);
     ~PowerDistributionNetwork();
 
     inline int getGridWidth() const {return this->m_gridWidth;}
@@ -89,6 +103,7 @@ public:
     inline int getViaLayerCount() const {return this->m_viaLayerCount;}
     inline int getuBumpConnectedMetalLayerIdx() const {return this->m_ubumpConnectedMetalLayerIdx;}
     inline int getc4ConnectedmetalLayerIdx() const {return this->m_c4ConnectedMetalLayerIdx;}
+    inline size_t calPhysicalNodeIdx(size_t layer, size_t y, size_t x) const {return (layer * physicalGridHeight + y) * physicalGridWidth + x;}
 
     
     bool checkOnePiece(int layer);
@@ -103,20 +118,26 @@ public:
 
 
     void buildPhysicalImplementation();
+    pdn_edge_t addPhysicalEdge(size_t n0, size_t n1, bool isVia);
     void growPDNNodeEdges();
     bool connectivityAwareAssignment(const std::vector<SignalType> &priority = {});
     void exportPhysicalToCircuitBySignal(SignalType st, const Technology &tch, const EqCktExtractor &extor, const std::string &filePath);
+    // reads the network only, so signals sharing one NodeNameTable may be exported concurrently
+    void exportPhysicalToCircuitBySignal(SignalType st, const Technology &tch, const EqCktExtractor &extor, const std::string &filePath, const NodeNameTable &nodeNames) const;
     void exportPhysicalToCircuit(const Technology &tch, const EqCktExtractor &extor, const std::string &filePath);
 
-    void writeSnapShot(const std::string &fileName);
-    void readSnapShot(const std::string &fileName);
+    // FNV-1a over the dimensions and the uBump / C4 pin canvases, identifies the case a snapshot belongs to
+    uint64_t getCaseHash() const;
+    bool writeSnapShot(const std::string &fileName, SnapshotFormat format = SnapshotFormat::BINARY_PACKED) const;
+    // binary snapshots are recognised by their magic and read through mmap, anything else is read as the text format
+    bool readSnapShot(const std::string &fileName);
 
     friend bool visualisePhysicalImplementation(const PowerDistributionNetwork &pdn, int layer, const std::string &filePath);
 
 };
 
-void markPinPadsWithoutSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const std::unordered_set<SignalType> &avoidSignalTypes);
-void markPinPadsWithSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const std::unordered_set<SignalType> &signalTypes);
+void markPinPadsWithoutSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const EnumSet<SignalType> &avoidSignalTypes);
+void markPinPadsWithSignals(std::vector<std::vector<SignalType>> &gridCanvas, const std::vector<std::vector<SignalType>> &pinCanvas, const EnumSet<SignalType> &signalTypes);
 
 void runClustering(const std::vector<std::vector<SignalType>> &canvas, std::vector<std::vector<int>> &cluster, std::unordered_map<SignalType, std::vector<int>> &label);
 
@@ -30,6 +30,7 @@
 // 2. Boost Library:
 
 // 3. Texo Library:
+#include "enumMap.hpp"
 
 enum class SignalType : uint8_t{
     
@@ -51,7 +52,12 @@ enum class SignalType : uint8_t{
     UNKNOWN = 15,
 };
 
-const std::unordered_set<SignalType> POWER_SIGNAL_SET = {
+template <>
+struct EnumTraits<SignalType>{
+    static constexpr size_t count = 16;
+};
+
+const EnumSet<SignalType> POWER_SIGNAL_SET = {
     SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
     SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
 };
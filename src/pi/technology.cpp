@@ -21,15 +21,17 @@
 #include <iostream>
 #include <cassert>
 #include <string>
-#include <regex>
+#include <string_view>
 #include <fstream>
 #include <algorithm>
+#include <cctype>
 #include <cmath>
 
 // 2. Boost Library:
 
 // 3. Texo Library:
 #include "technology.hpp"
+#include "inputTokenizer.hpp"
 
 const std::unordered_map<std::string, std::string> Technology::m_standardUnits = {
     {"DIE_GLOBAL_WIRE_PITCH", "nm"},
@@ -108,33 +110,57 @@ Technology::Technology():
 Technology::Technology(const std::string &filePath){
     Technology();
     std::unordered_map<char, int> magnitude_map = {{'f', -15}, {'p', -12}, {'n', -9}, {'u', -6}, {'m', -3}, {'c', -2}};
-    std::ifstream file(filePath);
+    MappedFile file(filePath);
     assert(file.is_open());
-
-    std::string lineBuffer;
-    while(std::getline(file, lineBuffer)){
-        if (lineBuffer.empty()|| lineBuffer.find("#") == 0) continue; // whole line comment
-        
-        size_t comment_pos = lineBuffer.find_first_of("#");
-        if (comment_pos != std::string::npos) {
-                lineBuffer = lineBuffer.substr(0, comment_pos);  // Remove everything after "#"
+    InputTokenizer tokenizer(file.view());
+
+    // length of the leading -?\d+(\.\d+)?([eE][-+]?\d+)? literal of text, 0 if there is none
+    auto numberPrefixLength = [](std::string_view text) -> size_t {
+        auto digitsFrom = [&](size_t pos) -> size_t {
+            size_t end = pos;
+            while((end < text.size()) && std::isdigit(static_cast<unsigned char>(text[end]))) ++end;
+            return end;
+        };
+        size_t pos = (!text.empty() && (text[0] == '-'))? 1 : 0;
+        size_t end = digitsFrom(pos);
+        if(end == pos) return 0;
+        if((end < text.size()) && (text[end] == '.')){
+            size_t fractionEnd = digitsFrom(end + 1);
+            if(fractionEnd == end + 1) return end;
+            end = fractionEnd;
         }
+        if((end < text.size()) && ((text[end] == 'e') || (text[end] == 'E'))){
+            size_t exponentPos = end + 1;
+            if((exponentPos < text.size()) && ((text[exponentPos] == '-') || (text[exponentPos] == '+'))) ++exponentPos;
+            size_t exponentEnd = digitsFrom(exponentPos);
+            if(exponentEnd != exponentPos) end = exponentEnd;
+        }
+        return end;
+    };
 
+    std::string_view lineBuffer;
+    while(tokenizer.nextLine(lineBuffer)){
         
-        // process the line
+        // process the line, KEY = VALUE UNIT
 
         std::string key, value, unit;
-        std::regex pattern(R"(\s*([\w_]+)\s*=\s*(-?\d+(?:\.\d+)?(?:[eE][-+]?\d+)?)\s*([\w.\-^/µ]*)\s*)");
-        std::smatch match;
-        if(!std::regex_match(lineBuffer, match, pattern)){
+        size_t equalPos = lineBuffer.find('=');
+        std::string_view keyText = (equalPos == std::string_view::npos)? std::string_view() : InputTokenizer::trim(lineBuffer.substr(0, equalPos));
+        std::string_view valueText = (equalPos == std::string_view::npos)? std::string_view() : InputTokenizer::trim(lineBuffer.substr(equalPos + 1));
+        size_t valueLength = numberPrefixLength(valueText);
+        std::string_view unitText = InputTokenizer::trim(valueText.substr(valueLength));
+
+        bool validKey = !keyText.empty() && std::all_of(keyText.begin(), keyText.end(), [](char c){ return std::isalnum(static_cast<unsigned char>(c)) || (c == '_'); });
+        bool validUnit = std::none_of(unitText.begin(), unitText.end(), [](char c){ return std::isspace(static_cast<unsigned char>(c)); });
+        if(!validKey || (valueLength == 0) || !validUnit){
             std::cout << "[PowerX:TchParser] Unmatch string: " << lineBuffer << std::endl;
             continue;
         }
 
-        key = match[1].str();
+        key = std::string(keyText);
         std::transform(key.begin(), key.end(), key.begin(), ::toupper);
-        value = match[2].str();
-        unit = match[3].str();
+        value = std::string(valueText.substr(0, valueLength));
+        unit = std::string(unitText);
 
         if(m_standardUnits.find(key) == m_standardUnits.end()){
             std::cout << "[PowerX:TchParser] Unmatch parameter: " << key << std::endl;
@@ -430,6 +456,4 @@ Technology::Technology(const std::string &filePath){
 
     }
 
-    file.close();
-
 }
\ No newline at end of file
@@ -0,0 +1,410 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 17:52:14
+//  Module Name:        transientSimulator.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Fixed-step transient simulation of an extracted PDNCircuit
+//                      under per-chiplet current steps. Every series R-L-C branch
+//                      is replaced by its backward-Euler or trapezoidal companion
+//                      model, so the nodal matrix stays constant and is factorised
+//                      once for the whole run. Probe waveforms are written in a
+//                      compact binary format (see writeWaveforms)
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+#include "dsu.hpp"
+#include "transientSimulator.hpp"
+
+// 4. PETSc
+#include "petscksp.h"
+
+double LoadStep::getCurrent(double time) const {
+    if(time <= stepTime) return baseCurrent;
+    if(riseTime <= 0.0 || time >= stepTime + riseTime) return stepCurrent;
+    return baseCurrent + (stepCurrent - baseCurrent) * (time - stepTime) / riseTime;
+}
+
+TransientSimulator::TransientSimulator(const PDNCircuit &circuit, IntegrationMethod method, double timeStep, double stopTime):
+    m_circuit(circuit), m_method(method), m_timeStep(timeStep), m_stopTime(stopTime), m_sampleCount(0), m_elapsedMs(0.0) {
+
+    assert(timeStep > 0.0 && stopTime >= timeStep);
+
+    for(int k = 0; k < circuit.getPortCount(); ++k){
+        double maxCurrent = circuit.portCurrents[k];
+        m_loads.push_back(LoadStep{0.1 * maxCurrent, maxCurrent, 10 * timeStep, 10 * timeStep});
+    }
+
+    addProbe(circuit.supplyNode);
+    for(int k = 0; k < circuit.getPortCount(); ++k){
+        addProbe(circuit.portNodes[k]);
+        if(circuit.portLoadNodes[k] != circuit.portNodes[k]) addProbe(circuit.portLoadNodes[k]);
+    }
+}
+
+void TransientSimulator::setLoadStep(int port, const LoadStep &load){
+    assert(port >= 0 && port < static_cast<int>(m_loads.size()));
+    m_loads[port] = load;
+}
+
+void TransientSimulator::addProbe(int node){
+    assert(node >= 0 && node < m_circuit.getNodeCount());
+    m_probeNodes.push_back(node);
+    m_probeNames.push_back(m_circuit.nodeNames[node]);
+}
+
+bool TransientSimulator::solveOperatingPoint(std::vector<double> &nodeVoltages) const {
+    const PDNCircuit &ckt = m_circuit;
+    const int nodeCount = ckt.getNodeCount();
+    const int groundIdx = nodeCount;
+
+    // capacitors are open at DC, nodes without a DC path to ground are left at 0 V
+    auto toDSU = [&](int n){return (n == PDN_CIRCUIT_GROUND)? groundIdx : n;};
+    DSU dsu(nodeCount + 1);
+    for(const PDNBranch &b : ckt.branches){
+        if(b.conductsDC()) dsu.unite(toDSU(b.n0), toDSU(b.n1));
+    }
+    const int groundRoot = dsu.find(groundIdx);
+
+    std::vector<PetscInt> nodeToRow(nodeCount, -1);
+    PetscInt rowCount = 0;
+    for(int n = 0; n < nodeCount; ++n){
+        if(dsu.find(n) == groundRoot) nodeToRow[n] = rowCount++;
+    }
+
+    nodeVoltages.assign(nodeCount, 0.0);
+    if(rowCount == 0) return true;
+
+    auto rowOf = [&](int n) -> PetscInt {return (n == PDN_CIRCUIT_GROUND)? -1 : nodeToRow[n];};
+
+    std::vector<PetscInt> rowNonZeros(rowCount, 1);
+    for(const PDNBranch &b : ckt.branches){
+        if(!b.conductsDC()) continue;
+        PetscInt r0 = rowOf(b.n0);
+        PetscInt r1 = rowOf(b.n1);
+        if(r0 >= 0 && r1 >= 0){
+            rowNonZeros[r0]++;
+            rowNonZeros[r1]++;
+        }
+    }
+
+    Mat G;
+    Vec I, V;
+    MatCreateSeqAIJ(PETSC_COMM_SELF, rowCount, rowCount, 0, rowNonZeros.data(), &G);
+    VecCreateSeq(PETSC_COMM_SELF, rowCount, &I);
+    VecDuplicate(I, &V);
+    VecSet(I, 0.0);
+
+    for(const PDNBranch &b : ckt.branches){
+        if(!b.conductsDC()) continue;
+        PetscScalar g = 1.0 / b.resistance;
+        PetscInt r0 = rowOf(b.n0);
+        PetscInt r1 = rowOf(b.n1);
+
+        if(r0 >= 0) MatSetValue(G, r0, r0, g, ADD_VALUES);
+        if(r1 >= 0) MatSetValue(G, r1, r1, g, ADD_VALUES);
+        if(r0 >= 0 && r1 >= 0){
+            MatSetValue(G, r0, r1, -g, ADD_VALUES);
+            MatSetValue(G, r1, r0, -g, ADD_VALUES);
+        }
+        // i(n0 -> n1) = g * (v0 - v1 + E)
+        if(b.seriesVoltage != 0.0){
+            if(r0 >= 0) VecSetValue(I, r0, -g * b.seriesVoltage, ADD_VALUES);
+            if(r1 >= 0) VecSetValue(I, r1, g * b.seriesVoltage, ADD_VALUES);
+        }
+    }
+
+    for(int k = 0; k < ckt.getPortCount(); ++k){
+        PetscInt row = nodeToRow[ckt.portLoadNodes[k]];
+        if(row >= 0) VecSetValue(I, row, -m_loads[k].getCurrent(0.0), ADD_VALUES);
+    }
+
+    MatAssemblyBegin(G, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(G, MAT_FINAL_ASSEMBLY);
+    MatSetOption(G, MAT_SPD, PETSC_TRUE);
+    VecAssemblyBegin(I);
+    VecAssemblyEnd(I);
+
+    KSP ksp;
+    KSPCreate(PETSC_COMM_SELF, &ksp);
+    KSPSetOperators(ksp, G, G);
+    KSPSetType(ksp, KSPPREONLY);
+    PC pc;
+    KSPGetPC(ksp, &pc);
+    PCSetType(pc, PCCHOLESKY);
+    PCFactorSetMatSolverType(pc, MATSOLVERCHOLMOD);
+    KSPSetFromOptions(ksp);
+    KSPSolve(ksp, I, V);
+
+    KSPConvergedReason reason;
+    KSPGetConvergedReason(ksp, &reason);
+    if(reason >= 0){
+        const PetscScalar *v;
+        VecGetArrayRead(V, &v);
+        for(int n = 0; n < nodeCount; ++n){
+            if(nodeToRow[n] >= 0) nodeVoltages[n] = PetscRealPart(v[nodeToRow[n]]);
+        }
+        VecRestoreArrayRead(V, &v);
+    }
+
+    KSPDestroy(&ksp);
+    VecDestroy(&V);
+    VecDestroy(&I);
+    MatDestroy(&G);
+
+    return reason >= 0;
+}
+
+bool TransientSimulator::run(){
+    auto startTime = std::chrono::steady_clock::now();
+
+    const PDNCircuit &ckt = m_circuit;
+    const PetscInt nodeCount = ckt.getNodeCount();
+    const size_t branchCount = ckt.branches.size();
+    const double h = m_timeStep;
+    const bool trapezoidal = (m_method == IntegrationMethod::TRAPEZOIDAL);
+    const size_t stepCount = static_cast<size_t>(std::llround(m_stopTime / h));
+    const size_t probeCount = m_probeNodes.size();
+
+    // a resistance-free DC branch has no companion conductance (R = L = 0) and no DC conductance (R = 0)
+    auto nameOf = [&](int n) -> std::string {return (n == PDN_CIRCUIT_GROUND)? std::string("0") : ckt.nodeNames[n];};
+    for(size_t bi = 0; bi < branchCount; ++bi){
+        const PDNBranch &b = ckt.branches[bi];
+        if(b.conductsDC() && !(b.resistance > 0.0)){
+            std::cout << "[Transient] Branch " << nameOf(b.n0) << " - " << nameOf(b.n1);
+            std::cout << " of " << ckt.signal << " has no resistance, short it in the circuit instead" << std::endl;
+            return false;
+        }
+    }
+
+    // 1. consistent initial state from the DC operating point under the base load currents
+    std::vector<double> nodeVoltages;
+    if(!solveOperatingPoint(nodeVoltages)){
+        std::cout << "[Transient] DC operating point of " << ckt.signal << " fails" << std::endl;
+        return false;
+    }
+    auto voltageOf = [&](int n) -> double {return (n == PDN_CIRCUIT_GROUND)? 0.0 : nodeVoltages[n];};
+
+    // per branch state: current, capacitor voltage and element voltage u = v0 - v1 + E
+    std::vector<double> branchCurrent(branchCount, 0.0);
+    std::vector<double> capVoltage(branchCount, 0.0);
+    std::vector<double> elementVoltage(branchCount, 0.0);
+    // companion model: i = (u - e) / Z
+    std::vector<double> companionG(branchCount, 0.0);
+    std::vector<double> historyE(branchCount, 0.0);
+
+    for(size_t bi = 0; bi < branchCount; ++bi){
+        const PDNBranch &b = ckt.branches[bi];
+        elementVoltage[bi] = voltageOf(b.n0) - voltageOf(b.n1) + b.seriesVoltage;
+        if(b.conductsDC()){
+            branchCurrent[bi] = elementVoltage[bi] / b.resistance;
+        }else{
+            capVoltage[bi] = elementVoltage[bi];
+        }
+
+        double Z = b.resistance + (trapezoidal? 2.0 : 1.0) * b.inductance / h;
+        if(!b.conductsDC()) Z += h / ((trapezoidal? 2.0 : 1.0) * b.capacitance);
+        companionG[bi] = 1.0 / Z;
+    }
+
+    // 2. the companion conductances do not change with time, assemble and factorise once
+    std::vector<PetscInt> rowNonZeros(nodeCount, 1);
+    for(const PDNBranch &b : ckt.branches){
+        if(b.n0 != PDN_CIRCUIT_GROUND && b.n1 != PDN_CIRCUIT_GROUND){
+            rowNonZeros[b.n0]++;
+            rowNonZeros[b.n1]++;
+        }
+    }
+
+    Mat G;
+    Vec rhs, solution;
+    MatCreateSeqAIJ(PETSC_COMM_SELF, nodeCount, nodeCount, 0, rowNonZeros.data(), &G);
+    VecCreateSeq(PETSC_COMM_SELF, nodeCount, &rhs);
+    VecDuplicate(rhs, &solution);
+
+    for(size_t bi = 0; bi < branchCount; ++bi){
+        const PDNBranch &b = ckt.branches[bi];
+        PetscScalar g = companionG[bi];
+        if(b.n0 != PDN_CIRCUIT_GROUND) MatSetValue(G, b.n0, b.n0, g, ADD_VALUES);
+        if(b.n1 != PDN_CIRCUIT_GROUND) MatSetValue(G, b.n1, b.n1, g, ADD_VALUES);
+        if(b.n0 != PDN_CIRCUIT_GROUND && b.n1 != PDN_CIRCUIT_GROUND){
+            MatSetValue(G, b.n0, b.n1, -g, ADD_VALUES);
+            MatSetValue(G, b.n1, b.n0, -g, ADD_VALUES);
+        }
+    }
+    MatAssemblyBegin(G, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(G, MAT_FINAL_ASSEMBLY);
+    MatSetOption(G, MAT_SPD, PETSC_TRUE);
+
+    KSP ksp;
+    KSPCreate(PETSC_COMM_SELF, &ksp);
+    KSPSetOperators(ksp, G, G);
+    KSPSetType(ksp, KSPPREONLY);
+    PC pc;
+    KSPGetPC(ksp, &pc);
+    PCSetType(pc, PCCHOLESKY);
+    PCFactorSetMatSolverType(pc, MATSOLVERCHOLMOD);
+    KSPSetFromOptions(ksp);
+    KSPSetUp(ksp);
+
+    m_sampleCount = stepCount + 1;
+    m_samples.assign(m_sampleCount * probeCount, 0.0f);
+    auto recordSample = [&](size_t sample){
+        for(size_t p = 0; p < probeCount; ++p){
+            m_samples[sample * probeCount + p] = static_cast<float>(nodeVoltages[m_probeNodes[p]]);
+        }
+    };
+    recordSample(0);
+
+    // 3. march in time, each step is one forward/backward substitution
+    bool solved = true;
+    for(size_t step = 1; step <= stepCount; ++step){
+        const double time = step * h;
+
+        PetscScalar *r;
+        VecGetArray(rhs, &r);
+        std::fill(r, r + nodeCount, 0.0);
+
+        for(size_t bi = 0; bi < branchCount; ++bi){
+            const PDNBranch &b = ckt.branches[bi];
+            double e;
+            if(trapezoidal){
+                double rTerm = b.resistance - 2.0 * b.inductance / h;
+                if(!b.conductsDC()) rTerm += h / (2.0 * b.capacitance);
+                e = rTerm * branchCurrent[bi] - elementVoltage[bi] + (b.conductsDC()? 0.0 : 2.0 * capVoltage[bi]);
+            }else{
+                e = capVoltage[bi] - (b.inductance / h) * branchCurrent[bi];
+            }
+            historyE[bi] = e;
+
+            // i(n0 -> n1) = g * (v0 - v1) + g * (E - e)
+            double source = companionG[bi] * (b.seriesVoltage - e);
+            if(b.n0 != PDN_CIRCUIT_GROUND) r[b.n0] -= source;
+            if(b.n1 != PDN_CIRCUIT_GROUND) r[b.n1] += source;
+        }
+        for(int k = 0; k < ckt.getPortCount(); ++k){
+            r[ckt.portLoadNodes[k]] -= m_loads[k].getCurrent(time);
+        }
+        VecRestoreArray(rhs, &r);
+
+        KSPSolve(ksp, rhs, solution);
+        KSPConvergedReason reason;
+        KSPGetConvergedReason(ksp, &reason);
+        if(reason < 0){
+            std::cout << "[Transient] Solve of " << ckt.signal << " fails at t = " << time << " s" << std::endl;
+            solved = false;
+            break;
+        }
+
+        const PetscScalar *v;
+        VecGetArrayRead(solution, &v);
+        for(PetscInt n = 0; n < nodeCount; ++n) nodeVoltages[n] = PetscRealPart(v[n]);
+        VecRestoreArrayRead(solution, &v);
+
+        // advance the branch states
+        for(size_t bi = 0; bi < branchCount; ++bi){
+            const PDNBranch &b = ckt.branches[bi];
+            double u = voltageOf(b.n0) - voltageOf(b.n1) + b.seriesVoltage;
+            double i = companionG[bi] * (u - historyE[bi]);
+            if(!b.conductsDC()){
+                if(trapezoidal) capVoltage[bi] += h / (2.0 * b.capacitance) * (branchCurrent[bi] + i);
+                else capVoltage[bi] += h / b.capacitance * i;
+            }
+            branchCurrent[bi] = i;
+            elementVoltage[bi] = u;
+        }
+
+        recordSample(step);
+    }
+
+    KSPDestroy(&ksp);
+    VecDestroy(&solution);
+    VecDestroy(&rhs);
+    MatDestroy(&G);
+
+    m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return solved;
+}
+
+double TransientSimulator::getMaxDroop(int port, double *droopTime) const {
+    const int loadNode = m_circuit.portLoadNodes[port];
+    auto probeIt = std::find(m_probeNodes.begin(), m_probeNodes.end(), loadNode);
+    assert(probeIt != m_probeNodes.end());
+    const size_t probe = static_cast<size_t>(probeIt - m_probeNodes.begin());
+    if(m_sampleCount == 0) return 0.0;
+
+    double initial = getProbeValue(0, probe);
+    double minimum = initial;
+    size_t minimumSample = 0;
+    for(size_t s = 1; s < m_sampleCount; ++s){
+        double value = getProbeValue(s, probe);
+        if(value < minimum){
+            minimum = value;
+            minimumSample = s;
+        }
+    }
+    if(droopTime != nullptr) *droopTime = minimumSample * m_timeStep;
+    return initial - minimum;
+}
+
+void TransientSimulator::printReport(std::ostream &os) const {
+    os << "[Transient] " << m_circuit.signal << ": " << ((m_method == IntegrationMethod::TRAPEZOIDAL)? "trapezoidal" : "backward Euler");
+    os << ", " << m_sampleCount << " samples of " << m_timeStep << " s in " << m_elapsedMs << " ms" << std::endl;
+    for(int k = 0; k < m_circuit.getPortCount(); ++k){
+        double droopTime = 0.0;
+        double droop = getMaxDroop(k, &droopTime);
+        os << "[Transient]     " << m_circuit.portNames[k] << ": max droop = " << droop * 1e3 << " mV at " << droopTime << " s" << std::endl;
+    }
+}
+
+bool TransientSimulator::writeWaveforms(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+    assert(ofs.is_open());
+    if(!ofs.is_open()) return false;
+
+    const uint32_t version = PDN_WAVEFORM_VERSION;
+    const uint32_t probeCount = static_cast<uint32_t>(m_probeNodes.size());
+    const uint64_t sampleCount = m_sampleCount;
+    const double startTime = 0.0;
+
+    ofs.write(PDN_WAVEFORM_MAGIC, sizeof(PDN_WAVEFORM_MAGIC));
+    ofs.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    ofs.write(reinterpret_cast<const char *>(&probeCount), sizeof(probeCount));
+    ofs.write(reinterpret_cast<const char *>(&sampleCount), sizeof(sampleCount));
+    ofs.write(reinterpret_cast<const char *>(&startTime), sizeof(startTime));
+    ofs.write(reinterpret_cast<const char *>(&m_timeStep), sizeof(m_timeStep));
+
+    for(const std::string &name : m_probeNames){
+        uint32_t nameLength = static_cast<uint32_t>(name.size());
+        ofs.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+        ofs.write(name.data(), nameLength);
+    }
+
+    ofs.write(reinterpret_cast<const char *>(m_samples.data()), m_samples.size() * sizeof(float));
+
+    ofs.close();
+    return true;
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 17:52:14
+//  Module Name:        transientSimulator.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Fixed-step transient simulation of an extracted PDNCircuit
+//                      under per-chiplet current steps. Every series R-L-C branch
+//                      is replaced by its backward-Euler or trapezoidal companion
+//                      model, so the nodal matrix stays constant and is factorised
+//                      once for the whole run. Probe waveforms are written in a
+//                      compact binary format (see writeWaveforms)
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TRANSIENT_SIMULATOR_H__
+#define __TRANSIENT_SIMULATOR_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "pdnCircuit.hpp"
+
+enum class IntegrationMethod : uint8_t{
+    BACKWARD_EULER, TRAPEZOIDAL
+};
+
+// load current of one chiplet: baseCurrent until stepTime, then a linear ramp of riseTime to stepCurrent
+struct LoadStep{
+    double baseCurrent; // A
+    double stepCurrent; // A
+    double stepTime;    // s
+    double riseTime;    // s, 0 for an ideal step
+
+    double getCurrent(double time) const;
+};
+
+// magic and version of the waveform files written by TransientSimulator::writeWaveforms
+constexpr char PDN_WAVEFORM_MAGIC[4] = {'P', 'X', 'W', 'F'};
+constexpr uint32_t PDN_WAVEFORM_VERSION = 1;
+
+class TransientSimulator{
+private:
+    const PDNCircuit &m_circuit;
+    IntegrationMethod m_method;
+    double m_timeStep;
+    double m_stopTime;
+    std::vector<LoadStep> m_loads;
+
+    std::vector<int> m_probeNodes;
+    std::vector<std::string> m_probeNames;
+    // [sample][probe]
+    std::vector<float> m_samples;
+    size_t m_sampleCount;
+    double m_elapsedMs;
+
+    bool solveOperatingPoint(std::vector<double> &nodeVoltages) const;
+
+public:
+    // every chiplet defaults to a step from 10% to 100% of its maximum current after 10 time steps, rising over 10 time steps
+    TransientSimulator(const PDNCircuit &circuit, IntegrationMethod method, double timeStep, double stopTime);
+
+    void setLoadStep(int port, const LoadStep &load);
+    // pcb_out and every chiplet_o / die node are probed by default
+    void addProbe(int node);
+
+    bool run();
+
+    inline size_t getSampleCount() const {return m_sampleCount;}
+    inline double getElapsedMs() const {return m_elapsedMs;}
+    inline const std::vector<std::string> &getProbeNames() const {return m_probeNames;}
+    double getProbeValue(size_t sample, size_t probe) const {return m_samples[sample * m_probeNodes.size() + probe];}
+
+    // difference between the die voltage at t = 0 and its minimum over the run
+    double getMaxDroop(int port, double *droopTime = nullptr) const;
+
+    void printReport(std::ostream &os = std::cout) const;
+
+    // layout, host byte order: magic[4] | u32 version | u32 probeCount | u64 sampleCount | f64 startTime | f64 timeStep
+    // | probeCount x (u32 nameLength | name) | sampleCount x probeCount x f32 volts
+    bool writeWaveforms(const std::string &filePath) const;
+};
+
+#endif // __TRANSIENT_SIMULATOR_H__
@@ -52,6 +52,7 @@
 #include "voronoiPDNGen.hpp"
 #include "doughnutPolygon.hpp"
 #include "doughnutPolygonSet.hpp"
+#include "componentLabeller.hpp"
 
 // 4. FLUTE
 #include "flute.h"
@@ -143,7 +144,7 @@ void VoronoiPDNGen::markPreplacedAndInsertPads(){
         this->viaLayers[i].markPreplacedToCanvas();
     }
 
-    std::unordered_set<SignalType> viaToMetalSignalTypes(POWER_SIGNAL_SET.begin(), POWER_SIGNAL_SET.end());
+    EnumSet<SignalType> viaToMetalSignalTypes(POWER_SIGNAL_SET);
     viaToMetalSignalTypes.insert(SignalType::SIGNAL);
     // insert pads for the uBump connecting metal layer
     markPinPadsWithSignals(this->metalLayers[m_ubumpConnectedMetalLayerIdx].canvas, this->uBump.canvas, POWER_SIGNAL_SET);
@@ -164,19 +165,19 @@ void VoronoiPDNGen::markPreplacedAndInsertPads(){
 
 void VoronoiPDNGen::initPointsAndSegments(){
     
-    const std::unordered_set<SignalType> uBumpSOI = {
+    const EnumSet<SignalType> uBumpSOI = {
         SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
         SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
     };
-    const std::unordered_set<SignalType> c4SOI = {
+    const EnumSet<SignalType> c4SOI = {
         SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
         SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
     };
-    const std::unordered_set<SignalType> viaSOI = {
+    const EnumSet<SignalType> viaSOI = {
         SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
         SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
 };
-    const std::unordered_set<SignalType> metalSOI = {
+    const EnumSet<SignalType> metalSOI = {
         SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
         SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
     };
@@ -354,7 +355,7 @@ void VoronoiPDNGen::connectLayers(int upLayerIdx, int downLayerIdx){
     assert(downLayerIdx <= m_c4ConnectedMetalLayerIdx);
     assert(downLayerIdx == (upLayerIdx+1));
 
-    const std::unordered_set<SignalType> metalSOI = {
+    const EnumSet<SignalType> metalSOI = {
         SignalType::POWER_1, SignalType::POWER_2, SignalType::POWER_3, SignalType::POWER_4, SignalType::POWER_5,
         SignalType::POWER_6, SignalType::POWER_7, SignalType::POWER_8, SignalType::POWER_9, SignalType::POWER_10
     };
@@ -1151,113 +1152,80 @@ void VoronoiPDNGen::exportToCanvas(std::vector<std::vector<SignalType>> &canvas,
 }
 
 void VoronoiPDNGen::obstacleAwareLegalisation(int layerIdx){
-    std::unordered_set<SignalType> ignoreSignalType = {SignalType::OBSTACLE, SignalType::SIGNAL, SignalType::GROUND, SignalType::EMPTY};
-    std::unordered_map<SignalType, DoughnutPolygonSet> dpSetMap = collectDoughnutPolygons(metalLayers[layerIdx].canvas);
+    EnumSet<SignalType> ignoreSignalType = {SignalType::OBSTACLE, SignalType::SIGNAL, SignalType::GROUND, SignalType::EMPTY};
+    std::vector<std::vector<SignalType>> &canvas = metalLayers[layerIdx].canvas;
 
-    for(std::unordered_map<SignalType, DoughnutPolygonSet>::iterator it = dpSetMap.begin(); it != dpSetMap.end(); ++it){
-        SignalType st = it->first;
-        if(ignoreSignalType.count(st)) continue;
-        if(dps::getShapesCount(it->second) <= 1) continue;
-
-        int splitSize = dps::getShapesCount(it->second);
-        for(int sidx = 0; sidx < splitSize; ++sidx){
-            DoughnutPolygon fragdp = it->second.at(sidx);
-            std::vector<Cord> containGrids = dp::getContainedGrids(fragdp);
-            bool mustKeep = false;
-            for(const Cord &c : containGrids){
-                if(this->preplaceOfLayers[layerIdx][c.y()][c.x()] != SignalType::EMPTY){
-                    mustKeep = true;
-                    break;
-                }
-            }
-            if(!mustKeep){
-                // std::cout << "Remove one fragment" << std::endl;
-                // empty out the part
-                for(const Cord &c : containGrids){
-                    this->metalLayers[layerIdx].setCanvas(c, SignalType::EMPTY);
-                }
-            }
-        }
-    }
+    std::vector<int> labels;
+    std::vector<SignalType> labelSignals;
+    int labelCount = labelCanvas(canvas, labels, labelSignals);
 
-}
+    // only signals split into more than one fragment are legalised
+    std::vector<int> fragmentCount(toIdx(SignalType::UNKNOWN) + 1, 0);
+    for(int cl = 0; cl < labelCount; ++cl) ++fragmentCount[toIdx(labelSignals[cl])];
 
-void VoronoiPDNGen::floatingPlaneReconnection(int layerIdx){
-    std::unordered_set<SignalType> ignoreSignalType = {SignalType::OBSTACLE, SignalType::SIGNAL, SignalType::GROUND, SignalType::EMPTY};
-    std::unordered_map<SignalType, DoughnutPolygonSet> dpSetMap = collectDoughnutPolygons(metalLayers[layerIdx].canvas);
-    if(dpSetMap.count(SignalType::EMPTY) == 0) return;
-
-    DoughnutPolygonSet targetdps = dpSetMap.at(SignalType::EMPTY);
-    for(int fragidx = 0; fragidx < dps::getShapesCount(targetdps); ++fragidx){
-        DoughnutPolygon frag = targetdps.at(fragidx);
-        std::unordered_map<SignalType, int> poll;
-        std::vector<Cord> winding;
-        for(auto it = frag.begin(); it != frag.end(); ++it){
-            winding.push_back(Cord(*it));
+    std::vector<bool> mustKeep(labelCount, false);
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            if(this->preplaceOfLayers[layerIdx][j][i] != SignalType::EMPTY) mustKeep[labels[j * m_gridWidth + i]] = true;
         }
-        winding.push_back(winding[0]);
-        for(int widx = 0; widx < (winding.size() - 1); ++widx){
-            Line longLine(winding.at(widx), winding.at(widx + 1));
-            if(longLine.getOrient() == eOrientation2D::HORIZONTAL){
-                len_t sy = longLine.getLow().y();
-                for(len_t vx = longLine.getLow().x(); vx < longLine.getHigh().x(); ++vx){
-                    Cord upCord(vx, sy);
-                    Cord downCord(vx, sy-1);
-
-                    bool upCordValid = ((vx >= 0) && (vx < m_gridWidth) && (sy >= 0) && (sy < m_gridHeight));
-                    bool downCordValid =  ((vx >= 0) && (vx < m_gridWidth) && ((sy-1) >= 0) && ((sy-1) < m_gridHeight));
-
-                    if(!upCordValid || !downCordValid) continue;
-
-                    SignalType uptype = metalLayers[layerIdx].canvas[upCord.y()][upCord.x()];
-                    SignalType downtype = metalLayers[layerIdx].canvas[downCord.y()][downCord.x()];
-
-                    poll[uptype] = (poll.count(uptype) == 0)? 1 : (poll[uptype] + 1);
-                    poll[downtype] = (poll.count(downtype) == 0)? 1 : (poll[downtype] + 1);
-                }
-
-            }else{ // eOrientation2D::VERTICAL
-                len_t sx = longLine.getLow().x();
-                for(len_t vy = longLine.getLow().y(); vy < longLine.getHigh().y(); ++vy){
-                    Cord rightCord(sx, vy);
-                    Cord leftCord(sx-1, vy);
-
-                    bool rightCordValid = ((sx >= 0) && (sx < m_gridWidth) && (vy >= 0) && (vy < m_gridHeight));
-                    bool leftCordValid = (((sx-1) >= 0) && ((sx-1) < m_gridWidth) && (vy >= 0) && (vy < m_gridHeight));
-
-                    if(!rightCordValid || ! leftCordValid) continue;
+    }
 
-                    SignalType righttype = metalLayers[layerIdx].canvas[rightCord.y()][rightCord.x()];
-                    SignalType lefttype = metalLayers[layerIdx].canvas[leftCord.y()][leftCord.x()];
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            int cl = labels[j * m_gridWidth + i];
+            SignalType st = labelSignals[cl];
+            if(ignoreSignalType.count(st)) continue;
+            if(fragmentCount[toIdx(st)] <= 1) continue;
+            // empty out the part
+            if(!mustKeep[cl]) this->metalLayers[layerIdx].setCanvas(j, i, SignalType::EMPTY);
+        }
+    }
 
-                    poll[righttype] = (poll.count(righttype) == 0)? 1 : (poll[righttype] + 1) ;
-                    poll[lefttype] = (poll.count(lefttype) == 0)? 1 : (poll[lefttype] + 1);
+}
 
-                }
+void VoronoiPDNGen::floatingPlaneReconnection(int layerIdx){
+    EnumSet<SignalType> ignoreSignalType = {SignalType::OBSTACLE, SignalType::SIGNAL, SignalType::GROUND, SignalType::EMPTY};
+    std::vector<std::vector<SignalType>> &canvas = metalLayers[layerIdx].canvas;
+
+    std::vector<int> labels;
+    int fragCount = labelCanvasSignal(canvas, SignalType::EMPTY, labels);
+    if(fragCount == 0) return;
+
+    // each empty fragment polls the signals across its boundary, one vote per boundary edge
+    std::vector<std::vector<int>> poll(fragCount, std::vector<int>(toIdx(SignalType::UNKNOWN) + 1, 0));
+    auto vote = [&](int frag, int x, int y){
+        SignalType st = canvas[y][x];
+        if(!ignoreSignalType.count(st)) ++poll[frag][toIdx(st)];
+    };
 
-            }
-        }
-        
-        // start painting to new color
-        for(const SignalType st : ignoreSignalType){
-            poll.erase(st);
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            int frag = labels[j * m_gridWidth + i];
+            if(frag == COMPONENT_LABEL_NONE) continue;
+            if(i != 0) vote(frag, i - 1, j);
+            if(i != (m_gridWidth - 1)) vote(frag, i + 1, j);
+            if(j != 0) vote(frag, i, j - 1);
+            if(j != (m_gridHeight - 1)) vote(frag, i, j + 1);
         }
+    }
 
-        if(poll.empty()) continue;
-
+    std::vector<SignalType> paintSignal(fragCount, SignalType::EMPTY);
+    for(int frag = 0; frag < fragCount; ++frag){
         int maxVote = 0;
-        SignalType maxVoteSig = SignalType::EMPTY;
-
-        for(std::unordered_map<SignalType, int>::const_iterator cit = poll.begin(); cit != poll.end(); ++cit){
-            if(cit->second > maxVote){
-                maxVote = cit->second;
-                maxVoteSig = cit->first;
+        for(size_t sigIdx = 0; sigIdx < poll[frag].size(); ++sigIdx){
+            if(poll[frag][sigIdx] > maxVote){
+                maxVote = poll[frag][sigIdx];
+                paintSignal[frag] = static_cast<SignalType>(sigIdx);
             }
         }
+    }
 
-        std::vector<Cord> paintTarget = dp::getContainedGrids(frag);
-        for(const Cord & c : paintTarget){
-            metalLayers[layerIdx].setCanvas(c, maxVoteSig);
+    // start painting to new color
+    for(int j = 0; j < m_gridHeight; ++j){
+        for(int i = 0; i < m_gridWidth; ++i){
+            int frag = labels[j * m_gridWidth + i];
+            if(frag == COMPONENT_LABEL_NONE) continue;
+            if(paintSignal[frag] != SignalType::EMPTY) metalLayers[layerIdx].setCanvas(j, i, paintSignal[frag]);
         }
     }
 
@@ -0,0 +1,354 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 19:40:08
+//  Module Name:        powerxLibrary.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Entry point of libpowerx, the flow of bin/pwrx for
+//                      callers that keep their design in memory
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <span>
+#include <chrono>
+#include <cassert>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_set>
+#include <unordered_map>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "powerxLibrary.hpp"
+#include "diffusionEngine.hpp"
+#include "pdnCircuit.hpp"
+#include "irDropAnalyser.hpp"
+
+// 4. PETSc Library
+#include "petscksp.h"
+
+namespace {
+#ifndef PETSC_HAVE_THREADSAFETY
+    // held by the design running a PETSc stage, PETSc without --with-threadsafety cannot serve two at once
+    std::mutex petscStageMutex;
+#endif
+}
+
+const char *to_string(PowerXStage stage){
+    switch(stage){
+        case PowerXStage::NONE:         return "NONE";
+        case PowerXStage::PREPROCESS:   return "PREPROCESS";
+        case PowerXStage::MCF:          return "MCF";
+        case PowerXStage::FILLING:      return "FILLING";
+        case PowerXStage::POSTPROCESS:  return "POSTPROCESS";
+        case PowerXStage::PHYSICAL:     return "PHYSICAL";
+        case PowerXStage::ANALYSIS:     return "ANALYSIS";
+        default:                        return "UNKNOWN";
+    }
+}
+
+bool PowerXDesign::initialiseRuntime(int *argc, char ***argv){
+    PetscBool initialised = PETSC_FALSE;
+    PetscInitialized(&initialised);
+    if(initialised) return true;
+    return PetscInitialize(argc, argv, NULL, NULL) == 0;
+}
+
+void PowerXDesign::finaliseRuntime(){
+    PetscBool initialised = PETSC_FALSE;
+    PetscInitialized(&initialised);
+    if(initialised) PetscFinalize();
+}
+
+bool PowerXDesign::validate(const DesignSpec &spec, std::string &error){
+    auto fail = [&error](const std::string &reason) -> bool {
+        error = reason;
+        return false;
+    };
+    auto validRotation = [](BallOutRotation rotation) -> bool {
+        return (rotation != BallOutRotation::EMPTY) && (rotation != BallOutRotation::UNKNOWN);
+    };
+    // dimensions of ballOut once rotated
+    auto rotatedSize = [](const BallOut &ballOut, BallOutRotation rotation, int &width, int &height){
+        bool swapped = (rotation == BallOutRotation::R90) || (rotation == BallOutRotation::R270);
+        width = swapped? ballOut.getBallOutHeight() : ballOut.getBallOutWidth();
+        height = swapped? ballOut.getBallOutWidth() : ballOut.getBallOutHeight();
+    };
+
+    if((spec.gridWidth <= 0) || (spec.gridHeight <= 0)) return fail("grid size must be positive");
+    if(spec.metalLayerCount < 2) return fail("at least 2 metal layers are needed");
+    const int pinWidth = spec.gridWidth + 1;
+    const int pinHeight = spec.gridHeight + 1;
+
+    // a BallOut built in memory already rejected EMPTY cells and ragged rows, a default constructed one is empty
+    std::unordered_map<std::string, const BallOut *> ballOuts;
+    for(const BallOut &ballOut : spec.ballOuts){
+        if(ballOut.getName().empty()) return fail("ballout without a name");
+        if(ballOut.ballOutArray.empty()) return fail("ballout " + ballOut.getName() + " is empty");
+        if(ballOut.getRotation() != BallOutRotation::R0) return fail("ballout " + ballOut.getName() + " must be given as R0");
+        if(!ballOuts.emplace(ballOut.getName(), &ballOut).second) return fail("repeated ballout " + ballOut.getName());
+    }
+
+    std::unordered_set<std::string> instances;
+    for(const ChipletPlacement &chiplet : spec.chiplets){
+        if(chiplet.instanceName.empty()) return fail("chiplet without an instance name");
+        if(!instances.insert(chiplet.instanceName).second) return fail("repeated chiplet instance " + chiplet.instanceName);
+
+        std::unordered_map<std::string, const BallOut *>::const_iterator it = ballOuts.find(chiplet.ballOutName);
+        if(it == ballOuts.end()) return fail("chiplet " + chiplet.instanceName + " uses unknown ballout " + chiplet.ballOutName);
+        if(!validRotation(chiplet.rotation)) return fail("chiplet " + chiplet.instanceName + " has no valid rotation");
+
+        int width, height;
+        rotatedSize(*(it->second), chiplet.rotation, width, height);
+        if((chiplet.x < 0) || (chiplet.y < 0) || (chiplet.x + width > pinWidth) || (chiplet.y + height > pinHeight)){
+            return fail("chiplet " + chiplet.instanceName + " lies outside the interposer");
+        }
+    }
+
+    const C4Layout &c4 = spec.c4Layout;
+    if(spec.c4BallOut.ballOutArray.empty()) return fail("C4 ballout is empty");
+    if(!validRotation(spec.c4Rotation)) return fail("C4 ballout has no valid rotation");
+    if((c4.clusterPinCountWidth <= 0) || (c4.clusterPinCountHeight <= 0)) return fail("C4 cluster pin count must be positive");
+    if((c4.clusterPitchWidth < c4.clusterPinCountWidth) || (c4.clusterPitchHeight < c4.clusterPinCountHeight)) return fail("C4 cluster pitch cannot be smaller than the cluster");
+    if((c4.clusterCountWidth <= 0) || (c4.clusterCountHeight <= 0)) return fail("C4 cluster count must be positive");
+    if((c4.leftBorder < 0) || (c4.rightBorder < 0) || (c4.upBorder < 0) || (c4.downBorder < 0)) return fail("C4 borders cannot be negative");
+    if(c4.leftBorder + c4.rightBorder + c4.clusterPinCountWidth + c4.clusterPitchWidth*(c4.clusterCountWidth - 1) != pinWidth){
+        return fail("C4 borders, clusters and pitch do not add up to the pin width " + std::to_string(pinWidth));
+    }
+    if(c4.downBorder + c4.upBorder + c4.clusterPinCountHeight + c4.clusterPitchHeight*(c4.clusterCountHeight - 1) != pinHeight){
+        return fail("C4 borders, clusters and pitch do not add up to the pin height " + std::to_string(pinHeight));
+    }
+    int c4Width, c4Height;
+    rotatedSize(spec.c4BallOut, spec.c4Rotation, c4Width, c4Height);
+    if((c4Width < c4.clusterCountWidth) || (c4Height < c4.clusterCountHeight)) return fail("C4 ballout is smaller than the cluster count");
+
+    auto validPreplaced = [&](const std::vector<std::unordered_map<SignalType, std::vector<Cord>>> &layers, size_t layerCount, int width, int height, const char *kind) -> bool {
+        if(layers.size() > layerCount) return fail(std::string(kind) + " preplace given for " + std::to_string(layers.size()) + " layers, only " + std::to_string(layerCount) + " exist");
+        for(size_t layer = 0; layer < layers.size(); ++layer){
+            // the canvas is painted in map order, so a cord listed under two signals would end up with either of them
+            std::unordered_map<Cord, SignalType> signalOfCord;
+            for(const auto &[st, cords] : layers[layer]){
+                if((st == SignalType::EMPTY) || (st == SignalType::UNKNOWN)) return fail(std::string(kind) + " preplace of layer " + std::to_string(layer) + " has no signal");
+                for(const Cord &c : cords){
+                    if((c.x() < 0) || (c.y() < 0) || (c.x() >= width) || (c.y() >= height)){
+                        return fail(std::string(kind) + " preplace of layer " + std::to_string(layer) + " lies outside the layer");
+                    }
+                    std::pair<std::unordered_map<Cord, SignalType>::iterator, bool> inserted = signalOfCord.emplace(c, st);
+                    if(!inserted.second && (inserted.first->second != st)){
+                        return fail(std::string(kind) + " preplace of layer " + std::to_string(layer) + " lists cord (" + std::to_string(c.x()) + ", " + std::to_string(c.y()) + ") under more than one signal");
+                    }
+                }
+            }
+        }
+        return true;
+    };
+    if(!validPreplaced(spec.metalPreplaced, spec.metalLayerCount, spec.gridWidth, spec.gridHeight, "metal")) return false;
+    if(!validPreplaced(spec.viaPreplaced, spec.metalLayerCount - 1, pinWidth, pinHeight, "via")) return false;
+
+    // the engine reaches for the four metal cells around every via it may use, which the outermost pins do not have,
+    // so every via layer must block that ring (the shipped cases preplace it as OBSTACLE)
+    for(int layer = 0; layer < spec.metalLayerCount - 1; ++layer){
+        std::unordered_set<Cord> blocked;
+        if(static_cast<size_t>(layer) < spec.viaPreplaced.size()){
+            for(const auto &[st, cords] : spec.viaPreplaced[layer]){
+                bool blocking = (st == SignalType::OBSTACLE) || (st == SignalType::GROUND) || (st == SignalType::SIGNAL) || (st == SignalType::OVERLAP);
+                if(blocking) blocked.insert(cords.begin(), cords.end());
+            }
+        }
+        for(int j = 0; j < pinHeight; ++j){
+            for(int i = 0; i < pinWidth; ++i){
+                bool onBorder = (i == 0) || (j == 0) || (i == pinWidth - 1) || (j == pinHeight - 1);
+                if(onBorder && (blocked.count(Cord(i, j)) == 0)){
+                    return fail("via layer " + std::to_string(layer) + " leaves border pin (" + std::to_string(i) + ", " + std::to_string(j) + ") unblocked");
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+PowerXDesign::PowerXDesign(const DesignSpec &spec, std::shared_ptr<const Technology> technology, GRBEnv *grbEnv)
+    : m_technology(technology? technology : std::make_shared<const Technology>()), m_grbEnv(grbEnv), m_completedStage(PowerXStage::NONE) {
+
+    if(!validate(spec, m_error)) return;
+    m_extractor = std::make_unique<EqCktExtractor>(*m_technology);
+    m_engine = std::make_unique<DiffusionEngine>(spec);
+}
+
+PowerXDesign::~PowerXDesign(){
+
+}
+
+void PowerXDesign::setMetric(const std::string &name, double value){
+    for(std::pair<std::string, double> &metric : m_metrics){
+        if(metric.first == name){
+            metric.second = value;
+            return;
+        }
+    }
+    m_metrics.emplace_back(name, value);
+}
+
+bool PowerXDesign::runUntil(PowerXStage stage){
+    if(!isValid()) return false;
+    while(m_completedStage < stage){
+        PowerXStage next = static_cast<PowerXStage>(static_cast<uint8_t>(m_completedStage) + 1);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if(!runStage(next)) return false;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        setMetric(std::string("runtime_") + to_string(next), elapsed.count());
+        m_completedStage = next;
+    }
+    return true;
+}
+
+bool PowerXDesign::runStage(PowerXStage stage){
+    DiffusionEngine &dse = *m_engine;
+
+    // the filler and the analysers build PETSc matrices and solvers
+    if(stage >= PowerXStage::FILLING){
+        PetscBool initialised = PETSC_FALSE;
+        PetscInitialized(&initialised);
+        if(!initialised){
+            m_error = std::string("PowerXDesign::initialiseRuntime() must be called before the ") + to_string(stage) + " stage";
+            return false;
+        }
+    }
+#ifndef PETSC_HAVE_THREADSAFETY
+    std::unique_lock<std::mutex> petscStageLock(petscStageMutex, std::defer_lock);
+    if((stage >= PowerXStage::FILLING) && !petscStageLock.try_lock()){
+        m_error = std::string("another design is running a PETSc stage, PETSc is not configured --with-threadsafety so the ") + to_string(stage) + " stage cannot run alongside it";
+        return false;
+    }
+#endif
+
+    switch(stage){
+        case PowerXStage::PREPROCESS:{
+            dse.markPreplacedAndInsertPadsOnCanvas();
+            dse.markObstaclesOnCanvas();
+            dse.initialiseGraphWithPreplaced();
+            dse.fillEnclosedRegions();
+            dse.writeBackToPDN();
+            return true;
+        }
+
+        case PowerXStage::MCF:{
+            dse.initialiseMCFSolver();
+            std::string error;
+            if(!dse.runMCFSolver("", 0, m_grbEnv, &error)){
+                m_error = "MCF stage failed: " + error;
+                return false;
+            }
+            dse.postMCFLocalRepairTop(false);
+            dse.writeBackToPDN();
+
+            size_t blankCountMetal = 0;
+            size_t blankCountVia = 0;
+            for(int layer = 0; layer < dse.getMetalLayerCount(); ++layer){
+                for(const std::vector<SignalType> &row : dse.metalLayers[layer].canvas){
+                    for(SignalType st : row) if(st == SignalType::EMPTY) blankCountMetal++;
+                }
+            }
+            for(int layer = 0; layer < dse.getViaLayerCount(); ++layer){
+                for(const std::vector<SignalType> &row : dse.viaLayers[layer].canvas){
+                    for(SignalType st : row) if(st == SignalType::EMPTY) blankCountVia++;
+                }
+            }
+            setMetric("empty_metal", double(blankCountMetal));
+            setMetric("empty_via", double(blankCountVia));
+            return true;
+        }
+
+        case PowerXStage::FILLING:{
+            dse.initialiseFiller();
+            dse.initialiseSignalTreesX();
+            dse.runInitialEvaluationX();
+            dse.evaluateAndFillX();
+            dse.writeBackToPDN();
+
+            setMetric("worst_vdrop", dse.initWorseVdrop);
+            setMetric("weighted_avg_vdrop", dse.initWeightedAvgVdrop);
+            setMetric("power_loss", dse.initTotalPowerLoss);
+            return true;
+        }
+
+        case PowerXStage::POSTPROCESS:{
+            dse.assignVias();
+            for(int i = 0; i < dse.getMetalLayerCount(); ++i){
+                dse.removeFloatingPlanes(i);
+            }
+            for(int i = 0; i < dse.getMetalLayerCount(); ++i){
+                setMetric("one_piece_m" + std::to_string(i), dse.checkOnePiece(i)? 1.0 : 0.0);
+            }
+            return true;
+        }
+
+        case PowerXStage::PHYSICAL:{
+            dse.buildPhysicalImplementation();
+            setMetric("connected", dse.connectivityAwareAssignment()? 1.0 : 0.0);
+            return true;
+        }
+
+        case PowerXStage::ANALYSIS:{
+            m_chipletDrops.clear();
+            for(SignalType st : dse.phySOI){
+                PDNCircuit circuit;
+                circuit.build(dse, st, *m_technology, *m_extractor);
+                IRDropAnalyser irDropAnalyser(circuit, *m_technology);
+                if(!irDropAnalyser.solve()) continue;
+
+                setMetric(std::string("ir_drop_") + to_string(st), irDropAnalyser.getWorstDrop());
+                m_chipletDrops[st] = irDropAnalyser.getChipletDrops();
+            }
+            return true;
+        }
+
+        default:{
+            m_error = std::string("unknown stage ") + to_string(stage);
+            return false;
+        }
+    }
+}
+
+int PowerXDesign::getGridWidth() const {return m_engine->getGridWidth();}
+int PowerXDesign::getGridHeight() const {return m_engine->getGridHeight();}
+int PowerXDesign::getPinWidth() const {return m_engine->getPinWidth();}
+int PowerXDesign::getPinHeight() const {return m_engine->getPinHeight();}
+int PowerXDesign::getMetalLayerCount() const {return m_engine->getMetalLayerCount();}
+int PowerXDesign::getViaLayerCount() const {return m_engine->getViaLayerCount();}
+
+std::span<const std::vector<SignalType>> PowerXDesign::getMetalCanvas(int layer) const {
+    assert((layer >= 0) && (layer < m_engine->getMetalLayerCount()));
+    return std::span<const std::vector<SignalType>>(m_engine->metalLayers[layer].canvas);
+}
+
+std::span<const std::vector<SignalType>> PowerXDesign::getViaCanvas(int layer) const {
+    assert((layer >= 0) && (layer < m_engine->getViaLayerCount()));
+    return std::span<const std::vector<SignalType>>(m_engine->viaLayers[layer].canvas);
+}
+
+std::span<const std::pair<std::string, double>> PowerXDesign::getMetrics() const {
+    return std::span<const std::pair<std::string, double>>(m_metrics);
+}
+
+std::span<const ChipletIRDrop> PowerXDesign::getChipletDrops(SignalType st) const {
+    std::unordered_map<SignalType, std::vector<ChipletIRDrop>>::const_iterator it = m_chipletDrops.find(st);
+    if(it == m_chipletDrops.end()) return {};
+    return std::span<const ChipletIRDrop>(it->second);
+}
@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 19:40:08
+//  Module Name:        powerxLibrary.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Entry point of libpowerx (make libpowerx), the flow of
+//                      bin/pwrx for callers that keep their design in memory.
+//                      A PowerXDesign is built from a DesignSpec, runs the
+//                      stages on request and hands back the canvases and the
+//                      QoR figures as spans into its own storage, so nothing
+//                      is read from or written to disk. The spans stay valid
+//                      until the next runUntil on the same design.
+//
+//                      Callers link bin/libpowerx.a with the LINKFLAGS of the
+//                      Makefile (Gurobi, PETSc, OpenMP) and call
+//                      initialiseRuntime() once per process before running
+//                      the FILLING stage or any later one. Designs are
+//                      independent and may run concurrently as long as they do
+//                      not share a GRBEnv. From FILLING onward every stage
+//                      builds PETSc objects, so unless PETSc is configured
+//                      --with-threadsafety (PETSC_HAVE_THREADSAFETY) only one
+//                      design at a time may be in those stages, runUntil fails
+//                      with the reason in getError() for a second one, the
+//                      same rule the batch and daemon modes apply to their jobs.
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __POWERX_LIBRARY_H__
+#define __POWERX_LIBRARY_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <span>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "technology.hpp"
+#include "eqCktExtractor.hpp"
+#include "designSpec.hpp"
+#include "irDropAnalyser.hpp"
+
+// 4. Gurobi Library
+#include "gurobi_c++.h"
+
+class DiffusionEngine;
+
+// in the order bin/pwrx runs them, each one needs the previous ones
+enum class PowerXStage : uint8_t{
+    NONE = 0,
+    PREPROCESS = 1,     // pads, obstacles and enclosed regions marked on the canvas
+    MCF = 2,            // multi-commodity flow and the post-MCF repair, written back to the canvas
+    FILLING = 3,        // resistance based filling, needs initialiseRuntime() from here on
+    POSTPROCESS = 4,    // via assignment and floating plane removal
+    PHYSICAL = 5,       // physical implementation and connectivity aware assignment
+    ANALYSIS = 6,       // IR-drop of every physical signal
+};
+
+const char *to_string(PowerXStage stage);
+
+class PowerXDesign{
+private:
+    std::shared_ptr<const Technology> m_technology;
+    std::unique_ptr<EqCktExtractor> m_extractor;
+    std::unique_ptr<DiffusionEngine> m_engine;
+    GRBEnv *m_grbEnv;
+
+    PowerXStage m_completedStage;
+    std::string m_error;
+
+    // same names as the _qor.csv of bin/pwrx, added here are runtime_<stage> in seconds, connected (1 when the
+    // connectivity aware assignment of PHYSICAL joined every pad, 0 otherwise) and ir_drop_<signal> in V
+    std::vector<std::pair<std::string, double>> m_metrics;
+    std::unordered_map<SignalType, std::vector<ChipletIRDrop>> m_chipletDrops;
+
+    bool runStage(PowerXStage stage);
+    void setMetric(const std::string &name, double value);
+
+public:
+    // PETSc for the FILLING stage onward, argc/argv may be null
+    static bool initialiseRuntime(int *argc = nullptr, char ***argv = nullptr);
+    static void finaliseRuntime();
+
+    // every check the file parsers would abort on, at most one signal per preplaced cord and the blocked outermost
+    // ring of pins every via layer needs, false with the first problem in error
+    static bool validate(const DesignSpec &spec, std::string &error);
+
+    // spec is validated first, a rejected spec leaves an invalid design with the reason in getError()
+    // technology defaults to Technology(), grbEnv (not owned) defaults to a private environment per MCF run
+    explicit PowerXDesign(const DesignSpec &spec, std::shared_ptr<const Technology> technology = nullptr, GRBEnv *grbEnv = nullptr);
+    ~PowerXDesign();
+
+    PowerXDesign(const PowerXDesign &other) = delete;
+    PowerXDesign &operator=(const PowerXDesign &other) = delete;
+
+    inline bool isValid() const {return this->m_engine != nullptr;}
+    inline const std::string &getError() const {return this->m_error;}
+    inline PowerXStage getCompletedStage() const {return this->m_completedStage;}
+
+    // runs the stages after getCompletedStage() up to and including stage, false with the reason in getError()
+    bool runUntil(PowerXStage stage);
+
+    // the accessors below need isValid()
+    int getGridWidth() const;
+    int getGridHeight() const;
+    int getPinWidth() const;
+    int getPinHeight() const;
+    int getMetalLayerCount() const;
+    int getViaLayerCount() const;
+
+    // rows of the layer, row 0 at the bottom, metal layers are gridWidth x gridHeight and via layers pinWidth x pinHeight
+    std::span<const std::vector<SignalType>> getMetalCanvas(int layer) const;
+    std::span<const std::vector<SignalType>> getViaCanvas(int layer) const;
+
+    std::span<const std::pair<std::string, double>> getMetrics() const;
+    // empty before the ANALYSIS stage or for a signal that failed to solve
+    std::span<const ChipletIRDrop> getChipletDrops(SignalType st) const;
+
+    // the engine behind the design, for anything not covered above
+    inline const DiffusionEngine &getEngine() const {return *(this->m_engine);}
+};
+
+#endif // __POWERX_LIBRARY_H__
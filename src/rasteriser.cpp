@@ -0,0 +1,325 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 23:26:05
+//  Module Name:        rasteriser.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Draws canvases and physical implementation layers straight
+//                      into PNG or PPM images, no text dump and no python needed.
+//                      Layout and colours follow renderObjectArray.py and
+//                      renderPhysicalImplementation.py, the colour table lives in
+//                      colours.hpp. The file type follows the file extension
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "colours.hpp"
+#include "rasteriser.hpp"
+
+// 4. zlib
+#include <zlib.h>
+
+namespace {
+    constexpr unsigned char RGB_BLACK[3] = {0x00, 0x00, 0x00};
+    // '0.6' grey of renderPhysicalImplementation.py for links without a signal
+    constexpr unsigned char RGB_EMPTY_LINK[3] = {0x99, 0x99, 0x99};
+
+    inline const unsigned char *signalRGB(SignalType st){
+        return colours::SIGNAL_RGB[static_cast<uint8_t>(st) & 0x0F];
+    }
+
+    // facecolor "none" in SIGNAL_COLORS of renderObjectArray.py
+    inline bool isUnfilled(SignalType st){
+        return (st == SignalType::EMPTY) || (st == SignalType::UNKNOWN);
+    }
+
+    void appendBigEndian(std::vector<uint8_t> &bytes, uint32_t value){
+        bytes.push_back(uint8_t(value >> 24));
+        bytes.push_back(uint8_t(value >> 16));
+        bytes.push_back(uint8_t(value >> 8));
+        bytes.push_back(uint8_t(value));
+    }
+
+    void writePNGChunk(std::ofstream &ofs, const char *type, const std::vector<uint8_t> &data){
+        std::vector<uint8_t> header;
+        appendBigEndian(header, uint32_t(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        uLong crc = crc32(0L, Z_NULL, 0);
+        crc = crc32(crc, reinterpret_cast<const Bytef *>(type), 4);
+        if(!data.empty()) crc = crc32(crc, data.data(), uInt(data.size()));
+        std::vector<uint8_t> trailer;
+        appendBigEndian(trailer, uint32_t(crc));
+
+        ofs.write(reinterpret_cast<const char *>(header.data()), header.size());
+        if(!data.empty()) ofs.write(reinterpret_cast<const char *>(data.data()), data.size());
+        ofs.write(reinterpret_cast<const char *>(trailer.data()), trailer.size());
+    }
+
+    bool hasExtension(const std::string &filePath, const std::string &extension){
+        if(filePath.size() < extension.size()) return false;
+        return std::equal(extension.rbegin(), extension.rend(), filePath.rbegin(), [](char a, char b){ return a == std::tolower(static_cast<unsigned char>(b)); });
+    }
+}
+
+RasterImage::RasterImage(int width, int height): m_width(width), m_height(height), m_pixels(size_t(width) * height * 3, 0xFF) {
+    assert(width > 0 && height > 0);
+}
+
+void RasterImage::fillRect(double x0, double y0, double x1, double y1, const unsigned char *rgb, double alpha){
+    if(x0 > x1) std::swap(x0, x1);
+    if(y0 > y1) std::swap(y0, y1);
+    // a pixel is covered when its centre is inside, rows are counted from the top
+    int colBegin = std::max(0, int(std::ceil(x0 - 0.5)));
+    int colEnd = std::min(m_width, int(std::ceil(x1 - 0.5)));
+    int rowBegin = std::max(0, int(std::ceil(m_height - y1 - 0.5)));
+    int rowEnd = std::min(m_height, int(std::ceil(m_height - y0 - 0.5)));
+
+    for(int row = rowBegin; row < rowEnd; ++row){
+        uint8_t *pixel = &m_pixels[(size_t(row) * m_width + colBegin) * 3];
+        for(int col = colBegin; col < colEnd; ++col, pixel += 3){
+            for(int c = 0; c < 3; ++c) pixel[c] = uint8_t(std::lround(alpha * rgb[c] + (1.0 - alpha) * pixel[c]));
+        }
+    }
+}
+
+void RasterImage::strokeRect(double x0, double y0, double x1, double y1, const unsigned char *rgb, double alpha){
+    drawLine(x0, y0, x1, y0, 1.0, rgb, alpha);
+    drawLine(x0, y1, x1, y1, 1.0, rgb, alpha);
+    drawLine(x0, y0, x0, y1, 1.0, rgb, alpha);
+    drawLine(x1, y0, x1, y1, 1.0, rgb, alpha);
+}
+
+void RasterImage::fillCircle(double cx, double cy, double radius, const unsigned char *rgb, double alpha, int half){
+    int colBegin = std::max(0, int(std::floor(cx - radius)));
+    int colEnd = std::min(m_width, int(std::ceil(cx + radius)) + 1);
+    int rowBegin = std::max(0, int(std::floor(m_height - cy - radius)));
+    int rowEnd = std::min(m_height, int(std::ceil(m_height - cy + radius)) + 1);
+    double radiusSquared = radius * radius;
+
+    for(int row = rowBegin; row < rowEnd; ++row){
+        double py = m_height - (row + 0.5);
+        double dy = py - cy;
+        if((half > 0) && (dy < 0)) continue;
+        if((half < 0) && (dy >= 0)) continue;
+        for(int col = colBegin; col < colEnd; ++col){
+            double dx = (col + 0.5) - cx;
+            if(dx * dx + dy * dy > radiusSquared) continue;
+            uint8_t *pixel = &m_pixels[(size_t(row) * m_width + col) * 3];
+            for(int c = 0; c < 3; ++c) pixel[c] = uint8_t(std::lround(alpha * rgb[c] + (1.0 - alpha) * pixel[c]));
+        }
+    }
+}
+
+void RasterImage::strokeCircle(double cx, double cy, double radius, const unsigned char *rgb, double alpha, int half){
+    int colBegin = std::max(0, int(std::floor(cx - radius)));
+    int colEnd = std::min(m_width, int(std::ceil(cx + radius)) + 1);
+    int rowBegin = std::max(0, int(std::floor(m_height - cy - radius)));
+    int rowEnd = std::min(m_height, int(std::ceil(m_height - cy + radius)) + 1);
+    // a one pixel wide ring just inside the radius, so a stroke never reaches past the matching fill
+    double outerSquared = radius * radius;
+    double inner = std::max(0.0, radius - 1.0);
+    double innerSquared = inner * inner;
+
+    for(int row = rowBegin; row < rowEnd; ++row){
+        double py = m_height - (row + 0.5);
+        double dy = py - cy;
+        if((half > 0) && (dy < 0)) continue;
+        if((half < 0) && (dy >= 0)) continue;
+        for(int col = colBegin; col < colEnd; ++col){
+            double dx = (col + 0.5) - cx;
+            double distanceSquared = dx * dx + dy * dy;
+            if((distanceSquared > outerSquared) || (distanceSquared < innerSquared)) continue;
+            uint8_t *pixel = &m_pixels[(size_t(row) * m_width + col) * 3];
+            for(int c = 0; c < 3; ++c) pixel[c] = uint8_t(std::lround(alpha * rgb[c] + (1.0 - alpha) * pixel[c]));
+        }
+    }
+}
+
+void RasterImage::drawLine(double x0, double y0, double x1, double y1, double thickness, const unsigned char *rgb, double alpha){
+    double halfThickness = std::max(0.5, thickness / 2.0);
+    int colBegin = std::max(0, int(std::floor(std::min(x0, x1) - halfThickness)));
+    int colEnd = std::min(m_width, int(std::ceil(std::max(x0, x1) + halfThickness)) + 1);
+    int rowBegin = std::max(0, int(std::floor(m_height - std::max(y0, y1) - halfThickness)));
+    int rowEnd = std::min(m_height, int(std::ceil(m_height - std::min(y0, y1) + halfThickness)) + 1);
+
+    double dx = x1 - x0;
+    double dy = y1 - y0;
+    double lengthSquared = dx * dx + dy * dy;
+
+    for(int row = rowBegin; row < rowEnd; ++row){
+        double py = m_height - (row + 0.5);
+        for(int col = colBegin; col < colEnd; ++col){
+            double px = col + 0.5;
+            // distance from the pixel centre to the segment
+            double t = (lengthSquared > 0)? std::clamp(((px - x0) * dx + (py - y0) * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+            double ex = px - (x0 + t * dx);
+            double ey = py - (y0 + t * dy);
+            if(ex * ex + ey * ey > halfThickness * halfThickness) continue;
+            uint8_t *pixel = &m_pixels[(size_t(row) * m_width + col) * 3];
+            for(int c = 0; c < 3; ++c) pixel[c] = uint8_t(std::lround(alpha * rgb[c] + (1.0 - alpha) * pixel[c]));
+        }
+    }
+}
+
+bool RasterImage::write(const std::string &filePath) const {
+    return hasExtension(filePath, ".png")? writePNG(filePath) : writePPM(filePath);
+}
+
+bool RasterImage::writePPM(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+    if(!ofs.is_open()) return false;
+
+    ofs << "P6\n" << m_width << " " << m_height << "\n255\n";
+    ofs.write(reinterpret_cast<const char *>(m_pixels.data()), m_pixels.size());
+    ofs.close();
+    return true;
+}
+
+bool RasterImage::writePNG(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+    if(!ofs.is_open()) return false;
+
+    static const uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    ofs.write(reinterpret_cast<const char *>(PNG_SIGNATURE), sizeof(PNG_SIGNATURE));
+
+    // 8 bit RGB, no interlace
+    std::vector<uint8_t> ihdr;
+    appendBigEndian(ihdr, uint32_t(m_width));
+    appendBigEndian(ihdr, uint32_t(m_height));
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});
+    writePNGChunk(ofs, "IHDR", ihdr);
+
+    // every scanline is prefixed by filter type 0, the canvases are flat colour so deflate alone does well
+    const size_t rowBytes = size_t(m_width) * 3;
+    std::vector<uint8_t> scanlines;
+    scanlines.reserve((rowBytes + 1) * m_height);
+    for(int row = 0; row < m_height; ++row){
+        scanlines.push_back(0);
+        scanlines.insert(scanlines.end(), m_pixels.begin() + row * rowBytes, m_pixels.begin() + (row + 1) * rowBytes);
+    }
+
+    uLongf compressedSize = compressBound(uLong(scanlines.size()));
+    std::vector<uint8_t> idat(compressedSize);
+    if(compress2(idat.data(), &compressedSize, scanlines.data(), uLong(scanlines.size()), Z_BEST_SPEED) != Z_OK){
+        std::cout << "[PowerX:Rasteriser] Error: PNG compression failed for " << filePath << std::endl;
+        return false;
+    }
+    idat.resize(compressedSize);
+    writePNGChunk(ofs, "IDAT", idat);
+    writePNGChunk(ofs, "IEND", {});
+
+    ofs.close();
+    return true;
+}
+
+bool rasteriseGridArrayWithPin(const std::vector<std::vector<SignalType>> &gridArr, const std::vector<std::vector<SignalType>> &pinArr, const Technology &tch, const std::string &filePath){
+    return rasteriseGridArrayWithPins(gridArr, pinArr, pinArr, tch, filePath);
+}
+
+bool rasteriseGridArrayWithPins(const std::vector<std::vector<SignalType>> &gridArr, const std::vector<std::vector<SignalType>> &upPinArr, const std::vector<std::vector<SignalType>> &downPinArr, const Technology &tch, const std::string &filePath){
+    int gridWidth = gridArr[0].size();
+    int gridHeight = gridArr.size();
+    int pinWidth = upPinArr[0].size();
+    int pinHeight = upPinArr.size();
+
+    assert(gridWidth == (pinWidth-1));
+    assert(gridHeight == (pinHeight-1));
+    assert(downPinArr.size() == upPinArr.size());
+
+    const double GRID_MUL = RASTER_CELL_PIXELS;
+    double pinRadius = GRID_MUL * double(tch.getMicrobumpRadius()) / (2.0 * double(tch.getMicrobumpPitch()));
+    // capped like the python renderer, and kept at least one pixel wide so that pins stay visible
+    pinRadius = std::clamp(pinRadius, 1.0, GRID_MUL / 2.0);
+
+    RasterImage image(int(GRID_MUL * (gridWidth + 2)), int(GRID_MUL * (gridHeight + 2)));
+
+    for(int j = 0; j < gridHeight; ++j){
+        for(int i = 0; i < gridWidth; ++i){
+            double x0 = GRID_MUL * (i + 1), y0 = GRID_MUL * (j + 1);
+            if(!isUnfilled(gridArr[j][i])) image.fillRect(x0, y0, x0 + GRID_MUL, y0 + GRID_MUL, signalRGB(gridArr[j][i]), 0.5);
+            image.strokeRect(x0, y0, x0 + GRID_MUL, y0 + GRID_MUL, RGB_BLACK, 0.5);
+        }
+    }
+
+    // a single via layer is a full disc with a faint edge, two layers are the upper and lower half of the same pin
+    // with a black edge, an EMPTY or UNKNOWN pin is only its edge so that the cells around it stay visible
+    bool splitPins = (&upPinArr != &downPinArr);
+    const double edgeAlpha = splitPins? 1.0 : 0.2;
+    auto drawPin = [&](double cx, double cy, SignalType st, int half){
+        if(st == SignalType::OBSTACLE) return;
+        if(!isUnfilled(st)) image.fillCircle(cx, cy, pinRadius, signalRGB(st), 1.0, half);
+        image.strokeCircle(cx, cy, pinRadius, RGB_BLACK, edgeAlpha, half);
+    };
+    for(int j = 0; j < pinHeight; ++j){
+        for(int i = 0; i < pinWidth; ++i){
+            double cx = GRID_MUL * (i + 1), cy = GRID_MUL * (j + 1);
+            drawPin(cx, cy, upPinArr[j][i], splitPins? 1 : 0);
+            if(splitPins) drawPin(cx, cy, downPinArr[j][i], -1);
+        }
+    }
+
+    return image.write(filePath);
+}
+
+bool rasterisePhysicalImplementation(int physicalGridWidth, int physicalGridHeight, const std::vector<PDNNode> &physicalNodes, const std::vector<PDNEdge> &pdnEdges, int layer, const std::string &filePath){
+    const double CELL = RASTER_CELL_PIXELS;
+    const double nodeRadius = 0.35 * CELL;
+    const double linkThickness = std::max(1.0, 0.15 * CELL);
+
+    RasterImage image(int(CELL * physicalGridWidth), int(CELL * physicalGridHeight));
+
+    const size_t layerOffset = size_t(layer) * physicalGridHeight * physicalGridWidth;
+    for(int j = 0; j < physicalGridHeight; ++j){
+        for(int i = 0; i < physicalGridWidth; ++i){
+            const PDNNode &node = physicalNodes[layerOffset + size_t(j) * physicalGridWidth + i];
+            if(node.signal == SignalType::EMPTY) continue;
+            image.fillCircle(CELL * (i + 0.5), CELL * (j + 0.5), nodeRadius, signalRGB(node.signal), 0.95);
+        }
+    }
+
+    for(const PDNEdge &edge : pdnEdges){
+        if(edge.isVia) continue;
+        const PDNNode &n0 = physicalNodes[edge.n0];
+        const PDNNode &n1 = physicalNodes[edge.n1];
+        if(n0.layer != layer) continue;
+
+        double x0 = CELL * (n0.x + 0.5), y0 = CELL * (n0.y + 0.5);
+        double x1 = CELL * (n1.x + 0.5), y1 = CELL * (n1.y + 0.5);
+        double dx = x1 - x0, dy = y1 - y0;
+        double length = std::sqrt(dx * dx + dy * dy);
+        if(length <= 1e-6) continue;
+
+        // stop a little short of both node discs
+        double shrink = nodeRadius * 1.05;
+        x0 += dx / length * shrink;
+        y0 += dy / length * shrink;
+        x1 -= dx / length * shrink;
+        y1 -= dy / length * shrink;
+
+        const unsigned char *rgb = (edge.signal == SignalType::EMPTY)? RGB_EMPTY_LINK : signalRGB(edge.signal);
+        image.drawLine(x0, y0, x1, y1, linkThickness, rgb, 0.8);
+    }
+
+    return image.write(filePath);
+}
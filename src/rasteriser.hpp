@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 23:26:05
+//  Module Name:        rasteriser.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Draws canvases and physical implementation layers straight
+//                      into PNG or PPM images, no text dump and no python needed.
+//                      Layout and colours follow renderObjectArray.py and
+//                      renderPhysicalImplementation.py, the colour table lives in
+//                      colours.hpp. The file type follows the file extension
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __RASTERISER_H__
+#define __RASTERISER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "technology.hpp"
+#include "pdnNode.hpp"
+#include "pdnEdge.hpp"
+
+// pixels per grid cell, GRID_MUL of the python renderers
+constexpr int RASTER_CELL_PIXELS = 10;
+
+class RasterImage{
+private:
+    int m_width;
+    int m_height;
+    // RGB, row 0 is the top of the image
+    std::vector<uint8_t> m_pixels;
+
+    bool writePPM(const std::string &filePath) const;
+    bool writePNG(const std::string &filePath) const;
+
+public:
+    RasterImage(int width, int height);
+
+    inline int getWidth() const {return this->m_width;}
+    inline int getHeight() const {return this->m_height;}
+
+    // drawing coordinates are plot coordinates, y grows upwards like the matplotlib axes
+    void fillRect(double x0, double y0, double x1, double y1, const unsigned char *rgb, double alpha = 1.0);
+    void strokeRect(double x0, double y0, double x1, double y1, const unsigned char *rgb, double alpha = 1.0);
+    // half = 0 full disc, 1 upper half, -1 lower half
+    void fillCircle(double cx, double cy, double radius, const unsigned char *rgb, double alpha = 1.0, int half = 0);
+    void strokeCircle(double cx, double cy, double radius, const unsigned char *rgb, double alpha = 1.0, int half = 0);
+    void drawLine(double x0, double y0, double x1, double y1, double thickness, const unsigned char *rgb, double alpha = 1.0);
+
+    // ".png" writes a PNG, anything else a binary PPM
+    bool write(const std::string &filePath) const;
+};
+
+// same picture as renderObjectArray.py on the GRID_PIN / PIN_GRID_PIN dumps of visualiser.hpp
+bool rasteriseGridArrayWithPin(const std::vector<std::vector<SignalType>> &gridArr, const std::vector<std::vector<SignalType>> &pinArr, const Technology &tch, const std::string &filePath);
+bool rasteriseGridArrayWithPins(const std::vector<std::vector<SignalType>> &gridArr, const std::vector<std::vector<SignalType>> &upPinArr, const std::vector<std::vector<SignalType>> &downPinArr, const Technology &tch, const std::string &filePath);
+
+// same picture as renderPhysicalImplementation.py on a PHYSICAL_IMPLEMENTATION dump
+bool rasterisePhysicalImplementation(int physicalGridWidth, int physicalGridHeight, const std::vector<PDNNode> &physicalNodes, const std::vector<PDNEdge> &pdnEdges, int layer, const std::string &filePath);
+
+#endif // __RASTERISER_H__
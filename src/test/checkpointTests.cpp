@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 22:58:41
+//  Module Name:        checkpointTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        DiffusionEngine checkpoints of the shipped case01: the
+//                      round trip of the cell and canvas state and the refusal of
+//                      checkpoints taken with other inputs or corrupted on disk
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "diffusionChamber.hpp"
+#include "diffusionEngine.hpp"
+#include "caseResolver.hpp"
+#include "selfTest.hpp"
+
+namespace {
+    constexpr uint64_t INPUT_HASH = 0xFEDCBA9876543210ull;
+    // offsets into the checkpoint header: magic, version, inputHash, then the section sizes
+    constexpr size_t VERSION_OFFSET = 4;
+    constexpr size_t METAL_CELL_COUNT_OFFSET = 16;
+
+    // case01 as main.cpp sets it up before the first stage boundary, nullptr if the case is not found
+    std::unique_ptr<DiffusionEngine> loadCase(){
+        CaseFiles files;
+        if(!resolveCaseFiles("case01", files)) return nullptr;
+        std::unique_ptr<DiffusionEngine> dse = std::make_unique<DiffusionEngine>(files.pinoutPath, files.configPath);
+        dse->markPreplacedAndInsertPadsOnCanvas();
+        dse->markObstaclesOnCanvas();
+        dse->initialiseGraphWithPreplaced();
+        return dse;
+    }
+
+    // everything a checkpoint carries, in the order it is written
+    std::vector<uint8_t> captureState(const DiffusionEngine &dse){
+        std::vector<uint8_t> state;
+        for(const MetalCell &mc : dse.metalGrid){
+            state.push_back(static_cast<uint8_t>(mc.type));
+            state.push_back(static_cast<uint8_t>(mc.signal));
+        }
+        for(const ViaCell &vc : dse.viaGrid){
+            state.push_back(static_cast<uint8_t>(vc.type));
+            state.push_back(static_cast<uint8_t>(vc.signal));
+        }
+        for(const std::vector<ObjectArray> *layers : {&dse.metalLayers, &dse.viaLayers}){
+            for(const ObjectArray &layer : *layers){
+                for(const std::vector<SignalType> &row : layer.canvas){
+                    for(SignalType st : row) state.push_back(static_cast<uint8_t>(st));
+                }
+            }
+        }
+        return state;
+    }
+
+    // a state no freshly loaded case has: a stripe of filled metal cells and a marked canvas corner
+    void scribble(DiffusionEngine &dse){
+        for(size_t i = 0; i < dse.metalGrid.size(); i += 7){
+            dse.metalGrid[i].type = CellType::MARKED;
+            dse.metalGrid[i].signal = static_cast<SignalType>(1 + i % 10);
+        }
+        for(size_t i = 0; i < dse.viaGrid.size(); i += 5){
+            dse.viaGrid[i].type = CellType::CANDIDATE;
+            dse.viaGrid[i].signal = SignalType::GROUND;
+        }
+        dse.metalLayers.back().canvas[0][0] = SignalType::OVERLAP;
+        dse.viaLayers.front().canvas[0][0] = SignalType::SIGNAL;
+    }
+
+    template <typename T>
+    void overwrite(const std::string &filePath, size_t offset, T value){
+        std::fstream fs(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(offset);
+        fs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+}
+
+void runCheckpointTests(SelfTest &test){
+    // loading the case takes a while, skip it unless one of the tests is selected
+    const std::vector<std::string> testNames = {"Checkpoint::case01 loads", "Checkpoint::round trip", "Checkpoint::hash mismatch is refused", "Checkpoint::corrupt file is refused"};
+    if(std::none_of(testNames.begin(), testNames.end(), [&](const std::string &name){return test.isSelected(name);})) return;
+
+    std::unique_ptr<DiffusionEngine> source = loadCase();
+    std::unique_ptr<DiffusionEngine> target = loadCase();
+    test.run("Checkpoint::case01 loads", [&](){
+        CHECK(test, source != nullptr && target != nullptr);
+    });
+    if(source == nullptr || target == nullptr) return;
+
+    const std::vector<uint8_t> freshState = captureState(*target);
+    scribble(*source);
+    const std::vector<uint8_t> sourceState = captureState(*source);
+    const std::string filePath = test.getScratchPath("case01.pxck");
+
+    test.run("Checkpoint::round trip", [&](){
+        CHECK(test, sourceState != freshState);
+        CHECK(test, source->exportCheckpoint(filePath, INPUT_HASH));
+        // a 48 byte header, then exactly the captured state
+        CHECK(test, std::filesystem::file_size(filePath) == 48 + sourceState.size());
+        CHECK(test, target->importCheckpoint(filePath, INPUT_HASH));
+        CHECK(test, captureState(*target) == sourceState);
+    });
+
+    // every refused checkpoint must leave the engine as it was
+    std::unique_ptr<DiffusionEngine> untouched = loadCase();
+    auto refuses = [&](uint64_t inputHash, const std::function<void(const std::string &)> &corrupt){
+        const std::string corruptPath = test.getScratchPath("corrupt.pxck");
+        source->exportCheckpoint(corruptPath, INPUT_HASH);
+        corrupt(corruptPath);
+        return !untouched->importCheckpoint(corruptPath, inputHash) && (captureState(*untouched) == freshState);
+    };
+    auto intact = [](const std::string &){};
+
+    test.run("Checkpoint::hash mismatch is refused", [&](){
+        CHECK(test, refuses(INPUT_HASH + 1, intact));
+        CHECK(test, refuses(0, intact));
+    });
+
+    test.run("Checkpoint::corrupt file is refused", [&](){
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){overwrite(p, 0, 'Q');}));
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){overwrite(p, VERSION_OFFSET, DIFFUSION_CHECKPOINT_VERSION + 1);}));
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){overwrite(p, METAL_CELL_COUNT_OFFSET, uint64_t(1));}));
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){std::filesystem::resize_file(p, std::filesystem::file_size(p) - 1);}));
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){std::filesystem::resize_file(p, 8);}));
+        CHECK(test, refuses(INPUT_HASH, [](const std::string &p){std::filesystem::remove(p);}));
+    });
+}
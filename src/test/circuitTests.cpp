@@ -0,0 +1,353 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:48:02
+//  Module Name:        circuitTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The circuit analysers against a hand-built PDNCircuit with
+//                      the topology of PDNCircuit::build (VRM, PCB, one C4, a run
+//                      of metal edges, one uBump and a chiplet load) small enough
+//                      to be solved on paper
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "technology.hpp"
+#include "pdnCircuit.hpp"
+#include "irDropAnalyser.hpp"
+#include "impedanceAnalyser.hpp"
+#include "transientSimulator.hpp"
+#include "macromodelReducer.hpp"
+#include "selfTest.hpp"
+
+namespace {
+    // SI units, the inductances are only seen by the AC and transient analyses
+    struct LadderValues{
+        double pcbResistance = 1e-4;
+        double pcbInductance = 1e-10;
+        double c4Resistance = 2e-3;
+        double c4Inductance = 2e-11;
+        double edgeResistance = 5e-3;
+        double edgeInductance = 5e-12;
+        double ubumpResistance = 3e-3;
+        double ubumpInductance = 1e-11;
+        double dieResistance = 1e-3;
+        double dieInductance = 1e-11;
+        double dieCapacitance = 100e-9;
+        double gridCapacitance = 0.0;
+        // metal edges in parallel between the C4 and the uBump landing node
+        int parallelEdges = 1;
+        double loadCurrent = 2.0;
+    };
+
+    // vrm_low(0) -PCB- pcb_out(1) -C4- c4(2) -EDGE x parallelEdges- bump(3) -UBUMP- chip_o(4) -R-L- chip_die(5) -C- 0
+    PDNCircuit buildLadder(const LadderValues &v){
+        PDNCircuit ckt;
+        ckt.nodeNames = {"vrm_low", "pcb_out", "c4", "bump", "chip_o", "chip_die"};
+        ckt.vrmNode = 0;
+        ckt.supplyNode = 1;
+
+        ckt.branches.push_back(PDNBranch{PDNBranchType::PCB, 0, 1, v.pcbResistance, v.pcbInductance, 0.0, PDN_EDGE_NONE});
+        ckt.branches.back().seriesVoltage = ckt.supplyVoltage;
+        ckt.branches.push_back(PDNBranch{PDNBranchType::PCB, 0, PDN_CIRCUIT_GROUND, v.pcbResistance, v.pcbInductance, 0.0, PDN_EDGE_NONE});
+        ckt.branches.push_back(PDNBranch{PDNBranchType::C4, 1, 2, v.c4Resistance, v.c4Inductance, 0.0, PDN_EDGE_NONE});
+        for(int e = 0; e < v.parallelEdges; ++e){
+            ckt.branches.push_back(PDNBranch{PDNBranchType::EDGE, 2, 3, v.edgeResistance, v.edgeInductance, 0.0, static_cast<pdn_edge_t>(e)});
+        }
+        ckt.branches.push_back(PDNBranch{PDNBranchType::UBUMP, 3, 4, v.ubumpResistance, v.ubumpInductance, 0.0, PDN_EDGE_NONE});
+        ckt.branches.push_back(PDNBranch{PDNBranchType::CHIPLET_LOAD, 4, 5, v.dieResistance, v.dieInductance, 0.0, PDN_EDGE_NONE});
+        ckt.branches.push_back(PDNBranch{PDNBranchType::CHIPLET_LOAD, 5, PDN_CIRCUIT_GROUND, 0.0, 0.0, v.dieCapacitance, PDN_EDGE_NONE});
+        if(v.gridCapacitance != 0.0){
+            ckt.branches.push_back(PDNBranch{PDNBranchType::GRID_CAP, 3, PDN_CIRCUIT_GROUND, 0.0, 0.0, v.gridCapacitance, PDN_EDGE_NONE});
+        }
+
+        ckt.portNames = {"chip"};
+        ckt.portNodes = {4};
+        ckt.portLoadNodes = {5};
+        ckt.portCurrents = {v.loadCurrent};
+        ckt.portBumpNodes = {{3}};
+        return ckt;
+    }
+
+    void testIRDrop(SelfTest &test){
+        test.run("IRDrop::series ladder", [&](){
+            LadderValues v;
+            PDNCircuit ckt = buildLadder(v);
+            IRDropAnalyser analyser(ckt, Technology());
+            CHECK(test, analyser.solve());
+
+            // the PCB is replaced by the ideal supply at pcb_out, so the drop is the current times the series resistance
+            const double I = v.loadCurrent;
+            const double bumpDrop = I * (v.c4Resistance + v.edgeResistance);
+            const double portDrop = bumpDrop + I * v.ubumpResistance;
+            const std::vector<double> &voltages = analyser.getNodeVoltages();
+            CHECK_NEAR(test, voltages[1], 1.0, 1e-12);
+            CHECK_NEAR(test, voltages[3], 1.0 - bumpDrop, 1e-12);
+            CHECK_NEAR(test, voltages[4], 1.0 - portDrop, 1e-12);
+            CHECK_NEAR(test, voltages[5], 1.0 - portDrop - I * v.dieResistance, 1e-12);
+
+            CHECK(test, analyser.getChipletDrops().size() == 1);
+            const ChipletIRDrop &cd = analyser.getChipletDrops().front();
+            CHECK(test, cd.connected);
+            CHECK_NEAR(test, cd.portDrop, portDrop, 1e-12);
+            CHECK_NEAR(test, cd.worstBumpDrop, bumpDrop, 1e-12);
+            CHECK_NEAR(test, cd.averageBumpDrop, bumpDrop, 1e-12);
+            CHECK_NEAR(test, analyser.getWorstDrop(), bumpDrop, 1e-12);
+
+            CHECK(test, analyser.getEdgeCurrents().size() == 1);
+            CHECK_NEAR(test, analyser.getEdgeCurrents().front().current, I, 1e-9);
+        });
+
+        test.run("IRDrop::parallel edges share the current", [&](){
+            LadderValues v;
+            v.parallelEdges = 4;
+            PDNCircuit ckt = buildLadder(v);
+            IRDropAnalyser analyser(ckt, Technology());
+            CHECK(test, analyser.solve());
+
+            const double I = v.loadCurrent;
+            const double bumpDrop = I * (v.c4Resistance + v.edgeResistance / v.parallelEdges);
+            CHECK_NEAR(test, analyser.getChipletDrops().front().worstBumpDrop, bumpDrop, 1e-12);
+            CHECK(test, analyser.getEdgeCurrents().size() == size_t(v.parallelEdges));
+            for(const EdgeCurrent &ec : analyser.getEdgeCurrents()){
+                CHECK_NEAR(test, ec.current, I / v.parallelEdges, 1e-9);
+                CHECK(test, !ec.isVia);
+            }
+        });
+
+        test.run("IRDrop::port without a DC path floats", [&](){
+            LadderValues v;
+            PDNCircuit ckt = buildLadder(v);
+            // a second chiplet hanging from the bump through a capacitor only
+            ckt.nodeNames.push_back("island_o");
+            ckt.branches.push_back(PDNBranch{PDNBranchType::GRID_CAP, 3, 6, 0.0, 0.0, 1e-12, PDN_EDGE_NONE});
+            ckt.portNames.push_back("island");
+            ckt.portNodes.push_back(6);
+            ckt.portLoadNodes.push_back(6);
+            ckt.portCurrents.push_back(1.0);
+            ckt.portBumpNodes.push_back({6});
+
+            IRDropAnalyser analyser(ckt, Technology());
+            CHECK(test, analyser.solve());
+            CHECK(test, std::isnan(analyser.getNodeVoltages()[6]));
+            const ChipletIRDrop &island = analyser.getChipletDrops()[1];
+            CHECK(test, !island.connected);
+            CHECK(test, std::isinf(island.portDrop));
+            // the floating load draws nothing from the connected part
+            CHECK_NEAR(test, analyser.getChipletDrops()[0].portDrop, v.loadCurrent * (v.c4Resistance + v.edgeResistance + v.ubumpResistance), 1e-12);
+        });
+    }
+
+    // series R + jwL, the capacitance in series when it is not 0
+    std::complex<double> seriesImpedance(double resistance, double inductance, double capacitance, double omega){
+        std::complex<double> z(resistance, omega * inductance);
+        if(capacitance != 0.0) z += std::complex<double>(0.0, -1.0 / (omega * capacitance));
+        return z;
+    }
+
+    std::complex<double> parallel(std::complex<double> a, std::complex<double> b){
+        return a * b / (a + b);
+    }
+
+    void testImpedance(SelfTest &test){
+        test.run("Impedance::log spaced frequencies", [&](){
+            std::vector<double> frequencies = ImpedanceAnalyser::getLogSpacedFrequencies(1e3, 1e9, 2);
+            CHECK(test, frequencies.size() == 13);
+            CHECK_NEAR(test, frequencies.front(), 1e3, 1e-9);
+            CHECK_NEAR(test, frequencies.back() / 1e9, 1.0, 1e-12);
+            CHECK_NEAR(test, frequencies[1] / frequencies[0], std::sqrt(10.0), 1e-12);
+        });
+
+        test.run("Impedance::RLC ladder seen from the chiplet", [&](){
+            LadderValues v;
+            v.parallelEdges = 2;
+            v.gridCapacitance = 1e-9;
+            PDNCircuit ckt = buildLadder(v);
+            ImpedanceAnalyser analyser(ckt);
+            std::vector<double> frequencies = ImpedanceAnalyser::getLogSpacedFrequencies(1e3, 1e10, 3);
+            CHECK(test, analyser.sweep(frequencies, 1));
+
+            // the VRM is a short in AC, so the supply side is both PCB branches in series down to ground
+            double worst = 0.0;
+            for(size_t fi = 0; fi < frequencies.size(); ++fi){
+                const double omega = 2.0 * M_PI * frequencies[fi];
+                std::complex<double> pcb = 2.0 * seriesImpedance(v.pcbResistance, v.pcbInductance, 0.0, omega);
+                std::complex<double> c4 = pcb + seriesImpedance(v.c4Resistance, v.c4Inductance, 0.0, omega);
+                std::complex<double> edges = seriesImpedance(v.edgeResistance, v.edgeInductance, 0.0, omega) / double(v.parallelEdges);
+                std::complex<double> bump = parallel(c4 + edges, seriesImpedance(0.0, 0.0, v.gridCapacitance, omega));
+                std::complex<double> die = seriesImpedance(v.dieResistance, v.dieInductance, v.dieCapacitance, omega);
+                std::complex<double> expected = parallel(bump + seriesImpedance(v.ubumpResistance, v.ubumpInductance, 0.0, omega), die);
+
+                std::complex<double> actual = analyser.getPortImpedance(0)[fi];
+                CHECK_NEAR(test, std::abs(actual - expected) / std::abs(expected), 0.0, 1e-9);
+                worst = std::max(worst, std::abs(expected));
+            }
+            CHECK_NEAR(test, analyser.getPeakImpedance(0) / worst, 1.0, 1e-9);
+        });
+    }
+
+    // with every inductance at 0 the die sees a single RC: the supply behind all series resistances and the die capacitance
+    void testTransient(SelfTest &test){
+        LadderValues v;
+        v.pcbInductance = v.c4Inductance = v.edgeInductance = v.ubumpInductance = v.dieInductance = 0.0;
+        const double Rt = 2.0 * v.pcbResistance + v.c4Resistance + v.edgeResistance + v.ubumpResistance + v.dieResistance;
+        const double tau = Rt * v.dieCapacitance;
+        const double h = tau / 200.0;
+        const double stopTime = 8.0 * tau;
+        // between two samples so the step is not at the mercy of the rounding of step * h
+        const LoadStep load{0.2, 2.0, 10.5 * h, 0.0};
+        const double swing = (load.stepCurrent - load.baseCurrent) * Rt;
+
+        auto expectedDie = [&](double time){
+            if(time <= load.stepTime) return 1.0 - load.baseCurrent * Rt;
+            return 1.0 - load.stepCurrent * Rt + swing * std::exp(-(time - load.stepTime) / tau);
+        };
+
+        for(IntegrationMethod method : {IntegrationMethod::TRAPEZOIDAL, IntegrationMethod::BACKWARD_EULER}){
+            const bool trapezoidal = (method == IntegrationMethod::TRAPEZOIDAL);
+            // backward Euler is first order, its step lands half a time step late
+            const double tolerance = (trapezoidal? 0.002 : 0.01) * swing;
+            test.run(std::string("Transient::RC step response, ") + (trapezoidal? "trapezoidal" : "backward Euler"), [&](){
+                PDNCircuit ckt = buildLadder(v);
+                TransientSimulator simulator(ckt, method, h, stopTime);
+                simulator.setLoadStep(0, load);
+                CHECK(test, simulator.run());
+                CHECK(test, simulator.getSampleCount() == size_t(std::llround(stopTime / h)) + 1);
+
+                // pcb_out, chip_o, chip_die
+                CHECK(test, simulator.getProbeNames().size() == 3);
+                const size_t dieProbe = 2;
+                CHECK_NEAR(test, simulator.getProbeValue(0, dieProbe), expectedDie(0.0), 1e-6);
+                for(double afterStep : {0.5 * tau, tau, 2.0 * tau, 6.0 * tau}){
+                    size_t sample = size_t(std::llround((load.stepTime + afterStep) / h));
+                    CHECK_NEAR(test, simulator.getProbeValue(sample, dieProbe), expectedDie(sample * h), tolerance);
+                }
+
+                double droopTime = 0.0;
+                double droop = simulator.getMaxDroop(0, &droopTime);
+                CHECK_NEAR(test, droop, swing * (1.0 - std::exp(-(stopTime - load.stepTime) / tau)), tolerance);
+                CHECK(test, droopTime > 6.0 * tau);
+            });
+        }
+
+        test.run("Transient::waveform file layout", [&](){
+            PDNCircuit ckt = buildLadder(v);
+            TransientSimulator simulator(ckt, IntegrationMethod::TRAPEZOIDAL, h, 20 * h);
+            CHECK(test, simulator.run());
+            const std::string filePath = test.getScratchPath("ladder.pxwf");
+            CHECK(test, simulator.writeWaveforms(filePath));
+
+            std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+            char magic[4];
+            uint32_t version, probeCount;
+            uint64_t sampleCount;
+            double startTime, timeStep;
+            ifs.read(magic, sizeof(magic));
+            ifs.read(reinterpret_cast<char *>(&version), sizeof(version));
+            ifs.read(reinterpret_cast<char *>(&probeCount), sizeof(probeCount));
+            ifs.read(reinterpret_cast<char *>(&sampleCount), sizeof(sampleCount));
+            ifs.read(reinterpret_cast<char *>(&startTime), sizeof(startTime));
+            ifs.read(reinterpret_cast<char *>(&timeStep), sizeof(timeStep));
+            CHECK(test, std::memcmp(magic, PDN_WAVEFORM_MAGIC, sizeof(magic)) == 0);
+            CHECK(test, version == PDN_WAVEFORM_VERSION);
+            CHECK(test, probeCount == 3);
+            CHECK(test, sampleCount == 21);
+            CHECK(test, startTime == 0.0);
+            CHECK(test, timeStep == h);
+
+            std::vector<std::string> names;
+            for(uint32_t p = 0; p < probeCount; ++p){
+                uint32_t nameLength = 0;
+                ifs.read(reinterpret_cast<char *>(&nameLength), sizeof(nameLength));
+                std::string name(nameLength, '\0');
+                ifs.read(name.data(), nameLength);
+                names.push_back(name);
+            }
+            CHECK(test, names == std::vector<std::string>({"pcb_out", "chip_o", "chip_die"}));
+
+            std::vector<float> samples(sampleCount * probeCount);
+            ifs.read(reinterpret_cast<char *>(samples.data()), samples.size() * sizeof(float));
+            CHECK(test, ifs.good());
+            CHECK(test, ifs.peek() == std::ifstream::traits_type::eof());
+            CHECK(test, samples[20 * probeCount + 2] == float(simulator.getProbeValue(20, 2)));
+        });
+
+        test.run("Transient::resistance-free DC branch is rejected", [&](){
+            PDNCircuit ckt = buildLadder(v);
+            ckt.branches.push_back(PDNBranch{PDNBranchType::EDGE, 2, 3, 0.0, 0.0, 0.0, PDN_EDGE_NONE});
+            TransientSimulator simulator(ckt, IntegrationMethod::TRAPEZOIDAL, h, 10 * h);
+            CHECK(test, !simulator.run());
+        });
+    }
+
+    // the interposer part of the ladder is a T: edge and uBump arms meeting at the bump node, the grid capacitance as the leg
+    void testMacromodel(SelfTest &test){
+        LadderValues v;
+        v.gridCapacitance = 1e-9;
+
+        test.run("Macromodel::two-port T network", [&](){
+            PDNCircuit ckt = buildLadder(v);
+            MacromodelReducer reducer(ckt);
+            CHECK(test, reducer.reduce(4, 1e9));
+            CHECK(test, reducer.getPortNames() == std::vector<std::string>({"c4", "chip_o"}));
+            // c4, bump and chip_o voltages, the edge and uBump currents
+            CHECK(test, reducer.getFullOrder() == 5);
+            CHECK(test, reducer.getReducedOrder() <= reducer.getFullOrder());
+
+            // the Krylov space spans the whole state space, so the reduced model is exact
+            for(double frequency : ImpedanceAnalyser::getLogSpacedFrequencies(1e6, 1e10, 2)){
+                const double omega = 2.0 * M_PI * frequency;
+                const std::complex<double> s(0.0, omega);
+                const std::complex<double> za = v.edgeResistance + s * v.edgeInductance;
+                const std::complex<double> zb = v.ubumpResistance + s * v.ubumpInductance;
+                const std::complex<double> zc = 1.0 / (s * v.gridCapacitance);
+                const std::vector<std::complex<double>> expected = {za + zc, zc, zc, zb + zc};
+
+                std::vector<std::complex<double>> actual = reducer.evaluate(frequency);
+                CHECK(test, actual.size() == 4);
+                for(size_t i = 0; i < expected.size(); ++i){
+                    CHECK_NEAR(test, std::abs(actual[i] - expected[i]) / std::abs(expected[i]), 0.0, 1e-8);
+                }
+            }
+        });
+
+        test.run("Macromodel::one block moment per port", [&](){
+            PDNCircuit ckt = buildLadder(v);
+            MacromodelReducer reducer(ckt);
+            CHECK(test, reducer.reduce(1, 1e9));
+            CHECK(test, reducer.getReducedOrder() <= 2);
+            // a congruence transform keeps the model reciprocal however low its order
+            for(double frequency : {1e6, 1e8, 1e10}){
+                std::vector<std::complex<double>> z = reducer.evaluate(frequency);
+                CHECK_NEAR(test, std::abs(z[1] - z[2]) / std::abs(z[1]), 0.0, 1e-12);
+            }
+        });
+    }
+}
+
+void runCircuitTests(SelfTest &test){
+    testIRDrop(test);
+    testImpedance(test);
+    testTransient(test);
+    testMacromodel(test);
+}
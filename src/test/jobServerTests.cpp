@@ -0,0 +1,179 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 23:41:26
+//  Module Name:        jobServerTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The daemon protocol of JobServer, served in-process on a
+//                      scratch socket with a handler that only echoes the request
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "jobServer.hpp"
+#include "selfTest.hpp"
+
+// 4. POSIX
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+namespace {
+    int connectTo(const std::string &socketPath){
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if((fd >= 0) && (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)){
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // every line the daemon writes until it hangs up
+    std::vector<std::string> readReply(int fd){
+        std::string text;
+        char buffer[1024];
+        ssize_t n;
+        while((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) text.append(buffer, size_t(n));
+        ::close(fd);
+
+        std::vector<std::string> lines;
+        std::istringstream iss(text);
+        std::string line;
+        while(std::getline(iss, line)) lines.push_back(line);
+        return lines;
+    }
+
+    std::vector<std::string> request(const std::string &socketPath, const std::string &text){
+        int fd = connectTo(socketPath);
+        if(fd < 0) return {"connect failed"};
+        ::send(fd, text.data(), text.size(), 0);
+        return readReply(fd);
+    }
+
+    bool startsWith(const std::string &text, const std::string &prefix){
+        return text.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    // echoes the request back, "fail" fails and "throw" throws
+    bool echoHandler(uint64_t jobId, const JobRequest &request, int workerIdx, const JobReply &reply){
+        (void)jobId;
+        (void)workerIdx;
+        reply("CASE " + request.caseSpec);
+        for(const std::pair<std::string, std::string> &kv : request.overrides) reply("SET " + kv.first + "=" + kv.second);
+        if(!request.outputDir.empty()) reply("OUTPUT " + request.outputDir);
+        if(request.caseSpec == "throw") throw std::runtime_error("handler threw");
+        return request.caseSpec != "fail";
+    }
+}
+
+void runJobServerTests(SelfTest &test){
+    const std::vector<std::string> testNames = {"JobServer::open", "JobServer::ping and status", "JobServer::run jobs", "JobServer::malformed requests",
+                                                "JobServer::idle client times out", "JobServer::shutdown"};
+    if(std::none_of(testNames.begin(), testNames.end(), [&](const std::string &name){return test.isSelected(name);})) return;
+
+    const std::string socketPath = test.getScratchPath("jobServer.sock");
+    JobServer server(socketPath, 1);
+    bool opened = server.open();
+    test.run("JobServer::open", [&](){
+        CHECK(test, opened);
+        if(!opened) return;
+        // a second daemon on the same path must not steal the socket
+        JobServer intruder(socketPath, 1);
+        CHECK(test, !intruder.open());
+    });
+    if(!opened) return;
+    std::thread serving([&](){server.serve(echoHandler);});
+
+    test.run("JobServer::ping and status", [&](){
+        CHECK(test, request(socketPath, "PING\n") == std::vector<std::string>({"PONG"}));
+        CHECK(test, request(socketPath, "STATUS\r\n") == std::vector<std::string>({"STATUS WORKERS 1 RUNNING 0 QUEUED 0 FINISHED 0"}));
+    });
+
+    test.run("JobServer::run jobs", [&](){
+        std::vector<std::string> lines = request(socketPath, "RUN case01\nSET maxFillingRate=0.8\nSET batchSize=1024\nOUTPUT outputs/job/\n\n");
+        CHECK(test, lines.size() == 7);
+        if(lines.size() != 7) return;
+        CHECK(test, lines[0] == "ACCEPTED 1 QUEUED 0");
+        CHECK(test, lines[1] == "STARTED 1 WORKER 0");
+        CHECK(test, lines[2] == "CASE case01");
+        CHECK(test, lines[3] == "SET maxFillingRate=0.8");
+        CHECK(test, lines[4] == "SET batchSize=1024");
+        CHECK(test, lines[5] == "OUTPUT outputs/job/");
+        CHECK(test, startsWith(lines[6], "DONE 1 OK "));
+
+        lines = request(socketPath, "RUN fail\n\n");
+        CHECK(test, !lines.empty() && startsWith(lines.back(), "DONE 2 FAILED "));
+        lines = request(socketPath, "RUN throw\n\n");
+        CHECK(test, lines.size() >= 2 && lines[lines.size() - 2] == "ERROR handler threw");
+        CHECK(test, !lines.empty() && startsWith(lines.back(), "DONE 3 FAILED "));
+        CHECK(test, request(socketPath, "STATUS\n") == std::vector<std::string>({"STATUS WORKERS 1 RUNNING 0 QUEUED 0 FINISHED 3"}));
+    });
+
+    test.run("JobServer::malformed requests", [&](){
+        auto isError = [&](const std::string &text, const std::string &reason){
+            std::vector<std::string> lines = request(socketPath, text);
+            return (lines.size() == 1) && startsWith(lines[0], "ERROR " + reason);
+        };
+        CHECK(test, isError("HELLO\n", "unknown request \"HELLO\""));
+        CHECK(test, isError("RUN\n\n", "RUN expects a case"));
+        CHECK(test, isError("RUN case01\nSET maxFillingRate\n\n", "SET expects <key>=<value>"));
+        CHECK(test, isError("RUN case01\nSET =1\n\n", "SET expects <key>=<value>"));
+        CHECK(test, isError("RUN case01\nOUTPUT\n\n", "OUTPUT expects a directory"));
+        CHECK(test, isError("RUN case01\nRESUME filling\n\n", "unknown RUN option \"RESUME\""));
+        CHECK(test, isError("\n\n", "empty request"));
+        // none of them reached a worker
+        CHECK(test, request(socketPath, "STATUS\n") == std::vector<std::string>({"STATUS WORKERS 1 RUNNING 0 QUEUED 0 FINISHED 3"}));
+    });
+
+    test.run("JobServer::idle client times out", [&](){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int idleFd = connectTo(socketPath);
+        CHECK(test, idleFd >= 0);
+        if(idleFd < 0) return;
+        // a client that says nothing holds up nobody else
+        CHECK(test, request(socketPath, "PING\n") == std::vector<std::string>({"PONG"}));
+        CHECK(test, std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+        std::vector<std::string> lines = readReply(idleFd);
+        double waited = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        CHECK(test, lines.size() == 1 && startsWith(lines[0], "ERROR request not received within"));
+        CHECK(test, waited > 4.0 && waited < 10.0);
+    });
+
+    test.run("JobServer::shutdown", [&](){
+        CHECK(test, request(socketPath, "SHUTDOWN\n") == std::vector<std::string>({"BYE"}));
+        serving.join();
+        struct stat st;
+        CHECK(test, ::stat(socketPath.c_str(), &st) != 0);
+        CHECK(test, connectTo(socketPath) < 0);
+    });
+    if(serving.joinable()){
+        request(socketPath, "SHUTDOWN\n");
+        serving.join();
+    }
+}
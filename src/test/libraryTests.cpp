@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/21/2026 00:06:38
+//  Module Name:        libraryTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The embeddable PowerXDesign API on a small in-memory
+//                      DesignSpec: what validate() turns away and what a design
+//                      exposes before and after its first stage
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "cord.hpp"
+#include "signalType.hpp"
+#include "ballOut.hpp"
+#include "designSpec.hpp"
+#include "powerxLibrary.hpp"
+#include "selfTest.hpp"
+
+namespace {
+    // a 6 x 6 grid (7 x 7 pins) with 3 metal layers, two 2 x 2 chiplets and a 2 x 2 array of single pin C4 clusters
+    DesignSpec buildSpec(){
+        const std::vector<std::vector<SignalType>> checker = {{SignalType::POWER_1, SignalType::GROUND}, {SignalType::GROUND, SignalType::POWER_1}};
+
+        DesignSpec spec;
+        spec.gridWidth = 6;
+        spec.gridHeight = 6;
+        spec.metalLayerCount = 3;
+        spec.ballOuts.emplace_back("core", checker, 2.0, 1.0, 0.01, 100.0);
+        spec.chiplets.push_back(ChipletPlacement{"core_0", "core", BallOutRotation::R0, 1, 1});
+        spec.chiplets.push_back(ChipletPlacement{"core_1", "core", BallOutRotation::R90, 4, 4});
+
+        spec.c4BallOut = BallOut("c4", checker, 0.0, 0.0, 0.0, 0.0);
+        spec.c4Rotation = BallOutRotation::R0;
+        // 1 + 1 + 4 x (2 - 1) + 1 = 7 pins both ways
+        spec.c4Layout = C4Layout{1, 1, 4, 4, 2, 2, 1, 1, 1, 1};
+
+        spec.metalPreplaced.resize(1);
+        spec.metalPreplaced[0][SignalType::POWER_1] = {Cord(0, 0), Cord(1, 0)};
+        // the outermost ring of pins is blocked on every via layer, as in the shipped cases
+        spec.viaPreplaced.resize(spec.metalLayerCount - 1);
+        for(std::unordered_map<SignalType, std::vector<Cord>> &layer : spec.viaPreplaced){
+            std::vector<Cord> &ring = layer[SignalType::OBSTACLE];
+            for(int i = 0; i <= spec.gridWidth; ++i){
+                ring.push_back(Cord(i, 0));
+                ring.push_back(Cord(i, spec.gridHeight));
+            }
+            for(int j = 1; j < spec.gridHeight; ++j){
+                ring.push_back(Cord(0, j));
+                ring.push_back(Cord(spec.gridWidth, j));
+            }
+        }
+        return spec;
+    }
+
+    void testValidate(SelfTest &test){
+        test.run("Library::validate accepts the reference spec", [&](){
+            std::string error;
+            CHECK(test, PowerXDesign::validate(buildSpec(), error));
+            CHECK(test, error.empty());
+        });
+
+        // each mutation of the reference spec must be turned away with a reason naming the problem
+        auto rejects = [&](const std::function<void(DesignSpec &)> &mutate, const std::string &reason){
+            DesignSpec spec = buildSpec();
+            mutate(spec);
+            std::string error;
+            return !PowerXDesign::validate(spec, error) && (error.find(reason) != std::string::npos);
+        };
+
+        test.run("Library::validate rejects broken specs", [&](){
+            CHECK(test, rejects([](DesignSpec &s){s.gridWidth = 0;}, "grid size must be positive"));
+            CHECK(test, rejects([](DesignSpec &s){s.metalLayerCount = 1;}, "at least 2 metal layers"));
+            CHECK(test, rejects([](DesignSpec &s){s.ballOuts.push_back(BallOut());}, "ballout without a name"));
+            CHECK(test, rejects([](DesignSpec &s){s.ballOuts.push_back(s.ballOuts[0]);}, "repeated ballout core"));
+            CHECK(test, rejects([](DesignSpec &s){s.ballOuts[0] = BallOut(s.ballOuts[0], BallOutRotation::R90);}, "must be given as R0"));
+            CHECK(test, rejects([](DesignSpec &s){s.chiplets[1].instanceName = "core_0";}, "repeated chiplet instance core_0"));
+            CHECK(test, rejects([](DesignSpec &s){s.chiplets[0].ballOutName = "gpu";}, "unknown ballout gpu"));
+            CHECK(test, rejects([](DesignSpec &s){s.chiplets[0].rotation = BallOutRotation::UNKNOWN;}, "no valid rotation"));
+            // 6 + 2 pins overrun the 7 pin wide interposer, 5 + 2 just fits
+            CHECK(test, rejects([](DesignSpec &s){s.chiplets[1].x = 6;}, "core_1 lies outside the interposer"));
+            CHECK(test, rejects([](DesignSpec &s){s.chiplets[0].y = -1;}, "core_0 lies outside the interposer"));
+            CHECK(test, rejects([](DesignSpec &s){s.c4BallOut = BallOut();}, "C4 ballout is empty"));
+            CHECK(test, rejects([](DesignSpec &s){s.c4Layout.clusterPitchWidth = 0;}, "C4 cluster pitch cannot be smaller"));
+            CHECK(test, rejects([](DesignSpec &s){s.c4Layout.leftBorder = 2;}, "do not add up to the pin width 7"));
+            CHECK(test, rejects([](DesignSpec &s){s.c4Layout.upBorder = 0;}, "do not add up to the pin height 7"));
+            CHECK(test, rejects([](DesignSpec &s){s.c4Layout.clusterCountWidth = 3; s.c4Layout.clusterPitchWidth = 2;}, "smaller than the cluster count"));
+            CHECK(test, rejects([](DesignSpec &s){s.metalPreplaced.resize(4);}, "metal preplace given for 4 layers, only 3 exist"));
+            CHECK(test, rejects([](DesignSpec &s){s.metalPreplaced[0][SignalType::EMPTY] = {Cord(2, 2)};}, "has no signal"));
+            // metal cords are grid cords, via cords are pin cords
+            CHECK(test, rejects([](DesignSpec &s){s.metalPreplaced[0][SignalType::GROUND] = {Cord(6, 0)};}, "metal preplace of layer 0 lies outside"));
+            CHECK(test, rejects([](DesignSpec &s){s.viaPreplaced[0][SignalType::GROUND] = {Cord(7, 7)};}, "via preplace of layer 0 lies outside"));
+            CHECK(test, rejects([](DesignSpec &s){s.viaPreplaced.resize(3);}, "via preplace given for 3 layers, only 2 exist"));
+            // a pin of the ring left open, or opened up by a power preplace that does not block it
+            CHECK(test, rejects([](DesignSpec &s){s.viaPreplaced.resize(1);}, "via layer 1 leaves border pin (0, 0) unblocked"));
+            CHECK(test, rejects([](DesignSpec &s){
+                std::vector<Cord> &ring = s.viaPreplaced[0][SignalType::OBSTACLE];
+                ring.erase(std::find(ring.begin(), ring.end(), Cord(3, 6)));
+                s.viaPreplaced[0][SignalType::POWER_1] = {Cord(3, 6)};
+            }, "via layer 0 leaves border pin (3, 6) unblocked"));
+            // a cord under two signals is painted in map order, an OBSTACLE ring pin also listed as POWER_1 may end up open
+            CHECK(test, rejects([](DesignSpec &s){s.viaPreplaced[0][SignalType::POWER_1] = {Cord(3, 6)};}, "via preplace of layer 0 lists cord (3, 6) under more than one signal"));
+            CHECK(test, rejects([](DesignSpec &s){s.metalPreplaced[0][SignalType::GROUND] = {Cord(1, 0)};}, "metal preplace of layer 0 lists cord (1, 0) under more than one signal"));
+        });
+
+        test.run("Library::validate accepts the boundaries", [&](){
+            std::string error;
+            DesignSpec spec = buildSpec();
+            spec.chiplets[1].x = 5;
+            spec.chiplets[1].y = 5;
+            spec.metalPreplaced[0][SignalType::GROUND] = {Cord(5, 5)};
+            spec.viaPreplaced[1][SignalType::GROUND] = {Cord(5, 5)};
+            // any signal that turns into an obstacle blocks the ring too
+            std::vector<Cord> &ring = spec.viaPreplaced[1][SignalType::OBSTACLE];
+            ring.erase(std::find(ring.begin(), ring.end(), Cord(0, 3)));
+            spec.viaPreplaced[1][SignalType::SIGNAL] = {Cord(0, 3)};
+            // the same signal listed twice is harmless
+            spec.metalPreplaced[0][SignalType::POWER_1].push_back(Cord(0, 0));
+            CHECK(test, PowerXDesign::validate(spec, error));
+        });
+    }
+
+    void testDesign(SelfTest &test){
+        test.run("Library::rejected spec gives an invalid design", [&](){
+            DesignSpec spec = buildSpec();
+            spec.metalLayerCount = 1;
+            PowerXDesign design(spec);
+            CHECK(test, !design.isValid());
+            CHECK(test, design.getError() == "at least 2 metal layers are needed");
+            CHECK(test, !design.runUntil(PowerXStage::PREPROCESS));
+            CHECK(test, design.getCompletedStage() == PowerXStage::NONE);
+        });
+
+        test.run("Library::design runs the preprocess stage", [&](){
+            PowerXDesign design(buildSpec());
+            CHECK(test, design.isValid());
+            if(!design.isValid()) return;
+            CHECK(test, design.getCompletedStage() == PowerXStage::NONE);
+            CHECK(test, design.getGridWidth() == 6 && design.getGridHeight() == 6);
+            CHECK(test, design.getPinWidth() == 7 && design.getPinHeight() == 7);
+            CHECK(test, design.getMetalLayerCount() == 3 && design.getViaLayerCount() == 2);
+            CHECK(test, design.getMetrics().empty());
+
+            // nothing to run up to the stage already completed
+            CHECK(test, design.runUntil(PowerXStage::NONE));
+            CHECK(test, design.runUntil(PowerXStage::PREPROCESS));
+            CHECK(test, design.getCompletedStage() == PowerXStage::PREPROCESS);
+            CHECK(test, design.runUntil(PowerXStage::PREPROCESS));
+
+            std::span<const std::vector<SignalType>> metal = design.getMetalCanvas(0);
+            CHECK(test, metal.size() == 6 && metal[0].size() == 6);
+            CHECK(test, metal.size() == 6 && metal[0][0] == SignalType::POWER_1 && metal[0][1] == SignalType::POWER_1);
+            std::span<const std::vector<SignalType>> via = design.getViaCanvas(1);
+            CHECK(test, via.size() == 7 && via[0].size() == 7);
+
+            std::span<const std::pair<std::string, double>> metrics = design.getMetrics();
+            CHECK(test, metrics.size() == 1 && metrics[0].first == "runtime_PREPROCESS" && metrics[0].second >= 0.0);
+            // drops only exist after the ANALYSIS stage
+            CHECK(test, design.getChipletDrops(SignalType::POWER_1).empty());
+        });
+
+        test.run("Library::stage names", [&](){
+            CHECK(test, std::string(to_string(PowerXStage::NONE)) == "NONE");
+            CHECK(test, std::string(to_string(PowerXStage::FILLING)) == "FILLING");
+            CHECK(test, std::string(to_string(PowerXStage::ANALYSIS)) == "ANALYSIS");
+            CHECK(test, std::string(to_string(static_cast<PowerXStage>(42))) == "UNKNOWN");
+        });
+    }
+}
+
+void runLibraryTests(SelfTest &test){
+    testValidate(test);
+    testDesign(test);
+}
@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/21/2026 01:12:47
+//  Module Name:        rasteriserTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The PNG and PPM encoders of RasterImage on a small grid
+//                      dump: signature, IHDR, chunk CRCs and the inflated
+//                      scanlines decoded back to pixels
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "technology.hpp"
+#include "colours.hpp"
+#include "rasteriser.hpp"
+#include "selfTest.hpp"
+
+// 4. zlib
+#include <zlib.h>
+
+namespace {
+    struct PNGChunk{
+        std::string type;
+        std::vector<uint8_t> data;
+        bool crcMatches;
+    };
+
+    uint32_t readBigEndian(const uint8_t *bytes){
+        return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+    }
+
+    std::vector<uint8_t> readFile(const std::string &filePath){
+        std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    // the chunks after the signature, empty if the file is cut short
+    std::vector<PNGChunk> readChunks(const std::vector<uint8_t> &bytes){
+        std::vector<PNGChunk> chunks;
+        size_t pos = 8;
+        while(pos + 12 <= bytes.size()){
+            uint32_t length = readBigEndian(&bytes[pos]);
+            if(pos + 12 + length > bytes.size()) return {};
+            PNGChunk chunk;
+            chunk.type.assign(bytes.begin() + pos + 4, bytes.begin() + pos + 8);
+            chunk.data.assign(bytes.begin() + pos + 8, bytes.begin() + pos + 8 + length);
+            uLong crc = crc32(0L, Z_NULL, 0);
+            crc = crc32(crc, &bytes[pos + 4], uInt(4 + length));
+            chunk.crcMatches = (uint32_t(crc) == readBigEndian(&bytes[pos + 8 + length]));
+            chunks.push_back(chunk);
+            pos += 12 + length;
+        }
+        return chunks;
+    }
+
+    // a 3 x 2 POWER_1 grid under 4 x 3 EMPTY pins with one GROUND pin, 5 x 4 cells of 10 pixels with the margin
+    void rasteriseSample(const std::string &filePath, bool &written){
+        std::vector<std::vector<SignalType>> grid(2, std::vector<SignalType>(3, SignalType::POWER_1));
+        std::vector<std::vector<SignalType>> pins(3, std::vector<SignalType>(4, SignalType::EMPTY));
+        pins[0][0] = SignalType::GROUND;
+        written = rasteriseGridArrayWithPin(grid, pins, Technology(), filePath);
+    }
+
+    void testPNG(SelfTest &test){
+        test.run("Rasteriser::PNG header and IHDR", [&](){
+            const std::string filePath = test.getScratchPath("grid.png");
+            bool written = false;
+            rasteriseSample(filePath, written);
+            CHECK(test, written);
+            std::vector<uint8_t> bytes = readFile(filePath);
+            const std::vector<uint8_t> signature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            CHECK(test, bytes.size() > 8 && std::vector<uint8_t>(bytes.begin(), bytes.begin() + 8) == signature);
+
+            std::vector<PNGChunk> chunks = readChunks(bytes);
+            CHECK(test, chunks.size() == 3);
+            if(chunks.size() != 3) return;
+            CHECK(test, chunks[0].type == "IHDR" && chunks[1].type == "IDAT" && chunks[2].type == "IEND");
+            CHECK(test, chunks[0].crcMatches && chunks[1].crcMatches && chunks[2].crcMatches);
+            CHECK(test, chunks[0].data.size() == 13);
+            if(chunks[0].data.size() != 13) return;
+            CHECK(test, readBigEndian(&chunks[0].data[0]) == 50);
+            CHECK(test, readBigEndian(&chunks[0].data[4]) == 40);
+            // 8 bit RGB, deflate, no filter method extensions, no interlace
+            CHECK(test, std::vector<uint8_t>(chunks[0].data.begin() + 8, chunks[0].data.end()) == std::vector<uint8_t>({8, 2, 0, 0, 0}));
+            CHECK(test, chunks[2].data.empty());
+        });
+
+        test.run("Rasteriser::PNG scanlines match the PPM", [&](){
+            const std::string pngPath = test.getScratchPath("grid.png");
+            const std::string ppmPath = test.getScratchPath("grid.ppm");
+            bool pngWritten = false, ppmWritten = false;
+            rasteriseSample(pngPath, pngWritten);
+            rasteriseSample(ppmPath, ppmWritten);
+            CHECK(test, pngWritten && ppmWritten);
+
+            std::vector<PNGChunk> chunks = readChunks(readFile(pngPath));
+            CHECK(test, chunks.size() == 3);
+            if(chunks.size() != 3) return;
+            // one filter byte then 50 RGB pixels per row
+            const size_t rowBytes = 50 * 3;
+            std::vector<uint8_t> scanlines((rowBytes + 1) * 40);
+            uLongf inflatedSize = uLongf(scanlines.size());
+            CHECK(test, uncompress(scanlines.data(), &inflatedSize, chunks[1].data.data(), uLong(chunks[1].data.size())) == Z_OK);
+            CHECK(test, inflatedSize == scanlines.size());
+
+            std::vector<uint8_t> pixels;
+            bool filtersAreNone = true;
+            for(size_t row = 0; row < 40; ++row){
+                filtersAreNone &= (scanlines[row * (rowBytes + 1)] == 0);
+                pixels.insert(pixels.end(), scanlines.begin() + row * (rowBytes + 1) + 1, scanlines.begin() + (row + 1) * (rowBytes + 1));
+            }
+            CHECK(test, filtersAreNone);
+
+            std::vector<uint8_t> ppm = readFile(ppmPath);
+            const std::string ppmHeader = "P6\n50 40\n255\n";
+            CHECK(test, ppm.size() == ppmHeader.size() + pixels.size());
+            CHECK(test, std::string(ppm.begin(), ppm.begin() + ppmHeader.size()) == ppmHeader);
+            CHECK(test, std::vector<uint8_t>(ppm.begin() + ppmHeader.size(), ppm.end()) == pixels);
+
+            // the margin stays white, the centre of grid cell (0, 0) is POWER_1 at half alpha over white
+            CHECK(test, pixels[0] == 0xFF && pixels[1] == 0xFF && pixels[2] == 0xFF);
+            const uint8_t *power = colours::SIGNAL_RGB[static_cast<uint8_t>(SignalType::POWER_1)];
+            const uint8_t *centre = &pixels[(size_t(40 - 15) * 50 + 15) * 3];
+            bool blended = true;
+            for(int c = 0; c < 3; ++c) blended &= (centre[c] == uint8_t((power[c] + 0xFF + 1) / 2));
+            CHECK(test, blended);
+        });
+
+        test.run("Rasteriser::unwritable path", [&](){
+            bool written = true;
+            rasteriseSample(test.getScratchPath("missing/grid.png"), written);
+            CHECK(test, !written);
+        });
+    }
+}
+
+void runRasteriserTests(SelfTest &test){
+    testPNG(test);
+}
@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:48:02
+//  Module Name:        selfTest.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Small check harness behind "make check". A test is a named
+//                      body of CHECK / CHECK_NEAR lines against golden values
+//                      worked out by hand (analytic circuits, hand-built binary
+//                      files), a failed check is reported with its line and the
+//                      test goes on so one run shows every mismatch
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <filesystem>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "colours.hpp"
+#include "selfTest.hpp"
+
+SelfTest::SelfTest(const std::string &filter, const std::string &scratchDir)
+    : m_filter(filter), m_scratchDir(scratchDir), m_currentFailed(false), m_testCount(0), m_checkCount(0), m_failedCheckCount(0) {
+
+}
+
+void SelfTest::fail(const std::string &message, const char *file, int line){
+    std::cout << colours::RED << "[PowerX:Check] " << m_currentTest << ": " << message;
+    if(file != nullptr) std::cout << " (" << file << ":" << line << ")";
+    std::cout << colours::COLORRST << std::endl;
+    m_currentFailed = true;
+}
+
+bool SelfTest::isSelected(const std::string &name) const {
+    return m_filter.empty() || (name.find(m_filter) != std::string::npos);
+}
+
+void SelfTest::run(const std::string &name, const std::function<void()> &body){
+    if(!isSelected(name)) return;
+
+    m_currentTest = name;
+    m_currentFailed = false;
+    ++m_testCount;
+    try{
+        body();
+    }catch(const std::exception &e){
+        fail(std::string("threw ") + e.what(), nullptr, 0);
+    }catch(...){
+        fail("threw an unknown exception", nullptr, 0);
+    }
+
+    if(m_currentFailed) m_failedTests.push_back(name);
+    std::cout << (m_currentFailed? colours::RED : colours::GREEN) << "[PowerX:Check] " << (m_currentFailed? "FAIL " : "PASS ") << name << colours::COLORRST << std::endl;
+}
+
+bool SelfTest::check(bool condition, const char *expression, const char *file, int line){
+    ++m_checkCount;
+    if(condition) return true;
+    ++m_failedCheckCount;
+    fail(std::string(expression) + " is false", file, line);
+    return false;
+}
+
+bool SelfTest::checkNear(double actual, double expected, double tolerance, const char *expression, const char *file, int line){
+    ++m_checkCount;
+    // NaN never compares within tolerance
+    if(std::abs(actual - expected) <= tolerance) return true;
+    ++m_failedCheckCount;
+    std::ostringstream message;
+    message.precision(10);
+    message << expression << " = " << actual << ", expected " << expected << " +- " << tolerance;
+    fail(message.str(), file, line);
+    return false;
+}
+
+std::string SelfTest::getScratchPath(const std::string &fileName) const {
+    std::filesystem::create_directories(m_scratchDir);
+    return m_scratchDir + fileName;
+}
+
+void SelfTest::printReport() const {
+    std::cout << "[PowerX:Check] " << m_testCount << " tests, " << m_checkCount << " checks, ";
+    std::cout << m_failedTests.size() << " failed tests, " << m_failedCheckCount << " failed checks" << std::endl;
+    for(const std::string &name : m_failedTests) std::cout << colours::RED << "[PowerX:Check]     " << name << colours::COLORRST << std::endl;
+}
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:48:02
+//  Module Name:        selfTest.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Small check harness behind "make check". A test is a named
+//                      body of CHECK / CHECK_NEAR lines against golden values
+//                      worked out by hand (analytic circuits, hand-built binary
+//                      files), a failed check is reported with its line and the
+//                      test goes on so one run shows every mismatch
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SELF_TEST_H__
+#define __SELF_TEST_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <vector>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+
+class SelfTest{
+private:
+    std::string m_filter;
+    std::string m_scratchDir;
+
+    std::string m_currentTest;
+    bool m_currentFailed;
+    size_t m_testCount;
+    size_t m_checkCount;
+    size_t m_failedCheckCount;
+    std::vector<std::string> m_failedTests;
+
+    void fail(const std::string &message, const char *file, int line);
+
+public:
+    // only tests whose name contains filter run, empty runs all
+    explicit SelfTest(const std::string &filter = "", const std::string &scratchDir = "outputs/check/");
+
+    bool isSelected(const std::string &name) const;
+    // a body that throws fails its test
+    void run(const std::string &name, const std::function<void()> &body);
+
+    bool check(bool condition, const char *expression, const char *file, int line);
+    // |actual - expected| <= tolerance
+    bool checkNear(double actual, double expected, double tolerance, const char *expression, const char *file, int line);
+
+    // fileName under the scratch directory, which is created on demand
+    std::string getScratchPath(const std::string &fileName) const;
+
+    void printReport() const;
+    inline bool passed() const {return this->m_failedTests.empty();}
+};
+
+#define CHECK(test, condition) (test).check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(test, actual, expected, tolerance) (test).checkNear((actual), (expected), (tolerance), #actual, __FILE__, __LINE__)
+
+// one per file of src/test, each runs its tests through test.run
+void runCircuitTests(SelfTest &test);
+void runSnapshotTests(SelfTest &test);
+void runCheckpointTests(SelfTest &test);
+void runTokenizerTests(SelfTest &test);
+void runJobServerTests(SelfTest &test);
+void runLibraryTests(SelfTest &test);
+void runRasteriserTests(SelfTest &test);
+
+#endif // __SELF_TEST_H__
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 22:36:15
+//  Module Name:        snapshotTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        The binary PDN snapshot: round trips of both payload
+//                      packings and the rejection of corrupted headers
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "objectArray.hpp"
+#include "pdnSnapshot.hpp"
+#include "selfTest.hpp"
+
+namespace {
+    constexpr uint64_t CASE_HASH = 0x0123456789ABCDEFull;
+
+    // two 3 x 2 metal layers and one 4 x 3 via layer, every SignalType appears at least once
+    struct SnapshotLayers{
+        std::vector<ObjectArray> metal;
+        std::vector<ObjectArray> via;
+
+        SnapshotLayers(): metal(2, ObjectArray(3, 2)), via(1, ObjectArray(4, 3)) {
+            int value = 0;
+            for(ObjectArray &layer : metal){
+                for(std::vector<SignalType> &row : layer.canvas){
+                    for(SignalType &cell : row) cell = static_cast<SignalType>(value++ % EnumTraits<SignalType>::count);
+                }
+            }
+            for(ObjectArray &layer : via){
+                for(std::vector<SignalType> &row : layer.canvas){
+                    for(SignalType &cell : row) cell = static_cast<SignalType>(value++ % EnumTraits<SignalType>::count);
+                }
+            }
+        }
+    };
+
+    template <typename T>
+    void overwrite(const std::string &filePath, size_t offset, T value){
+        std::fstream fs(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(offset);
+        fs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void testRoundTrip(SelfTest &test){
+        const SnapshotLayers layers;
+        for(bool packed : {false, true}){
+            test.run(std::string("Snapshot::round trip, ") + (packed? "packed" : "one byte per cell"), [&](){
+                const std::string filePath = test.getScratchPath("roundTrip.pxsn");
+                CHECK(test, PDNSnapshot::write(filePath, layers.metal, layers.via, CASE_HASH, packed));
+                CHECK(test, PDNSnapshot::isSnapshotFile(filePath));
+                // 2 x 3 x 2 metal and 1 x 4 x 3 via cells
+                CHECK(test, std::filesystem::file_size(filePath) == sizeof(PDNSnapshotHeader) + (packed? 12 : 24));
+
+                PDNSnapshot snapshot;
+                CHECK(test, snapshot.open(filePath));
+                if(!snapshot.isOpen()) return;
+                const PDNSnapshotHeader &header = snapshot.getHeader();
+                CHECK(test, header.version == PDN_SNAPSHOT_VERSION);
+                CHECK(test, header.packed == (packed? 1u : 0u));
+                CHECK(test, header.metalLayerCount == 2 && header.gridWidth == 3 && header.gridHeight == 2);
+                CHECK(test, header.viaLayerCount == 1 && header.pinWidth == 4 && header.pinHeight == 3);
+                CHECK(test, header.caseHash == CASE_HASH);
+                CHECK(test, header.cellCount == 24);
+                CHECK(test, header.payloadBytes == (packed? 12u : 24u));
+
+                bool allMatch = true;
+                for(int layer = 0; layer < 2; ++layer){
+                    for(int y = 0; y < 2; ++y){
+                        for(int x = 0; x < 3; ++x) allMatch &= (snapshot.getMetalCell(layer, y, x) == layers.metal[layer].canvas[y][x]);
+                    }
+                }
+                for(int y = 0; y < 3; ++y){
+                    for(int x = 0; x < 4; ++x) allMatch &= (snapshot.getViaCell(0, y, x) == layers.via[0].canvas[y][x]);
+                }
+                CHECK(test, allMatch);
+
+                snapshot.close();
+                CHECK(test, !snapshot.isOpen());
+            });
+        }
+    }
+
+    void testCorruptHeader(SelfTest &test){
+        const SnapshotLayers layers;
+
+        // every case starts from a freshly written file and patches one header field
+        auto rejects = [&](bool packed, const std::function<void(const std::string &)> &corrupt){
+            const std::string filePath = test.getScratchPath("corrupt.pxsn");
+            PDNSnapshot::write(filePath, layers.metal, layers.via, CASE_HASH, packed);
+            corrupt(filePath);
+            PDNSnapshot snapshot;
+            return !snapshot.open(filePath) && !snapshot.isOpen();
+        };
+
+        for(bool packed : {false, true}){
+            test.run(std::string("Snapshot::corrupt header is rejected, ") + (packed? "packed" : "one byte per cell"), [&](){
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, 0, 'Q');}));
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, version), PDN_SNAPSHOT_VERSION + 1);}));
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, packed), uint32_t(7));}));
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, cellCount), uint64_t(1) << 30);}));
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, payloadBytes), uint64_t(3));}));
+                // dimensions that overflow the cell count
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, gridWidth), UINT32_MAX);}));
+                CHECK(test, rejects(packed, [](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, metalLayerCount), UINT32_MAX);}));
+                // a flipped packing flag makes the payload size disagree with the cell count
+                CHECK(test, rejects(packed, [=](const std::string &p){overwrite(p, offsetof(PDNSnapshotHeader, packed), uint32_t(packed? 0 : 1));}));
+                CHECK(test, rejects(packed, [](const std::string &p){std::filesystem::resize_file(p, std::filesystem::file_size(p) - 1);}));
+                CHECK(test, rejects(packed, [](const std::string &p){std::filesystem::resize_file(p, sizeof(PDNSnapshotHeader) - 1);}));
+            });
+        }
+
+        test.run("Snapshot::missing and foreign files", [&](){
+            PDNSnapshot snapshot;
+            CHECK(test, !snapshot.open(test.getScratchPath("missing.pxsn")));
+            const std::string textPath = test.getScratchPath("foreign.txt");
+            std::ofstream(textPath) << "not a snapshot" << std::endl;
+            CHECK(test, !PDNSnapshot::isSnapshotFile(textPath));
+            CHECK(test, !snapshot.open(textPath));
+        });
+
+        test.run("Snapshot::corrupt cell value reads as UNKNOWN", [&](){
+            const std::string filePath = test.getScratchPath("badValue.pxsn");
+            CHECK(test, PDNSnapshot::write(filePath, layers.metal, layers.via, CASE_HASH, false));
+            overwrite(filePath, sizeof(PDNSnapshotHeader) + 1, uint8_t(99));
+            PDNSnapshot snapshot;
+            CHECK(test, snapshot.open(filePath));
+            if(!snapshot.isOpen()) return;
+            CHECK(test, snapshot.getMetalCell(0, 0, 1) == SignalType::UNKNOWN);
+            CHECK(test, snapshot.getMetalCell(0, 0, 2) == layers.metal[0].canvas[0][2]);
+        });
+    }
+}
+
+void runSnapshotTests(SelfTest &test){
+    testRoundTrip(test);
+    testCorruptHeader(test);
+}
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 21:48:02
+//  Module Name:        testMain.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Golden checks of the numerical kernels and the binary
+//                      formats, ./pwrx_test [--filter name] [--scratch dir].
+//                      Exits non-zero when any check fails
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <cstdlib>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "selfTest.hpp"
+
+// 4. PETSc Library
+#include "petscksp.h"
+
+int main(int argc, char **argv){
+    std::string filter;
+    std::string scratchDir = "outputs/check/";
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if((arg == "--filter") && (i + 1 < argc)) filter = argv[++i];
+        else if((arg == "--scratch") && (i + 1 < argc)) scratchDir = std::string(argv[++i]) + "/";
+        // anything else is left for PETSc
+    }
+
+    PetscInitialize(&argc, &argv, NULL, NULL);
+
+    SelfTest test(filter, scratchDir);
+    runCircuitTests(test);
+    runSnapshotTests(test);
+    runCheckpointTests(test);
+    runTokenizerTests(test);
+    runJobServerTests(test);
+    runLibraryTests(test);
+    runRasteriserTests(test);
+    test.printReport();
+
+    PetscFinalize();
+    return test.passed()? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/20/2026 23:17:52
+//  Module Name:        tokenizerTests.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Edge cases of InputTokenizer and MappedFile: comments,
+//                      blank and CRLF lines, quoting and the whole-word number
+//                      conversions the input parsers rely on
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "signalType.hpp"
+#include "objectArray.hpp"
+#include "inputTokenizer.hpp"
+#include "selfTest.hpp"
+
+namespace {
+    std::vector<std::string> allLines(std::string_view text, std::vector<size_t> *lineNumbers = nullptr){
+        InputTokenizer tokenizer(text);
+        std::vector<std::string> lines;
+        std::string_view line;
+        while(tokenizer.nextLine(line)){
+            lines.emplace_back(line);
+            if(lineNumbers != nullptr) lineNumbers->push_back(tokenizer.getLineNumber());
+        }
+        return lines;
+    }
+
+    std::vector<std::string> allWords(std::string_view text){
+        InputTokenizer tokenizer(text);
+        std::vector<std::string> words;
+        std::string_view word;
+        while(tokenizer.nextWord(word)) words.emplace_back(word);
+        return words;
+    }
+
+    void testLines(SelfTest &test){
+        test.run("Tokenizer::lines, comments and blanks", [&](){
+            std::vector<size_t> lineNumbers;
+            CHECK(test, allLines("  a b  # c\n# only a comment\n\n\t  \nlast", &lineNumbers) == std::vector<std::string>({"a b", "last"}));
+            CHECK(test, lineNumbers == std::vector<size_t>({1, 5}));
+            CHECK(test, allLines("").empty());
+            CHECK(test, allLines("\n\n# x\n").empty());
+            CHECK(test, allLines("#").empty());
+            // CRLF files and a missing final newline
+            CHECK(test, allLines("x 1\r\ny 2\r\n") == std::vector<std::string>({"x 1", "y 2"}));
+            CHECK(test, allLines("x\ny") == std::vector<std::string>({"x", "y"}));
+            // the comment starts at the first '#', wherever it is
+            CHECK(test, allLines("key=#value") == std::vector<std::string>({"key="}));
+        });
+
+        test.run("Tokenizer::words", [&](){
+            CHECK(test, allWords(" a\n\tb  c\r\n") == std::vector<std::string>({"a", "b", "c"}));
+            CHECK(test, allWords("").empty());
+            CHECK(test, allWords(" \t\r\n\v\f").empty());
+            // nextWord leaves comments to the caller
+            CHECK(test, allWords("x # y") == std::vector<std::string>({"x", "#", "y"}));
+
+            // words and lines share the cursor
+            InputTokenizer tokenizer("HEAD 3\nrest of line\n");
+            std::string_view token;
+            CHECK(test, tokenizer.nextWord(token) && token == "HEAD");
+            CHECK(test, tokenizer.nextWord(token) && token == "3");
+            CHECK(test, tokenizer.nextLine(token) && token == "rest of line");
+            CHECK(test, !tokenizer.nextWord(token));
+        });
+
+        test.run("Tokenizer::split and trim", [&](){
+            std::vector<std::string_view> words = {"stale"};
+            CHECK(test, InputTokenizer::split("", words) == 0 && words.empty());
+            CHECK(test, InputTokenizer::split(" \t ", words) == 0);
+            CHECK(test, InputTokenizer::split(" a  bb\tccc ", words) == 3);
+            CHECK(test, words == std::vector<std::string_view>({"a", "bb", "ccc"}));
+            CHECK(test, InputTokenizer::split("one", words) == 1 && words[0] == "one");
+
+            CHECK(test, InputTokenizer::trim("") == "");
+            CHECK(test, InputTokenizer::trim(" \t\r\n") == "");
+            CHECK(test, InputTokenizer::trim("  a b \r") == "a b");
+            CHECK(test, InputTokenizer::trim("x") == "x");
+        });
+
+        test.run("Tokenizer::unquote", [&](){
+            CHECK(test, InputTokenizer::unquote("\"inputs/a.csv\"") == "inputs/a.csv");
+            CHECK(test, InputTokenizer::unquote("inputs/a.csv") == "inputs/a.csv");
+            CHECK(test, InputTokenizer::unquote("\"\"") == "");
+            CHECK(test, InputTokenizer::unquote("\"") == "");
+            CHECK(test, InputTokenizer::unquote("") == "");
+            CHECK(test, InputTokenizer::unquote("\"\"a\"\"") == "a");
+            CHECK(test, InputTokenizer::unquote("\"a\"b\"") == "a\"b");
+        });
+    }
+
+    void testNumbers(SelfTest &test){
+        test.run("Tokenizer::integers", [&](){
+            int value = -1;
+            CHECK(test, InputTokenizer::toInteger("42", value) && value == 42);
+            CHECK(test, InputTokenizer::toInteger("-7", value) && value == -7);
+            CHECK(test, InputTokenizer::toInteger("007", value) && value == 7);
+            CHECK(test, InputTokenizer::toInteger("2147483647", value) && value == 2147483647);
+
+            CHECK(test, !InputTokenizer::toInteger("", value));
+            CHECK(test, !InputTokenizer::toInteger("+1", value));
+            CHECK(test, !InputTokenizer::toInteger(" 1", value));
+            CHECK(test, !InputTokenizer::toInteger("1 ", value));
+            CHECK(test, !InputTokenizer::toInteger("12a", value));
+            CHECK(test, !InputTokenizer::toInteger("1.0", value));
+            CHECK(test, !InputTokenizer::toInteger("2147483648", value));
+
+            int8_t small;
+            CHECK(test, !InputTokenizer::toInteger("128", small));
+            size_t count;
+            CHECK(test, !InputTokenizer::toInteger("-1", count));
+            CHECK(test, InputTokenizer::toInteger("18446744073709551615", count) && count == SIZE_MAX);
+        });
+
+        test.run("Tokenizer::doubles", [&](){
+            double value = -1.0;
+            CHECK(test, InputTokenizer::toDouble("1e-3", value) && value == 1e-3);
+            CHECK(test, InputTokenizer::toDouble("-2.5", value) && value == -2.5);
+            CHECK(test, InputTokenizer::toDouble(".5", value) && value == 0.5);
+            CHECK(test, InputTokenizer::toDouble("3", value) && value == 3.0);
+            CHECK(test, InputTokenizer::toDouble("+0.25", value) && value == 0.25);
+
+            value = 9.0;
+            CHECK(test, !InputTokenizer::toDouble("", value));
+            CHECK(test, !InputTokenizer::toDouble("1e", value));
+            CHECK(test, !InputTokenizer::toDouble("1.0x", value));
+            CHECK(test, !InputTokenizer::toDouble("1 ", value));
+            CHECK(test, !InputTokenizer::toDouble("abc", value));
+            CHECK(test, value == 9.0);
+
+            // the literal must fit the 63 character buffer, the view is not null terminated
+            const std::string longest = "0." + std::string(61, '0');
+            CHECK(test, InputTokenizer::toDouble(longest, value) && value == 0.0);
+            CHECK(test, !InputTokenizer::toDouble(longest + "1", value));
+            const std::string text = "2.5e1trailing";
+            CHECK(test, InputTokenizer::toDouble(std::string_view(text).substr(0, 5), value) && value == 25.0);
+        });
+    }
+
+    // the module and message of the InputError thrown by parse, an empty module if nothing was thrown
+    std::string inputErrorOf(const std::function<void()> &parse){
+        try{
+            parse();
+        }catch(const InputError &e){
+            return e.getModule() + ": " + e.what();
+        }
+        return "";
+    }
+
+    void testInputErrors(SelfTest &test){
+        test.run("Tokenizer::malformed input throws", [&](){
+            CHECK(test, InputTokenizer::parseInt("12") == 12);
+            CHECK(test, inputErrorOf([](){InputTokenizer::parseInt("12a");}) == "InputTokenizer: Expecting an integer: 12a");
+            CHECK(test, inputErrorOf([](){InputTokenizer::parseDouble("x1");}) == "InputTokenizer: Expecting a number: x1");
+
+            // a preplace file is read into a 3 x 2 layer
+            auto readBlockages = [&](const std::string &text){
+                const std::string filePath = test.getScratchPath("blockages.txt");
+                std::ofstream(filePath) << "BEGIN_PREPLACE\n" << text << "END_PREPLACE\n";
+                ObjectArray layer(3, 2);
+                std::string error = inputErrorOf([&](){layer.readBlockages(filePath);});
+                return error.empty()? std::to_string(layer.preplacedCords[SignalType::GROUND].size()) : error;
+            };
+            CHECK(test, readBlockages("SIGNAL: GROUND\nCord(0, 0)\nCord(0, 1) to Cord(2, 1)\n") == "4");
+            CHECK(test, readBlockages("SIGNAL: NOISE\n") == "ObjectArray: Unknown preplace SignalType NOISE");
+            CHECK(test, readBlockages("SIGNAL: GROUND\nCord(3, 0)\n") == "ObjectArray: X Coordinates must be within range: [0, 2]: Cord(3, 0)");
+            CHECK(test, readBlockages("SIGNAL: GROUND\nCord(0, a)\n") == "ObjectArray: Coordinates must be integers: Cord(0, a)");
+            CHECK(test, readBlockages("SIGNAL: GROUND\n(0, 0)\n") == "ObjectArray: Blockage format unrecognized: (0, 0)");
+            const std::string missingPath = test.getScratchPath("missingBlockages.txt");
+            CHECK(test, inputErrorOf([&](){ObjectArray(3, 2).readBlockages(missingPath);}) == "ObjectArray: Cannot open preplace file: " + missingPath);
+        });
+    }
+
+    void testMappedFile(SelfTest &test){
+        test.run("Tokenizer::mapped files", [&](){
+            MappedFile missing(test.getScratchPath("missing.txt"));
+            CHECK(test, !missing.is_open());
+            CHECK(test, missing.view().empty());
+
+            const std::string emptyPath = test.getScratchPath("empty.txt");
+            std::ofstream(emptyPath).close();
+            MappedFile empty(emptyPath);
+            CHECK(test, empty.is_open());
+            CHECK(test, empty.view().empty());
+            CHECK(test, allLines(empty.view()).empty());
+
+            const std::string filePath = test.getScratchPath("words.txt");
+            std::ofstream(filePath) << "A 1 # first\n\nB \"x y.csv\"";
+            MappedFile file(filePath);
+            CHECK(test, file.is_open());
+            CHECK(test, file.view() == "A 1 # first\n\nB \"x y.csv\"");
+            CHECK(test, allLines(file.view()) == std::vector<std::string>({"A 1", "B \"x y.csv\""}));
+        });
+    }
+}
+
+void runTokenizerTests(SelfTest &test){
+    testLines(test);
+    testNumbers(test);
+    testInputErrors(test);
+    testMappedFile(test);
+}
@@ -22,8 +22,17 @@
 #include <string>
 #include <chrono>
 #include <vector>
+#include <array>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <set>
+#include <mutex>
+#include <memory>
+#include <fstream>
 #include <algorithm>
+#include <cstdio>
+#include <iostream>
 
 // 2. Boost Library:
 
@@ -41,6 +50,12 @@ void TimeProfiler::startTimer(const timeSpanName &newTimeSpan){
     }
 
     m_timeSpanMap[newTimeSpan].startingPoints.push_back(std::chrono::high_resolution_clock::now());
+    m_timeSpanMap[newTimeSpan].traceBegin = TraceRecorder::isEnabled()? TraceRecorder::now() : -1;
+    if(PerfCounters::isOpen()) m_timeSpanMap[newTimeSpan].counterStart = PerfCounters::read();
+    m_timeSpanMap[newTimeSpan].peakRSSAtStart = MemoryProfiler::getPeakRSS();
+    m_timeSpanMap[newTimeSpan].peakHeapAtStart = MemoryProfiler::getPeakAllocatedBytes();
+
+    if(m_listener) m_listener(newTimeSpan, true, 0.0);
 }
 
 void TimeProfiler::pauseTimer(const timeSpanName &oldTimeSpan) {
@@ -48,6 +63,60 @@ void TimeProfiler::pauseTimer(const timeSpanName &oldTimeSpan) {
     if (it != m_timeSpanMap.end() && (!it->second.startingPoints.empty())) {
         it->second.endingPoints.push_back(std::chrono::high_resolution_clock::now());
         it->second.periodCount++;
+
+        if(PerfCounters::isOpen()){
+            PerfSample counterEnd = PerfCounters::read();
+            for(int i = 0; i < PERF_EVENT_COUNT; ++i){
+                if(counterEnd.values[i] > it->second.counterStart.values[i]) it->second.counterTotals[i] += counterEnd.values[i] - it->second.counterStart.values[i];
+            }
+        }
+
+        timeSpan &ts = it->second;
+        ts.rssAtEnd = MemoryProfiler::getCurrentRSS();
+        ts.peakRSSAtEnd = std::max(MemoryProfiler::getPeakRSS(), ts.rssAtEnd);
+        ts.heapAtEnd = MemoryProfiler::getAllocatedBytes();
+        size_t peakHeapAtEnd = MemoryProfiler::getPeakAllocatedBytes();
+        ts.peakRSSGrowth += ts.peakRSSAtEnd - std::min(ts.peakRSSAtEnd, ts.peakRSSAtStart);
+        ts.peakHeapGrowth += peakHeapAtEnd - std::min(peakHeapAtEnd, ts.peakHeapAtStart);
+
+        if(it->second.traceBegin >= 0){
+            TraceRecorder::record(TraceRecorder::intern(oldTimeSpan), it->second.traceBegin, TraceRecorder::now());
+            it->second.traceBegin = -1;
+        }
+
+        if(m_listener) m_listener(oldTimeSpan, false, std::chrono::duration<double>(ts.endingPoints.back() - ts.startingPoints.back()).count());
+    }
+}
+
+namespace {
+    // 75 characters, the free column of the timing report
+    std::string formatCounterColumn(const std::array<uint64_t, PERF_EVENT_COUNT> &counts){
+        auto formatCount = [&](PerfEvent event) -> std::string {
+            if(!PerfCounters::isAvailable(event)) return "-";
+            double value = double(counts[static_cast<int>(event)]);
+            const char *suffix[] = {"", "K", "M", "G", "T"};
+            int magnitude = 0;
+            while((value >= 1000.0) && (magnitude < 4)){
+                value /= 1000.0;
+                ++magnitude;
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), (magnitude == 0)? "%.0lf%s" : "%.2lf%s", value, suffix[magnitude]);
+            return buffer;
+        };
+
+        std::string ipc = "-";
+        uint64_t cycles = counts[static_cast<int>(PerfEvent::CYCLES)];
+        if(PerfCounters::isAvailable(PerfEvent::CYCLES) && PerfCounters::isAvailable(PerfEvent::INSTRUCTIONS) && (cycles != 0)){
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.2lf", double(counts[static_cast<int>(PerfEvent::INSTRUCTIONS)]) / double(cycles));
+            ipc = buffer;
+        }
+
+        char column[128];
+        std::snprintf(column, sizeof(column), " %10s %10s %6s %10s %10s %10s%13s", formatCount(PerfEvent::CYCLES).c_str(), formatCount(PerfEvent::INSTRUCTIONS).c_str(), ipc.c_str(),
+            formatCount(PerfEvent::LLC_MISSES).c_str(), formatCount(PerfEvent::BRANCH_MISSES).c_str(), formatCount(PerfEvent::PAGE_FAULTS).c_str(), "");
+        return column;
     }
 }
 
@@ -69,7 +138,8 @@ void TimeProfiler::printTimingReport() const {
     }
 
     printf("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
-    printf("║ Stage                        │      Runtime (s)       |                                                                           ║\n");
+    if(PerfCounters::isOpen()) printf("║ Stage                        │      Runtime (s)       | %10s %10s %6s %10s %10s %10s%13s║\n", "Cycles", "Instr", "IPC", "LLC Miss", "Br Miss", "Pg Fault", "");
+    else printf("║ Stage                        │      Runtime (s)       |                                                                           ║\n");
     printf("╟──────────────────────────────│────────────────────────│───────────────────────────────────────────────────────────────────────────╢\n");
     for(int i = 0; i < m_timeSpans.size(); ++i){
         const timeSpan &ts = m_timeSpanMap.at(m_timeSpans[i]);
@@ -80,12 +150,236 @@ void TimeProfiler::printTimingReport() const {
         durationS = durationS / 1000.0;
         
 
-        printf("║%-30s│ %11.6lf (%6.2lf %%) │%75s║\n", StageName.c_str(), durationS, durationPercentage,  "");
+        std::string counterColumn = PerfCounters::isOpen()? formatCounterColumn(ts.counterTotals) : "";
+        printf("║%-30s│ %11.6lf (%6.2lf %%) │%75s║\n", StageName.c_str(), durationS, durationPercentage,  counterColumn.c_str());
 
     }
     printf("╟──────────────────────────────│────────────────────────│───────────────────────────────────────────────────────────────────────────╢\n");
-    printf("║ Summary                      │ %8.3lf               │%75s║\n", totalDuration/1000.0, "");
+    std::array<uint64_t, PERF_EVENT_COUNT> counterSummary{};
+    for(const timeSpanName &name : m_timeSpans){
+        for(int i = 0; i < PERF_EVENT_COUNT; ++i) counterSummary[i] += m_timeSpanMap.at(name).counterTotals[i];
+    }
+    std::string counterColumn = PerfCounters::isOpen()? formatCounterColumn(counterSummary) : "";
+    printf("║ Summary                      │ %8.3lf               │%75s║\n", totalDuration/1000.0, counterColumn.c_str());
+    printf("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+
+    // memory at the end of each stage, "Peak +" is how far the stage pushed the high-water mark
+    const bool countingAllocations = MemoryProfiler::isCountingAllocations();
+    char rss[32], peakRSS[32], peakRSSGrowth[32], heap[32], peakHeapGrowth[32];
+    printf("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║ Stage                        │ %12s │ %12s │ %12s │ %12s │ %12s%27s║\n", "RSS", "Peak RSS", "Peak RSS +", "Live Heap", "Peak Heap +", "");
+    printf("╟──────────────────────────────│────────────────────────────────────────────────────────────────────────────────────────────────────╢\n");
+    for(const timeSpanName &name : m_timeSpans){
+        const timeSpan &ts = m_timeSpanMap.at(name);
+        std::string StageName = " " + name;
+        MemoryProfiler::formatBytes(ts.rssAtEnd, rss, sizeof(rss));
+        MemoryProfiler::formatBytes(ts.peakRSSAtEnd, peakRSS, sizeof(peakRSS));
+        MemoryProfiler::formatBytes(ts.peakRSSGrowth, peakRSSGrowth, sizeof(peakRSSGrowth));
+        MemoryProfiler::formatBytes(ts.heapAtEnd, heap, sizeof(heap));
+        MemoryProfiler::formatBytes(ts.peakHeapGrowth, peakHeapGrowth, sizeof(peakHeapGrowth));
+        printf("║%-30s│ %12s │ %12s │ %12s │ %12s │ %12s%27s║\n", StageName.c_str(), rss, peakRSS, peakRSSGrowth,
+            countingAllocations? heap : "-", countingAllocations? peakHeapGrowth : "-", "");
+    }
+    MemoryProfiler::formatBytes(MemoryProfiler::getCurrentRSS(), rss, sizeof(rss));
+    MemoryProfiler::formatBytes(MemoryProfiler::getPeakRSS(), peakRSS, sizeof(peakRSS));
+    MemoryProfiler::formatBytes(MemoryProfiler::getAllocatedBytes(), heap, sizeof(heap));
+    MemoryProfiler::formatBytes(MemoryProfiler::getPeakAllocatedBytes(), peakHeapGrowth, sizeof(peakHeapGrowth));
+    printf("╟──────────────────────────────│────────────────────────────────────────────────────────────────────────────────────────────────────╢\n");
+    printf("║ Summary                      │ %12s │ %12s │ %12s │ %12s │ %12s%27s║\n", rss, peakRSS, "", countingAllocations? heap : "-", countingAllocations? peakHeapGrowth : "-", "");
     printf("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+    MemoryProfiler::printTagReport();
+
+}
+
+bool TimeProfiler::writeStageCSV(const std::string &filePath) const {
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        std::cout << "[PowerX:TimeProfiler] Error: Cannot open stage file " << filePath << std::endl;
+        return false;
+    }
+
+    ofs << "stage,periods,runtime_s,rss_bytes,peak_rss_bytes,peak_rss_growth_bytes,heap_bytes,peak_heap_growth_bytes\n";
+    char buffer[160];
+    for(const timeSpanName &name : m_timeSpans){
+        const timeSpan &ts = m_timeSpanMap.at(name);
+        std::chrono::duration<double> duration(0);
+        for(int j = 0; j < ts.periodCount; ++j) duration += (ts.endingPoints[j] - ts.startingPoints[j]);
+
+        std::snprintf(buffer, sizeof(buffer), ",%d,%.6lf,%zu,%zu,%zu,%zu,%zu\n", ts.periodCount, duration.count(),
+            ts.rssAtEnd, ts.peakRSSAtEnd, ts.peakRSSGrowth, ts.heapAtEnd, ts.peakHeapGrowth);
+        ofs << name << buffer;
+    }
+    ofs.close();
+    return true;
+}
+
+namespace {
+    std::mutex &traceRegistryMutex(){
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::string escapeJSON(const char *text){
+        std::string escaped;
+        for(const char *c = text; *c != '\0'; ++c){
+            if(*c == '"' || *c == '\\') escaped.push_back('\\');
+            escaped.push_back(*c);
+        }
+        return escaped;
+    }
+}
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+std::chrono::steady_clock::time_point TraceRecorder::s_epoch = std::chrono::steady_clock::now();
+
+void TraceRecorder::enable(){
+    s_epoch = std::chrono::steady_clock::now();
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::disable(){
+    s_enabled.store(false, std::memory_order_relaxed);
+}
+
+std::vector<std::unique_ptr<TraceRecorder::ThreadBuffer>> &TraceRecorder::registry(){
+    // buffers are owned here so they outlive OpenMP worker threads
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+TraceRecorder::ThreadBuffer &TraceRecorder::threadBuffer(){
+    thread_local ThreadBuffer *buffer = nullptr;
+    if(buffer == nullptr){
+        std::lock_guard<std::mutex> lock(traceRegistryMutex());
+        registry().push_back(std::make_unique<ThreadBuffer>());
+        buffer = registry().back().get();
+        buffer->threadIdx = registry().size() - 1;
+    }
+    return *buffer;
+}
+
+std::vector<const TraceRecorder::ThreadBuffer *> TraceRecorder::snapshotBuffers(){
+    std::lock_guard<std::mutex> lock(traceRegistryMutex());
+    std::vector<const ThreadBuffer *> buffers;
+    for(const std::unique_ptr<ThreadBuffer> &buffer : registry()) buffers.push_back(buffer.get());
+    return buffers;
+}
+
+void TraceRecorder::record(const char *name, int64_t begin, int64_t end){
+    ThreadBuffer &buffer = threadBuffer();
+    if(buffer.events.size() < TRACE_RING_CAPACITY) buffer.events.push_back(TraceEvent{name, begin, end});
+    else buffer.events[buffer.written % TRACE_RING_CAPACITY] = TraceEvent{name, begin, end};
+    ++buffer.written;
+}
+
+const char *TraceRecorder::intern(const std::string &name){
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> lock(traceRegistryMutex());
+    return names.insert(name).first->c_str();
+}
+
+std::vector<TraceEvent> TraceRecorder::getEvents(){
+    std::vector<TraceEvent> events;
+    for(const ThreadBuffer *tb : snapshotBuffers()) events.insert(events.end(), tb->events.begin(), tb->events.end());
+    return events;
+}
+
+void TraceRecorder::clear(){
+    std::lock_guard<std::mutex> lock(traceRegistryMutex());
+    for(std::unique_ptr<ThreadBuffer> &buffer : registry()){
+        buffer->events.clear();
+        buffer->written = 0;
+    }
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string &filePath){
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        std::cout << "[PowerX:TimeProfiler] Error: Cannot open trace file " << filePath << std::endl;
+        return false;
+    }
+
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"PowerX\"}}";
+
+    char buffer[64];
+    size_t droppedEvents = 0;
+    for(const ThreadBuffer *tb : snapshotBuffers()){
+        ofs << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tb->threadIdx << ",\"args\":{\"name\":\"thread " << tb->threadIdx << "\"}}";
+        if(tb->written > tb->events.size()) droppedEvents += tb->written - tb->events.size();
+        for(const TraceEvent &ev : tb->events){
+            // microseconds, nanosecond resolution kept in the fraction
+            std::snprintf(buffer, sizeof(buffer), "\"ts\":%.3lf,\"dur\":%.3lf", ev.begin / 1000.0, (ev.end - ev.begin) / 1000.0);
+            ofs << ",\n{\"name\":\"" << escapeJSON(ev.name) << "\",\"cat\":\"powerx\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tb->threadIdx << "," << buffer << "}";
+        }
+    }
+    ofs << "\n]}\n";
+    ofs.close();
+
+    if(droppedEvents != 0) std::cout << "[PowerX:TimeProfiler] Warning: " << droppedEvents << " oldest events were overwritten, raise TRACE_RING_CAPACITY for a full trace" << std::endl;
+    return true;
+}
+
+bool TraceRecorder::writeSummaryCSV(const std::string &filePath){
+    struct PathSummary{
+        std::set<int> threads;
+        size_t calls = 0;
+        int64_t total = 0;
+        int64_t self = 0;
+        int64_t max = 0;
+    };
+    // ordered so a scope is listed right before its children
+    std::map<std::string, PathSummary> summaries;
+
+    for(const ThreadBuffer *tb : snapshotBuffers()){
+        std::vector<TraceEvent> events(tb->events);
+        // parents first: earlier begin, and the longer scope on a tie
+        std::sort(events.begin(), events.end(), [](const TraceEvent &a, const TraceEvent &b){
+            return (a.begin != b.begin)? (a.begin < b.begin) : (a.end > b.end);
+        });
 
+        // open scopes of this thread, each with its path and summary entry
+        std::vector<std::pair<const TraceEvent *, std::map<std::string, PathSummary>::iterator>> stack;
+        for(const TraceEvent &ev : events){
+            while(!stack.empty() && (ev.end > stack.back().first->end)) stack.pop_back();
+
+            std::string path = stack.empty()? std::string(ev.name) : (stack.back().second->first + "/" + ev.name);
+            int64_t length = ev.end - ev.begin;
+            if(!stack.empty()) stack.back().second->second.self -= length;
+
+            std::map<std::string, PathSummary>::iterator it = summaries.try_emplace(std::move(path)).first;
+            PathSummary &ps = it->second;
+            ps.threads.insert(tb->threadIdx);
+            ps.calls++;
+            ps.total += length;
+            ps.self += length;
+            ps.max = std::max(ps.max, length);
+            stack.emplace_back(&ev, it);
+        }
+    }
+
+    std::ofstream ofs(filePath, std::ios::out);
+    if(!ofs.is_open()){
+        std::cout << "[PowerX:TimeProfiler] Error: Cannot open summary file " << filePath << std::endl;
+        return false;
+    }
+
+    ofs << "path,threads,calls,total_s,self_s,mean_s,max_s\n";
+    char buffer[128];
+    for(const auto &[path, ps] : summaries){
+        std::snprintf(buffer, sizeof(buffer), ",%zu,%zu,%.9lf,%.9lf,%.9lf,%.9lf\n", ps.threads.size(), ps.calls, ps.total * 1e-9, ps.self * 1e-9, ps.total * 1e-9 / ps.calls, ps.max * 1e-9);
+        // a path may hold commas, quote it the CSV way
+        if(path.find_first_of(",\"") == std::string::npos) ofs << path;
+        else{
+            ofs << '"';
+            for(char c : path){
+                if(c == '"') ofs << '"';
+                ofs << c;
+            }
+            ofs << '"';
+        }
+        ofs << buffer;
+    }
+    ofs.close();
+    return true;
 }
- 
\ No newline at end of file
@@ -14,6 +14,20 @@
 //
 //////////////////////////////////////////////////////////////////////////////////
 //  Revision:
+//  10/19/2026          Added TraceRecorder and ScopedTimer, nested scopes are
+//                      recorded into per-thread ring buffers and exported as a
+//                      Chrome trace (chrome://tracing, ui.perfetto.dev) and a
+//                      flat CSV summary keyed by the hierarchical scope path.
+//                      TimeProfiler spans are recorded as well, recording is off
+//                      until TraceRecorder::enable() and then costs a clock read
+//  10/19/2026          Spans also accumulate PerfCounters deltas, shown next to
+//                      the runtime when the counters are open
+//  10/20/2026          Spans sample MemoryProfiler at both ends, the report adds
+//                      a memory table with RSS, peak growth and live heap
+//  10/20/2026          writeStageCSV() exports the span runtimes and memory for
+//                      the regression harness (utils/regressionHarness.py)
+//  10/20/2026          An optional listener hears every span border, the daemon
+//                      streams stage progress to its clients through it
 //
 //////////////////////////////////////////////////////////////////////////////////
 
@@ -25,12 +39,18 @@
 #include <string>
 #include <chrono>
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <functional>
 #include <unordered_map>
 
 // 2. Boost Library:
 
 
 // 3. Texo Library:
+#include "perfCounters.hpp"
+#include "memoryProfiler.hpp"
 
 typedef std::string timeSpanName;
 
@@ -38,18 +58,108 @@ struct timeSpan{
     int periodCount = 0;
     std::vector<std::chrono::high_resolution_clock::time_point> startingPoints;
     std::vector<std::chrono::high_resolution_clock::time_point> endingPoints;
+    // TraceRecorder::now() of the open period, -1 when tracing was off at startTimer()
+    int64_t traceBegin = -1;
+    // PerfCounters at startTimer() and the sum over closed periods
+    PerfSample counterStart;
+    std::array<uint64_t, PERF_EVENT_COUNT> counterTotals{};
+    // high-water marks at startTimer(), how much each period raised them, and the state at the last pauseTimer()
+    size_t peakRSSAtStart = 0;
+    size_t peakHeapAtStart = 0;
+    size_t peakRSSGrowth = 0;
+    size_t peakHeapGrowth = 0;
+    size_t rssAtEnd = 0;
+    size_t peakRSSAtEnd = 0;
+    size_t heapAtEnd = 0;
 };
 
+// started is false at pauseTimer(), seconds is then the length of the period just closed
+typedef std::function<void(const timeSpanName &timeSpan, bool started, double seconds)> TimeSpanListener;
+
 class TimeProfiler{
     std::vector<timeSpanName> m_timeSpans;
     std::unordered_map<timeSpanName, timeSpan> m_timeSpanMap;
+    TimeSpanListener m_listener;
 
 public:
-    
+
+    inline void setListener(const TimeSpanListener &listener) {this->m_listener = listener;}
+
     void startTimer(const timeSpanName &newTimeSpan);
     void pauseTimer(const timeSpanName &timeSpan);
 
     void printTimingReport() const;
+    // stage,periods,runtime_s,rss_bytes,peak_rss_bytes,peak_rss_growth_bytes,heap_bytes,peak_heap_growth_bytes in startTimer() order
+    bool writeStageCSV(const std::string &filePath) const;
+};
+
+// events kept per thread, the oldest are overwritten once a thread records more
+constexpr size_t TRACE_RING_CAPACITY = 1 << 16;
+
+struct TraceEvent{
+    // static string or a TraceRecorder::intern() result, never freed
+    const char *name;
+    // nanoseconds since TraceRecorder::enable()
+    int64_t begin;
+    int64_t end;
+};
+
+class TraceRecorder{
+private:
+    struct ThreadBuffer{
+        int threadIdx;
+        std::vector<TraceEvent> events;
+        // total events ever recorded, events[written % capacity] is the next slot
+        size_t written = 0;
+    };
+
+    static std::atomic<bool> s_enabled;
+    static std::chrono::steady_clock::time_point s_epoch;
+
+    static std::vector<std::unique_ptr<ThreadBuffer>> &registry();
+    static ThreadBuffer &threadBuffer();
+    static std::vector<const ThreadBuffer *> snapshotBuffers();
+
+public:
+    static void enable();
+    static void disable();
+    static inline bool isEnabled() {return s_enabled.load(std::memory_order_relaxed);}
+
+    static inline int64_t now() {return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();}
+    static void record(const char *name, int64_t begin, int64_t end);
+    // stable copy of a runtime name
+    static const char *intern(const std::string &name);
+
+    // every event still held, in no particular order, and dropping them all, neither may race a recording thread
+    static std::vector<TraceEvent> getEvents();
+    static void clear();
+
+    // both exports expect no scope to be open on another thread
+    // complete ("X") events, one track per thread
+    static bool writeChromeTrace(const std::string &filePath);
+    // path,threads,calls,total_s,self_s,mean_s,max_s, a path is the enclosing scopes joined by '/'
+    static bool writeSummaryCSV(const std::string &filePath);
+};
+
+// records the enclosing block into the calling thread's ring buffer
+class ScopedTimer{
+private:
+    const char *m_name;
+    int64_t m_begin;
+
+public:
+    explicit ScopedTimer(const char *name): m_name(name), m_begin(TraceRecorder::isEnabled()? TraceRecorder::now() : -1) {}
+    ~ScopedTimer() {stop();}
+
+    ScopedTimer(const ScopedTimer &other) = delete;
+    ScopedTimer &operator=(const ScopedTimer &other) = delete;
+
+    // ends the scope early, later calls do nothing
+    inline void stop(){
+        if(m_begin < 0) return;
+        TraceRecorder::record(m_name, m_begin, TraceRecorder::now());
+        m_begin = -1;
+    }
 };
 
-#endif // __TIMEPROFILER_H__
\ No newline at end of file
+#endif // __TIMEPROFILER_H__
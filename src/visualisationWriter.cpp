@@ -0,0 +1,203 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 22:48:31
+//  Module Name:        visualisationWriter.cpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Moves the intermediate visualisation dumps off the critical
+//                      path. The caller copies the canvases (or the physical
+//                      network) into an immutable snapshot and returns, a single
+//                      background thread writes the files through visualiser.hpp.
+//                      At most VISUALISATION_QUEUE_CAPACITY snapshots exist at
+//                      once, the one being written included, a further dump
+//                      waits for a slot before it copies anything so memory
+//                      stays bounded
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+// Dependencies
+// 1. C++ STL:
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <iostream>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "visualisationWriter.hpp"
+#include "visualiser.hpp"
+#include "rasteriser.hpp"
+#include "signalType.hpp"
+#include "pdnNode.hpp"
+#include "pdnEdge.hpp"
+
+namespace {
+    typedef std::vector<std::vector<SignalType>> Canvas;
+
+    struct CanvasSnapshot{
+        std::vector<Canvas> metalLayers;
+        std::vector<Canvas> viaLayers;
+    };
+
+    struct PhysicalSnapshot{
+        int physicalGridWidth;
+        int physicalGridHeight;
+        int metalLayerCount;
+        std::vector<PDNNode> physicalNodes;
+        std::vector<PDNEdge> pdnEdges;
+    };
+}
+
+VisualisationWriter::VisualisationWriter(size_t capacity, bool rasterise): m_capacity(capacity), m_rasterise(rasterise), m_writing(false), m_stopping(false),
+    m_snapshotTime(0), m_stallTime(0), m_writeTime(0), m_dumpCount(0), m_failedDumpCount(0) {
+
+    assert(capacity >= 1);
+    m_worker = std::thread(&VisualisationWriter::workerLoop, this);
+}
+
+VisualisationWriter::~VisualisationWriter(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_queueChanged.notify_all();
+    if(m_worker.joinable()) m_worker.join();
+}
+
+void VisualisationWriter::workerLoop(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true){
+        m_queueChanged.wait(lock, [this]{ return m_stopping || !m_queue.empty(); });
+        // stopping only ends the loop once the queue is empty, nothing submitted is dropped
+        if(m_queue.empty()) return;
+
+        Dump dump = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+        lock.unlock();
+        m_queueChanged.notify_all();
+
+        std::chrono::steady_clock::time_point writeStart = std::chrono::steady_clock::now();
+        bool success = dump.write();
+        std::chrono::duration<double> writeDuration = std::chrono::steady_clock::now() - writeStart;
+
+        lock.lock();
+        m_writing = false;
+        m_writeTime += writeDuration;
+        ++m_dumpCount;
+        if(!success){
+            ++m_failedDumpCount;
+            std::cout << "[PowerX:VisualisationWriter] Warning: Dump " << dump.name << " failed" << std::endl;
+        }
+        m_queueChanged.notify_all();
+    }
+}
+
+std::chrono::steady_clock::time_point VisualisationWriter::waitForSlot(){
+    std::chrono::steady_clock::time_point stallStart = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queueChanged.wait(lock, [this]{ return m_queue.size() + (m_writing? 1 : 0) < m_capacity; });
+    std::chrono::steady_clock::time_point stallEnd = std::chrono::steady_clock::now();
+    m_stallTime += stallEnd - stallStart;
+    return stallEnd;
+}
+
+void VisualisationWriter::submit(const std::string &name, std::function<bool()> write, std::chrono::steady_clock::time_point snapshotStart){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_snapshotTime += std::chrono::steady_clock::now() - snapshotStart;
+    m_queue.push_back(Dump{name, std::move(write)});
+    lock.unlock();
+    m_queueChanged.notify_all();
+}
+
+void VisualisationWriter::dumpGridArrayWithPin(const PowerDistributionNetwork &pdn, const Technology &tch, bool upDownDisplay, const std::string &fileNamePrefix){
+    std::chrono::steady_clock::time_point snapshotStart = waitForSlot();
+
+    std::shared_ptr<CanvasSnapshot> snapshot = std::make_shared<CanvasSnapshot>();
+    snapshot->metalLayers.reserve(pdn.metalLayers.size());
+    for(const ObjectArray &layer : pdn.metalLayers) snapshot->metalLayers.push_back(layer.canvas);
+    snapshot->viaLayers.reserve(pdn.viaLayers.size());
+    for(const ObjectArray &layer : pdn.viaLayers) snapshot->viaLayers.push_back(layer.canvas);
+
+    std::function<bool()> write = [snapshot, tch, upDownDisplay, fileNamePrefix, rasterise = m_rasterise]() -> bool {
+        const std::vector<Canvas> &metal = snapshot->metalLayers;
+        const std::vector<Canvas> &via = snapshot->viaLayers;
+        const int metalLayerCount = metal.size();
+        bool success = true;
+
+        // layers are independent files
+        #pragma omp parallel for schedule(dynamic) reduction(&&:success)
+        for(int layer = 0; layer < metalLayerCount; ++layer){
+            std::string fileName = fileNamePrefix + std::to_string(layer);
+            bool layerSuccess = true;
+            if(layer == 0){
+                layerSuccess &= visualiseGridArrayWithPin(metal[layer], via[layer], tch, fileName + ".txt");
+                if(rasterise) layerSuccess &= rasteriseGridArrayWithPin(metal[layer], via[layer], tch, fileName + ".png");
+            }else if(layer == (metalLayerCount - 1)){
+                layerSuccess &= visualiseGridArrayWithPin(metal[layer], via[layer-1], tch, fileName + ".txt");
+                if(rasterise) layerSuccess &= rasteriseGridArrayWithPin(metal[layer], via[layer-1], tch, fileName + ".png");
+            }else{
+                layerSuccess &= visualiseGridArrayWithPins(metal[layer], via[layer-1], via[layer], tch, fileName + ".txt");
+                if(rasterise) layerSuccess &= rasteriseGridArrayWithPins(metal[layer], via[layer-1], via[layer], tch, fileName + ".png");
+                if(upDownDisplay){
+                    layerSuccess &= visualiseGridArrayWithPin(metal[layer], via[layer-1], tch, fileName + "_up.txt");
+                    layerSuccess &= visualiseGridArrayWithPin(metal[layer], via[layer], tch, fileName + "_down.txt");
+                }
+            }
+            success = success && layerSuccess;
+        }
+        return success;
+    };
+
+    submit(fileNamePrefix, std::move(write), snapshotStart);
+}
+
+void VisualisationWriter::dumpPhysicalImplementation(const PowerDistributionNetwork &pdn, const std::string &fileNamePrefix){
+    std::chrono::steady_clock::time_point snapshotStart = waitForSlot();
+
+    std::shared_ptr<PhysicalSnapshot> snapshot = std::make_shared<PhysicalSnapshot>();
+    snapshot->physicalGridWidth = pdn.physicalGridWidth;
+    snapshot->physicalGridHeight = pdn.physicalGridHeight;
+    snapshot->metalLayerCount = pdn.getMetalLayerCount();
+    snapshot->physicalNodes = pdn.physicalNodes;
+    snapshot->pdnEdges = pdn.pdnEdges;
+
+    std::function<bool()> write = [snapshot, fileNamePrefix, rasterise = m_rasterise]() -> bool {
+        bool success = true;
+
+        #pragma omp parallel for schedule(dynamic) reduction(&&:success)
+        for(int layer = 0; layer < snapshot->metalLayerCount; ++layer){
+            std::string displayFileName = fileNamePrefix + std::to_string(layer);
+            bool layerSuccess = visualisePhysicalImplementation(snapshot->physicalGridWidth, snapshot->physicalGridHeight, snapshot->physicalNodes, snapshot->pdnEdges, layer, displayFileName + ".txt");
+            if(rasterise) layerSuccess &= rasterisePhysicalImplementation(snapshot->physicalGridWidth, snapshot->physicalGridHeight, snapshot->physicalNodes, snapshot->pdnEdges, layer, displayFileName + ".png");
+            success = success && layerSuccess;
+        }
+        return success;
+    };
+
+    submit(fileNamePrefix, std::move(write), snapshotStart);
+}
+
+void VisualisationWriter::drain(){
+    std::chrono::steady_clock::time_point drainStart = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queueChanged.wait(lock, [this]{ return m_queue.empty() && !m_writing; });
+    m_stallTime += std::chrono::steady_clock::now() - drainStart;
+}
+
+void VisualisationWriter::printReport(){
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout << "[PowerX:VisualisationWriter] " << m_dumpCount << " dumps (" << m_failedDumpCount << " failed)";
+    std::printf(", snapshot %.6lf s, stalled %.6lf s on the pipeline, background I/O %.6lf s\n", m_snapshotTime.count(), m_stallTime.count(), m_writeTime.count());
+}
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////
+//  Engineer:           Tzu-Han Hsu
+//  Create Date:        10/19/2026 22:48:31
+//  Module Name:        visualisationWriter.hpp
+//  Project Name:       PowerX
+//  C++(Version):       C++17
+//  g++(Version):       Apple clang version 16.0.0 (clang-1600.0.26.6)
+//  Target:             arm64-apple-darwin24.3.0
+//  Thread model:       posix
+//
+//////////////////////////////////////////////////////////////////////////////////
+//  Description:        Moves the intermediate visualisation dumps off the critical
+//                      path. The caller copies the canvases (or the physical
+//                      network) into an immutable snapshot and returns, a single
+//                      background thread writes the files through visualiser.hpp.
+//                      At most VISUALISATION_QUEUE_CAPACITY snapshots exist at
+//                      once, the one being written included, a further dump
+//                      waits for a slot before it copies anything so memory
+//                      stays bounded
+//////////////////////////////////////////////////////////////////////////////////
+//  Revision:
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VISUALISATION_WRITER_H__
+#define __VISUALISATION_WRITER_H__
+
+// Dependencies
+// 1. C++ STL:
+#include <string>
+#include <deque>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// 2. Boost Library:
+
+// 3. Texo Library:
+#include "technology.hpp"
+#include "powerDistributionNetwork.hpp"
+
+// snapshots alive at once, the one being written included: one being written and one waiting (or being taken),
+// the pipeline stalls before taking a third
+constexpr size_t VISUALISATION_QUEUE_CAPACITY = 2;
+
+class VisualisationWriter{
+private:
+    struct Dump{
+        std::string name;
+        std::function<bool()> write;
+    };
+
+    size_t m_capacity;
+    // also draw a .png next to every text dump
+    bool m_rasterise;
+    std::deque<Dump> m_queue;
+    bool m_writing;
+    bool m_stopping;
+
+    std::mutex m_mutex;
+    std::condition_variable m_queueChanged;
+    std::thread m_worker;
+
+    // main thread side: copying snapshots and waiting for a free slot
+    std::chrono::duration<double> m_snapshotTime;
+    std::chrono::duration<double> m_stallTime;
+    // writer thread side, guarded by m_mutex
+    std::chrono::duration<double> m_writeTime;
+    size_t m_dumpCount;
+    size_t m_failedDumpCount;
+
+    // blocks until fewer than m_capacity snapshots are queued or being written, returns when the snapshot may start,
+    // the pipeline thread is the only producer so the slot stays free until its submit()
+    std::chrono::steady_clock::time_point waitForSlot();
+    void submit(const std::string &name, std::function<bool()> write, std::chrono::steady_clock::time_point snapshotStart);
+    void workerLoop();
+
+public:
+    explicit VisualisationWriter(size_t capacity = VISUALISATION_QUEUE_CAPACITY, bool rasterise = false);
+    // writes everything still queued before returning
+    ~VisualisationWriter();
+
+    VisualisationWriter(const VisualisationWriter &other) = delete;
+    VisualisationWriter &operator=(const VisualisationWriter &other) = delete;
+
+    // same files as displayGridArrayWithPin() in main.cpp, <fileNamePrefix><layer>.txt (and .png)
+    void dumpGridArrayWithPin(const PowerDistributionNetwork &pdn, const Technology &tch, bool upDownDisplay, const std::string &fileNamePrefix);
+    // one visualisePhysicalImplementation() file per metal layer, <fileNamePrefix><layer>.txt (and .png)
+    void dumpPhysicalImplementation(const PowerDistributionNetwork &pdn, const std::string &fileNamePrefix);
+
+    // blocks until every submitted dump is on disk
+    void drain();
+
+    void printReport();
+};
+
+#endif // __VISUALISATION_WRITER_H__
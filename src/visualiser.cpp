@@ -216,18 +216,18 @@ bool visualiseGridArrayWithPin(const std::vector<std::vector<SignalType>> &gridA
     len_t pitch = tch.getMicrobumpPitch();
     len_t pinRadius = tch.getMicrobumpRadius();
 
-    ofs << "GRID_PIN VISUALISATION" << std::endl;
-    ofs << pitch << " " << pinRadius << " " << gridWidth << " " << gridHeight << " " << pinWidth << " " << pinHeight << std::endl;
+    ofs << "GRID_PIN VISUALISATION" << '\n';
+    ofs << pitch << " " << pinRadius << " " << gridWidth << " " << gridHeight << " " << pinWidth << " " << pinHeight << '\n';
     
     for(int j = 0; j < gridHeight; ++j){
         for(int i = 0; i < gridWidth; ++i){
-            ofs << i << " " << j << " " << gridArr[j][i] << std::endl;
+            ofs << i << " " << j << " " << gridArr[j][i] << '\n';
         }
     }
 
     for(int j = 0; j < pinHeight; ++j){
         for(int i = 0; i < pinWidth; ++i){
-            ofs << i << " " << j << " " << pinArr[j][i] << std::endl; 
+            ofs << i << " " << j << " " << pinArr[j][i] << '\n'; 
         }
     }
 
@@ -261,24 +261,24 @@ bool visualiseGridArrayWithPins(const std::vector<std::vector<SignalType>> &grid
     len_t pitch = tch.getMicrobumpPitch();
     len_t pinRadius = tch.getMicrobumpRadius();
 
-    ofs << "PIN_GRID_PIN VISUALISATION" << std::endl;
-    ofs << pitch << " " << pinRadius << " " << gridWidth << " " << gridHeight << " " << upPinWidth << " " << upPinHeight << std::endl;
+    ofs << "PIN_GRID_PIN VISUALISATION" << '\n';
+    ofs << pitch << " " << pinRadius << " " << gridWidth << " " << gridHeight << " " << upPinWidth << " " << upPinHeight << '\n';
 
     for(int j = 0; j < gridHeight; ++j){
         for(int i = 0; i < gridWidth; ++i){
-            ofs << i << " " << j << " " << gridArr[j][i] << std::endl;
+            ofs << i << " " << j << " " << gridArr[j][i] << '\n';
         }
     }
 
     for(int j = 0; j < upPinHeight; ++j){
         for(int i = 0; i < upPinWidth; ++i){
-            ofs << i << " " << j << " " << upPinArr[j][i] << std::endl; 
+            ofs << i << " " << j << " " << upPinArr[j][i] << '\n'; 
         }
     }
 
     for(int j = 0; j < downPinHeight; ++j){
         for(int i = 0; i < downPinWidth; ++i){
-            ofs << i << " " << j << " " << downPinArr[j][i] << std::endl; 
+            ofs << i << " " << j << " " << downPinArr[j][i] << '\n'; 
         }
     }
 
@@ -752,6 +752,10 @@ bool visualiseDiffusionEngineMetalAndVia(const DiffusionEngine &dfe, size_t meta
 }
 
 bool visualisePhysicalImplementation(const PowerDistributionNetwork &pdn, int layer, const std::string &filePath){
+    return visualisePhysicalImplementation(pdn.physicalGridWidth, pdn.physicalGridHeight, pdn.physicalNodes, pdn.pdnEdges, layer, filePath);
+}
+
+bool visualisePhysicalImplementation(int physicalGridWidth, int physicalGridHeight, const std::vector<PDNNode> &physicalNodes, const std::vector<PDNEdge> &pdnEdges, int layer, const std::string &filePath){
     std::ofstream ofs(filePath, std::ios::out);
 
     assert(ofs.is_open());
@@ -759,31 +763,35 @@ bool visualisePhysicalImplementation(const PowerDistributionNetwork &pdn, int la
 
 
 
-    ofs << "PHYSICAL_IMPLEMENTATION VISUALISATION" << std::endl;
-    ofs << "W = " << pdn.physicalGridWidth << ", H = " << pdn.physicalGridHeight << std::endl;
+    ofs << "PHYSICAL_IMPLEMENTATION VISUALISATION" << '\n';
+    ofs << "W = " << physicalGridWidth << ", H = " << physicalGridHeight << '\n';
 
-    for(int j = 0; j < pdn.physicalGridHeight; ++j){
-        for(int i = 0; i < pdn.physicalGridWidth; ++i){
-            PDNNode *node = pdn.physicalNodes[layer][j][i];
-            ofs << i << ", " << j << ": " << node->signal << " ";
-            if(node->up != nullptr){
-                ofs << "up = " << node->up->signal << " ";
+    // same indexing as PowerDistributionNetwork::calPhysicalNodeIdx
+    const size_t layerOffset = size_t(layer) * physicalGridHeight * physicalGridWidth;
+    for(int j = 0; j < physicalGridHeight; ++j){
+        for(int i = 0; i < physicalGridWidth; ++i){
+            const PDNNode &node = physicalNodes[layerOffset + size_t(j) * physicalGridWidth + i];
+            ofs << i << ", " << j << ": " << node.signal << " ";
+            if(node.up != PDN_EDGE_NONE){
+                ofs << "up = " << pdnEdges[node.up].signal << " ";
             }else{
                 ofs << "up = nullptr" << " ";
             }
 
-            if(node->down != nullptr){
-                ofs << "down = " << node->down->signal << std::endl;
+            if(node.down != PDN_EDGE_NONE){
+                ofs << "down = " << pdnEdges[node.down].signal << '\n';
             }else{
-                ofs << "down = nullptr" << std::endl;
+                ofs << "down = nullptr" << '\n';
             }
         }
     }
 
-    for(PDNEdge *edge : pdn.pdnEdgeOwner){
-        if(edge->isVia) continue;
-        if(edge->n0->layer != layer) continue;
-        ofs << edge->n0->x << " " << edge->n0->y << " " << edge->n1->x << " " << edge->n1->y << " " << edge->signal << std::endl;
+    for(const PDNEdge &edge : pdnEdges){
+        if(edge.isVia) continue;
+        const PDNNode &n0 = physicalNodes[edge.n0];
+        const PDNNode &n1 = physicalNodes[edge.n1];
+        if(n0.layer != layer) continue;
+        ofs << n0.x << " " << n0.y << " " << n1.x << " " << n1.y << " " << edge.signal << '\n';
     }
 
     ofs.close();
@@ -81,6 +81,8 @@ bool visualiseDiffusionEngineMetalAndVia(const DiffusionEngine &dfe, size_t meta
 
 // user "renderPhysicalImplementation" to render PDNNode/PDNEdge 
 bool visualisePhysicalImplementation(const PowerDistributionNetwork &pdn, int layer, const std::string &filePath);
+// same output from a copy of the physical network, lets a background writer dump while the network keeps changing
+bool visualisePhysicalImplementation(int physicalGridWidth, int physicalGridHeight, const std::vector<PDNNode> &physicalNodes, const std::vector<PDNEdge> &pdnEdges, int layer, const std::string &filePath);
 
 
 #endif // __VISUALIZER_H__
\ No newline at end of file
@@ -0,0 +1,364 @@
+#!/usr/bin/env python3
+"""
+genSyntheticCase.py
+Generate a complete PowerX input case of arbitrary size for stress and scaling runs.
+
+Writes inputs/<name>/ with:
+  <name>.pinout                  technology, preplace, microbump and C4 sections
+  <name>.tch / <name>.config     copied from the template case (inputs/case01 of the repo by default)
+  <name>_CHIPk.csv               one ballout per chiplet prototype
+  <name>_C4.csv                  the C4 cluster ballout
+  <name>_preplaced_m*.txt        random rectangular obstacles per metal layer
+  <name>_preplaced_v*.txt        vias enclosed by an obstacle in either metal layer
+
+Everything random is drawn from one seeded generator, the same arguments give the same case.
+
+Usage:
+  python3 utils/genSyntheticCase.py syn500 --grid 500 --layers 4 --chiplets 8 --domains 3 \
+      --obstacle-density 0.03 --seed 7
+
+  ./bin/pwrx syn500
+
+Notes:
+- PIN = GRID + 1, microbumps and C4 pins sit on the pin grid, metal obstacles on the grid.
+- Power domains are POWER_1 .. POWER_<domains> (at most 10). Every domain gets at least one
+  chiplet prototype and at least one C4 cluster so that every net has a source and a sink.
+- Chiplet ballouts alternate power and ground like the shipped cases, with a ring of SIG pins
+  on larger chiplets. Chiplets with several domains split their columns into one band per domain.
+- Obstacles keep clear of the chiplet footprints on the top metal layer and of the C4 clusters
+  on the bottom metal layer, the layers in between are blocked freely.
+"""
+
+import os
+import sys
+import random
+import shutil
+from argparse import ArgumentParser
+
+COLORRST    = "\u001b[0m"
+RED         = "\u001b[31m"
+GREEN       = "\u001b[32m"
+
+MAX_DOMAINS = 10
+ROTATIONS = ["R0", "R90", "R180", "R270"]
+
+
+def excel_letters(n):
+    """1->A, 2->B, ..., 26->Z, 27->AA, 28->AB, ... (matches CSVCellToCord)"""
+    s = ""
+    while n > 0:
+        n, r = divmod(n - 1, 26)
+        s = chr(ord('A') + r) + s
+    return s
+
+
+def write_ballout_csv(path, name, grid, attributes):
+    """grid[j][i] with j counted from the bottom, row A of the csv is the top row"""
+    height = len(grid)
+    width = len(grid[0])
+    pad = max(2, len(str(width)))
+    with open(path, "w") as f:
+        for key, value in attributes:
+            f.write(f"{key} = {value}\n")
+        f.write(f"BEGIN_CHIPLET {name} {width} {height}\n")
+        for r in range(height):
+            row = grid[height - 1 - r]
+            letters = excel_letters(r + 1)
+            for c in range(width):
+                f.write(f"{letters}{c + 1:0{pad}d},{row[c]}\n")
+        f.write("END_CHIPLET")
+
+
+def chiplet_ballout(width, height, domains):
+    """power / ground alternating in every row, one column band per domain, SIG ring when large"""
+    grid = [["GROUND"] * width for _ in range(height)]
+    bandWidth = width / len(domains)
+    for j in range(height):
+        for i in range(width):
+            if (i + j) % 2 == 0:
+                domain = domains[min(int(i / bandWidth), len(domains) - 1)]
+                grid[j][i] = f"POWER_{domain}"
+    if (width >= 8) and (height >= 8):
+        for j in range(height):
+            for i in range(width):
+                if (i == 0) or (j == 0) or (i == width - 1) or (j == height - 1):
+                    grid[j][i] = "SIG"
+    return grid
+
+
+def overlaps(a, b, spacing):
+    """a, b as (x0, y0, x1, y1) inclusive"""
+    return not ((a[2] + spacing < b[0]) or (b[2] + spacing < a[0]) or (a[3] + spacing < b[1]) or (b[3] + spacing < a[1]))
+
+
+def place_chiplets(rng, pinWidth, pinHeight, prototypes, count, spacing, attempts):
+    placed = []
+    for k in range(count):
+        protoIdx = k % len(prototypes)
+        protoWidth, protoHeight = prototypes[protoIdx]["size"]
+        for _ in range(attempts):
+            rotation = rng.choice(ROTATIONS)
+            width, height = (protoHeight, protoWidth) if rotation in ("R90", "R270") else (protoWidth, protoHeight)
+            if (width + 2 > pinWidth) or (height + 2 > pinHeight):
+                continue
+            x = rng.randint(1, pinWidth - width - 1)
+            y = rng.randint(1, pinHeight - height - 1)
+            rect = (x, y, x + width - 1, y + height - 1)
+            if any(overlaps(rect, p["rect"], spacing) for p in placed):
+                continue
+            placed.append({"proto": protoIdx, "rotation": rotation, "rect": rect})
+            break
+        else:
+            print(f"{RED}[PowerX:SyntheticCase] Error: Cannot place chiplet {k} after {attempts} attempts, "
+                  f"lower --chiplets or --chiplet-size{COLORRST}")
+            sys.exit(4)
+    return placed
+
+
+def c4_layout(pinLength, clusterSize, pitch, minBorder):
+    """cluster count and the two borders so that border + size + pitch*(count-1) + border == pinLength"""
+    count = (pinLength - clusterSize - 2 * minBorder) // pitch + 1
+    if count < 1:
+        print(f"{RED}[PowerX:SyntheticCase] Error: Pin length {pinLength} too small for one C4 cluster{COLORRST}")
+        sys.exit(4)
+    slack = pinLength - clusterSize - pitch * (count - 1)
+    return count, slack // 2, slack - slack // 2
+
+
+def c4_ballout(rng, countWidth, countHeight, leftBorder, downBorder, pitch, clusterSize, chiplets, prototypes, domainCount, signalRatio):
+    """ground on the checkerboard, the rest powers the nearest chiplet or carries signal"""
+    grid = [["GROUND"] * countWidth for _ in range(countHeight)]
+    centres = []
+    for c in chiplets:
+        x0, y0, x1, y1 = c["rect"]
+        centres.append(((x0 + x1) / 2, (y0 + y1) / 2, prototypes[c["proto"]]["domains"]))
+
+    for j in range(countHeight):
+        for i in range(countWidth):
+            if (i + j) % 2 == 0:
+                continue
+            if rng.random() < signalRatio:
+                grid[j][i] = "SIG"
+                continue
+            cx = leftBorder + i * pitch + clusterSize / 2
+            cy = downBorder + j * pitch + clusterSize / 2
+            nearest = min(centres, key=lambda c: (c[0] - cx) ** 2 + (c[1] - cy) ** 2)
+            grid[j][i] = f"POWER_{rng.choice(nearest[2])}"
+
+    # a domain left without a cluster would have no source, claim one off-checkerboard cluster for it
+    present = {cell for row in grid for cell in row}
+    oddCells = [(i, j) for j in range(countHeight) for i in range(countWidth) if (i + j) % 2 == 1]
+    rng.shuffle(oddCells)
+    for d in range(1, domainCount + 1):
+        if f"POWER_{d}" in present:
+            continue
+        if not oddCells:
+            print(f"{RED}[PowerX:SyntheticCase] Error: Not enough C4 clusters for {domainCount} domains{COLORRST}")
+            sys.exit(4)
+        i, j = oddCells.pop()
+        grid[j][i] = f"POWER_{d}"
+    return grid
+
+
+def random_obstacles(rng, gridWidth, gridHeight, density, maxSide, keepOut):
+    """rectangles (x0, y0, x1, y1) covering about density of the layer and clear of the keepOut cells"""
+    target = int(density * gridWidth * gridHeight)
+    covered = set()
+    rects = []
+    misses = 0
+    while (len(covered) < target) and (misses < 1000):
+        w = rng.randint(1, maxSide)
+        h = rng.randint(1, maxSide)
+        x = rng.randint(0, gridWidth - w)
+        y = rng.randint(0, gridHeight - h)
+        rect = (x, y, x + w - 1, y + h - 1)
+        if any((xx, yy) in keepOut for yy in range(rect[1], rect[3] + 1) for xx in range(rect[0], rect[2] + 1)):
+            misses += 1
+            continue
+        misses = 0
+        rects.append(rect)
+        for yy in range(rect[1], rect[3] + 1):
+            for xx in range(rect[0], rect[2] + 1):
+                covered.add((xx, yy))
+    return rects, covered
+
+
+def write_preplace(path, title, sections):
+    """sections: list of (signal, [lines])"""
+    with open(path, "w") as f:
+        f.write("BEGIN_PREPLACE\n\n")
+        f.write(f"# {title}\n\n")
+        for signal, lines in sections:
+            f.write(f"SIGNAL: SIGNALTYPE::{signal}\n")
+            for line in lines:
+                f.write(line + "\n")
+            f.write("\n")
+        f.write("END_PREPLACE")
+
+
+def main():
+    ap = ArgumentParser(description="Generate a synthetic PowerX case under inputs/<name>/")
+    ap.add_argument("name", help="case name, also the directory and file prefix")
+    ap.add_argument("--grid", type=int, nargs="+", default=[125], help="GRID_WIDTH [GRID_HEIGHT]")
+    ap.add_argument("--layers", type=int, default=4, help="metal layer count, at least 2")
+    ap.add_argument("--chiplets", type=int, default=4, help="chiplet instances")
+    ap.add_argument("--domains", type=int, default=2, help=f"power domains, 1 ~ {MAX_DOMAINS}")
+    ap.add_argument("--obstacle-density", type=float, default=0.02, help="blocked fraction of every metal layer")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--chiplet-size", type=int, nargs=2, default=None, metavar=("MIN", "MAX"),
+                    help="chiplet side in pins, defaults to 10%% ~ 22%% of the pin grid, smaller for many chiplets")
+    ap.add_argument("--c4-pitch", type=int, default=6)
+    ap.add_argument("--c4-size", type=int, default=2)
+    ap.add_argument("--c4-border", type=int, default=5, help="minimum C4 border")
+    ap.add_argument("--c4-signal-ratio", type=float, default=0.3, help="share of non-ground C4 clusters carrying signal")
+    ap.add_argument("--template", default="case01", help="case whose .tch and .config are copied")
+    ap.add_argument("--template-dir", default=os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "inputs")),
+                    help="directory holding the template case, the inputs/ of this repo by default")
+    ap.add_argument("--outdir", default="inputs")
+    args = ap.parse_args()
+
+    gridWidth = args.grid[0]
+    gridHeight = args.grid[1] if len(args.grid) > 1 else args.grid[0]
+    pinWidth, pinHeight = gridWidth + 1, gridHeight + 1
+
+    if args.layers < 2:
+        print(f"{RED}[PowerX:SyntheticCase] Error: At least 2 metal layers are required{COLORRST}")
+        sys.exit(4)
+    if not (1 <= args.domains <= MAX_DOMAINS):
+        print(f"{RED}[PowerX:SyntheticCase] Error: Domains must be within [1, {MAX_DOMAINS}]{COLORRST}")
+        sys.exit(4)
+    if args.chiplets < 1:
+        print(f"{RED}[PowerX:SyntheticCase] Error: At least 1 chiplet is required{COLORRST}")
+        sys.exit(4)
+    if not (0.0 <= args.obstacle_density < 1.0):
+        print(f"{RED}[PowerX:SyntheticCase] Error: Obstacle density must be within [0, 1){COLORRST}")
+        sys.exit(4)
+
+    # checked before anything is written, a missing template must not leave a half written case behind
+    templateDir = os.path.join(args.template_dir, args.template)
+    templateFiles = [os.path.join(templateDir, f"{args.template}{ext}") for ext in (".tch", ".config")]
+    for path in templateFiles:
+        if not os.path.isfile(path):
+            print(f"{RED}[PowerX:SyntheticCase] Error: Template file {path} not found, see --template and --template-dir{COLORRST}")
+            sys.exit(4)
+
+    rng = random.Random(args.seed)
+    caseDir = os.path.join(args.outdir, args.name)
+    os.makedirs(caseDir, exist_ok=True)
+    prefix = os.path.join(caseDir, args.name)
+
+    # prototypes: one per domain group, domains dealt round robin when there are fewer chiplets than domains
+    protoCount = min(args.chiplets, args.domains)
+    if args.chiplet_size is None:
+        # chiplets together take at most about 40% of the interposer
+        sizeUB = int(min(min(pinWidth, pinHeight) * 0.22, (0.4 * pinWidth * pinHeight / args.chiplets) ** 0.5))
+        sizeUB = max(4, sizeUB)
+        sizeLB = max(4, min(sizeUB, int(min(pinWidth, pinHeight) * 0.10)))
+    else:
+        sizeLB, sizeUB = args.chiplet_size
+    prototypes = []
+    for p in range(protoCount):
+        domains = [d for d in range(1, args.domains + 1) if (d - 1) % protoCount == p]
+        size = (rng.randint(sizeLB, sizeUB), rng.randint(sizeLB, sizeUB))
+        prototypes.append({"name": f"{args.name}CHIP{p}", "size": size, "domains": domains})
+
+    spacing = max(2, min(pinWidth, pinHeight) // 60)
+    chiplets = place_chiplets(rng, pinWidth, pinHeight, prototypes, args.chiplets, spacing, 5000)
+
+    # ballouts
+    for p, proto in enumerate(prototypes):
+        width, height = proto["size"]
+        attributes = [("MAX_CURRENT", "1.05 A"), ("SERIES_RESISTANCE", "55 mOhm"),
+                      ("SERIES_INDUCTANCE", "200 nH"), ("SHUNT_CAPACITANCE", "40 pF")]
+        write_ballout_csv(f"{prefix}_CHIP{p}.csv", proto["name"], chiplet_ballout(width, height, proto["domains"]), attributes)
+
+    c4CountWidth, c4Left, c4Right = c4_layout(pinWidth, args.c4_size, args.c4_pitch, args.c4_border)
+    c4CountHeight, c4Down, c4Up = c4_layout(pinHeight, args.c4_size, args.c4_pitch, args.c4_border)
+    c4Grid = c4_ballout(rng, c4CountWidth, c4CountHeight, c4Left, c4Down, args.c4_pitch, args.c4_size,
+                        chiplets, prototypes, args.domains, args.c4_signal_ratio)
+    write_ballout_csv(f"{prefix}_C4.csv", f"{args.name}C4", c4Grid, [])
+
+    # obstacles, a cell is touched by the pins on its four corners so footprints grow by one towards the origin
+    def cells_of(rect):
+        return {(x, y) for y in range(rect[1], rect[3] + 1) for x in range(rect[0], rect[2] + 1)}
+
+    chipletKeepOut = set()
+    for c in chiplets:
+        chipletKeepOut |= cells_of((c["rect"][0] - 1, c["rect"][1] - 1, c["rect"][2], c["rect"][3]))
+    c4KeepOut = set()
+    for j in range(c4CountHeight):
+        for i in range(c4CountWidth):
+            x0 = c4Left + i * args.c4_pitch
+            y0 = c4Down + j * args.c4_pitch
+            c4KeepOut |= cells_of((x0 - 1, y0 - 1, x0 + args.c4_size - 1, y0 + args.c4_size - 1))
+
+    maxSide = max(2, min(gridWidth, gridHeight) // 25)
+    metalCovered = []
+    for layer in range(args.layers):
+        keepOut = set()
+        if layer == 0: keepOut |= chipletKeepOut
+        if layer == args.layers - 1: keepOut |= c4KeepOut
+        rects, covered = random_obstacles(rng, gridWidth, gridHeight, args.obstacle_density, maxSide, keepOut)
+        metalCovered.append(covered)
+        lines = []
+        for n, (x0, y0, x1, y1) in enumerate(rects):
+            lines.append(f"# Obstacle {n + 1}")
+            for y in range(y0, y1 + 1):
+                lines.append(f"Cord({x0}, {y}) to Cord({x1}, {y})" if x1 > x0 else f"Cord({x0}, {y})")
+        write_preplace(f"{prefix}_preplaced_m{layer}.txt",
+                       f"seed {args.seed}, {len(rects)} obstacles, {len(covered)} cells", [("OBSTACLE", lines)])
+
+    # a via whose four surrounding cells are blocked in the metal above or below cannot land anywhere
+    for layer in range(args.layers - 1):
+        lines = []
+        for covered in (metalCovered[layer], metalCovered[layer + 1]):
+            for (x, y) in covered:
+                if (x + 1 >= pinWidth - 1) or (y + 1 >= pinHeight - 1): continue
+                if ((x + 1, y) in covered) and ((x, y + 1) in covered) and ((x + 1, y + 1) in covered):
+                    lines.append(f"Cord({x + 1}, {y + 1})")
+        lines = sorted(set(lines))
+        write_preplace(f"{prefix}_preplaced_v{layer}.txt", f"seed {args.seed}, {len(lines)} vias", [("OBSTACLE", lines)])
+
+    # the technology and hyperparameters of the template case
+    shutil.copyfile(templateFiles[0], f"{prefix}.tch")
+    shutil.copyfile(templateFiles[1], f"{prefix}.config")
+
+    with open(f"{prefix}.pinout", "w") as f:
+        f.write("TECHNOLOGY_BEGIN\n")
+        f.write(f"GRID_WIDTH = {gridWidth}\nGRID_HEIGHT = {gridHeight}\n")
+        f.write(f"PIN_WIDTH = {pinWidth}\nPIN_HEIGHT = {pinHeight}\n")
+        f.write(f"LAYERS = {args.layers}\n")
+        f.write("TECHNOLOGY_END\n\n")
+
+        f.write("PDN_PREPLACE_START\n")
+        for layer in range(args.layers):
+            f.write(f"METAL_LAYER {layer} \"{prefix}_preplaced_m{layer}.txt\"\n")
+        f.write("\n")
+        for layer in range(args.layers - 1):
+            f.write(f"VIA_LAYER {layer} \"{prefix}_preplaced_v{layer}.txt\"\n")
+        f.write("PDN_PREPLACE_END\n\n")
+
+        f.write("MICROBUMP_START\n\n")
+        for p in range(len(prototypes)):
+            f.write(f"include \"{prefix}_CHIP{p}.csv\"\n")
+        f.write("\n")
+        for k, c in enumerate(chiplets):
+            f.write(f"CHIPLET {prototypes[c['proto']]['name']} {args.name}CHIP{c['proto']}_{k} {c['rotation']} ({c['rect'][0]}, {c['rect'][1]})\n")
+        f.write("\nMICROBUMP_END\n\n")
+
+        f.write("C4_START\n\n")
+        f.write(f"C4_WIDTH = {args.c4_size}\nC4_HEIGHT = {args.c4_size}\n\n")
+        f.write(f"C4_PITCH_WIDTH = {args.c4_pitch}\nC4_PITCH_HEIGHT = {args.c4_pitch}\n\n")
+        f.write(f"C4_COUNT_WIDTH = {c4CountWidth}\nC4_COUNT_HEIGHT = {c4CountHeight}\n\n")
+        f.write(f"C4_LEFT_BORDER = {c4Left}\nC4_RIGHT_BORDER = {c4Right}\n")
+        f.write(f"C4_DOWN_BORDER = {c4Down}\nC4_UP_BORDER = {c4Up}\n\n")
+        f.write(f"include \"{prefix}_C4.csv\"\n")
+        f.write("ROTATION = 0\n\n")
+        f.write("C4_END")
+
+    print(f"{GREEN}[PowerX:SyntheticCase] {args.name}: grid {gridWidth}x{gridHeight}, {args.layers} layers, "
+          f"{len(chiplets)} chiplets, {args.domains} domains, C4 {c4CountWidth}x{c4CountHeight}, seed {args.seed}{COLORRST}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,295 @@
+#!/usr/bin/env python3
+"""
+hyperSweep.py
+Hyperparameter sweep over the .config knobs of DiffusionEngine::readConfigurations.
+
+A JSON spec names the case, the knobs and how to sample them:
+  {
+    "case": "case01",
+    "mode": "grid",                                   # or "random"
+    "trials": 20,                                     # random mode only
+    "seed": 1,                                        # random mode only
+    "params": {
+      "ViaEdgeUB":     [2.0, 2.5, 3.0],               # a list is a grid axis / a random choice
+      "viaEdgeWeight": [0.02, 0.05],
+      "minCommitRate": {"min": 0.25, "max": 0.5},     # a range, random mode only
+      "batchSize":     {"min": 1024, "max": 16384, "log": true, "int": true}
+    }
+  }
+"base_config" may point to another config than inputs/<case>/<case>.config, knobs not in "params" keep
+its values.
+
+Every trial runs as `bin/pwrx <case> --config <trial>/<case>.config --output-dir <trial>/ --qor --no-dumps`
+in a pool of worker processes. Trials that only differ in filling knobs (batchSize, *CommitRate,
+expectedFillingCycles, maxFillingRate, ...) share one MCF result: the first trial of such a group
+writes the filling checkpoint and the others resume from it.
+
+Results of all trials are kept in <outdir>/results.csv (rewritten after every trial) with the wall
+time, the runtime of every stage, the QoR figures of --qor and the knob values; the best trials by
+--objective are printed at the end.
+
+Usage:
+  make pwrx
+  python3 utils/hyperSweep.py sweep.json --workers 4
+  python3 utils/hyperSweep.py sweep.json --objective weighted_avg_vdrop --top 10
+
+Notes:
+- The filling knobs come from `bin/pwrx --list-filling-only-keys` and the trial configs are written by
+  `bin/pwrx --write-config`, so the groups and the filling checkpoint key always agree with the binary.
+- A resumed trial does not pay for the MCF stage, compare the runtime of trials within a group or
+  run with --no-share for a fair runtime comparison.
+- Each worker gets OMP_NUM_THREADS = cores / workers unless OMP_NUM_THREADS is already set.
+"""
+
+import os
+import sys
+import json
+import math
+import time
+import random
+import itertools
+import subprocess
+import concurrent.futures
+from argparse import ArgumentParser
+
+COLORRST    = "\u001b[0m"
+RED         = "\u001b[31m"
+GREEN       = "\u001b[32m"
+YELLOW      = "\u001b[33m"
+
+QOR_METRICS = ["worst_vdrop", "weighted_avg_vdrop", "power_loss", "empty_metal", "empty_via"]
+
+
+def read_csv(path):
+    with open(path) as f:
+        header = f.readline().strip().split(",")
+        return [dict(zip(header, line.strip().split(","))) for line in f if line.strip()]
+
+
+def format_value(value):
+    """the same value always prints the same, the filling checkpoint key depends on it"""
+    if isinstance(value, int) and not isinstance(value, bool):
+        return str(value)
+    return repr(float(value))
+
+
+def sample_trials(spec):
+    """list of {knob: value}"""
+    params = spec["params"]
+    mode = spec.get("mode", "grid")
+    if mode == "grid":
+        for knob, domain in params.items():
+            if not isinstance(domain, list):
+                raise ValueError(f"grid mode needs a list of values for {knob}")
+        knobs = list(params)
+        return [dict(zip(knobs, values)) for values in itertools.product(*(params[knob] for knob in knobs))]
+
+    if mode != "random":
+        raise ValueError(f"unknown mode {mode}, expected grid or random")
+    rng = random.Random(spec.get("seed", 1))
+    trials = []
+    for _ in range(spec.get("trials", 10)):
+        trial = {}
+        for knob, domain in params.items():
+            if isinstance(domain, list):
+                trial[knob] = rng.choice(domain)
+                continue
+            lo, hi = domain["min"], domain["max"]
+            if domain.get("log", False):
+                value = math.exp(rng.uniform(math.log(lo), math.log(hi)))
+            else:
+                value = rng.uniform(lo, hi)
+            trial[knob] = int(round(value)) if domain.get("int", False) else value
+        trials.append(trial)
+    return trials
+
+
+def query_filling_only_keys(binary):
+    """DiffusionEngine::getFillingOnlyConfigurations of the binary under test"""
+    result = subprocess.run([binary, "--list-filling-only-keys"], capture_output=True, text=True)
+    if result.returncode != 0:
+        raise RuntimeError(result.stderr.strip() or f"{binary} --list-filling-only-keys failed")
+    return set(result.stdout.split())
+
+
+def write_trial_config(binary, baseConfig, overrides, path):
+    """base config with the knobs of the trial replaced, knobs missing from the base are appended"""
+    command = [binary, "--write-config", baseConfig, path] + [f"{k}={format_value(v)}" for k, v in sorted(overrides.items())]
+    result = subprocess.run(command, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise RuntimeError(result.stderr.strip() or f"{binary} --write-config failed")
+
+
+def group_trials(trials, share, fillingOnlyKeys):
+    """trials with the same MCF knobs form a group, list of lists of trial indices in first-seen order"""
+    if not share:
+        return [[i] for i in range(len(trials))]
+    groups = {}
+    for i, trial in enumerate(trials):
+        signature = tuple(sorted((k, format_value(v)) for k, v in trial.items() if k not in fillingOnlyKeys))
+        groups.setdefault(signature, []).append(i)
+    return list(groups.values())
+
+
+def run_trial(binary, case, trialDir, role, checkpointDir, env):
+    """role is full, seed (writes the filling checkpoint) or resumed; returns the result row"""
+    command = [binary, case, "--config", os.path.join(trialDir, case + ".config"), "--output-dir", trialDir, "--qor", "--no-dumps"]
+    if role == "seed":
+        command += ["--checkpoint", "--checkpoint-dir", checkpointDir]
+    elif role == "resumed":
+        command += ["--resume-from", "filling", "--checkpoint-dir", checkpointDir]
+
+    for suffix in ("_stages.csv", "_qor.csv"):
+        path = os.path.join(trialDir, case + suffix)
+        if os.path.exists(path): os.remove(path)
+
+    logPath = os.path.join(trialDir, "run.log")
+    start = time.perf_counter()
+    with open(logPath, "w") as log:
+        result = subprocess.run(command, stdout=log, stderr=subprocess.STDOUT, env=env)
+    row = {"role": role, "wall_s": time.perf_counter() - start, "status": "done", "stages": {}, "qor": {}}
+
+    stagesPath = os.path.join(trialDir, case + "_stages.csv")
+    qorPath = os.path.join(trialDir, case + "_qor.csv")
+    if result.returncode != 0 or not (os.path.exists(stagesPath) and os.path.exists(qorPath)):
+        row["status"] = f"failed({result.returncode})"
+        return row
+    row["stages"] = {r["stage"]: float(r["runtime_s"]) for r in read_csv(stagesPath)}
+    row["peak_rss_bytes"] = max([int(r["peak_rss_bytes"]) for r in read_csv(stagesPath)] + [0])
+    row["qor"] = {r["metric"]: float(r["value"]) for r in read_csv(qorPath)}
+    return row
+
+
+def write_results(path, trials, groupOf, rows):
+    """one line per finished trial, columns are the union over all trials so far"""
+    stageNames, qorNames = [], list(QOR_METRICS)
+    for row in rows.values():
+        for name in row["stages"]:
+            if name not in stageNames: stageNames.append(name)
+        for name in sorted(row["qor"]):
+            if name not in qorNames: qorNames.append(name)
+    knobs = list(trials[0]) if trials else []
+
+    with open(path + ".tmp", "w") as f:
+        header = ["trial", "group", "role", "status", "wall_s", "runtime_s", "peak_rss_bytes"]
+        header += ["stage:" + name for name in stageNames] + qorNames + knobs
+        f.write(",".join(header) + "\n")
+        for i in sorted(rows):
+            row = rows[i]
+            values = [str(i), str(groupOf[i]), row["role"], row["status"], f"{row['wall_s']:.3f}",
+                      f"{sum(row['stages'].values()):.3f}", str(row.get("peak_rss_bytes", ""))]
+            values += [f"{row['stages'][name]:.6f}" if name in row["stages"] else "" for name in stageNames]
+            values += [f"{row['qor'][name]:.17g}" if name in row["qor"] else "" for name in qorNames]
+            values += [format_value(trials[i][knob]) for knob in knobs]
+            f.write(",".join(values) + "\n")
+    os.replace(path + ".tmp", path)
+
+
+def objective_value(row, objective):
+    if objective == "wall_s": return row["wall_s"]
+    if objective == "runtime_s": return sum(row["stages"].values())
+    return row["qor"].get(objective)
+
+
+def print_best(trials, rows, objective, top):
+    ranked = [(objective_value(row, objective), i) for i, row in rows.items() if row["status"] == "done"]
+    ranked = sorted((v, i) for v, i in ranked if v is not None)[:top]
+
+    print("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗")
+    print(f"║ {'Trial':>6} │ {objective[:18]:>18} │ {'Wall (s)':>10} │ {'Knobs':<87}║")
+    print("╟────────│────────────────────│────────────│────────────────────────────────────────────────────────────────────────────────────────╢")
+    for value, i in ranked:
+        knobs = " ".join(f"{k}={format_value(v)}" for k, v in trials[i].items())
+        if len(knobs) > 87: knobs = knobs[:84] + "..."
+        print(f"║ {i:>6} │ {value:>18.6g} │ {rows[i]['wall_s']:>10.3f} │ {knobs:<87}║")
+    print("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝")
+
+
+def main():
+    ap = ArgumentParser(description="Hyperparameter sweep over the PowerX .config knobs")
+    ap.add_argument("spec", help="JSON sweep spec")
+    ap.add_argument("--binary", default="bin/pwrx")
+    ap.add_argument("--workers", type=int, default=2, help="trials running at the same time")
+    ap.add_argument("--outdir", default=None, help="defaults to outputs/sweep/<case>")
+    ap.add_argument("--objective", default="worst_vdrop", help="QoR metric, runtime_s or wall_s; lower is better")
+    ap.add_argument("--top", type=int, default=5, help="best trials printed at the end")
+    ap.add_argument("--no-share", action="store_true", help="run every trial from scratch instead of sharing the MCF result")
+    args = ap.parse_args()
+
+    with open(args.spec) as f: spec = json.load(f)
+    case = spec["case"]
+    baseConfig = spec.get("base_config", os.path.join("inputs", case, case + ".config"))
+    outdir = args.outdir or os.path.join("outputs", "sweep", case)
+
+    if not os.path.exists(args.binary):
+        print(f"{RED}[PowerX:Sweep] Error: {args.binary} not found, run make first{COLORRST}")
+        sys.exit(2)
+    if not os.path.exists(baseConfig):
+        print(f"{RED}[PowerX:Sweep] Error: Base config {baseConfig} not found{COLORRST}")
+        sys.exit(2)
+    try:
+        trials = sample_trials(spec)
+    except (KeyError, ValueError) as e:
+        print(f"{RED}[PowerX:Sweep] Error: Invalid spec {args.spec}: {e}{COLORRST}")
+        sys.exit(2)
+    if not trials:
+        print(f"{RED}[PowerX:Sweep] Error: {args.spec} yields no trial{COLORRST}")
+        sys.exit(2)
+
+    try:
+        fillingOnlyKeys = query_filling_only_keys(args.binary)
+        for i, trial in enumerate(trials):
+            trialDir = os.path.join(outdir, f"trial_{i:04d}")
+            os.makedirs(trialDir, exist_ok=True)
+            write_trial_config(args.binary, baseConfig, trial, os.path.join(trialDir, case + ".config"))
+    except RuntimeError as e:
+        print(f"{RED}[PowerX:Sweep] Error: {e}{COLORRST}")
+        sys.exit(2)
+
+    groups = group_trials(trials, not args.no_share, fillingOnlyKeys)
+    groupOf = {i: g for g, members in enumerate(groups) for i in members}
+    print(f"[PowerX:Sweep] {case}: {len(trials)} trials in {len(groups)} MCF group(s), {args.workers} worker(s)")
+
+    env = dict(os.environ)
+    if "OMP_NUM_THREADS" not in env:
+        env["OMP_NUM_THREADS"] = str(max(1, (os.cpu_count() or 1) // max(1, args.workers)))
+
+    resultsPath = os.path.join(outdir, "results.csv")
+    rows = {}
+
+    def submit(pool, i, role):
+        checkpointDir = os.path.join(outdir, "checkpoints", f"group_{groupOf[i]:04d}")
+        return pool.submit(run_trial, args.binary, case, os.path.join(outdir, f"trial_{i:04d}"), role, checkpointDir, env)
+
+    # the first trial of a group runs the MCF stage, the rest of the group is queued once its checkpoint exists
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.workers)) as pool:
+        running = {}
+        for members in groups:
+            running[submit(pool, members[0], "seed" if len(members) > 1 else "full")] = members[0]
+        while running:
+            finished, _ = concurrent.futures.wait(running, return_when=concurrent.futures.FIRST_COMPLETED)
+            for future in finished:
+                i = running.pop(future)
+                row = future.result()
+                rows[i] = row
+                colour = GREEN if row["status"] == "done" else RED
+                print(f"{colour}[PowerX:Sweep] Trial {i} ({row['role']}) {row['status']} in {row['wall_s']:.1f}s{COLORRST}", flush=True)
+                write_results(resultsPath, trials, groupOf, rows)
+
+                if row["role"] != "seed": continue
+                followerRole = "resumed" if row["status"] == "done" else "full"
+                if followerRole == "full":
+                    print(f"{YELLOW}[PowerX:Sweep] Warning: Group {groupOf[i]} has no checkpoint, its trials run from scratch{COLORRST}")
+                for j in groups[groupOf[i]][1:]:
+                    running[submit(pool, j, followerRole)] = j
+
+    failed = [i for i, row in rows.items() if row["status"] != "done"]
+    print(f"[PowerX:Sweep] Results of {len(rows)} trials written to {resultsPath}")
+    print_best(trials, rows, args.objective, args.top)
+    if failed:
+        print(f"{RED}[PowerX:Sweep] {len(failed)} trial(s) failed: {' '.join(map(str, sorted(failed)))}{COLORRST}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
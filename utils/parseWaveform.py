@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Read a PXWF waveform file written by TransientSimulator::writeWaveforms and
+print the droop of every probe, optionally plotting the waveforms.
+
+Usage:
+  python parseWaveform.py outputs/POWER_1_tran.pxwf [--plot] [-o out.png]
+
+Notes:
+- Layout (host byte order): magic "PXWF" | u32 version | u32 probeCount | u64 sampleCount
+  | f64 startTime | f64 timeStep | probeCount x (u32 nameLength | name) | sampleCount x probeCount x f32
+- Droop is reported in mV (4 decimals) as the value at t = 0 minus the minimum over the run
+"""
+
+import sys
+import struct
+import argparse
+from typing import List, Tuple
+
+import numpy as np
+
+PXWF_MAGIC = b'PXWF'
+PXWF_VERSION = 1
+
+
+def readWaveform(path: str) -> Tuple[np.ndarray, List[str], np.ndarray]:
+    """Return (time [s], probe names, samples [sample, probe] in V)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:4] != PXWF_MAGIC:
+        raise ValueError(f"{path}: not a PXWF waveform file")
+    version, probeCount, sampleCount, startTime, timeStep = struct.unpack_from('=IIQdd', data, 4)
+    if version != PXWF_VERSION:
+        raise ValueError(f"{path}: unsupported PXWF version {version}")
+
+    offset = 4 + struct.calcsize('=IIQdd')
+    names = []
+    for _ in range(probeCount):
+        (nameLength,) = struct.unpack_from('=I', data, offset)
+        offset += 4
+        names.append(data[offset:offset + nameLength].decode('ascii'))
+        offset += nameLength
+
+    samples = np.frombuffer(data, dtype=np.float32, count=sampleCount * probeCount, offset=offset)
+    samples = samples.reshape(sampleCount, probeCount)
+    time = startTime + timeStep * np.arange(sampleCount)
+    return time, names, samples
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Report and plot PXWF transient waveforms")
+    parser.add_argument('waveform', help="path to a .pxwf file")
+    parser.add_argument('--plot', action='store_true', help="plot every probe")
+    parser.add_argument('-o', '--output', default=None, help="save the plot instead of showing it")
+    args = parser.parse_args()
+
+    time, names, samples = readWaveform(args.waveform)
+    print(f"{args.waveform}: {len(names)} probes, {len(time)} samples, step = {time[1] - time[0] if len(time) > 1 else 0:.3e} s")
+    for p, name in enumerate(names):
+        droop = samples[0, p] - samples[:, p].min()
+        droopTime = time[samples[:, p].argmin()]
+        print(f"  {name:<24s} V(0) = {samples[0, p]:.6f} V, droop = {droop * 1e3:.4f} mV at {droopTime:.3e} s")
+
+    if args.plot:
+        import matplotlib.pyplot as plt
+        fig, ax = plt.subplots(figsize=(10, 6))
+        for p, name in enumerate(names):
+            ax.plot(time * 1e9, samples[:, p], label=name)
+        ax.set_xlabel("time (ns)")
+        ax.set_ylabel("voltage (V)")
+        ax.legend(fontsize='small')
+        ax.grid(True, alpha=0.3)
+        if args.output:
+            fig.savefig(args.output, dpi=200, bbox_inches='tight')
+        else:
+            plt.show()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
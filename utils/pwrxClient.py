@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""
+pwrxClient.py
+Local client of the PowerX daemon (`bin/pwrx --daemon <socket>`), see src/jobServer.hpp for the protocol.
+
+Submits one job, prints the progress the daemon streams back and exits 0 when the job succeeded:
+  python3 utils/pwrxClient.py --socket /tmp/pwrx.sock run case01
+  python3 utils/pwrxClient.py --socket /tmp/pwrx.sock run inputs/syn500 --set ViaEdgeUB=3.0 --set minCommitRate=0.3 \
+      --output outputs/fp/iter17
+
+Daemon control:
+  python3 utils/pwrxClient.py --socket /tmp/pwrx.sock ping
+  python3 utils/pwrxClient.py --socket /tmp/pwrx.sock status
+  python3 utils/pwrxClient.py --socket /tmp/pwrx.sock shutdown      # running jobs finish, queued jobs are dropped
+
+Notes:
+- --quiet only prints the QOR lines and the final DONE line, --json prints one JSON object with the
+  output directory, the stage runtimes and the QoR figures once the job is done.
+- The daemon only accepts connections from the user that started it (socket mode 0600).
+"""
+
+import sys
+import json
+import socket
+from argparse import ArgumentParser
+
+COLORRST    = "\u001b[0m"
+RED         = "\u001b[31m"
+GREEN       = "\u001b[32m"
+
+
+def request_lines(args):
+    if args.command != "run":
+        return [args.command.upper()]
+    lines = ["RUN " + args.case]
+    lines += ["SET " + override for override in args.set]
+    if args.output: lines.append("OUTPUT " + args.output)
+    return lines
+
+
+def main():
+    ap = ArgumentParser(description="Client of the PowerX daemon")
+    ap.add_argument("--socket", default="/tmp/pwrx.sock", help="socket path given to bin/pwrx --daemon")
+    sub = ap.add_subparsers(dest="command", required=True)
+    run = sub.add_parser("run", help="run one case")
+    run.add_argument("case", help="case name or case directory, resolved by the daemon")
+    run.add_argument("--set", action="append", default=[], metavar="KEY=VALUE", help="config override, repeatable")
+    run.add_argument("--output", default=None, help="output directory of the job")
+    run.add_argument("--quiet", action="store_true")
+    run.add_argument("--json", action="store_true")
+    for command in ("ping", "status", "shutdown"):
+        sub.add_parser(command)
+    args = ap.parse_args()
+
+    for override in getattr(args, "set", []):
+        if "=" not in override:
+            print(f"{RED}[PowerX:Client] Error: --set expects KEY=VALUE, got {override}{COLORRST}")
+            sys.exit(2)
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        sock.connect(args.socket)
+    except OSError as e:
+        print(f"{RED}[PowerX:Client] Error: Cannot connect to {args.socket}: {e}{COLORRST}")
+        sys.exit(2)
+    sock.sendall(("\n".join(request_lines(args)) + "\n\n").encode())
+    sock.shutdown(socket.SHUT_WR)
+
+    quiet = getattr(args, "quiet", False) or getattr(args, "json", False)
+    result = {"case": getattr(args, "case", None), "output": None, "stages": {}, "qor": {}}
+    succeeded = args.command != "run"
+    for raw in sock.makefile("r", encoding="utf-8", errors="replace"):
+        line = raw.rstrip("\n")
+        fields = line.split(" ")
+        if fields[0] == "ERROR":
+            succeeded = False
+            print(f"{RED}[PowerX:Client] {line}{COLORRST}")
+            continue
+        if fields[0] == "OUTPUT":
+            result["output"] = line[len("OUTPUT "):]
+        elif fields[0] == "STAGE" and fields[1] == "DONE":
+            name = " ".join(fields[3:])
+            result["stages"][name] = result["stages"].get(name, 0.0) + float(fields[2])
+        elif fields[0] == "QOR":
+            result["qor"][fields[1]] = float(fields[2])
+        elif fields[0] == "DONE":
+            succeeded = fields[2] == "OK"
+            result["status"] = fields[2]
+            result["wall_s"] = float(fields[3])
+
+        if getattr(args, "json", False): continue
+        if quiet and fields[0] not in ("QOR", "DONE"): continue
+        colour = (GREEN if succeeded else RED) if fields[0] == "DONE" else ""
+        print(f"{colour}{line}{COLORRST if colour else ''}", flush=True)
+    sock.close()
+
+    if getattr(args, "json", False):
+        print(json.dumps(result, indent=2))
+    sys.exit(0 if succeeded else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""
+regressionHarness.py
+Speed and QoR regression check of the full runMyAlgorithm pipeline over case01 ~ case06.
+
+Every case runs as `bin/pwrx <case> --qor`, which writes
+  outputs/<case>_stages.csv      per-stage runtime, RSS and peak RSS growth (TimeProfiler::writeStageCSV)
+  outputs/<case>_qor.csv         worst / weighted average vdrop, power loss, empty metal / via counts
+                                 and checkOnePiece of every metal layer after post-processing
+The figures are compared with a stored baseline; a slower stage, a larger peak RSS or a worse
+QoR beyond its tolerance is a regression and the harness exits with 1.
+
+Usage:
+  make pwrx
+  python3 utils/regressionHarness.py --update-baseline            # record the reference once
+  python3 utils/regressionHarness.py                              # compare, exit 1 on regression
+  python3 utils/regressionHarness.py --cases case01 case04 --repeat 3 --time-tol 0.05
+
+Notes:
+- Runtime is the fastest of --repeat runs, QoR and memory come from the first run. The pipeline is
+  deterministic for a fixed thread count, QoR that differs between repeats is reported as noise.
+- Lower is better for runtime, memory, vdrop and power loss; an improvement is reported, never failed.
+- Empty metal / via counts are a result of the MCF stage, any change beyond --count-tol is flagged.
+- A metal layer that was one piece in the baseline must stay one piece.
+- --batch N launches one `bin/pwrx --batch --jobs N` process per repeat instead of one per case, each case
+  then reports under outputs/<case>/; compare a batch run only with a baseline recorded the same way.
+"""
+
+import os
+import sys
+import json
+import time
+import platform
+import subprocess
+from argparse import ArgumentParser
+
+COLORRST    = "\u001b[0m"
+RED         = "\u001b[31m"
+GREEN       = "\u001b[32m"
+YELLOW      = "\u001b[33m"
+
+ALL_CASES = ["case01", "case02", "case03", "case04", "case05", "case06"]
+LOWER_IS_BETTER = ["worst_vdrop", "weighted_avg_vdrop", "power_loss"]
+COUNTS = ["empty_metal", "empty_via"]
+MiB = 1024.0 * 1024.0
+
+
+def read_csv(path):
+    with open(path) as f:
+        header = f.readline().strip().split(",")
+        return [dict(zip(header, line.strip().split(","))) for line in f if line.strip()]
+
+
+def report_dir(case, batchJobs):
+    """where --qor leaves the reports of a case, a batch gives every case its own sub-directory"""
+    return "outputs" if batchJobs is None else os.path.join("outputs", case)
+
+
+def read_reports(case, reportDir):
+    """(stages, qor) written by --qor, None when missing"""
+    stagesPath = os.path.join(reportDir, case + "_stages.csv")
+    qorPath = os.path.join(reportDir, case + "_qor.csv")
+    if not (os.path.exists(stagesPath) and os.path.exists(qorPath)):
+        return None
+
+    stages = {}
+    for row in read_csv(stagesPath):
+        stages[row["stage"]] = {"runtime_s": float(row["runtime_s"]),
+                                "peak_rss_bytes": int(row["peak_rss_bytes"]),
+                                "peak_rss_growth_bytes": int(row["peak_rss_growth_bytes"])}
+    qor = {row["metric"]: float(row["value"]) for row in read_csv(qorPath)}
+    return stages, qor
+
+
+def run_launch(binary, cases, logDir, batchJobs):
+    """one process for one case, or for all of them with --batch; returns {case: (stages, qor) or None}"""
+    for case in cases:
+        for suffix in ("_stages.csv", "_qor.csv"):
+            path = os.path.join(report_dir(case, batchJobs), case + suffix)
+            if os.path.exists(path): os.remove(path)
+
+    if batchJobs is None:
+        command = [binary, cases[0], "--qor"]
+        logPath = os.path.join(logDir, f"{cases[0]}_regression.log")
+    else:
+        command = [binary, "--batch", "--jobs", str(batchJobs)] + cases + ["--qor"]
+        logPath = os.path.join(logDir, "batch_regression.log")
+    with open(logPath, "w") as log:
+        result = subprocess.run(command, stdout=log, stderr=subprocess.STDOUT)
+    if result.returncode != 0:
+        print(f"{RED}[PowerX:Regression] Error: {' '.join(cases)} exited with {result.returncode}, see {logPath}{COLORRST}")
+
+    # a failed batch may still have finished some of its cases
+    reports = {}
+    for case in cases:
+        reports[case] = read_reports(case, report_dir(case, batchJobs))
+        if reports[case] is None:
+            print(f"{RED}[PowerX:Regression] Error: {case} wrote no stage / QoR report, see {logPath}{COLORRST}")
+    return reports
+
+
+def measure_cases(binary, cases, repeat, logDir, batchJobs):
+    """fastest runtime per stage over repeat runs, memory and QoR of the first run, None for a failed case"""
+    records = {case: None for case in cases}
+    failed = set()
+    for r in range(repeat):
+        launches = [cases] if batchJobs is not None else [[case] for case in cases]
+        for launch in launches:
+            launch = [case for case in launch if case not in failed]
+            if not launch: continue
+            print(f"[PowerX:Regression] {' '.join(launch)} run {r + 1}/{repeat} ...", flush=True)
+            for case, report in run_launch(binary, launch, logDir, batchJobs).items():
+                if report is None:
+                    failed.add(case)
+                    records[case] = None
+                    continue
+                stages, qor = report
+                record = records[case]
+                if record is None:
+                    records[case] = {"stages": stages, "qor": qor}
+                    continue
+                for name, figures in stages.items():
+                    if name in record["stages"]:
+                        record["stages"][name]["runtime_s"] = min(record["stages"][name]["runtime_s"], figures["runtime_s"])
+                if qor != record["qor"]:
+                    print(f"{YELLOW}[PowerX:Regression] Warning: {case} QoR differs between repeats{COLORRST}")
+
+    for record in records.values():
+        if record is not None:
+            record["peak_rss_bytes"] = max([s["peak_rss_bytes"] for s in record["stages"].values()] + [0])
+    return records
+
+
+class Comparison:
+    def __init__(self):
+        self.rows = []
+        self.regressions = 0
+
+    def add(self, case, item, base, new, verdict):
+        if verdict == "REGRESSION": self.regressions += 1
+        self.rows.append((case, item, base, new, verdict))
+
+    def print_report(self):
+        print("╔═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╗")
+        print("║ Case     │ Item                                 │         Baseline │          Current │    Change │ Verdict                       ║")
+        print("╟──────────│──────────────────────────────────────│──────────────────│──────────────────│───────────│───────────────────────────────╢")
+        for case, item, base, new, verdict in self.rows:
+            change = "-" if (base is None or new is None or base == 0) else f"{100.0 * (new - base) / abs(base):+.2f}%"
+            baseText = "-" if base is None else f"{base:.6g}"
+            newText = "-" if new is None else f"{new:.6g}"
+            colour = RED if verdict == "REGRESSION" else (GREEN if verdict == "improved" else "")
+            print(f"║ {case:<8} │ {item:<36.36} │ {baseText:>16} │ {newText:>16} │ {change:>9} │ {colour}{verdict:<30}{COLORRST}║")
+        print("╚═══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════╝")
+
+
+def compare_lower_is_better(cmp, case, item, base, new, relTol, absFloor):
+    if new > base + max(relTol * abs(base), absFloor):
+        cmp.add(case, item, base, new, "REGRESSION")
+    elif new < base - max(relTol * abs(base), absFloor):
+        cmp.add(case, item, base, new, "improved")
+    else:
+        cmp.add(case, item, base, new, "ok")
+
+
+def compare_case(cmp, case, base, new, args):
+    # speed
+    for name, figures in base["stages"].items():
+        if name not in new["stages"]:
+            cmp.add(case, f"time: {name}", figures["runtime_s"], None, "REGRESSION")
+            continue
+        compare_lower_is_better(cmp, case, f"time: {name}", figures["runtime_s"], new["stages"][name]["runtime_s"],
+                                args.time_tol, args.time_floor)
+    baseTotal = sum(s["runtime_s"] for s in base["stages"].values())
+    newTotal = sum(s["runtime_s"] for s in new["stages"].values())
+    compare_lower_is_better(cmp, case, "time: total", baseTotal, newTotal, args.time_tol, args.time_floor)
+
+    # memory, in MiB so the floor reads naturally
+    compare_lower_is_better(cmp, case, "peak RSS (MiB)", base["peak_rss_bytes"] / MiB, new["peak_rss_bytes"] / MiB,
+                            args.mem_tol, args.mem_floor)
+
+    # quality
+    for metric, baseValue in base["qor"].items():
+        newValue = new["qor"].get(metric)
+        if newValue is None:
+            cmp.add(case, metric, baseValue, None, "REGRESSION")
+        elif metric in LOWER_IS_BETTER:
+            compare_lower_is_better(cmp, case, metric, baseValue, newValue, args.qor_tol, 0.0)
+        elif metric in COUNTS:
+            changed = abs(newValue - baseValue) > args.count_tol * max(abs(baseValue), 1.0)
+            cmp.add(case, metric, baseValue, newValue, "REGRESSION" if changed else "ok")
+        elif metric.startswith("one_piece_m"):
+            broken = (baseValue == 1.0) and (newValue != 1.0)
+            fixed = (baseValue != 1.0) and (newValue == 1.0)
+            cmp.add(case, metric, baseValue, newValue, "REGRESSION" if broken else ("improved" if fixed else "ok"))
+        else:
+            cmp.add(case, metric, baseValue, newValue, "ok" if newValue == baseValue else "changed")
+
+
+def main():
+    ap = ArgumentParser(description="Speed and QoR regression check of the PowerX pipeline")
+    ap.add_argument("--binary", default="bin/pwrx")
+    ap.add_argument("--cases", nargs="+", default=ALL_CASES)
+    ap.add_argument("--baseline", default="utils/regressionBaseline.json")
+    ap.add_argument("--update-baseline", action="store_true", help="record the current figures as the baseline")
+    ap.add_argument("--repeat", type=int, default=1, help="runs per case, the fastest runtime counts")
+    ap.add_argument("--time-tol", type=float, default=0.10, help="relative slowdown allowed per stage")
+    ap.add_argument("--time-floor", type=float, default=0.5, help="absolute slowdown in seconds always allowed")
+    ap.add_argument("--mem-tol", type=float, default=0.10, help="relative peak RSS growth allowed")
+    ap.add_argument("--mem-floor", type=float, default=32.0, help="absolute peak RSS growth in MiB always allowed")
+    ap.add_argument("--qor-tol", type=float, default=0.001, help="relative worsening allowed for vdrop and power loss")
+    ap.add_argument("--count-tol", type=float, default=0.0, help="relative change allowed for empty metal / via counts")
+    ap.add_argument("--log-dir", default="outputs")
+    ap.add_argument("--batch", type=int, default=None, metavar="JOBS",
+                    help="run all cases in one --batch process with JOBS workers, stage runtimes then include contention")
+    args = ap.parse_args()
+
+    if not os.path.exists(args.binary):
+        print(f"{RED}[PowerX:Regression] Error: {args.binary} not found, run make first{COLORRST}")
+        sys.exit(2)
+    os.makedirs("outputs", exist_ok=True)
+    os.makedirs(args.log_dir, exist_ok=True)
+
+    records = measure_cases(args.binary, args.cases, args.repeat, args.log_dir, args.batch)
+    current = {case: record for case, record in records.items() if record is not None}
+    failedRuns = [case for case, record in records.items() if record is None]
+
+    if args.update_baseline:
+        if failedRuns:
+            print(f"{RED}[PowerX:Regression] Error: Baseline not written, failed cases: {' '.join(failedRuns)}{COLORRST}")
+            sys.exit(1)
+        baseline = {}
+        if os.path.exists(args.baseline):
+            with open(args.baseline) as f: baseline = json.load(f)
+        baseline.setdefault("cases", {}).update(current)
+        baseline["host"] = platform.node()
+        baseline["recorded"] = time.strftime("%m/%d/%Y %H:%M:%S")
+        with open(args.baseline, "w") as f: json.dump(baseline, f, indent=2, sort_keys=True)
+        print(f"{GREEN}[PowerX:Regression] Baseline of {len(current)} cases written to {args.baseline}{COLORRST}")
+        return
+
+    if not os.path.exists(args.baseline):
+        print(f"{RED}[PowerX:Regression] Error: No baseline at {args.baseline}, record one with --update-baseline{COLORRST}")
+        sys.exit(2)
+    with open(args.baseline) as f: baseline = json.load(f)
+    if baseline.get("host") != platform.node():
+        print(f"{YELLOW}[PowerX:Regression] Warning: Baseline recorded on {baseline.get('host')}, runtimes may not compare{COLORRST}")
+
+    cmp = Comparison()
+    for case in args.cases:
+        if case in failedRuns:
+            cmp.add(case, "pipeline run", None, None, "REGRESSION")
+        elif case not in baseline.get("cases", {}):
+            cmp.add(case, "no baseline", None, None, "skipped")
+        else:
+            compare_case(cmp, case, baseline["cases"][case], current[case], args)
+    cmp.print_report()
+
+    if cmp.regressions != 0:
+        print(f"{RED}[PowerX:Regression] {cmp.regressions} regression(s){COLORRST}")
+        sys.exit(1)
+    print(f"{GREEN}[PowerX:Regression] No regression{COLORRST}")
+
+
+if __name__ == "__main__":
+    main()